@@ -0,0 +1,464 @@
+/**
+ * @file bench_kernels.c
+ * @brief Implementación de los kernels de referencia de bench_kernels.h.
+ */
+
+#include "bench_kernels.h"
+#include <math.h>
+
+#if BENCH_HAS_NEON
+#include <arm_neon.h>
+#endif
+#if BENCH_HAS_CRC32_HW
+#include <arm_acle.h>
+#endif
+
+/** @brief Accesos de 32 bits sobre buffers de bytes sin romper el aliasing estricto. */
+typedef uint32_t __attribute__((may_alias)) bench_u32_alias_t;
+
+uint32_t bench_rand_next(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// --- memcpy / memset ---
+
+void bench_memcpy_bytewise(void* dst, const void* src, size_t n) {
+    volatile uint8_t* d = (volatile uint8_t*)dst; // volatile: evita que el compilador lo convierta en memcpy()
+    const uint8_t* s = (const uint8_t*)src;
+    while (n--) {
+        *d++ = *s++;
+    }
+}
+
+void bench_memcpy_word(void* dst, const void* src, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+
+    // Alinear el destino a 4 bytes
+    while (n > 0 && ((uintptr_t)d & 3u) != 0) {
+        *d++ = *s++;
+        n--;
+    }
+    if (((uintptr_t)s & 3u) == 0) {
+        bench_u32_alias_t* dw = (bench_u32_alias_t*)d;
+        const bench_u32_alias_t* sw = (const bench_u32_alias_t*)s;
+        while (n >= 16) {
+            dw[0] = sw[0];
+            dw[1] = sw[1];
+            dw[2] = sw[2];
+            dw[3] = sw[3];
+            dw += 4;
+            sw += 4;
+            n -= 16;
+        }
+        while (n >= 4) {
+            *dw++ = *sw++;
+            n -= 4;
+        }
+        d = (uint8_t*)dw;
+        s = (const uint8_t*)sw;
+    }
+    // Cola (o todo el resto si el origen no quedó alineado)
+    while (n--) {
+        *d++ = *s++;
+    }
+}
+
+void bench_memset_bytewise(void* dst, uint8_t value, size_t n) {
+    volatile uint8_t* d = (volatile uint8_t*)dst;
+    while (n--) {
+        *d++ = value;
+    }
+}
+
+void bench_memset_word(void* dst, uint8_t value, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    uint32_t pattern = 0x01010101u * value;
+
+    while (n > 0 && ((uintptr_t)d & 3u) != 0) {
+        *d++ = value;
+        n--;
+    }
+    bench_u32_alias_t* dw = (bench_u32_alias_t*)d;
+    while (n >= 16) {
+        dw[0] = pattern;
+        dw[1] = pattern;
+        dw[2] = pattern;
+        dw[3] = pattern;
+        dw += 4;
+        n -= 16;
+    }
+    while (n >= 4) {
+        *dw++ = pattern;
+        n -= 4;
+    }
+    d = (uint8_t*)dw;
+    while (n--) {
+        *d++ = value;
+    }
+}
+
+#if BENCH_HAS_NEON
+void bench_memcpy_neon(void* dst, const void* src, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+    while (n >= 64) {
+        uint8x16_t v0 = vld1q_u8(s);
+        uint8x16_t v1 = vld1q_u8(s + 16);
+        uint8x16_t v2 = vld1q_u8(s + 32);
+        uint8x16_t v3 = vld1q_u8(s + 48);
+        vst1q_u8(d, v0);
+        vst1q_u8(d + 16, v1);
+        vst1q_u8(d + 32, v2);
+        vst1q_u8(d + 48, v3);
+        d += 64;
+        s += 64;
+        n -= 64;
+    }
+    while (n >= 16) {
+        vst1q_u8(d, vld1q_u8(s));
+        d += 16;
+        s += 16;
+        n -= 16;
+    }
+    while (n--) {
+        *d++ = *s++;
+    }
+}
+
+void bench_memset_neon(void* dst, uint8_t value, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    uint8x16_t v = vdupq_n_u8(value);
+    while (n >= 64) {
+        vst1q_u8(d, v);
+        vst1q_u8(d + 16, v);
+        vst1q_u8(d + 32, v);
+        vst1q_u8(d + 48, v);
+        d += 64;
+        n -= 64;
+    }
+    while (n >= 16) {
+        vst1q_u8(d, v);
+        d += 16;
+        n -= 16;
+    }
+    while (n--) {
+        *d++ = value;
+    }
+}
+#endif
+
+// --- CRC32 ---
+
+static uint32_t s_crc32_tables[8][256];
+
+void bench_crc32_init(void) {
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1u) ? (c >> 1) ^ 0xEDB88320u : (c >> 1);
+        }
+        s_crc32_tables[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+        for (int t = 1; t < 8; ++t) {
+            uint32_t prev = s_crc32_tables[t - 1][i];
+            s_crc32_tables[t][i] = (prev >> 8) ^ s_crc32_tables[0][prev & 0xFFu];
+        }
+    }
+}
+
+uint32_t bench_crc32_bitwise(const uint8_t* data, size_t n) {
+    uint32_t crc = 0xFFFFFFFFu;
+    while (n--) {
+        crc ^= *data++;
+        for (int k = 0; k < 8; ++k) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+uint32_t bench_crc32_table(const uint8_t* data, size_t n) {
+    uint32_t crc = 0xFFFFFFFFu;
+    while (n--) {
+        crc = (crc >> 8) ^ s_crc32_tables[0][(crc ^ *data++) & 0xFFu];
+    }
+    return ~crc;
+}
+
+uint32_t bench_crc32_slice8(const uint8_t* data, size_t n) {
+    uint32_t crc = 0xFFFFFFFFu;
+    while (n >= 8) {
+        // Lectura little-endian byte a byte: válida para cualquier alineación y endianness
+        uint32_t one = ((uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+                        ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24)) ^ crc;
+        uint32_t two = (uint32_t)data[4] | ((uint32_t)data[5] << 8) |
+                       ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24);
+        crc = s_crc32_tables[7][one & 0xFFu] ^
+              s_crc32_tables[6][(one >> 8) & 0xFFu] ^
+              s_crc32_tables[5][(one >> 16) & 0xFFu] ^
+              s_crc32_tables[4][one >> 24] ^
+              s_crc32_tables[3][two & 0xFFu] ^
+              s_crc32_tables[2][(two >> 8) & 0xFFu] ^
+              s_crc32_tables[1][(two >> 16) & 0xFFu] ^
+              s_crc32_tables[0][two >> 24];
+        data += 8;
+        n -= 8;
+    }
+    while (n--) {
+        crc = (crc >> 8) ^ s_crc32_tables[0][(crc ^ *data++) & 0xFFu];
+    }
+    return ~crc;
+}
+
+#if BENCH_HAS_CRC32_HW
+uint32_t bench_crc32_hw(const uint8_t* data, size_t n) {
+    uint32_t crc = 0xFFFFFFFFu;
+    while (n > 0 && ((uintptr_t)data & 3u) != 0) {
+        crc = __crc32b(crc, *data++);
+        n--;
+    }
+    while (n >= 4) {
+        crc = __crc32w(crc, *(const bench_u32_alias_t*)data);
+        data += 4;
+        n -= 4;
+    }
+    while (n--) {
+        crc = __crc32b(crc, *data++);
+    }
+    return ~crc;
+}
+#endif
+
+// --- FIR ---
+
+void bench_fir_scalar(const float* in, const float* coeffs, float* out, size_t n_out, size_t n_taps) {
+    for (size_t i = 0; i < n_out; ++i) {
+        float acc = 0.0f;
+        for (size_t k = 0; k < n_taps; ++k) {
+            acc += coeffs[k] * in[i + k];
+        }
+        out[i] = acc;
+    }
+}
+
+#if BENCH_HAS_NEON
+void bench_fir_neon(const float* in, const float* coeffs, float* out, size_t n_out, size_t n_taps) {
+    size_t i = 0;
+    // Cuatro salidas consecutivas por iteración: cada tap se multiplica por una ventana de 4 muestras
+    for (; i + 4 <= n_out; i += 4) {
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        for (size_t k = 0; k < n_taps; ++k) {
+            acc = vmlaq_n_f32(acc, vld1q_f32(&in[i + k]), coeffs[k]);
+        }
+        vst1q_f32(&out[i], acc);
+    }
+    if (i < n_out) {
+        bench_fir_scalar(&in[i], coeffs, &out[i], n_out - i, n_taps);
+    }
+}
+#endif
+
+// --- FFT ---
+
+static bench_complex_t s_fft_twiddles[BENCH_FFT_MAX_N / 2];
+
+void bench_fft_init(void) {
+    const double pi = 3.14159265358979323846;
+    for (size_t k = 0; k < BENCH_FFT_MAX_N / 2; ++k) {
+        double angle = -2.0 * pi * (double)k / (double)BENCH_FFT_MAX_N;
+        s_fft_twiddles[k].re = (float)cos(angle);
+        s_fft_twiddles[k].im = (float)sin(angle);
+    }
+}
+
+void bench_fft_radix2(bench_complex_t* data, size_t n) {
+    // Permutación bit-reversal
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            bench_complex_t tmp = data[i];
+            data[i] = data[j];
+            data[j] = tmp;
+        }
+    }
+    // Mariposas
+    for (size_t len = 2; len <= n; len <<= 1) {
+        size_t half = len >> 1;
+        size_t stride = BENCH_FFT_MAX_N / len;
+        for (size_t start = 0; start < n; start += len) {
+            for (size_t k = 0; k < half; ++k) {
+                bench_complex_t w = s_fft_twiddles[k * stride];
+                bench_complex_t* a = &data[start + k];
+                bench_complex_t* b = &data[start + k + half];
+                float tre = b->re * w.re - b->im * w.im;
+                float tim = b->re * w.im + b->im * w.re;
+                b->re = a->re - tre;
+                b->im = a->im - tim;
+                a->re += tre;
+                a->im += tim;
+            }
+        }
+    }
+}
+
+// --- Matrices ---
+
+/** @brief Tamaño de bloque para la versión blocked (16x16 floats = 1 KiB por bloque). */
+#define BENCH_MATMUL_BLOCK 16
+
+void bench_matmul_naive(const float* a, const float* b, float* c, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            float acc = 0.0f;
+            for (size_t k = 0; k < n; ++k) {
+                acc += a[i * n + k] * b[k * n + j];
+            }
+            c[i * n + j] = acc;
+        }
+    }
+}
+
+void bench_matmul_blocked(const float* a, const float* b, float* c, size_t n) {
+    for (size_t i = 0; i < n * n; ++i) {
+        c[i] = 0.0f;
+    }
+    for (size_t ii = 0; ii < n; ii += BENCH_MATMUL_BLOCK) {
+        size_t i_end = (ii + BENCH_MATMUL_BLOCK < n) ? ii + BENCH_MATMUL_BLOCK : n;
+        for (size_t kk = 0; kk < n; kk += BENCH_MATMUL_BLOCK) {
+            size_t k_end = (kk + BENCH_MATMUL_BLOCK < n) ? kk + BENCH_MATMUL_BLOCK : n;
+            for (size_t jj = 0; jj < n; jj += BENCH_MATMUL_BLOCK) {
+                size_t j_end = (jj + BENCH_MATMUL_BLOCK < n) ? jj + BENCH_MATMUL_BLOCK : n;
+                for (size_t i = ii; i < i_end; ++i) {
+                    for (size_t k = kk; k < k_end; ++k) {
+                        float aik = a[i * n + k];
+                        for (size_t j = jj; j < j_end; ++j) {
+                            c[i * n + j] += aik * b[k * n + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#if BENCH_HAS_NEON
+void bench_matmul_neon(const float* a, const float* b, float* c, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = 0;
+        for (; j + 4 <= n; j += 4) {
+            float32x4_t acc = vdupq_n_f32(0.0f);
+            for (size_t k = 0; k < n; ++k) {
+                acc = vmlaq_n_f32(acc, vld1q_f32(&b[k * n + j]), a[i * n + k]);
+            }
+            vst1q_f32(&c[i * n + j], acc);
+        }
+        for (; j < n; ++j) {
+            float acc = 0.0f;
+            for (size_t k = 0; k < n; ++k) {
+                acc += a[i * n + k] * b[k * n + j];
+            }
+            c[i * n + j] = acc;
+        }
+    }
+}
+#endif
+
+// --- Ordenación ---
+
+static void bench_insertion_sort_u32(uint32_t* data, size_t n) {
+    for (size_t i = 1; i < n; ++i) {
+        uint32_t v = data[i];
+        size_t j = i;
+        while (j > 0 && data[j - 1] > v) {
+            data[j] = data[j - 1];
+            j--;
+        }
+        data[j] = v;
+    }
+}
+
+void bench_quicksort_u32(uint32_t* data, size_t n) {
+    // Pila explícita: siempre se apila la partición grande, así la profundidad es O(log n)
+    size_t stack_lo[64];
+    size_t stack_hi[64];
+    int top = 0;
+
+    if (n < 2) return;
+    stack_lo[top] = 0;
+    stack_hi[top] = n - 1;
+    top++;
+
+    while (top > 0) {
+        top--;
+        size_t lo = stack_lo[top];
+        size_t hi = stack_hi[top];
+
+        while (hi > lo && hi - lo >= 16) {
+            // Mediana de tres como pivote
+            size_t mid = lo + (hi - lo) / 2;
+            uint32_t x = data[lo], y = data[mid], z = data[hi];
+            uint32_t pivot = (x < y) ? ((y < z) ? y : ((x < z) ? z : x))
+                                     : ((x < z) ? x : ((y < z) ? z : y));
+            size_t i = lo;
+            size_t j = hi;
+            while (i <= j) {
+                while (data[i] < pivot) i++;
+                while (data[j] > pivot) j--;
+                if (i <= j) {
+                    uint32_t tmp = data[i];
+                    data[i] = data[j];
+                    data[j] = tmp;
+                    i++;
+                    if (j == 0) break;
+                    j--;
+                }
+            }
+            // [lo, j] y [i, hi]: se itera sobre la pequeña y se apila la grande
+            if (j - lo < hi - i) {
+                if (i < hi) { stack_lo[top] = i; stack_hi[top] = hi; top++; }
+                hi = j;
+            } else {
+                if (lo < j) { stack_lo[top] = lo; stack_hi[top] = j; top++; }
+                lo = i;
+            }
+        }
+        if (hi > lo) {
+            bench_insertion_sort_u32(&data[lo], hi - lo + 1);
+        }
+    }
+}
+
+void bench_radix_sort_u32(uint32_t* data, uint32_t* tmp, size_t n) {
+    uint32_t* src = data;
+    uint32_t* dst = tmp;
+    for (int shift = 0; shift < 32; shift += 8) {
+        size_t count[256] = {0};
+        for (size_t i = 0; i < n; ++i) {
+            count[(src[i] >> shift) & 0xFFu]++;
+        }
+        size_t sum = 0;
+        for (int b = 0; b < 256; ++b) {
+            size_t c = count[b];
+            count[b] = sum;
+            sum += c;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            dst[count[(src[i] >> shift) & 0xFFu]++] = src[i];
+        }
+        uint32_t* swap = src;
+        src = dst;
+        dst = swap;
+    }
+    // Con 4 pasadas el resultado termina de nuevo en `data`
+}
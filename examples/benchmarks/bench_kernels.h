@@ -0,0 +1,102 @@
+/**
+ * @file bench_kernels.h
+ * @brief Kernels de referencia para caracterizar placas y compiladores con BMT.
+ *
+ * Cada kernel tiene una variante escalar y, donde aplica, una variante NEON
+ * (compilada solo si el compilador define `__ARM_NEON`) o con instrucciones
+ * específicas (`__ARM_FEATURE_CRC32`). Ningún kernel usa memoria dinámica.
+ */
+
+#ifndef BENCH_KERNELS_H
+#define BENCH_KERNELS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define BENCH_HAS_NEON 1
+#else
+#define BENCH_HAS_NEON 0
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#define BENCH_HAS_CRC32_HW 1
+#else
+#define BENCH_HAS_CRC32_HW 0
+#endif
+
+/** @brief Generador pseudoaleatorio xorshift32 para rellenar datos de prueba. */
+uint32_t bench_rand_next(uint32_t* state);
+
+// --- memcpy / memset ---
+
+void bench_memcpy_bytewise(void* dst, const void* src, size_t n);
+void bench_memcpy_word(void* dst, const void* src, size_t n);
+void bench_memset_bytewise(void* dst, uint8_t value, size_t n);
+void bench_memset_word(void* dst, uint8_t value, size_t n);
+#if BENCH_HAS_NEON
+void bench_memcpy_neon(void* dst, const void* src, size_t n);
+void bench_memset_neon(void* dst, uint8_t value, size_t n);
+#endif
+
+// --- CRC32 (IEEE 802.3, reflejado, polinomio 0xEDB88320) ---
+
+/** @brief Inicializa las tablas de CRC32 (1 tabla para la versión por bytes, 8 para slice-by-8). */
+void bench_crc32_init(void);
+uint32_t bench_crc32_bitwise(const uint8_t* data, size_t n);
+uint32_t bench_crc32_table(const uint8_t* data, size_t n);
+uint32_t bench_crc32_slice8(const uint8_t* data, size_t n);
+#if BENCH_HAS_CRC32_HW
+uint32_t bench_crc32_hw(const uint8_t* data, size_t n);
+#endif
+
+// --- Filtro FIR ---
+
+/**
+ * @brief Filtro FIR: out[i] = sum_k coeffs[k] * in[i + k], para i en [0, n_out).
+ * @note `in` debe tener al menos `n_out + n_taps - 1` muestras.
+ */
+void bench_fir_scalar(const float* in, const float* coeffs, float* out, size_t n_out, size_t n_taps);
+#if BENCH_HAS_NEON
+void bench_fir_neon(const float* in, const float* coeffs, float* out, size_t n_out, size_t n_taps);
+#endif
+
+// --- FFT radix-2 ---
+
+/** @brief Tamaño máximo de FFT soportado por la tabla de twiddles estática. */
+#define BENCH_FFT_MAX_N 1024
+
+/** @brief Número complejo en formato intercalado (re, im). */
+typedef struct {
+    float re;
+    float im;
+} bench_complex_t;
+
+/** @brief Precalcula los twiddles para FFTs de hasta BENCH_FFT_MAX_N puntos. */
+void bench_fft_init(void);
+
+/**
+ * @brief FFT compleja in-place, radix-2, decimación en el tiempo.
+ * @param data Datos de entrada/salida.
+ * @param n Número de puntos. Potencia de 2, como máximo BENCH_FFT_MAX_N.
+ */
+void bench_fft_radix2(bench_complex_t* data, size_t n);
+
+// --- Multiplicación de matrices (cuadradas, row-major) ---
+
+void bench_matmul_naive(const float* a, const float* b, float* c, size_t n);
+void bench_matmul_blocked(const float* a, const float* b, float* c, size_t n);
+#if BENCH_HAS_NEON
+void bench_matmul_neon(const float* a, const float* b, float* c, size_t n);
+#endif
+
+// --- Ordenación ---
+
+void bench_quicksort_u32(uint32_t* data, size_t n);
+/**
+ * @brief Radix sort LSD de 8 bits.
+ * @param tmp Buffer auxiliar de `n` elementos.
+ */
+void bench_radix_sort_u32(uint32_t* data, uint32_t* tmp, size_t n);
+
+#endif // BENCH_KERNELS_H
@@ -0,0 +1,544 @@
+/**
+ * @file bench_tests.c
+ * @brief Suite de benchmarks de referencia para caracterizar placas y compiladores.
+ *
+ * Contiene dos grupos de tests:
+ * - `BenchCorrectness.*`: comprueban que todas las variantes (escalar, NEON, HW) de cada
+ *   kernel dan el mismo resultado que la referencia. Se ejecutan siempre.
+ * - `Bench.*`: miden cada variante con bmt_bench_run() (o bmt_bench_compare() para los
+ *   pares A/B con muestras intercaladas) y reportan ns/iteración, ruido (CV) y MB/s
+ *   en líneas "[ BENCH    ]" que `parse_bmt_output.py --bench_json` recoge.
+ *
+ * Este archivo no define `main()`: se enlaza junto con `examples/linux_host/main_linux_host.c`
+ * en el host, o se añade al proyecto de Vitis junto a `main_tests.c` en las placas Xilinx.
+ * Con `BMT_BENCH_QUICK` definido, se reducen tamaños e iteraciones (útil en placas lentas).
+ */
+
+#include "baremetal_test.h"
+#include "bmt_bench.h"
+#include "bench_kernels.h"
+#include <string.h>
+#include <math.h>
+
+#ifdef BMT_BENCH_QUICK
+#define BENCH_ITER_SCALE 1
+#else
+#define BENCH_ITER_SCALE 10
+#endif
+
+/** @brief Tamaño máximo de los buffers de memcpy/memset/CRC. */
+#define BENCH_BUF_SIZE 16384
+/** @brief Número de elementos para los benchmarks de ordenación. */
+#define BENCH_SORT_N 4096
+/** @brief Dimensión de las matrices (cuadradas). */
+#define BENCH_MATMUL_N 64
+/** @brief Número de taps del filtro FIR. */
+#define BENCH_FIR_TAPS 32
+/** @brief Número de salidas del filtro FIR. */
+#define BENCH_FIR_N 1024
+
+// Buffers estáticos (sin memoria dinámica). +64 bytes para poder desalinear origen/destino.
+static uint8_t s_src[BENCH_BUF_SIZE + 64] __attribute__((aligned(64)));
+static uint8_t s_dst[BENCH_BUF_SIZE + 64] __attribute__((aligned(64)));
+static uint32_t s_sort_a[BENCH_SORT_N];
+static uint32_t s_sort_b[BENCH_SORT_N];
+static uint32_t s_sort_tmp[BENCH_SORT_N];
+static uint32_t s_sort_input[BENCH_SORT_N];
+static float s_mat_a[BENCH_MATMUL_N * BENCH_MATMUL_N] __attribute__((aligned(16)));
+static float s_mat_b[BENCH_MATMUL_N * BENCH_MATMUL_N] __attribute__((aligned(16)));
+static float s_mat_c[BENCH_MATMUL_N * BENCH_MATMUL_N] __attribute__((aligned(16)));
+static float s_mat_ref[BENCH_MATMUL_N * BENCH_MATMUL_N] __attribute__((aligned(16)));
+static float s_fir_in[BENCH_FIR_N + BENCH_FIR_TAPS] __attribute__((aligned(16)));
+static float s_fir_coeffs[BENCH_FIR_TAPS] __attribute__((aligned(16)));
+static float s_fir_out[BENCH_FIR_N] __attribute__((aligned(16)));
+static float s_fir_ref[BENCH_FIR_N] __attribute__((aligned(16)));
+static bench_complex_t s_fft_data[BENCH_FFT_MAX_N];
+
+/**
+ * @brief Rellena los buffers de entrada con datos pseudoaleatorios reproducibles
+ *        e inicializa las tablas de CRC32 y FFT.
+ */
+static void bench_prepare_inputs(void) {
+    uint32_t seed = 0x12345678u;
+    for (size_t i = 0; i < sizeof(s_src); ++i) {
+        s_src[i] = (uint8_t)bench_rand_next(&seed);
+    }
+    for (size_t i = 0; i < BENCH_SORT_N; ++i) {
+        s_sort_input[i] = bench_rand_next(&seed);
+    }
+    for (size_t i = 0; i < BENCH_MATMUL_N * BENCH_MATMUL_N; ++i) {
+        s_mat_a[i] = (float)(bench_rand_next(&seed) % 200) / 100.0f - 1.0f;
+        s_mat_b[i] = (float)(bench_rand_next(&seed) % 200) / 100.0f - 1.0f;
+    }
+    for (size_t i = 0; i < BENCH_FIR_N + BENCH_FIR_TAPS; ++i) {
+        s_fir_in[i] = (float)(bench_rand_next(&seed) % 2000) / 1000.0f - 1.0f;
+    }
+    for (size_t k = 0; k < BENCH_FIR_TAPS; ++k) {
+        s_fir_coeffs[k] = 1.0f / (float)(k + 1);
+    }
+    bench_crc32_init();
+    bench_fft_init();
+}
+
+/**
+ * @brief Comprueba si un array está ordenado de forma no decreciente.
+ */
+static int bench_is_sorted(const uint32_t* data, size_t n) {
+    for (size_t i = 1; i < n; ++i) {
+        if (data[i - 1] > data[i]) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Máxima diferencia absoluta entre dos arrays de floats.
+ */
+static float bench_max_abs_diff(const float* a, const float* b, size_t n) {
+    float max = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        float d = fabsf(a[i] - b[i]);
+        if (d > max) max = d;
+    }
+    return max;
+}
+
+// ============================================================================
+// Tests de corrección
+// ============================================================================
+
+/**
+ * @brief Todas las variantes de memcpy copian correctamente con cualquier alineación y tamaño.
+ */
+TEST(BenchCorrectness, MemcpyAllAlignments) {
+    bench_prepare_inputs();
+    static const size_t sizes[] = {0, 1, 3, 15, 16, 17, 63, 64, 65, 1000};
+    for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+        for (size_t src_off = 0; src_off < 4; ++src_off) {
+            for (size_t dst_off = 0; dst_off < 4; ++dst_off) {
+                size_t n = sizes[si];
+                memset(s_dst, 0xEE, n + 8);
+                bench_memcpy_word(s_dst + dst_off, s_src + src_off, n);
+                ASSERT_EQ(memcmp(s_dst + dst_off, s_src + src_off, n), 0);
+                ASSERT_EQ(s_dst[dst_off + n], 0xEE); // Sin escribir fuera de rango
+
+                memset(s_dst, 0xEE, n + 8);
+                bench_memcpy_bytewise(s_dst + dst_off, s_src + src_off, n);
+                ASSERT_EQ(memcmp(s_dst + dst_off, s_src + src_off, n), 0);
+#if BENCH_HAS_NEON
+                memset(s_dst, 0xEE, n + 8);
+                bench_memcpy_neon(s_dst + dst_off, s_src + src_off, n);
+                ASSERT_EQ(memcmp(s_dst + dst_off, s_src + src_off, n), 0);
+                ASSERT_EQ(s_dst[dst_off + n], 0xEE);
+#endif
+            }
+        }
+    }
+}
+
+/**
+ * @brief Todas las variantes de memset rellenan exactamente el rango pedido.
+ */
+TEST(BenchCorrectness, MemsetAllAlignments) {
+    static const size_t sizes[] = {0, 1, 5, 16, 31, 64, 100};
+    for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+        for (size_t off = 0; off < 4; ++off) {
+            size_t n = sizes[si];
+            memset(s_dst, 0xEE, n + 8);
+            bench_memset_word(s_dst + off, 0x5A, n);
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(s_dst[off + i], 0x5A);
+            }
+            ASSERT_EQ(s_dst[off + n], 0xEE);
+
+            memset(s_dst, 0xEE, n + 8);
+            bench_memset_bytewise(s_dst + off, 0x5A, n);
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(s_dst[off + i], 0x5A);
+            }
+#if BENCH_HAS_NEON
+            memset(s_dst, 0xEE, n + 8);
+            bench_memset_neon(s_dst + off, 0x5A, n);
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(s_dst[off + i], 0x5A);
+            }
+            ASSERT_EQ(s_dst[off + n], 0xEE);
+#endif
+        }
+    }
+}
+
+/**
+ * @brief CRC32 del vector de comprobación estándar "123456789" (0xCBF43926) y
+ *        coherencia entre variantes sobre datos aleatorios.
+ */
+TEST(BenchCorrectness, Crc32) {
+    bench_prepare_inputs();
+    const uint8_t* check = (const uint8_t*)"123456789";
+    ASSERT_EQ(bench_crc32_bitwise(check, 9), 0xCBF43926u);
+    ASSERT_EQ(bench_crc32_table(check, 9), 0xCBF43926u);
+    ASSERT_EQ(bench_crc32_slice8(check, 9), 0xCBF43926u);
+
+    for (size_t off = 0; off < 8; ++off) {
+        uint32_t ref = bench_crc32_bitwise(s_src + off, 1021);
+        EXPECT_EQ(bench_crc32_table(s_src + off, 1021), ref);
+        EXPECT_EQ(bench_crc32_slice8(s_src + off, 1021), ref);
+#if BENCH_HAS_CRC32_HW
+        EXPECT_EQ(bench_crc32_hw(s_src + off, 1021), ref);
+#endif
+    }
+}
+
+/**
+ * @brief El filtro FIR escalar coincide con un cálculo directo y la variante NEON con la escalar.
+ */
+TEST(BenchCorrectness, Fir) {
+    bench_prepare_inputs();
+    bench_fir_scalar(s_fir_in, s_fir_coeffs, s_fir_ref, BENCH_FIR_N, BENCH_FIR_TAPS);
+
+    double direct = 0.0;
+    for (size_t k = 0; k < BENCH_FIR_TAPS; ++k) {
+        direct += (double)s_fir_coeffs[k] * (double)s_fir_in[5 + k];
+    }
+    ASSERT_NEAR(s_fir_ref[5], direct, 1e-4);
+#if BENCH_HAS_NEON
+    bench_fir_neon(s_fir_in, s_fir_coeffs, s_fir_out, BENCH_FIR_N - 3, BENCH_FIR_TAPS); // Con cola escalar
+    ASSERT_TRUE(bench_max_abs_diff(s_fir_out, s_fir_ref, BENCH_FIR_N - 3) < 1e-4f);
+#endif
+}
+
+/**
+ * @brief La FFT de un tono puro concentra la energía en el bin esperado.
+ */
+TEST(BenchCorrectness, FftSingleTone) {
+    bench_prepare_inputs();
+    const size_t n = 256;
+    const size_t bin = 10;
+    const double pi = 3.14159265358979323846;
+    for (size_t i = 0; i < n; ++i) {
+        s_fft_data[i].re = (float)cos(2.0 * pi * (double)(bin * i) / (double)n);
+        s_fft_data[i].im = 0.0f;
+    }
+    bench_fft_radix2(s_fft_data, n);
+
+    // Un coseno de amplitud 1 da n/2 en los bins +bin y -bin, y ~0 en el resto
+    ASSERT_NEAR(s_fft_data[bin].re, n / 2.0, 1e-2);
+    ASSERT_NEAR(s_fft_data[n - bin].re, n / 2.0, 1e-2);
+    for (size_t k = 0; k < n; ++k) {
+        if (k == bin || k == n - bin) continue;
+        float mag = fabsf(s_fft_data[k].re) + fabsf(s_fft_data[k].im);
+        ASSERT_TRUE(mag < 1e-2f);
+    }
+}
+
+/**
+ * @brief Las variantes blocked y NEON de la multiplicación de matrices coinciden con la naive.
+ */
+TEST(BenchCorrectness, Matmul) {
+    bench_prepare_inputs();
+    bench_matmul_naive(s_mat_a, s_mat_b, s_mat_ref, BENCH_MATMUL_N);
+    bench_matmul_blocked(s_mat_a, s_mat_b, s_mat_c, BENCH_MATMUL_N);
+    ASSERT_TRUE(bench_max_abs_diff(s_mat_c, s_mat_ref, BENCH_MATMUL_N * BENCH_MATMUL_N) < 1e-3f);
+
+    // Tamaño no múltiplo del bloque ni del ancho SIMD
+    bench_matmul_naive(s_mat_a, s_mat_b, s_mat_ref, 37);
+    bench_matmul_blocked(s_mat_a, s_mat_b, s_mat_c, 37);
+    ASSERT_TRUE(bench_max_abs_diff(s_mat_c, s_mat_ref, 37 * 37) < 1e-3f);
+#if BENCH_HAS_NEON
+    bench_matmul_neon(s_mat_a, s_mat_b, s_mat_c, 37);
+    ASSERT_TRUE(bench_max_abs_diff(s_mat_c, s_mat_ref, 37 * 37) < 1e-3f);
+#endif
+}
+
+/**
+ * @brief Quicksort y radix sort ordenan igual datos aleatorios, ordenados, inversos y repetidos.
+ */
+TEST(BenchCorrectness, Sorting) {
+    bench_prepare_inputs();
+    for (int pattern = 0; pattern < 4; ++pattern) {
+        for (size_t i = 0; i < BENCH_SORT_N; ++i) {
+            switch (pattern) {
+                case 0: s_sort_a[i] = s_sort_input[i]; break;
+                case 1: s_sort_a[i] = (uint32_t)i; break;
+                case 2: s_sort_a[i] = (uint32_t)(BENCH_SORT_N - i); break;
+                default: s_sort_a[i] = s_sort_input[i] % 7u; break;
+            }
+            s_sort_b[i] = s_sort_a[i];
+        }
+        bench_quicksort_u32(s_sort_a, BENCH_SORT_N);
+        bench_radix_sort_u32(s_sort_b, s_sort_tmp, BENCH_SORT_N);
+        ASSERT_TRUE(bench_is_sorted(s_sort_a, BENCH_SORT_N));
+        ASSERT_EQ(memcmp(s_sort_a, s_sort_b, sizeof(s_sort_a)), 0);
+    }
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+/** @brief Contexto común para los benchmarks de memoria: tamaño y desalineación. */
+typedef struct {
+    size_t size;
+    size_t src_off;
+    size_t dst_off;
+} bench_mem_ctx_t;
+
+static void bench_body_memcpy_libc(void* ctx) {
+    const bench_mem_ctx_t* c = (const bench_mem_ctx_t*)ctx;
+    memcpy(s_dst + c->dst_off, s_src + c->src_off, c->size);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+static void bench_body_memcpy_word(void* ctx) {
+    const bench_mem_ctx_t* c = (const bench_mem_ctx_t*)ctx;
+    bench_memcpy_word(s_dst + c->dst_off, s_src + c->src_off, c->size);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+static void bench_body_memcpy_bytewise(void* ctx) {
+    const bench_mem_ctx_t* c = (const bench_mem_ctx_t*)ctx;
+    bench_memcpy_bytewise(s_dst + c->dst_off, s_src + c->src_off, c->size);
+}
+
+static void bench_body_memset_libc(void* ctx) {
+    const bench_mem_ctx_t* c = (const bench_mem_ctx_t*)ctx;
+    memset(s_dst + c->dst_off, 0xA5, c->size);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+static void bench_body_memset_word(void* ctx) {
+    const bench_mem_ctx_t* c = (const bench_mem_ctx_t*)ctx;
+    bench_memset_word(s_dst + c->dst_off, 0xA5, c->size);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+#if BENCH_HAS_NEON
+static void bench_body_memcpy_neon(void* ctx) {
+    const bench_mem_ctx_t* c = (const bench_mem_ctx_t*)ctx;
+    bench_memcpy_neon(s_dst + c->dst_off, s_src + c->src_off, c->size);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+static void bench_body_memset_neon(void* ctx) {
+    const bench_mem_ctx_t* c = (const bench_mem_ctx_t*)ctx;
+    bench_memset_neon(s_dst + c->dst_off, 0xA5, c->size);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+#endif
+
+/** @brief Valor de `off` para bench_make_name() que omite el sufijo de desalineación. */
+#define BENCH_NO_OFFSET ((size_t)-1)
+
+/**
+ * @brief Compone el nombre "kernel/tamaño/+off" de un benchmark en un buffer.
+ */
+static const char* bench_make_name(char* buf, size_t buf_len, const char* kernel, size_t size, size_t off) {
+    size_t pos = 0;
+    char digits[12];
+    int nd;
+
+    while (*kernel && pos + 1 < buf_len) buf[pos++] = *kernel++;
+    if (pos + 1 < buf_len) buf[pos++] = '/';
+    nd = 0;
+    do { digits[nd++] = (char)('0' + size % 10); size /= 10; } while (size > 0);
+    while (nd > 0 && pos + 1 < buf_len) buf[pos++] = digits[--nd];
+    if (off != BENCH_NO_OFFSET && pos + 3 < buf_len) {
+        buf[pos++] = '/';
+        buf[pos++] = '+';
+        buf[pos++] = (char)('0' + off % 10);
+    }
+    buf[pos] = '\0';
+    return buf;
+}
+
+/** @brief Iteraciones por muestra para procesar ~256 KiB por muestra en los kernels de memoria. */
+static uint32_t bench_mem_iterations(size_t size) {
+    uint32_t iters = (uint32_t)((256u * 1024u * BENCH_ITER_SCALE / 10u) / (size ? size : 1));
+    return iters > 0 ? iters : 1;
+}
+
+/**
+ * @brief memcpy (libc, palabra, byte a byte, NEON) con tamaños de 64 B a 16 KiB,
+ *        alineado y con origen desalineado.
+ */
+TEST(Bench, Memcpy) {
+    static const size_t sizes[] = {64, 1024, BENCH_BUF_SIZE};
+    static const size_t offsets[] = {0, 1};
+    char name[48];
+    bench_prepare_inputs();
+
+    for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+        for (size_t oi = 0; oi < sizeof(offsets) / sizeof(offsets[0]); ++oi) {
+            bench_mem_ctx_t ctx = {sizes[si], offsets[oi], 0};
+            uint32_t iters = bench_mem_iterations(ctx.size);
+            bmt_bench_run(bench_make_name(name, sizeof(name), "memcpy_libc", ctx.size, ctx.src_off),
+                          bench_body_memcpy_libc, &ctx, iters, (uint32_t)ctx.size, NULL);
+            bmt_bench_run(bench_make_name(name, sizeof(name), "memcpy_word", ctx.size, ctx.src_off),
+                          bench_body_memcpy_word, &ctx, iters, (uint32_t)ctx.size, NULL);
+            bmt_bench_run(bench_make_name(name, sizeof(name), "memcpy_byte", ctx.size, ctx.src_off),
+                          bench_body_memcpy_bytewise, &ctx, iters, (uint32_t)ctx.size, NULL);
+#if BENCH_HAS_NEON
+            bmt_bench_run(bench_make_name(name, sizeof(name), "memcpy_neon", ctx.size, ctx.src_off),
+                          bench_body_memcpy_neon, &ctx, iters, (uint32_t)ctx.size, NULL);
+#endif
+        }
+    }
+    ASSERT_EQ(memcmp(s_dst, s_src + 1, BENCH_BUF_SIZE), 0);
+}
+
+/**
+ * @brief memset (libc, palabra, NEON) con tamaños de 64 B a 16 KiB, alineado y desalineado.
+ */
+TEST(Bench, Memset) {
+    static const size_t sizes[] = {64, 1024, BENCH_BUF_SIZE};
+    static const size_t offsets[] = {0, 1};
+    char name[48];
+
+    for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+        for (size_t oi = 0; oi < sizeof(offsets) / sizeof(offsets[0]); ++oi) {
+            bench_mem_ctx_t ctx = {sizes[si], 0, offsets[oi]};
+            uint32_t iters = bench_mem_iterations(ctx.size);
+            bmt_bench_run(bench_make_name(name, sizeof(name), "memset_libc", ctx.size, ctx.dst_off),
+                          bench_body_memset_libc, &ctx, iters, (uint32_t)ctx.size, NULL);
+            bmt_bench_run(bench_make_name(name, sizeof(name), "memset_word", ctx.size, ctx.dst_off),
+                          bench_body_memset_word, &ctx, iters, (uint32_t)ctx.size, NULL);
+#if BENCH_HAS_NEON
+            bmt_bench_run(bench_make_name(name, sizeof(name), "memset_neon", ctx.size, ctx.dst_off),
+                          bench_body_memset_neon, &ctx, iters, (uint32_t)ctx.size, NULL);
+#endif
+        }
+    }
+    ASSERT_EQ(s_dst[1], 0xA5);
+}
+
+/** @brief Contexto de los benchmarks de CRC32. */
+typedef struct {
+    size_t size;
+    uint32_t (*fn)(const uint8_t*, size_t);
+} bench_crc_ctx_t;
+
+static void bench_body_crc32(void* ctx) {
+    const bench_crc_ctx_t* c = (const bench_crc_ctx_t*)ctx;
+    uint32_t crc = c->fn(s_src, c->size);
+    BMT_BENCH_DO_NOT_OPTIMIZE(crc);
+}
+
+/**
+ * @brief CRC32 por tabla frente a slice-by-8 (y con instrucciones CRC32 de ARMv8 si existen) sobre 4 KiB.
+ */
+TEST(Bench, Crc32) {
+    bench_prepare_inputs();
+    const uint32_t iters = 20 * BENCH_ITER_SCALE;
+    bench_crc_ctx_t table_ctx = {4096, bench_crc32_table};
+    bench_crc_ctx_t slice8_ctx = {4096, bench_crc32_slice8};
+    bmt_bench_compare("crc32_table/4096", bench_body_crc32, &table_ctx,
+                      "crc32_slice8/4096", bench_body_crc32, &slice8_ctx, iters, 4096, NULL, NULL);
+#if BENCH_HAS_CRC32_HW
+    bench_crc_ctx_t hw_ctx = {4096, bench_crc32_hw};
+    bmt_bench_run("crc32_hw/4096", bench_body_crc32, &hw_ctx, iters, 4096, NULL);
+#endif
+    ASSERT_EQ(bench_crc32_slice8(s_src, 4096), bench_crc32_table(s_src, 4096));
+}
+
+static void bench_body_fir_scalar(void* ctx) {
+    (void)ctx;
+    bench_fir_scalar(s_fir_in, s_fir_coeffs, s_fir_out, BENCH_FIR_N, BENCH_FIR_TAPS);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+#if BENCH_HAS_NEON
+static void bench_body_fir_neon(void* ctx) {
+    (void)ctx;
+    bench_fir_neon(s_fir_in, s_fir_coeffs, s_fir_out, BENCH_FIR_N, BENCH_FIR_TAPS);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+#endif
+
+/**
+ * @brief Filtro FIR de 32 taps sobre 1024 muestras (bytes = muestras de salida * 4).
+ */
+TEST(Bench, Fir) {
+    bench_prepare_inputs();
+    const uint32_t iters = 2 * BENCH_ITER_SCALE;
+    bmt_bench_run("fir_scalar/32x1024", bench_body_fir_scalar, NULL, iters, BENCH_FIR_N * sizeof(float), NULL);
+#if BENCH_HAS_NEON
+    bmt_bench_run("fir_neon/32x1024", bench_body_fir_neon, NULL, iters, BENCH_FIR_N * sizeof(float), NULL);
+#endif
+}
+
+static void bench_body_fft(void* ctx) {
+    size_t n = *(const size_t*)ctx;
+    bench_fft_radix2(s_fft_data, n);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+/**
+ * @brief FFT radix-2 compleja de 256 y 1024 puntos.
+ */
+TEST(Bench, FftRadix2) {
+    static const size_t sizes[] = {256, BENCH_FFT_MAX_N};
+    char name[48];
+    bench_prepare_inputs();
+    for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); ++si) {
+        size_t n = sizes[si];
+        for (size_t i = 0; i < n; ++i) {
+            s_fft_data[i].re = (float)(i & 7u);
+            s_fft_data[i].im = 0.0f;
+        }
+        bmt_bench_run(bench_make_name(name, sizeof(name), "fft_radix2", n, BENCH_NO_OFFSET), bench_body_fft, &n,
+                      (uint32_t)(BENCH_ITER_SCALE * 1024 / n), (uint32_t)(n * sizeof(bench_complex_t)), NULL);
+    }
+}
+
+/** @brief Contexto de los benchmarks de matrices. */
+typedef struct {
+    size_t n;
+    void (*fn)(const float*, const float*, float*, size_t);
+} bench_matmul_ctx_t;
+
+static void bench_body_matmul(void* ctx) {
+    const bench_matmul_ctx_t* c = (const bench_matmul_ctx_t*)ctx;
+    c->fn(s_mat_a, s_mat_b, s_mat_c, c->n);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+/**
+ * @brief Multiplicación de matrices 64x64: naive frente a blocked (y NEON).
+ */
+TEST(Bench, Matmul) {
+    bench_prepare_inputs();
+    const uint32_t iters = BENCH_ITER_SCALE;
+    bench_matmul_ctx_t naive_ctx = {BENCH_MATMUL_N, bench_matmul_naive};
+    bench_matmul_ctx_t blocked_ctx = {BENCH_MATMUL_N, bench_matmul_blocked};
+    bmt_bench_compare("matmul_naive/64", bench_body_matmul, &naive_ctx,
+                      "matmul_blocked/64", bench_body_matmul, &blocked_ctx, iters, 0, NULL, NULL);
+#if BENCH_HAS_NEON
+    bench_matmul_ctx_t neon_ctx = {BENCH_MATMUL_N, bench_matmul_neon};
+    bmt_bench_run("matmul_neon/64", bench_body_matmul, &neon_ctx, iters, 0, NULL);
+#endif
+}
+
+static void bench_body_quicksort(void* ctx) {
+    (void)ctx;
+    memcpy(s_sort_a, s_sort_input, sizeof(s_sort_a));
+    bench_quicksort_u32(s_sort_a, BENCH_SORT_N);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+static void bench_body_radix(void* ctx) {
+    (void)ctx;
+    memcpy(s_sort_a, s_sort_input, sizeof(s_sort_a));
+    bench_radix_sort_u32(s_sort_a, s_sort_tmp, BENCH_SORT_N);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+/**
+ * @brief Ordenación de 4096 enteros aleatorios: quicksort frente a radix sort
+ *        (incluye la copia de la entrada en cada iteración).
+ */
+TEST(Bench, Sorting) {
+    bench_prepare_inputs();
+    const uint32_t iters = BENCH_ITER_SCALE;
+    bmt_bench_compare("quicksort_u32/4096", bench_body_quicksort, NULL,
+                      "radix_sort_u32/4096", bench_body_radix, NULL, iters, BENCH_SORT_N * sizeof(uint32_t), NULL, NULL);
+    ASSERT_TRUE(bench_is_sorted(s_sort_a, BENCH_SORT_N));
+}
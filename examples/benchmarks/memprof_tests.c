@@ -0,0 +1,76 @@
+/**
+ * @file memprof_tests.c
+ * @brief Perfil de memoria de la placa (latencia y ancho de banda) como paso de calibración.
+ *
+ * `MemoryProfile.Calibrate` mide la región principal (un buffer estático en DDR, o en la
+ * RAM del PC en el host) y, si se define `BENCH_MEMPROF_OCM_BASE`/`BENCH_MEMPROF_OCM_SIZE`,
+ * también la OCM. Los resultados salen como líneas "[ MEMPROF  ]" que el parser agrupa en
+ * el perfil de memoria de la placa, y quedan registrados para los tests de rendimiento
+ * posteriores (bmt_memprof_find()).
+ *
+ * Valores orientativos para las placas soportadas:
+ * - Zynq-7000: OCM en 0xFFFC0000 (256 KiB, si no la usa el programa).
+ * - Zynq UltraScale+: OCM en 0xFFFC0000 (256 KiB).
+ */
+
+#include "baremetal_test.h"
+#include "bmt_bench.h"
+#include "bmt_memprof.h"
+#include <string.h>
+
+/** @brief Tamaño del buffer de la región principal. Debe superar la última caché (L2/L3). */
+#ifndef BENCH_MEMPROF_MAIN_SIZE
+#define BENCH_MEMPROF_MAIN_SIZE (8u * 1024u * 1024u)
+#endif
+
+/** @brief Nombre de la región principal en el perfil. */
+#ifndef BENCH_MEMPROF_MAIN_NAME
+#define BENCH_MEMPROF_MAIN_NAME "DDR"
+#endif
+
+static uint8_t s_memprof_main[BENCH_MEMPROF_MAIN_SIZE] __attribute__((aligned(4096)));
+
+/**
+ * @brief Mide la región principal (y la OCM si está configurada) desde 1 KiB hasta su tamaño.
+ *
+ * Debe ejecutarse antes que los tests de rendimiento que consultan el perfil; los tests
+ * se ejecutan en orden de registro, así que este archivo debe enlazarse primero
+ * (o llamar a bmt_memprof_run() desde `main()` antes de RUN_ALL_TESTS()).
+ */
+TEST(MemoryProfile, Calibrate) {
+    const bmt_memprof_profile_t* p = bmt_memprof_run(BENCH_MEMPROF_MAIN_NAME, s_memprof_main,
+                                                     sizeof(s_memprof_main), 1024);
+    ASSERT_NOT_NULL(p);
+    ASSERT_GT(p->num_points, 0);
+#if defined(BENCH_MEMPROF_OCM_BASE) && defined(BENCH_MEMPROF_OCM_SIZE)
+    ASSERT_NOT_NULL(bmt_memprof_run("OCM", (void*)(uintptr_t)(BENCH_MEMPROF_OCM_BASE), BENCH_MEMPROF_OCM_SIZE, 1024));
+#endif
+    // La latencia del mayor working set (fuera de caché) no puede ser menor que la del menor
+    EXPECT_GE(p->points[p->num_points - 1].latency_ps, p->points[0].latency_ps);
+}
+
+static void bench_body_memcpy_64k(void* ctx) {
+    (void)ctx;
+    memcpy(s_memprof_main + 65536, s_memprof_main, 65536);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+/**
+ * @brief Ejemplo de test de rendimiento calibrado: memcpy de 64 KiB debe alcanzar al menos
+ *        la mitad del ancho de banda de copia medido para ese working set.
+ */
+TEST(MemoryProfile, MemcpyReachesCalibratedBandwidth) {
+    const bmt_memprof_profile_t* p = bmt_memprof_find(BENCH_MEMPROF_MAIN_NAME);
+    if (p == NULL) {
+        // MemoryProfile.Calibrate aún no se ha ejecutado (el orden de registro depende del enlazado, p. ej. con LTO)
+        p = bmt_memprof_run(BENCH_MEMPROF_MAIN_NAME, s_memprof_main, sizeof(s_memprof_main), 1024);
+    }
+    ASSERT_NOT_NULL(p);
+    const bmt_memprof_point_t* pt = bmt_memprof_lookup(p, 2 * 65536);
+    ASSERT_NOT_NULL(pt);
+
+    bmt_bench_result_t res;
+    bmt_bench_run("memcpy_libc/65536/calibrated", bench_body_memcpy_64k, NULL, 16, 65536, &res);
+    uint64_t mbps = res.min_ps ? (65536ULL * 1000000ULL) / res.min_ps : 0;
+    EXPECT_GE((long)mbps, (long)(pt->copy_mbps / 2));
+}
@@ -0,0 +1,118 @@
+/**
+ * @file selfbench_tests.c
+ * @brief Lo que cuesta el propio framework: aserciones que pasan y aserciones que fallan,
+ *        medidos con bmt_bench_run() como cualquier otro kernel.
+ *
+ * Cada aserción de un test cuesta esto en cada ejecución de la suite, en la placa y en la CI, así
+ * que una regresión aquí ralentiza todas las suites de todos los usuarios. Las líneas
+ * "[ BENCH    ] selfbench/..." entran en `bmt_matrix.py` y `bmt_bisect.py` como las demás; el
+ * coste por test del runner a 1k-100k tests lo mide `pyton_parser/bmt_selfbench.py`.
+ *
+ * Las aserciones que fallan se ejecutan con bmt_run_isolated(): sus fallos no se imprimen ni
+ * cuentan para el test, y un ASSERT_* vuelve allí. Se mide el camino del fallo sin el texto del
+ * informe; el informe completo, con su salida, lo mide `bmt_selfbench.py` en las suites con fallos.
+ */
+
+#include "baremetal_test.h"
+#include "bmt_bench.h"
+#include <string.h>
+#include <math.h>
+
+#ifdef BMT_BENCH_QUICK
+#define SELFBENCH_ITER_SCALE 1
+#else
+#define SELFBENCH_ITER_SCALE 10
+#endif
+
+/** @brief Iteraciones de las aserciones que pasan (unos pocos ns cada una). */
+#define SELFBENCH_PASS_ITERS (2000u * SELFBENCH_ITER_SCALE)
+/** @brief Iteraciones de los fallos (cada una guarda y restaura el estado del test). */
+#define SELFBENCH_FAIL_ITERS (200u * SELFBENCH_ITER_SCALE)
+
+/** @brief Operandos de las aserciones, en memoria para que el compilador no las resuelva. */
+typedef struct {
+    long a;
+    long b;
+    const char* s1;
+    const char* s2;
+    double x;
+    double y;
+} selfbench_ctx_t;
+
+static selfbench_ctx_t s_ctx = { 42, 42, "selfbench", "selfbench", 1.0, 1.0005 };
+
+static void selfbench_body_expect_eq(void* ctx) {
+    selfbench_ctx_t* c = (selfbench_ctx_t*)ctx;
+    EXPECT_EQ(c->a, c->b);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+static void selfbench_body_assert_eq(void* ctx) {
+    selfbench_ctx_t* c = (selfbench_ctx_t*)ctx;
+    ASSERT_EQ(c->a, c->b);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+static void selfbench_body_expect_streq(void* ctx) {
+    selfbench_ctx_t* c = (selfbench_ctx_t*)ctx;
+    EXPECT_STREQ(c->s1, c->s2);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+static void selfbench_body_expect_near(void* ctx) {
+    selfbench_ctx_t* c = (selfbench_ctx_t*)ctx;
+    EXPECT_NEAR(c->x, c->y, 0.001);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+static void selfbench_expect_eq_fail(void* ctx) {
+    selfbench_ctx_t* c = (selfbench_ctx_t*)ctx;
+    EXPECT_EQ(c->a, c->b + 1);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+static void selfbench_assert_eq_fail(void* ctx) {
+    selfbench_ctx_t* c = (selfbench_ctx_t*)ctx;
+    ASSERT_EQ(c->a, c->b + 1);
+    BMT_BENCH_CLOBBER_MEMORY();
+}
+
+static void selfbench_body_isolated_pass(void* ctx) {
+    bmt_run_isolated(selfbench_body_expect_eq, ctx);
+}
+
+static void selfbench_body_expect_eq_fail(void* ctx) {
+    bmt_run_isolated(selfbench_expect_eq_fail, ctx);
+}
+
+static void selfbench_body_assert_eq_fail(void* ctx) {
+    bmt_run_isolated(selfbench_assert_eq_fail, ctx);
+}
+
+/**
+ * @brief Una aserción que pasa: lo que se paga en cada comprobación de cada test.
+ */
+TEST(SelfBench, PassingAssertions) {
+    bmt_bench_result_t eq;
+    bmt_bench_run("selfbench/expect_eq_pass", selfbench_body_expect_eq, &s_ctx, SELFBENCH_PASS_ITERS, 0, &eq);
+    bmt_bench_run("selfbench/assert_eq_pass", selfbench_body_assert_eq, &s_ctx, SELFBENCH_PASS_ITERS, 0, NULL);
+    bmt_bench_run("selfbench/expect_streq_pass", selfbench_body_expect_streq, &s_ctx, SELFBENCH_PASS_ITERS, 0, NULL);
+    bmt_bench_run("selfbench/expect_near_pass", selfbench_body_expect_near, &s_ctx, SELFBENCH_PASS_ITERS, 0, NULL);
+    EXPECT_GT(eq.median_ps, 0u);
+}
+
+/**
+ * @brief Un EXPECT_EQ y un ASSERT_EQ que fallan (este vuelve con longjmp), cada uno dentro de
+ *        bmt_run_isolated(); `selfbench/isolated_pass` da el coste del propio aislamiento.
+ */
+TEST(SelfBench, FailureReports) {
+    EXPECT_TRUE(bmt_run_isolated(selfbench_body_expect_eq, &s_ctx));
+    EXPECT_FALSE(bmt_run_isolated(selfbench_expect_eq_fail, &s_ctx));
+    EXPECT_FALSE(bmt_run_isolated(selfbench_assert_eq_fail, &s_ctx));
+
+    bmt_bench_result_t fail;
+    bmt_bench_run("selfbench/isolated_pass", selfbench_body_isolated_pass, &s_ctx, SELFBENCH_FAIL_ITERS, 0, NULL);
+    bmt_bench_run("selfbench/expect_eq_fail", selfbench_body_expect_eq_fail, &s_ctx, SELFBENCH_FAIL_ITERS, 0, &fail);
+    bmt_bench_run("selfbench/assert_eq_fail", selfbench_body_assert_eq_fail, &s_ctx, SELFBENCH_FAIL_ITERS, 0, NULL);
+    EXPECT_GT(fail.median_ps, 0u);
+}
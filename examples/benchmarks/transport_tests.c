@@ -0,0 +1,33 @@
+/**
+ * @file transport_tests.c
+ * @brief Caudal del camino de salida (`bmt_transport.h`): UART, TCP, UDP o stdout.
+ *
+ * Envía `BMT_TRANSPORT_BENCH` bytes de líneas de relleno ("[ TX FILL  ]", que el parser cuenta
+ * sin mostrarlas) y reporta el caudal visto desde la placa en una línea "[ TRANSPORT] ... bench_*".
+ * Ejecutando la misma suite por la UART y por Ethernet se comparan ambos caminos; el parser
+ * añade el caudal con que llegaron al host.
+ *
+ * Es opcional: sin `-DBMT_TRANSPORT_BENCH=<bytes>` (o sin transporte, bmt_transport_set() no
+ * llamado) el test no hace nada, para no alargar cada ejecución (16 KiB son ~1,4 s a 115200
+ * baudios).
+ */
+
+#include "baremetal_test.h"
+#include "bmt_transport.h"
+
+/** @brief Bytes de relleno del benchmark. 0 lo desactiva. */
+#ifndef BMT_TRANSPORT_BENCH
+#define BMT_TRANSPORT_BENCH 0u
+#endif
+
+TEST(Transport, Throughput) {
+    if (BMT_TRANSPORT_BENCH == 0u || bmt_transport_get() == NULL) {
+        return;
+    }
+    bmt_transport_stats_t before, after;
+    bmt_transport_get_stats(&before);
+    uint64_t bytes_per_s = bmt_transport_bench(BMT_TRANSPORT_BENCH);
+    bmt_transport_get_stats(&after);
+    EXPECT_GE(after.bytes - before.bytes, (uint64_t)(BMT_TRANSPORT_BENCH / 64u * 64u));
+    EXPECT_GT(bytes_per_s, 0u);
+}
@@ -0,0 +1,137 @@
+/**
+ * @file assert_modes_tests.cpp
+ * @brief Ejemplo de BMT_CPP_ASSERT_MODE: un ASSERT_* que falla deja que se ejecuten los
+ *        destructores del test (RAII), y benchmark del coste de los ASSERT_* que pasan.
+ *
+ * Compilando este archivo con `-DBMT_CPP_ASSERT_MODE=0` (longjmp), `1` (excepciones) o `2`
+ * (return temprano), `AssertModes.PassPath` mide 8 ASSERT_EQ que pasan frente a las mismas
+ * lecturas sin comparar; la línea `[ BENCH AB ]` da el sobrecoste de cada modo.
+ *
+ * `AssertModes.IntentionallyFailingWithLease` falla a propósito con todos los bloques del pool
+ * prestados, dentro de bmt::run_as_test_body(), y comprueba en el mismo test que han vuelto:
+ * con THROW y RETURN solo se ve el fallo intencionado; con LONGJMP, además, los bloques perdidos.
+ */
+
+#include "baremetal_test.hpp"
+#include "bmt_bench.h"
+#include <stdint.h>
+
+#if BMT_CPP_ASSERT_MODE == BMT_CPP_ASSERT_THROW
+#define ASSERT_MODE_NAME "throw"
+#elif BMT_CPP_ASSERT_MODE == BMT_CPP_ASSERT_RETURN
+#define ASSERT_MODE_NAME "return"
+#else
+#define ASSERT_MODE_NAME "longjmp"
+#endif
+
+/** @brief Pool de bloques de ejemplo: un bloque que no se devuelve queda perdido para los tests siguientes. */
+class BlockPool {
+public:
+    static constexpr uint32_t kBlocks = 4;
+
+    /** @brief Préstamo RAII de un bloque: lo devuelve al pool al salir de ámbito. */
+    class Lease {
+    public:
+        explicit Lease(BlockPool& pool) : pool_(pool), index_(pool.take()) {}
+        ~Lease() { pool_.give(index_); }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        bool valid() const { return index_ < kBlocks; }
+
+    private:
+        BlockPool& pool_;
+        uint32_t index_;
+    };
+
+    uint32_t available() const { return __builtin_popcount(free_mask_); }
+
+private:
+    uint32_t take() {
+        if (free_mask_ == 0) {
+            return kBlocks;
+        }
+        uint32_t i = static_cast<uint32_t>(__builtin_ctz(free_mask_));
+        free_mask_ &= ~(1u << i);
+        return i;
+    }
+    void give(uint32_t i) {
+        if (i < kBlocks) {
+            free_mask_ |= 1u << i;
+        }
+    }
+
+    uint32_t free_mask_ = (1u << kBlocks) - 1;
+};
+
+static BlockPool s_pool;
+
+/** @brief Comprobación auxiliar: con BMT_CPP_ASSERT_RETURN, un fallo aquí solo sale de esta función. */
+static void check_lease(const BlockPool::Lease& lease) {
+    ASSERT_TRUE(lease.valid());
+}
+
+TEST(AssertModes, LeasesReturnToPool) {
+    // Si un ASSERT de un test anterior hubiera saltado los destructores, faltarían bloques
+    ASSERT_EQ(s_pool.available(), BlockPool::kBlocks);
+    BlockPool::Lease a(s_pool);
+    BlockPool::Lease b(s_pool);
+    ASSERT_NO_FATAL_FAILURE(check_lease(a));
+    ASSERT_NO_FATAL_FAILURE(check_lease(b));
+    EXPECT_EQ(s_pool.available(), 2);
+}
+
+/**
+ * @brief Falla a propósito: un ASSERT falla (dentro de una función auxiliar) con los cuatro
+ *        bloques del pool prestados. bmt::run_as_test_body() lo ejecuta como el cuerpo de un
+ *        test y vuelve; solo los modos que deshacen la pila devuelven los bloques, y
+ *        el EXPECT_EQ del final lo comprueba.
+ */
+TEST(AssertModes, IntentionallyFailingWithLease) {
+    const uint32_t before = s_pool.available();
+    const bool completed = bmt::run_as_test_body([] {
+        BlockPool::Lease a(s_pool);
+        BlockPool::Lease b(s_pool);
+        BlockPool::Lease c(s_pool);
+        BlockPool::Lease d(s_pool);
+        BlockPool::Lease extra(s_pool);  // Pool agotado: préstamo no válido
+        ASSERT_TRUE(d.valid());
+        ASSERT_NO_FATAL_FAILURE(check_lease(extra));
+        bmt_platform_puts("Esta línea NUNCA se imprimirá.\r\n");
+    });
+    EXPECT_FALSE(completed);
+    EXPECT_EQ(s_pool.available(), before);  // Con LONGJMP falla: el longjmp se saltó los destructores
+}
+
+/** @brief Datos del benchmark, fuera del alcance del optimizador. */
+static volatile uint32_t s_bench_values[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+/** @brief Las mismas lecturas que check_values(), sin comparar. */
+__attribute__((noinline)) static void load_values(void* ctx) {
+    BMT_BENCH_DO_NOT_OPTIMIZE(s_bench_values[0]);
+    BMT_BENCH_DO_NOT_OPTIMIZE(s_bench_values[1]);
+    BMT_BENCH_DO_NOT_OPTIMIZE(s_bench_values[2]);
+    BMT_BENCH_DO_NOT_OPTIMIZE(s_bench_values[3]);
+    BMT_BENCH_DO_NOT_OPTIMIZE(s_bench_values[4]);
+    BMT_BENCH_DO_NOT_OPTIMIZE(s_bench_values[5]);
+    BMT_BENCH_DO_NOT_OPTIMIZE(s_bench_values[6]);
+    BMT_BENCH_DO_NOT_OPTIMIZE(s_bench_values[7]);
+    (void)ctx;
+}
+
+/** @brief 8 ASSERT_EQ que pasan. */
+__attribute__((noinline)) static void check_values(void* ctx) {
+    ASSERT_EQ(s_bench_values[0], 1);
+    ASSERT_EQ(s_bench_values[1], 2);
+    ASSERT_EQ(s_bench_values[2], 3);
+    ASSERT_EQ(s_bench_values[3], 4);
+    ASSERT_EQ(s_bench_values[4], 5);
+    ASSERT_EQ(s_bench_values[5], 6);
+    ASSERT_EQ(s_bench_values[6], 7);
+    ASSERT_EQ(s_bench_values[7], 8);
+    (void)ctx;
+}
+
+TEST(AssertModes, PassPath) {
+    bmt_bench_compare("load8", load_values, nullptr, "assert_eq8/" ASSERT_MODE_NAME, check_values, nullptr,
+                      100000, 0, nullptr, nullptr);
+}
@@ -0,0 +1,76 @@
+/**
+ * @file cpp_tests.cpp
+ * @brief Ejemplo de la API C++17 (`baremetal_test.hpp`): tests registrados sin constructores
+ *        estáticos, comparaciones con los tipos nativos y matchers compuestos en compilación.
+ */
+
+#include "baremetal_test.hpp"
+#include "ring_buffer.hpp"
+#include <stdint.h>
+
+using namespace bmt;
+
+enum class LinkState : uint8_t { Down, Up };
+
+/** @brief Rango válido de una muestra del ADC de 12 bits, comprobado ya en compilación. */
+constexpr auto kAdcSample = AllOf(Ge(0), Lt(4096));
+static_assert(kAdcSample.matches(4095) && !kAdcSample.matches(4096), "matcher evaluado en compilación");
+
+TEST(RingBufferCpp, KeepsInsertionOrder) {
+    RingBuffer<uint16_t, 4> rb;
+    rb.push(10);
+    rb.push(20);
+    rb.push(30);
+
+    ASSERT_EQ(rb.size(), 3);  // size_t frente a int, sin conversiones ni avisos
+    EXPECT_THAT(rb, ElementsAre(10, 20, 30));
+}
+
+TEST(RingBufferCpp, RejectsWhenFull) {
+    RingBuffer<uint16_t, 2> rb;
+    EXPECT_TRUE(rb.push(1));
+    EXPECT_TRUE(rb.push(2));
+    EXPECT_EQ(rb.push(3), false);
+    EXPECT_THAT(rb, ElementsAre(1, 2));
+}
+
+TEST(RingBufferCpp, WrapsAround) {
+    RingBuffer<int16_t, 3> rb;
+    int16_t out = 0;
+    for (int16_t i = 0; i < 7; ++i) {
+        if (rb.full()) {
+            ASSERT_TRUE(rb.pop(out));
+        }
+        rb.push(static_cast<int16_t>(i * 100));
+    }
+    EXPECT_EQ(out, 300);
+    EXPECT_THAT(rb, ElementsAre(400, Gt(400), AllOf(Ge(600), Le(600))));
+}
+
+TEST(MatchersCpp, ComposeAtCompileTime) {
+    const uint16_t samples[] = {12, 2048, 4095, 0};
+    EXPECT_THAT(samples, Each(kAdcSample));
+    EXPECT_THAT(3.14159, Near(3.14, 0.01));
+    EXPECT_THAT(LinkState::Up, AnyOf(LinkState::Up, Not(LinkState::Down)));
+}
+
+TEST(MatchersCpp, ComparesAcrossSignedness) {
+    EXPECT_NE(-1, 0xFFFFFFFFu);  // Con la macro de C, en un long de 32 bits serían iguales
+    EXPECT_LT(-1, 1u);
+    EXPECT_EQ(LinkState::Down, LinkState::Down);
+}
+
+/** @brief Lo pone RunsSecond: si RunsFirst lo ve puesto, el runner no respeta la declaración. */
+static bool s_second_ran = false;
+
+/**
+ * @brief Los tests C++ de un archivo se ejecutan en orden de declaración, como los de C, aunque
+ *        g++ emita sus descriptores al revés. Con un filtro que deje solo uno, ambos pasan.
+ */
+TEST(DeclarationOrderCpp, RunsFirst) {
+    EXPECT_FALSE(s_second_ran);
+}
+
+TEST(DeclarationOrderCpp, RunsSecond) {
+    s_second_ran = true;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file ring_buffer.hpp
+ * @brief Cola circular de tamaño fijo de ejemplo, el tipo de código C++17 de firmware (sin
+ *        memoria dinámica ni excepciones) que prueban los tests de `cpp_tests.cpp`.
+ */
+
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <stddef.h>
+
+template <typename T, size_t N>
+class RingBuffer {
+public:
+    /** @brief Recorre los elementos del más antiguo al más reciente. */
+    class const_iterator {
+    public:
+        constexpr const_iterator(const RingBuffer* rb, size_t i) : rb_(rb), i_(i) {}
+        constexpr const T& operator*() const { return rb_->data_[(rb_->head_ + i_) % N]; }
+        constexpr const_iterator& operator++() { ++i_; return *this; }
+        constexpr bool operator!=(const const_iterator& o) const { return i_ != o.i_; }
+        constexpr bool operator==(const const_iterator& o) const { return i_ == o.i_; }
+
+    private:
+        const RingBuffer* rb_;
+        size_t i_;
+    };
+
+    /** @brief Añade al final. @return false si está llena (el elemento se descarta). */
+    constexpr bool push(const T& v) {
+        if (count_ == N) {
+            return false;
+        }
+        data_[(head_ + count_) % N] = v;
+        ++count_;
+        return true;
+    }
+
+    /** @brief Saca el más antiguo. @return false si está vacía. */
+    constexpr bool pop(T& out) {
+        if (count_ == 0) {
+            return false;
+        }
+        out = data_[head_];
+        head_ = (head_ + 1) % N;
+        --count_;
+        return true;
+    }
+
+    constexpr size_t size() const { return count_; }
+    constexpr bool full() const { return count_ == N; }
+    constexpr const_iterator begin() const { return const_iterator(this, 0); }
+    constexpr const_iterator end() const { return const_iterator(this, count_); }
+
+private:
+    T data_[N] = {};
+    size_t head_ = 0;
+    size_t count_ = 0;
+};
+
+#endif // RING_BUFFER_HPP
@@ -0,0 +1,47 @@
+/**
+ * @file fuzz_tests.c
+ * @brief Ejemplo de FUZZ_TEST sobre el parser TLV.
+ *
+ * En la build normal, el test reproduce el corpus: las entradas de FUZZ_CORPUS y, en el
+ * host, los archivos de `$BMT_FUZZ_CORPUS/TlvParser.RoundTrip/`. Compilado con
+ * `-DBMT_FUZZ_BUILD -fsanitize=fuzzer,address` (clang) es un objetivo de libFuzzer que parte
+ * de `examples/fuzz/corpus/TlvParser.RoundTrip/` (ver README).
+ */
+
+#include "baremetal_test.h"
+#include "bmt_fuzz.h"
+#include "tlv_parser.h"
+#include <string.h>
+
+/** @brief Registros que admite el test (las entradas con más se rechazan). */
+#define FUZZ_TLV_MAX_RECORDS 16u
+
+/** @brief Tamaño máximo que ocupan FUZZ_TLV_MAX_RECORDS registros serializados. */
+#define FUZZ_TLV_MAX_BYTES (FUZZ_TLV_MAX_RECORDS * (2u + 255u))
+
+FUZZ_CORPUS(TlvParser, RoundTrip,
+            BMT_FUZZ_INPUT(""),
+            BMT_FUZZ_INPUT("\x01\x03" "abc"),
+            BMT_FUZZ_INPUT("\x01\x00\x02\x01" "x"),
+            BMT_FUZZ_INPUT("\x01\x05" "ab"));
+
+/**
+ * @brief Cualquier entrada se rechaza o se analiza en registros que caen dentro del búfer y
+ *        que, serializados de nuevo, dan exactamente la entrada.
+ */
+FUZZ_TEST(TlvParser, RoundTrip)(const uint8_t* data, size_t size) {
+    tlv_record_t records[FUZZ_TLV_MAX_RECORDS];
+    static uint8_t encoded[FUZZ_TLV_MAX_BYTES];
+
+    int count = tlv_parse(data, size, records, FUZZ_TLV_MAX_RECORDS);
+    if (count < 0) {
+        ASSERT_TRUE(count == TLV_ERR_TRUNCATED || count == TLV_ERR_TOO_MANY);
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        ASSERT_TRUE(records[i].value >= data && records[i].value + records[i].length <= data + size);
+    }
+    size_t encoded_size = tlv_encode(records, (size_t)count, encoded, sizeof(encoded));
+    ASSERT_EQ(encoded_size, size);
+    ASSERT_EQ(memcmp(encoded, data, size), 0);
+}
@@ -0,0 +1,40 @@
+/**
+ * @file tlv_parser.c
+ * @brief Implementación del parser TLV de ejemplo.
+ */
+
+#include "tlv_parser.h"
+#include <string.h>
+
+int tlv_parse(const uint8_t* data, size_t size, tlv_record_t* records, size_t max_records) {
+    size_t count = 0;
+    size_t pos = 0;
+    while (pos < size) {
+        if (size - pos < 2u || size - pos - 2u < data[pos + 1]) {
+            return TLV_ERR_TRUNCATED;
+        }
+        if (count == max_records) {
+            return TLV_ERR_TOO_MANY;
+        }
+        records[count].type = data[pos];
+        records[count].length = data[pos + 1];
+        records[count].value = &data[pos + 2];
+        pos += 2u + data[pos + 1];
+        count++;
+    }
+    return (int)count;
+}
+
+size_t tlv_encode(const tlv_record_t* records, size_t count, uint8_t* out, size_t capacity) {
+    size_t pos = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (capacity - pos < 2u + records[i].length) {
+            return 0;
+        }
+        out[pos] = records[i].type;
+        out[pos + 1] = records[i].length;
+        memcpy(&out[pos + 2], records[i].value, records[i].length);
+        pos += 2u + records[i].length;
+    }
+    return pos;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file tlv_parser.h
+ * @brief Parser TLV (tipo, longitud, valor) de ejemplo, el tipo de código que recibe datos
+ *        de fuera (UART, red, flash) y que conviene fuzzear.
+ *
+ * Cada registro es `[tipo:1][longitud:1][valor:longitud]`, uno tras otro hasta el final del
+ * búfer. Los valores no se copian: cada registro apunta a su valor dentro del búfer original.
+ *
+ * Es el código que ejercitan los FUZZ_TEST de `fuzz_tests.c`.
+ */
+
+#ifndef TLV_PARSER_H
+#define TLV_PARSER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/** @brief El búfer termina a mitad de un registro. */
+#define TLV_ERR_TRUNCATED (-1)
+/** @brief Hay más registros de los que caben en la salida. */
+#define TLV_ERR_TOO_MANY  (-2)
+
+/**
+ * @brief Un registro TLV.
+ */
+typedef struct {
+    uint8_t type;
+    uint8_t length;
+    const uint8_t* value;  /**< Dentro del búfer analizado. */
+} tlv_record_t;
+
+/**
+ * @brief Separa `data` en registros.
+ * @return Número de registros, o TLV_ERR_TRUNCATED / TLV_ERR_TOO_MANY.
+ */
+int tlv_parse(const uint8_t* data, size_t size, tlv_record_t* records, size_t max_records);
+
+/**
+ * @brief Serializa registros (operación inversa de tlv_parse()).
+ * @return Bytes escritos, o 0 si no caben en `capacity`.
+ */
+size_t tlv_encode(const tlv_record_t* records, size_t count, uint8_t* out, size_t capacity);
+
+#endif // TLV_PARSER_H
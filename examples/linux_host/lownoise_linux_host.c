@@ -0,0 +1,221 @@
+/**
+ * @file lownoise_linux_host.c
+ * @brief Modo de bajo ruido para benchmarks en el puerto Linux (host).
+ *
+ * En máquinas de CI compartidas los benchmarks varían un ±20 % entre ejecuciones.
+ * Este modo aísla el proceso todo lo que el sistema permite y, sobre todo, informa
+ * de lo que no ha podido controlar (governor, turbo, SMT), para que los resultados
+ * se interpreten con el contexto adecuado. Ver platform_linux_host.h.
+ */
+
+#define _GNU_SOURCE
+#include "platform_linux_host.h"
+#include "bmt_platform_io.h"
+#include "bmt_bench.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/** @brief Muestras por benchmark en modo de bajo ruido. */
+#define LOW_NOISE_SAMPLES 15
+/** @brief Muestras de calentamiento por benchmark en modo de bajo ruido. */
+#define LOW_NOISE_WARMUP 3
+
+/**
+ * @brief CPUs de los hilos de STRESS_TEST en modo de bajo ruido: la afinidad original del
+ *        proceso sin la CPU fijada, para no competir con el hilo principal en SCHED_FIFO.
+ */
+static cpu_set_t s_stress_set;
+/** @brief El modo de bajo ruido ha fijado el proceso: los hilos de stress usan s_stress_set. */
+static bool s_stress_set_valid = false;
+/** @brief CPUs disponibles para todos los hilos de stress, incluido el principal. */
+static uint32_t s_stress_cpus = 0;
+
+/**
+ * @brief Lee la primera línea de un archivo de sysfs/procfs sin el salto de línea.
+ * @return true si se pudo leer.
+ */
+static bool read_sysfs_line(const char* path, char* buf, size_t len) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    bool ok = fgets(buf, (int)len, f) != NULL;
+    fclose(f);
+    if (ok) buf[strcspn(buf, "\r\n")] = '\0';
+    return ok;
+}
+
+/**
+ * @brief Elige la CPU: la indicada, la primera aislada (`isolcpus=`) o la última disponible.
+ */
+static int choose_cpu(const char* request) {
+    char buf[128];
+    if (request && strcmp(request, "auto") != 0 && request[0] != '\0') {
+        return atoi(request);
+    }
+    // Formato "2-3,6": nos quedamos con el primer número
+    if (read_sysfs_line("/sys/devices/system/cpu/isolated", buf, sizeof(buf)) && buf[0] >= '0' && buf[0] <= '9') {
+        return atoi(buf);
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = CPU_SETSIZE - 1; cpu >= 0; --cpu) {
+            if (CPU_ISSET(cpu, &set)) return cpu;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Lee un entero de una variable de entorno.
+ * @return true si la variable existe.
+ */
+static bool env_u32(const char* name, uint32_t* out) {
+    const char* v = getenv(name);
+    if (!v || !*v) return false;
+    *out = (uint32_t)strtoul(v, NULL, 10);
+    return true;
+}
+
+bool linux_host_low_noise_setup(void) {
+    const char* request = getenv("BMT_LOW_NOISE");
+    bmt_bench_config_t cfg = *bmt_bench_get_config();
+    bool env_ok = true;
+    char line[512];
+    char governor[64] = "unknown";
+    char value[64];
+    const char* turbo = "unknown";
+    const char* smt = "unknown";
+    const char* sched = "SCHED_OTHER";
+    const char* mlock_state = "no";
+    bool isolated = false;
+    int cpu = -1;
+
+    if (request) {
+        cfg.samples = LOW_NOISE_SAMPLES;
+        cfg.warmup = LOW_NOISE_WARMUP;
+    }
+    env_u32("BMT_BENCH_SAMPLES", &cfg.samples);
+    env_u32("BMT_BENCH_WARMUP", &cfg.warmup);
+    env_u32("BMT_BENCH_CV_MAX", &cfg.cv_max_x100);
+    bmt_bench_set_config(&cfg);
+
+    if (!request) {
+        return false;
+    }
+
+    // 1. Afinidad a una CPU (idealmente aislada con isolcpus=/nohz_full=)
+    cpu = choose_cpu(request);
+    cpu_set_t original;
+    CPU_ZERO(&original);
+    bool have_original = sched_getaffinity(0, sizeof(original), &original) == 0;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        env_ok = false;
+        cpu = -1;
+    } else if (have_original) {
+        // Los hilos de stress vuelven a las demás CPUs; con una sola, la comparten
+        s_stress_set = original;
+        CPU_CLR(cpu, &s_stress_set);
+        if (CPU_COUNT(&s_stress_set) == 0) {
+            s_stress_set = original;
+        }
+        s_stress_set_valid = true;
+        CPU_SET(cpu, &original);
+        s_stress_cpus = (uint32_t)CPU_COUNT(&original);
+    }
+    if (cpu >= 0 && read_sysfs_line("/sys/devices/system/cpu/isolated", value, sizeof(value))) {
+        // Lista con formato "2-3,6"
+        for (char* tok = strtok(value, ","); tok; tok = strtok(NULL, ",")) {
+            int lo = atoi(tok);
+            const char* dash = strchr(tok, '-');
+            int hi = dash ? atoi(dash + 1) : lo;
+            if (cpu >= lo && cpu <= hi) isolated = true;
+        }
+    }
+
+    // 2. Planificador de tiempo real, si hay permisos (root o CAP_SYS_NICE). Con una sola CPU,
+    //    un hilo principal en SCHED_FIFO dejaría sin CPU a los hilos de stress
+    struct sched_param sp;
+    memset(&sp, 0, sizeof(sp));
+    sp.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+    if (s_stress_set_valid && s_stress_cpus < 2) {
+        sched = "SCHED_OTHER(single_cpu)";
+        env_ok = false;
+    } else if (sched_setscheduler(0, SCHED_FIFO, &sp) == 0) {
+        sched = "SCHED_FIFO";
+    } else {
+        sched = "SCHED_OTHER(no_permission)";
+        env_ok = false;
+    }
+    // Solo lo ya mapeado: con MCL_FUTURE se bloquearían también la región de memtest y las pilas
+    if (mlockall(MCL_CURRENT) == 0) {
+        mlock_state = "yes";
+    }
+
+    // 3. Estado de la CPU: governor, turbo y SMT
+    if (cpu >= 0) {
+        char path[96];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", cpu);
+        if (!read_sysfs_line(path, governor, sizeof(governor))) {
+            snprintf(governor, sizeof(governor), "unknown");
+        }
+    }
+    if (strcmp(governor, "performance") != 0) {
+        env_ok = false;
+    }
+    if (read_sysfs_line("/sys/devices/system/cpu/intel_pstate/no_turbo", value, sizeof(value))) {
+        turbo = (value[0] == '1') ? "off" : "on";
+    } else if (read_sysfs_line("/sys/devices/system/cpu/cpufreq/boost", value, sizeof(value))) {
+        turbo = (value[0] == '1') ? "on" : "off";
+    }
+    if (strcmp(turbo, "on") == 0) {
+        env_ok = false;
+    }
+    if (read_sysfs_line("/sys/devices/system/cpu/smt/active", value, sizeof(value))) {
+        smt = (value[0] == '1') ? "on" : "off";
+    }
+    if (strcmp(smt, "on") == 0) {
+        env_ok = false;
+    }
+
+    snprintf(line, sizeof(line),
+             "[ HOST ENV ] low_noise=1 cpu=%d isolated=%s sched=%s mlock=%s governor=%s turbo=%s smt=%s "
+             "samples=%u warmup=%u cv_max_pct=%u.%02u trusted=%d\r\n",
+             cpu, isolated ? "yes" : "no", sched, mlock_state, governor, turbo, smt,
+             (unsigned)bmt_bench_get_config()->samples, (unsigned)cfg.warmup,
+             (unsigned)(cfg.cv_max_x100 / 100), (unsigned)(cfg.cv_max_x100 % 100), env_ok ? 1 : 0);
+    bmt_platform_puts(line);
+    return env_ok;
+}
+
+void linux_host_stress_thread_attr(pthread_attr_t* attr) {
+    if (!s_stress_set_valid) {
+        return;  // Sin bajo ruido, los hilos heredan el planificador y la afinidad del proceso
+    }
+    struct sched_param sp;
+    memset(&sp, 0, sizeof(sp));
+    pthread_attr_setinheritsched(attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(attr, SCHED_OTHER);
+    pthread_attr_setschedparam(attr, &sp);
+    pthread_attr_setaffinity_np(attr, sizeof(s_stress_set), &s_stress_set);
+}
+
+uint32_t linux_host_stress_cpus(void) {
+    if (s_stress_set_valid) {
+        return s_stress_cpus;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0 && CPU_COUNT(&set) > 0) {
+        return (uint32_t)CPU_COUNT(&set);
+    }
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (uint32_t)cpus : 1u;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file main_linux_host.c
+ * @brief Punto de entrada para ejecutar las suites de BMT en Linux (host).
+ *
+ * Los tests se auto-registran mediante constructores, así que basta con enlazar este
+ * archivo junto con los archivos de tests deseados (por ejemplo `examples/benchmarks/`).
+ * El código de salida del proceso es 0 si todos los tests pasan y 1 en caso contrario.
+ *
+ * Con `BMT_FUZZ_SERVE=1` no ejecuta los tests: atiende al mutador de
+ * `pyton_parser/bmt_fuzz_host.py` por stdin/stdout (bmt_fuzz_serve()), igual que una placa
+ * por la UART.
+ *
+ * Antes del token de fin imprime las estadísticas del transporte de la salida (stdout o socket,
+ * `BMT_TRANSPORT`) y, con `BMT_COMPRESS=1`, las del compresor.
+ *
+ * En una build de fuzzing (`bmt_fuzz.h`) este archivo no define `main()` con libFuzzer
+ * (`-DBMT_FUZZ_BUILD`, la pone el fuzzer) y define el bucle persistente de AFL++ con
+ * `-DBMT_FUZZ_AFL`.
+ */
+
+#include "baremetal_test.h"
+#include "bmt_compress.h"
+#include "bmt_transport.h"
+#include "platform_linux_host.h"
+#include "bmt_fuzz.h"
+#include <stdlib.h>
+
+#if defined(BMT_FUZZ_AFL)
+#include <unistd.h>
+
+#ifdef __AFL_FUZZ_TESTCASE_LEN
+__AFL_FUZZ_INIT();
+#endif
+
+/** @brief Entradas por proceso antes de que AFL++ lo reinicie (limita fugas de estado). */
+#ifndef BMT_FUZZ_AFL_LOOPS
+#define BMT_FUZZ_AFL_LOOPS 100000
+#endif
+
+/**
+ * @brief Bucle persistente de AFL++: cada entrada llega por memoria compartida, sin fork.
+ *        Compilado sin afl-clang-fast, ejecuta una sola entrada leída de stdin (útil para
+ *        reproducir un crash guardado).
+ * @return 0.
+ */
+int main(void)
+{
+#ifdef __AFL_FUZZ_TESTCASE_LEN
+    __AFL_INIT();
+    const unsigned char* buf = __AFL_FUZZ_TESTCASE_BUF;
+    while (__AFL_LOOP(BMT_FUZZ_AFL_LOOPS)) {
+        bmt_fuzz_one_input(buf, (size_t)__AFL_FUZZ_TESTCASE_LEN);
+    }
+#else
+    static uint8_t buf[BMT_FUZZ_MAX_INPUT];
+    size_t len = 0;
+    ssize_t n;
+    while (len < sizeof(buf) && (n = read(0, buf + len, sizeof(buf) - len)) > 0) {
+        len += (size_t)n;
+    }
+    bmt_fuzz_one_input(buf, len);
+#endif
+    return 0;
+}
+
+#elif !defined(BMT_FUZZ_BUILD)
+
+/**
+ * @brief Ejecuta todos los tests registrados y envía el token de fin para el parser.
+ * @return 0 si todas las pruebas pasan, 1 en caso contrario.
+ */
+int main(void)
+{
+    if (getenv("BMT_FUZZ_SERVE") != NULL) {
+        return bmt_fuzz_serve() == 0 ? 0 : 1;
+    }
+    int ret = RUN_ALL_TESTS();
+    if (bmt_compress_enabled()) {
+        bmt_compress_report();
+    }
+    bmt_transport_report();
+    bmt_platform_puts("[BMT_DONE_ALL_TESTS]\r\n");
+    linux_host_flush();
+    return ret == 0 ? 0 : 1;
+}
+#endif
@@ -0,0 +1,250 @@
+/**
+ * @file mmio_linux_host.c
+ * @brief Trampa de accesos a registros simulados para el puerto Linux (ver mmio_linux_host.h).
+ *
+ * Las páginas de los periféricos se mapean sin permisos. Un acceso provoca SIGSEGV con la
+ * dirección exacta (`si_addr`) y, en x86-64, si es escritura (bit 1 del código de error del
+ * fallo de página). El manejador abre la página, carga en la palabra el valor del modelo si
+ * es una lectura, y activa el paso a paso (TF) para que la instrucción se ejecute sobre la
+ * página abierta. Tras esa única instrucción llega SIGTRAP: si era una escritura, el valor
+ * que ha quedado en la palabra se entrega al modelo, y la página se vuelve a cerrar.
+ */
+
+#define _GNU_SOURCE
+#include "mmio_linux_host.h"
+#include "bmt_platform_io.h"
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000  // Linux >= 4.17; los kernels anteriores lo ignoran
+#endif
+
+/** @brief Bit TF de RFLAGS: excepción de depuración tras la siguiente instrucción. */
+#define MMIO_X86_TRAP_FLAG 0x100
+
+/** @brief Región registrada. */
+typedef struct {
+    uintptr_t base;
+    size_t size;
+    mmio_sim_device_t* dev;
+} mmio_region_t;
+
+static mmio_region_t s_regions[MMIO_SIM_MAX_REGIONS];
+static uint32_t s_region_count = 0;
+static uintptr_t s_pages[MMIO_SIM_MAX_PAGES];
+static uint32_t s_page_count = 0;
+static uint32_t s_trap_count = 0;
+
+static bool s_handlers_installed = false;
+static struct sigaction s_prev_segv;
+static struct sigaction s_prev_trap;
+
+/** @brief Acceso en curso entre el SIGSEGV y el SIGTRAP de su instrucción. */
+static struct {
+    bool active;
+    bool write;
+    uintptr_t word;
+    uintptr_t page;
+    mmio_region_t* region;
+} s_pending;
+
+static uintptr_t mmio_page_size(void) {
+    return (uintptr_t)sysconf(_SC_PAGESIZE);
+}
+
+static mmio_region_t* mmio_find_region(uintptr_t addr) {
+    for (uint32_t i = 0; i < s_region_count; ++i) {
+        if (addr >= s_regions[i].base && addr - s_regions[i].base < s_regions[i].size) {
+            return &s_regions[i];
+        }
+    }
+    return NULL;
+}
+
+static bool mmio_page_mapped(uintptr_t page) {
+    for (uint32_t i = 0; i < s_page_count; ++i) {
+        if (s_pages[i] == page) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool mmio_add_region(uintptr_t base, size_t size, mmio_sim_device_t* dev) {
+    for (uint32_t i = 0; i < s_region_count; ++i) {
+        if (s_regions[i].base == base) {
+            s_regions[i].size = size;
+            s_regions[i].dev = dev;
+            return true;
+        }
+    }
+    if (s_region_count >= MMIO_SIM_MAX_REGIONS) {
+        bmt_platform_puts("ERROR: Max MMIO regions reached. Increase MMIO_SIM_MAX_REGIONS.\r\n");
+        return false;
+    }
+    s_regions[s_region_count].base = base;
+    s_regions[s_region_count].size = size;
+    s_regions[s_region_count].dev = dev;
+    s_region_count++;
+    return true;
+}
+
+/**
+ * @brief Pasa la señal al manejador que había antes (o a la acción por defecto).
+ */
+static void mmio_chain(const struct sigaction* prev, int sig, siginfo_t* info, void* context) {
+    if (prev->sa_flags & SA_SIGINFO) {
+        prev->sa_sigaction(sig, info, context);
+    } else if (prev->sa_handler == SIG_DFL) {
+        signal(sig, SIG_DFL);  // El fallo se repite al volver y termina el proceso
+    } else if (prev->sa_handler != SIG_IGN) {
+        prev->sa_handler(sig);
+    }
+}
+
+#if defined(__x86_64__)
+static void mmio_segv_handler(int sig, siginfo_t* info, void* context) {
+    ucontext_t* uc = (ucontext_t*)context;
+    uintptr_t addr = (uintptr_t)info->si_addr;
+    uintptr_t page = addr & ~(mmio_page_size() - 1u);
+    if (s_pending.active || !mmio_page_mapped(page)) {
+        mmio_chain(&s_prev_segv, sig, info, context);
+        return;
+    }
+    s_pending.active = true;
+    s_pending.write = (uc->uc_mcontext.gregs[REG_ERR] & 0x2) != 0;
+    s_pending.word = addr & ~(uintptr_t)3u;
+    s_pending.page = page;
+    s_pending.region = mmio_find_region(s_pending.word);
+
+    mprotect((void*)page, mmio_page_size(), PROT_READ | PROT_WRITE);
+    mmio_region_t* r = s_pending.region;
+    if (!s_pending.write && r != NULL && r->dev->read != NULL) {
+        *(volatile uint32_t*)s_pending.word = r->dev->read(r->dev, (uint32_t)(s_pending.word - r->base));
+    }
+    uc->uc_mcontext.gregs[REG_EFL] |= MMIO_X86_TRAP_FLAG;
+}
+
+static void mmio_trap_handler(int sig, siginfo_t* info, void* context) {
+    ucontext_t* uc = (ucontext_t*)context;
+    if (!s_pending.active) {
+        mmio_chain(&s_prev_trap, sig, info, context);
+        return;
+    }
+    uc->uc_mcontext.gregs[REG_EFL] &= ~(greg_t)MMIO_X86_TRAP_FLAG;
+    mmio_region_t* r = s_pending.region;
+    if (s_pending.write && r != NULL && r->dev->write != NULL) {
+        r->dev->write(r->dev, (uint32_t)(s_pending.word - r->base), *(volatile uint32_t*)s_pending.word);
+    }
+    mprotect((void*)s_pending.page, mmio_page_size(), PROT_NONE);
+    s_pending.active = false;
+    s_trap_count++;
+}
+
+static void mmio_install_handlers(void) {
+    if (s_handlers_installed) {
+        return;
+    }
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_SIGINFO;
+    sa.sa_sigaction = mmio_segv_handler;
+    sigaction(SIGSEGV, &sa, &s_prev_segv);
+    sa.sa_sigaction = mmio_trap_handler;
+    sigaction(SIGTRAP, &sa, &s_prev_trap);
+    s_handlers_installed = true;
+}
+
+/**
+ * @brief Reserva una página sin permisos en `page` (o donde elija el sistema si es 0).
+ * @return La página, o 0 si no se pudo.
+ */
+static uintptr_t mmio_map_page(uintptr_t page) {
+    if (page != 0 && mmio_page_mapped(page)) {
+        return page;
+    }
+    if (s_page_count >= MMIO_SIM_MAX_PAGES) {
+        bmt_platform_puts("ERROR: Max MMIO pages reached. Increase MMIO_SIM_MAX_PAGES.\r\n");
+        return 0;
+    }
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | ((page != 0) ? MAP_FIXED_NOREPLACE : 0);
+    void* p = mmap((void*)page, mmio_page_size(), PROT_NONE, flags, -1, 0);
+    if (p == MAP_FAILED) {
+        return 0;
+    }
+    if (page != 0 && (uintptr_t)p != page) {
+        munmap(p, mmio_page_size());  // Kernel sin MAP_FIXED_NOREPLACE: la dirección estaba ocupada
+        return 0;
+    }
+    s_pages[s_page_count++] = (uintptr_t)p;
+    return (uintptr_t)p;
+}
+#endif
+
+volatile void* mmio_sim_map(uintptr_t base, size_t size, mmio_sim_device_t* dev) {
+#if defined(__x86_64__)
+    uintptr_t page_size = mmio_page_size();
+    if (size == 0 || dev == NULL) {
+        return NULL;
+    }
+    if (base == 0) {
+        if (size > page_size || (base = mmio_map_page(0)) == 0) {
+            return NULL;
+        }
+    } else {
+        for (uintptr_t page = base & ~(page_size - 1u); page < base + size; page += page_size) {
+            if (mmio_map_page(page) == 0) {
+                return NULL;
+            }
+        }
+    }
+    mmio_install_handlers();
+    return mmio_add_region(base, size, dev) ? (volatile void*)base : NULL;
+#else
+    (void)base; (void)size; (void)dev;
+    bmt_platform_puts("ERROR: MMIO trap only implemented on x86-64. Use mmio_sim_read32/write32.\r\n");
+    return NULL;
+#endif
+}
+
+bool mmio_sim_add(uintptr_t base, size_t size, mmio_sim_device_t* dev) {
+    return dev != NULL && mmio_add_region(base, size, dev);
+}
+
+void mmio_sim_reset(void) {
+#if defined(__x86_64__)
+    for (uint32_t i = 0; i < s_page_count; ++i) {
+        munmap((void*)s_pages[i], mmio_page_size());
+    }
+    if (s_handlers_installed) {
+        sigaction(SIGSEGV, &s_prev_segv, NULL);
+        sigaction(SIGTRAP, &s_prev_trap, NULL);
+        s_handlers_installed = false;
+    }
+#endif
+    s_page_count = 0;
+    s_region_count = 0;
+    s_trap_count = 0;
+    memset(&s_pending, 0, sizeof(s_pending));
+}
+
+uint32_t mmio_sim_read32(uintptr_t addr) {
+    mmio_region_t* r = mmio_find_region(addr);
+    return (r != NULL && r->dev->read != NULL) ? r->dev->read(r->dev, (uint32_t)(addr - r->base)) : 0;
+}
+
+void mmio_sim_write32(uintptr_t addr, uint32_t value) {
+    mmio_region_t* r = mmio_find_region(addr);
+    if (r != NULL && r->dev->write != NULL) {
+        r->dev->write(r->dev, (uint32_t)(addr - r->base), value);
+    }
+}
+
+uint32_t mmio_sim_trap_count(void) {
+    return s_trap_count;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file mmio_linux_host.h
+ * @brief Simulación de periféricos mapeados en memoria para probar drivers en el puerto Linux.
+ *
+ * Un driver accede a sus registros con punteros `volatile` a direcciones fijas
+ * (`XPAR_..._BASEADDR`). mmio_sim_map() reserva esas mismas direcciones en el proceso sin
+ * permisos de acceso: cada lectura o escritura provoca un fallo de página que se convierte en
+ * una llamada al modelo del periférico (mmio_sim_device_t), y el driver se ejecuta sin
+ * cambios en el PC. Para código que ya pasa por un accesor (`Xil_In32()` / `Xil_Out32()`),
+ * mmio_sim_read32() / mmio_sim_write32() despachan al modelo sin fallos de página.
+ *
+ * Los registros se modelan como palabras de 32 bits alineadas; un acceso de 8 o 16 bits se
+ * ve como un acceso a la palabra que lo contiene. La trampa solo está implementada en x86-64
+ * y no es apta para varios hilos a la vez (no usarla en un STRESS_TEST).
+ */
+
+#ifndef MMIO_LINUX_HOST_H
+#define MMIO_LINUX_HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** @brief Regiones simultáneas como máximo. */
+#ifndef MMIO_SIM_MAX_REGIONS
+#define MMIO_SIM_MAX_REGIONS 16
+#endif
+
+/** @brief Páginas mapeadas simultáneamente como máximo. */
+#ifndef MMIO_SIM_MAX_PAGES
+#define MMIO_SIM_MAX_PAGES 32
+#endif
+
+/**
+ * @brief Modelo de un periférico. Los desplazamientos son relativos a la base de la región.
+ *
+ * Con la trampa, un registro sin callback (read o write a NULL) se comporta como memoria:
+ * guarda lo último que se escribió. Con el accesor, lee 0 y descarta las escrituras.
+ */
+typedef struct mmio_sim_device {
+    /** @brief Valor que ve el driver al leer el registro en `offset`. */
+    uint32_t (*read)(struct mmio_sim_device* dev, uint32_t offset);
+    /** @brief El driver escribe `value` en el registro en `offset`. */
+    void (*write)(struct mmio_sim_device* dev, uint32_t offset, uint32_t value);
+    /** @brief Estado del modelo. */
+    void* state;
+} mmio_sim_device_t;
+
+/**
+ * @brief Mapea un periférico simulado en `[base, base + size)` y activa la trampa.
+ *
+ * Las páginas que cubren la región se reservan con `mmap(MAP_FIXED_NOREPLACE)` (varias
+ * regiones pueden compartir página, como los periféricos privados del Cortex-A9). Volver a
+ * mapear una región existente sustituye su modelo.
+ *
+ * @param base Dirección física del periférico en la placa, o 0 para que el sistema elija
+ *        una (el driver recibe entonces la base por parámetro o por una variable).
+ * @return La base de la región, o NULL si la dirección está ocupada o la plataforma no
+ *         admite la trampa.
+ */
+volatile void* mmio_sim_map(uintptr_t base, size_t size, mmio_sim_device_t* dev);
+
+/**
+ * @brief Registra un periférico solo para el accesor (sin mapear memoria ni trampa).
+ * @return false si no quedan regiones.
+ */
+bool mmio_sim_add(uintptr_t base, size_t size, mmio_sim_device_t* dev);
+
+/**
+ * @brief Elimina todas las regiones, libera las páginas y restaura los manejadores de señal.
+ *        Conviene llamarla al empezar cada test: un ASSERT que falla no llega al final.
+ */
+void mmio_sim_reset(void);
+
+/**
+ * @brief Lee un registro simulado a través del modelo (sustituto de `Xil_In32()`).
+ */
+uint32_t mmio_sim_read32(uintptr_t addr);
+
+/**
+ * @brief Escribe un registro simulado a través del modelo (sustituto de `Xil_Out32()`).
+ */
+void mmio_sim_write32(uintptr_t addr, uint32_t value);
+
+/**
+ * @brief Accesos atendidos por la trampa desde el último mmio_sim_reset() (para comprobar
+ *        que un test pasa de verdad por el modelo).
+ */
+uint32_t mmio_sim_trap_count(void);
+
+#endif // MMIO_LINUX_HOST_H
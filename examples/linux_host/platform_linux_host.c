@@ -0,0 +1,544 @@
+/**
+ * @file platform_linux_host.c
+ * @brief Implementación de la interfaz de plataforma de BMT para Linux (host).
+ *
+ * Permite compilar y ejecutar las mismas suites de tests que en la placa directamente
+ * en el PC de desarrollo o en CI. La salida va a stdout, con el mismo formato que por
+ * la UART, así que `parse_bmt_output.py --input` puede procesarla igual.
+ *
+ * La interrupción de timer de `bmt_irqlat.h` se emula con un temporizador POSIX
+ * (`timer_create`) que entrega una señal de tiempo real; el manejador de la señal hace
+ * de ISR. Las latencias medidas incluyen, por tanto, el planificador del kernel.
+ *
+ * Los STRESS_TEST (`bmt_stress.h`) usan un hilo POSIX por "núcleo". El número de hilos
+ * es el de CPUs de la afinidad del proceso (mínimo 2) o el indicado en `BMT_STRESS_THREADS`;
+ * en modo de bajo ruido los hilos vuelven a `SCHED_OTHER` y a las CPUs no fijadas.
+ *
+ * `BMT_TEST_FILTER=Suite.*:Otra.Nombre` ejecuta solo los tests que encajan con algún patrón.
+ *
+ * Los metadatos de la ejecución toman el build ID de la nota del ejecutable
+ * (`dl_iterate_phdr`), las cachés de `sysconf` y la frecuencia de cpufreq o `/proc/cpuinfo`.
+ *
+ * Los PROPERTY (`bmt_property.h`) toman la semilla base de `BMT_PROP_SEED` y el caso a
+ * reproducir de `BMT_PROP_REPLAY` (decimal o 0x...), si están definidas.
+ *
+ * Los FUZZ_TEST (`bmt_fuzz.h`) leen su corpus de `$BMT_FUZZ_CORPUS/Suite.Nombre/` (un
+ * archivo por entrada, en orden alfabético), y en una build de fuzzing el objetivo se elige
+ * con `BMT_FUZZ_TARGET=Suite.Nombre`. Para el fuzzing remoto (bmt_fuzz_serve()) las tramas
+ * llegan por stdin, y SIGSEGV, SIGBUS, SIGFPE y SIGILL se convierten en un crash de la
+ * entrada en curso en lugar de terminar el proceso.
+ *
+ * Con `-DBMT_TEST_STACK_SIZE=<bytes>` cada test corre en su propia pila, entre dos páginas
+ * sin acceso (`mprotect`): un desbordamiento llega como SIGSEGV a la pila alternativa de
+ * señales y se convierte en un fallo "STACK OVERFLOW" del test.
+ *
+ * Los tests de RAM (`bmt_memtest.h`) se ejecutan sobre una región reservada con `mmap` de
+ * `BMT_MEMTEST_SIZE` bytes; `BMT_MEMTEST_ALIAS` simula un fallo de direccionamiento.
+ *
+ * La salida va por stdout o, con `BMT_TRANSPORT`, por un socket TCP o UDP (`bmt_transport.h`,
+ * ver linux_host_transport_setup()). Con `BMT_COMPRESS=1` además se comprime (`bmt_compress.h`)
+ * y lleva tramas binarias, que `parse_bmt_output.py` descomprime.
+ */
+
+#define _GNU_SOURCE
+#include "bmt_platform_io.h"
+#include "bmt_compress.h"
+#include "bmt_transport.h"
+#include "bmt_fuzz.h"
+#include "bmt_vclock.h"
+#include "platform_linux_host.h"
+#include <dirent.h>
+#include <link.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+/** @brief Señal usada por el temporizador de bmt_platform_timer_irq_arm(). */
+#define LINUX_HOST_TIMER_SIGNAL (SIGRTMIN)
+
+/** @brief Temporizador POSIX que hace de "interrupción" de timer (creado en el primer uso). */
+static timer_t s_irq_timer;
+static bool s_irq_timer_created = false;
+/** @brief Handler a llamar desde el manejador de la señal. */
+static volatile bmt_platform_irq_handler_t s_irq_handler = NULL;
+
+/** @brief Índice de "núcleo" del hilo actual (0 para el hilo principal). */
+static __thread uint32_t s_core_id = 0;
+/** @brief Hay más hilos de stress que CPUs: las esperas activas deben ceder la CPU. */
+static bool s_oversubscribed = false;
+
+/**
+ * @brief Argumento de arranque de un hilo de stress.
+ */
+typedef struct {
+    uint32_t core;
+    void (*entry)(uint32_t core);
+} linux_host_core_start_t;
+
+/**
+ * @brief Lee CLOCK_MONOTONIC en nanosegundos.
+ */
+static uint64_t linux_host_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Lee una variable de entorno numérica (decimal o 0x...).
+ * @return Su valor, o `fallback` si no está definida.
+ */
+static uint64_t linux_host_env_u64(const char* name, uint64_t fallback) {
+    const char* env = getenv(name);
+    return (env && *env) ? strtoull(env, NULL, 0) : fallback;
+}
+
+void linux_host_flush(void) {
+    bmt_compress_flush();
+    bmt_transport_flush();
+}
+
+/**
+ * @brief Abre la salida en el primer uso: por stdout o por un socket (`BMT_TRANSPORT`, ver
+ *        platform_linux_host.h), comprimida con `BMT_COMPRESS=1`. Los caminos de fuzzing
+ *        imprimen sin pasar por bmt_platform_io_init().
+ */
+static void linux_host_output_open(void) {
+    if (bmt_transport_get() != NULL) {
+        return;
+    }
+    bmt_transport_set(linux_host_transport_setup());
+    atexit(linux_host_flush);  // Lo pendiente al salir por exit() fuera de main()
+    if (linux_host_env_u64("BMT_COMPRESS", 0) != 0) {
+        bmt_compress_init(bmt_transport_write);
+    }
+}
+
+void bmt_platform_io_init(void) {
+    linux_host_output_open();
+    // Modo de bajo ruido para benchmarks (BMT_LOW_NOISE=<cpu>|auto), ver platform_linux_host.h
+    linux_host_low_noise_setup();
+}
+
+void bmt_platform_putchar(char c) {
+    linux_host_output_open();
+    if (bmt_compress_enabled()) {
+        bmt_compress_write(&c, 1);
+    } else {
+        bmt_transport_write((const uint8_t*)&c, 1);
+    }
+}
+
+void bmt_platform_puts(const char *str) {
+    linux_host_output_open();
+    if (bmt_compress_enabled()) {
+        bmt_compress_write(str, strlen(str));
+    } else {
+        bmt_transport_write((const uint8_t*)str, strlen(str));
+    }
+}
+
+uint32_t bmt_platform_get_msec_ticks(void) {
+    return (uint32_t)(bmt_platform_get_hires_ticks() / 1000000ULL);
+}
+
+uint64_t bmt_platform_get_hires_ticks(void) {
+    uint64_t virtual_ns;
+    if (bmt_vclock_read(&virtual_ns)) {
+        return virtual_ns;  // El test ha pasado a tiempo virtual (bmt_vclock.h)
+    }
+    return linux_host_monotonic_ns();
+}
+
+uint32_t bmt_platform_get_hires_tick_hz(void) {
+    return 1000000000U;
+}
+
+/**
+ * @brief Manejador de la señal del temporizador: hace el papel de la ISR.
+ */
+static void linux_host_timer_signal(int sig) {
+    (void)sig;
+    bmt_platform_irq_handler_t handler = s_irq_handler;
+    s_irq_handler = NULL;
+    if (handler) {
+        handler();
+    }
+}
+
+bool bmt_platform_timer_irq_arm(uint64_t fire_at, bmt_platform_irq_handler_t handler) {
+    if (!s_irq_timer_created) {
+        struct sigaction sa;
+        struct sigevent sev;
+        sigemptyset(&sa.sa_mask);
+        sa.sa_flags = 0;
+        sa.sa_handler = linux_host_timer_signal;
+        if (sigaction(LINUX_HOST_TIMER_SIGNAL, &sa, NULL) != 0) {
+            return false;
+        }
+        sev.sigev_notify = SIGEV_SIGNAL;
+        sev.sigev_signo = LINUX_HOST_TIMER_SIGNAL;
+        sev.sigev_value.sival_ptr = NULL;
+        if (timer_create(CLOCK_MONOTONIC, &sev, &s_irq_timer) != 0) {
+            return false;
+        }
+        s_irq_timer_created = true;
+    }
+    // fire_at está en el dominio de bmt_platform_get_hires_ticks(): ns de CLOCK_MONOTONIC
+    struct itimerspec its;
+    its.it_interval.tv_sec = 0;
+    its.it_interval.tv_nsec = 0;
+    its.it_value.tv_sec = (time_t)(fire_at / 1000000000ULL);
+    its.it_value.tv_nsec = (long)(fire_at % 1000000000ULL);
+    s_irq_handler = handler;
+    if (timer_settime(s_irq_timer, TIMER_ABSTIME, &its, NULL) != 0) {
+        s_irq_handler = NULL;
+        return false;
+    }
+    return true;
+}
+
+void bmt_platform_timer_irq_cancel(void) {
+    struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+    s_irq_handler = NULL;
+    if (s_irq_timer_created) {
+        timer_settime(s_irq_timer, 0, &its, NULL);
+    }
+}
+
+uint32_t bmt_platform_num_cores(void) {
+    long cpus = (long)linux_host_stress_cpus();
+    const char* env = getenv("BMT_STRESS_THREADS");
+    long n = (env && *env) ? strtol(env, NULL, 10) : cpus;
+    if (n < 2) {
+        n = 2; // Incluso con una CPU, la expropiación entre hilos encuentra carreras
+    }
+    s_oversubscribed = n > cpus;
+    return (uint32_t)n;
+}
+
+uint32_t bmt_platform_core_id(void) {
+    return s_core_id;
+}
+
+/**
+ * @brief Punto de entrada de los hilos de stress.
+ */
+static void* linux_host_core_thread(void* arg) {
+    linux_host_core_start_t* start = (linux_host_core_start_t*)arg;
+    s_core_id = start->core;
+    start->entry(start->core);
+    return NULL;
+}
+
+bool bmt_platform_start_secondary_cores(uint32_t num_cores, void (*entry)(uint32_t core)) {
+    static linux_host_core_start_t starts[64];
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    linux_host_stress_thread_attr(&attr);
+    for (uint32_t core = 1; core < num_cores && core < 64; ++core) {
+        starts[core].core = core;
+        starts[core].entry = entry;
+        pthread_t thread;
+        if (pthread_create(&thread, &attr, linux_host_core_thread, &starts[core]) != 0) {
+            // El núcleo 0 detectará en la barrera inicial que faltan hilos
+            break;
+        }
+    }
+    pthread_attr_destroy(&attr);
+    return true;
+}
+
+void bmt_platform_cpu_relax(void) {
+    if (s_oversubscribed) {
+        sched_yield();
+    } else {
+        __asm__ __volatile__("" ::: "memory");
+#if defined(__i386__) || defined(__x86_64__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+/** @brief ID de `.note.gnu.build-id` del ejecutable, encontrado por linux_host_build_id_note(). */
+static const uint8_t* s_build_id = NULL;
+static size_t s_build_id_size = 0;
+
+/**
+ * @brief Callback de `dl_iterate_phdr()`: busca la nota NT_GNU_BUILD_ID en los segmentos
+ *        PT_NOTE del primer objeto (el ejecutable).
+ */
+static int linux_host_build_id_note(struct dl_phdr_info* info, size_t size, void* data) {
+    (void)size;
+    (void)data;
+    for (int i = 0; i < info->dlpi_phnum; ++i) {
+        if (info->dlpi_phdr[i].p_type != PT_NOTE) {
+            continue;
+        }
+        const uint8_t* p = (const uint8_t*)(info->dlpi_addr + info->dlpi_phdr[i].p_vaddr);
+        const uint8_t* end = p + info->dlpi_phdr[i].p_memsz;
+        while (p + sizeof(ElfW(Nhdr)) <= end) {
+            const ElfW(Nhdr)* note = (const ElfW(Nhdr)*)p;
+            const uint8_t* name = p + sizeof(ElfW(Nhdr));
+            const uint8_t* desc = name + ((note->n_namesz + 3u) & ~3u);
+            if (note->n_type == NT_GNU_BUILD_ID && note->n_namesz == 4 && memcmp(name, "GNU", 4) == 0) {
+                s_build_id = desc;
+                s_build_id_size = note->n_descsz;
+                return 1;
+            }
+            p = desc + ((note->n_descsz + 3u) & ~3u);
+        }
+    }
+    return 1; // Solo el ejecutable: las bibliotecas compartidas tienen su propio ID
+}
+
+const uint8_t* bmt_platform_build_id(size_t* size) {
+    if (s_build_id == NULL) {
+        dl_iterate_phdr(linux_host_build_id_note, NULL);
+    }
+    *size = s_build_id_size;
+    return s_build_id;
+}
+
+/**
+ * @brief Lee un número de la primera línea de un archivo de /sys o /proc que empieza por `prefix`.
+ * @return El número, o 0 si no existe.
+ */
+static double linux_host_read_number(const char* path, const char* prefix) {
+    char line[256];
+    double value = 0;
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (strncmp(line, prefix, strlen(prefix)) == 0) {
+            const char* colon = strchr(line, ':');
+            value = strtod(colon ? colon + 1 : line, NULL);
+            break;
+        }
+    }
+    fclose(f);
+    return value;
+}
+
+/** @brief `sysconf()` de un tamaño de caché: 0 si glibc no lo conoce. */
+static uint32_t linux_host_cache_size(int name) {
+    long value = sysconf(name);
+    return (value > 0) ? (uint32_t)value : 0;
+}
+
+bool bmt_platform_cpu_info(bmt_platform_cpu_info_t* info) {
+    // Frecuencia actual de cpufreq (kHz) o, en máquinas virtuales sin cpufreq, la de /proc/cpuinfo
+    double khz = linux_host_read_number("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq", "");
+    if (khz <= 0) {
+        khz = linux_host_read_number("/proc/cpuinfo", "cpu MHz") * 1000.0;
+    }
+    info->cpu_khz = (uint32_t)khz;
+    info->l1d_bytes = linux_host_cache_size(_SC_LEVEL1_DCACHE_SIZE);
+    info->l1i_bytes = linux_host_cache_size(_SC_LEVEL1_ICACHE_SIZE);
+    info->l2_bytes = linux_host_cache_size(_SC_LEVEL2_CACHE_SIZE);
+    info->l3_bytes = linux_host_cache_size(_SC_LEVEL3_CACHE_SIZE);
+    info->line_bytes = linux_host_cache_size(_SC_LEVEL1_DCACHE_LINESIZE);
+    return true;
+}
+
+const char* bmt_platform_test_filter(void) {
+    return getenv("BMT_TEST_FILTER");
+}
+
+uint64_t bmt_platform_prop_seed(void) {
+    return linux_host_env_u64("BMT_PROP_SEED", linux_host_monotonic_ns());
+}
+
+uint64_t bmt_platform_prop_replay(void) {
+    return linux_host_env_u64("BMT_PROP_REPLAY", 0);
+}
+
+const char* bmt_platform_fuzz_target(void) {
+    const char* env = getenv("BMT_FUZZ_TARGET");
+    return (env && *env) ? env : NULL;
+}
+
+/**
+ * @brief Descarta los archivos ocultos ("." y ".." incluidos) al listar un corpus.
+ */
+static int linux_host_fuzz_visible(const struct dirent* entry) {
+    return entry->d_name[0] != '.';
+}
+
+bool bmt_platform_fuzz_corpus_entry(const char* name, uint32_t index, uint8_t* buffer, size_t capacity, size_t* size) {
+    // Listado del directorio, ordenado, que se rehace al pedir la entrada 0
+    static struct dirent** s_entries = NULL;
+    static int s_count = 0;
+    static char s_dir[512];
+    const char* root = getenv("BMT_FUZZ_CORPUS");
+
+    *size = 0;
+    if (root == NULL || *root == '\0') {
+        return false;
+    }
+    if (index == 0) {
+        for (int i = 0; i < s_count; ++i) {
+            free(s_entries[i]);
+        }
+        free(s_entries);
+        s_entries = NULL;
+        snprintf(s_dir, sizeof(s_dir), "%s/%s", root, name);
+        s_count = scandir(s_dir, &s_entries, linux_host_fuzz_visible, alphasort);
+        if (s_count < 0) {
+            s_count = 0;
+        }
+    }
+    if (index >= (uint32_t)s_count) {
+        return false;
+    }
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s", s_dir, s_entries[index]->d_name);
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        return true;  // Entrada vacía: no se pudo leer, pero no corta la lista
+    }
+    *size = fread(buffer, 1, capacity, f);
+    fclose(f);
+    return true;
+}
+
+int bmt_platform_getchar(void) {
+    linux_host_output_open();
+    bmt_compress_flush();  // Lo que el host espera leer antes de enviar más
+    return bmt_transport_getchar();
+}
+
+/** @brief Señales que se convierten en crash de la entrada o en desbordamiento de la pila del test. */
+static const int s_fault_signals[] = { SIGSEGV, SIGBUS, SIGFPE, SIGILL };
+#define LINUX_HOST_FAULT_SIGNALS (sizeof(s_fault_signals) / sizeof(s_fault_signals[0]))
+static struct sigaction s_fault_previous[LINUX_HOST_FAULT_SIGNALS];
+static struct sigaction s_stack_previous[LINUX_HOST_FAULT_SIGNALS];
+
+/**
+ * @brief Manejador de fallos: si el fallo está en una guarda de la pila del test, falla el test
+ *        (bmt_stack_fault()); si hay una entrada de fuzzing en curso, vuelve a bmt_fuzz_serve().
+ *        Si no, restaura la acción por defecto y deja que el fallo vuelva a ocurrir.
+ */
+static void linux_host_fault_handler(int sig, siginfo_t* info, void* context) {
+    (void)context;
+    if (bmt_stack_guard_hit((uintptr_t)info->si_addr) != 0) {
+        bmt_stack_fault();  // Ya estamos en la pila alternativa: no hace falta la que devuelve
+    }
+    bmt_fuzz_fault((uint32_t)sig, (uintptr_t)info->si_addr);
+    signal(sig, SIG_DFL);
+}
+
+/**
+ * @brief Instala linux_host_fault_handler() (guardando las acciones anteriores en `previous`)
+ *        o restaura las de `previous`.
+ */
+static void linux_host_fault_handlers(bool enable, struct sigaction* previous) {
+    // Pila alternativa: un desbordamiento de pila también debe llegar al manejador
+    static uint8_t s_alt_stack[64 * 1024];
+    if (enable) {
+        stack_t ss = { .ss_sp = s_alt_stack, .ss_size = sizeof(s_alt_stack), .ss_flags = 0 };
+        sigaltstack(&ss, NULL);
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_sigaction = linux_host_fault_handler;
+        // SA_NODEFER: se sale del manejador con longjmp, así que la señal no debe quedar bloqueada
+        sa.sa_flags = SA_SIGINFO | SA_NODEFER | SA_ONSTACK;
+        sigemptyset(&sa.sa_mask);
+        for (size_t i = 0; i < LINUX_HOST_FAULT_SIGNALS; ++i) {
+            sigaction(s_fault_signals[i], &sa, &previous[i]);
+        }
+    } else {
+        for (size_t i = 0; i < LINUX_HOST_FAULT_SIGNALS; ++i) {
+            sigaction(s_fault_signals[i], &previous[i], NULL);
+        }
+    }
+}
+
+void bmt_platform_fuzz_fault_guard(bool enable) {
+    linux_host_fault_handlers(enable, s_fault_previous);
+}
+
+bool bmt_platform_stack_guard(void* base, size_t size, bool enable) {
+    // Las guardas ocupan páginas enteras del pool (BMT_TEST_STACK_GUARD_SIZE múltiplo de la página)
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0 || ((uintptr_t)base % (uintptr_t)page) != 0 || (size % (size_t)page) != 0) {
+        return false;
+    }
+    if (mprotect(base, size, enable ? PROT_NONE : (PROT_READ | PROT_WRITE)) != 0) {
+        return false;
+    }
+    // El runner protege las dos guardas seguidas: los manejadores se instalan con la primera
+    static int s_guards = 0;
+    if (enable && s_guards++ == 0) {
+        linux_host_fault_handlers(true, s_stack_previous);
+    } else if (!enable && --s_guards == 0) {
+        linux_host_fault_handlers(false, s_stack_previous);
+    }
+    return true;
+}
+
+/** @brief Región de bmt_memtest_run_regions(), reservada en el primer uso. */
+static uint8_t* s_memtest_base = NULL;
+static size_t s_memtest_size = 0;
+
+/**
+ * @brief Reserva la región de los tests de RAM: `BMT_MEMTEST_SIZE` bytes (16 MiB por defecto).
+ *
+ * Con `BMT_MEMTEST_ALIAS` definida, las dos mitades de la región son la misma memoria (un
+ * `memfd` mapeado dos veces), como una placa con la línea de dirección más alta pegada a 0.
+ * Sirve para comprobar que los tests detectan un fallo del decodificador de direcciones.
+ */
+static bool linux_host_memtest_map(void) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = (size_t)linux_host_env_u64("BMT_MEMTEST_SIZE", 16u << 20);
+    size_t half = ((size / 2u) + page - 1u) & ~(page - 1u);
+    if (half == 0) {
+        return false;
+    }
+    if (getenv("BMT_MEMTEST_ALIAS") == NULL) {
+        void* p = mmap(NULL, 2u * half, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+        if (p == MAP_FAILED) {
+            return false;
+        }
+        s_memtest_base = (uint8_t*)p;
+    } else {
+        int fd = memfd_create("bmt_memtest", 0);
+        if (fd < 0) {
+            return false;
+        }
+        void* p = (ftruncate(fd, (off_t)half) == 0)
+                      ? mmap(NULL, 2u * half, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) : MAP_FAILED;
+        if (p == MAP_FAILED
+            || mmap(p, half, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+            || mmap((uint8_t*)p + half, half, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            if (p != MAP_FAILED) {
+                munmap(p, 2u * half);
+            }
+            close(fd);
+            return false;
+        }
+        close(fd);
+        s_memtest_base = (uint8_t*)p;
+    }
+    s_memtest_size = 2u * half;
+    return true;
+}
+
+bool bmt_platform_memtest_region(uint32_t index, const char** name, void** base, size_t* size) {
+    if (index != 0 || (s_memtest_base == NULL && !linux_host_memtest_map())) {
+        return false;
+    }
+    *name = "HOST";
+    *base = s_memtest_base;
+    *size = s_memtest_size;
+    return true;
+}
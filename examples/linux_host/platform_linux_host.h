@@ -0,0 +1,71 @@
+/**
+ * @file platform_linux_host.h
+ * @brief Funciones propias del puerto Linux (host) de BMT.
+ *
+ * No forman parte de la interfaz de plataforma (`bmt_platform_io.h`): son utilidades
+ * que solo tienen sentido al ejecutar los tests en el PC.
+ */
+
+#ifndef PLATFORM_LINUX_HOST_H
+#define PLATFORM_LINUX_HOST_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "bmt_transport.h"
+
+/**
+ * @brief Activa el modo de bajo ruido para benchmarks si la variable de entorno
+ *        `BMT_LOW_NOISE` está definida.
+ *
+ * `BMT_LOW_NOISE` puede valer el número de CPU a usar o `auto` (primera CPU aislada con
+ * `isolcpus=`, o la última CPU disponible). En ese modo:
+ * - Fija el proceso a esa CPU (`sched_setaffinity`).
+ * - Pide `SCHED_FIFO` (salvo con una sola CPU) y bloquea la memoria ya mapeada
+ *   (`mlockall(MCL_CURRENT)`) si hay permisos.
+ * - Comprueba e informa del governor de la CPU, el turbo y el SMT.
+ * - Sube las muestras y las iteraciones de calentamiento de bmt_bench_run().
+ *
+ * Variables adicionales: `BMT_BENCH_SAMPLES`, `BMT_BENCH_WARMUP` y `BMT_BENCH_CV_MAX`
+ * (umbral de ruido en centésimas de %, p. ej. 200 = 2 %), válidas también sin `BMT_LOW_NOISE`.
+ * El resultado se imprime en una línea "[ HOST ENV ]".
+ *
+ * @return true si el entorno es apto para medir (todas las comprobaciones correctas).
+ */
+bool linux_host_low_noise_setup(void);
+
+/**
+ * @brief Prepara los atributos de un hilo de STRESS_TEST. En modo de bajo ruido el hilo no
+ *        hereda `SCHED_FIFO` ni la CPU fijada: usa `SCHED_OTHER` y el resto de la afinidad
+ *        original del proceso. Sin ese modo no cambia nada.
+ */
+void linux_host_stress_thread_attr(pthread_attr_t* attr);
+
+/**
+ * @brief CPUs que pueden usar los hilos de STRESS_TEST, contando la del hilo principal: la
+ *        afinidad original en modo de bajo ruido, o la actual (`taskset`, cgroups) si no.
+ */
+uint32_t linux_host_stress_cpus(void);
+
+/**
+ * @brief Abre el transporte de la salida indicado en la variable de entorno `BMT_TRANSPORT`:
+ *
+ * - `stdout` (o sin definir): la salida estándar, el equivalente a la UART.
+ * - `tcp:HOST:PUERTO`: conecta con `parse_bmt_output.py --listen PUERTO`. Reintenta durante
+ *   `BMT_TRANSPORT_WAIT_MS` ms (5000 por defecto) mientras el parser no escucha.
+ * - `tcp-listen:[HOST:]PUERTO`: espera a que se conecte `parse_bmt_output.py --connect`.
+ * - `udp:HOST:PUERTO`: datagramas para `parse_bmt_output.py --listen PUERTO --udp`.
+ *
+ * Si no puede abrirlo, lo indica por stderr y usa stdout.
+ *
+ * @return El transporte, para bmt_transport_set().
+ */
+const bmt_transport_t* linux_host_transport_setup(void);
+
+/**
+ * @brief Envía lo pendiente del compresor (`BMT_COMPRESS`) y del transporte. Se llama al
+ *        terminar y antes de esperar datos del host.
+ */
+void linux_host_flush(void);
+
+#endif // PLATFORM_LINUX_HOST_H
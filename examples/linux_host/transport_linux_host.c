@@ -0,0 +1,203 @@
+/**
+ * @file transport_linux_host.c
+ * @brief Transportes de la salida (`bmt_transport.h`) del puerto Linux (host): stdout y sockets BSD.
+ *
+ * Permiten probar en localhost el mismo camino que una placa con Ethernet, y que la CI no
+ * necesite adaptadores serie. Ver linux_host_transport_setup() en platform_linux_host.h.
+ */
+
+#define _GNU_SOURCE
+#include "platform_linux_host.h"
+#include "bmt_transport.h"
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+/** @brief Socket del transporte TCP o UDP (-1 si no hay). */
+static int s_socket = -1;
+/** @brief Número de secuencia del siguiente datagrama UDP. */
+static uint16_t s_udp_seq = 0;
+
+static void stdout_write(const uint8_t* data, size_t size) {
+    fwrite(data, 1, size, stdout);
+    fflush(stdout);
+}
+
+static int stdout_read(void) {
+    return getchar();
+}
+
+static void tcp_write(const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = send(s_socket, data, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return;  // El host ha cerrado: se pierde la salida, como con la UART desconectada
+        }
+        data += n;
+        size -= (size_t)n;
+    }
+}
+
+static int tcp_read(void) {
+    unsigned char c;
+    ssize_t n;
+    do {
+        n = recv(s_socket, &c, 1, 0);
+    } while (n < 0 && errno == EINTR);
+    return n == 1 ? c : -1;
+}
+
+static void udp_write(const uint8_t* data, size_t size) {
+    uint8_t datagram[BMT_TRANSPORT_UDP_HEADER + BMT_TRANSPORT_BUFFER];
+    while (size > 0) {
+        size_t chunk = size < BMT_TRANSPORT_BUFFER ? size : BMT_TRANSPORT_BUFFER;
+        datagram[0] = (uint8_t)(s_udp_seq >> 8);
+        datagram[1] = (uint8_t)s_udp_seq;
+        memcpy(datagram + BMT_TRANSPORT_UDP_HEADER, data, chunk);
+        if (send(s_socket, datagram, BMT_TRANSPORT_UDP_HEADER + chunk, 0) < 0 && errno == ENOBUFS) {
+            continue;  // Cola del kernel llena: reintenta el mismo datagrama
+        }
+        s_udp_seq++;
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+static const bmt_transport_t s_stdout_transport = { "stdout", stdout_write, stdout_read };
+static const bmt_transport_t s_tcp_transport = { "tcp", tcp_write, tcp_read };
+static const bmt_transport_t s_udp_transport = { "udp", udp_write, NULL };
+
+/**
+ * @brief Resuelve "HOST:PUERTO" (o solo "PUERTO", en todas las interfaces si `passive`).
+ * @return Lista de getaddrinfo() a liberar con freeaddrinfo(), o NULL si no se puede resolver.
+ */
+static struct addrinfo* linux_host_resolve(const char* spec, int socktype, bool passive) {
+    char host[256] = "";
+    const char* port = spec;
+    const char* colon = strrchr(spec, ':');
+    if (colon != NULL) {
+        size_t len = (size_t)(colon - spec);
+        if (len >= sizeof(host)) {
+            return NULL;
+        }
+        memcpy(host, spec, len);
+        host[len] = '\0';
+        port = colon + 1;
+    }
+    struct addrinfo hints = {0};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = socktype;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    struct addrinfo* result = NULL;
+    if (getaddrinfo(host[0] ? host : NULL, port, &hints, &result) != 0) {
+        return NULL;
+    }
+    return result;
+}
+
+/**
+ * @brief Conecta con el parser (`--listen`), reintentando durante `BMT_TRANSPORT_WAIT_MS`
+ *        (5000 por defecto) por si aún no escucha.
+ */
+static bool linux_host_tcp_connect(const char* spec) {
+    struct addrinfo* addrs = linux_host_resolve(spec, SOCK_STREAM, false);
+    if (addrs == NULL) {
+        return false;
+    }
+    const char* wait_env = getenv("BMT_TRANSPORT_WAIT_MS");
+    long wait_ms = wait_env ? strtol(wait_env, NULL, 0) : 5000;
+    for (long waited = 0; s_socket < 0 && waited <= wait_ms; waited += 100) {
+        for (struct addrinfo* a = addrs; a != NULL; a = a->ai_next) {
+            int fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+            if (fd >= 0 && connect(fd, a->ai_addr, a->ai_addrlen) == 0) {
+                s_socket = fd;
+                break;
+            }
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+        if (s_socket < 0) {
+            nanosleep(&(struct timespec){ .tv_nsec = 100000000L }, NULL);
+        }
+    }
+    freeaddrinfo(addrs);
+    return s_socket >= 0;
+}
+
+/**
+ * @brief Espera a que el parser (`--connect`) se conecte al puerto indicado.
+ */
+static bool linux_host_tcp_accept(const char* spec) {
+    struct addrinfo* addrs = linux_host_resolve(spec, SOCK_STREAM, true);
+    if (addrs == NULL) {
+        return false;
+    }
+    int server = socket(addrs->ai_family, addrs->ai_socktype, addrs->ai_protocol);
+    int one = 1;
+    bool ok = server >= 0 &&
+              setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) == 0 &&
+              bind(server, addrs->ai_addr, addrs->ai_addrlen) == 0 &&
+              listen(server, 1) == 0;
+    freeaddrinfo(addrs);
+    if (ok) {
+        fprintf(stderr, "BMT: waiting for the parser on tcp port %s\n", strrchr(spec, ':') ? strrchr(spec, ':') + 1 : spec);
+        s_socket = accept(server, NULL, NULL);
+    }
+    if (server >= 0) {
+        close(server);
+    }
+    return s_socket >= 0;
+}
+
+/**
+ * @brief Crea el socket UDP conectado al parser (`--listen --udp`).
+ */
+static bool linux_host_udp_open(const char* spec) {
+    struct addrinfo* addrs = linux_host_resolve(spec, SOCK_DGRAM, false);
+    if (addrs == NULL) {
+        return false;
+    }
+    int fd = socket(addrs->ai_family, addrs->ai_socktype, addrs->ai_protocol);
+    if (fd >= 0 && connect(fd, addrs->ai_addr, addrs->ai_addrlen) == 0) {
+        s_socket = fd;
+    } else if (fd >= 0) {
+        close(fd);
+    }
+    freeaddrinfo(addrs);
+    return s_socket >= 0;
+}
+
+const bmt_transport_t* linux_host_transport_setup(void) {
+    const char* spec = getenv("BMT_TRANSPORT");
+    if (spec == NULL || spec[0] == '\0' || strcmp(spec, "stdout") == 0) {
+        return &s_stdout_transport;
+    }
+    const bmt_transport_t* transport = NULL;
+    if (strncmp(spec, "tcp:", 4) == 0 && linux_host_tcp_connect(spec + 4)) {
+        transport = &s_tcp_transport;
+    } else if (strncmp(spec, "tcp-listen:", 11) == 0 && linux_host_tcp_accept(spec + 11)) {
+        transport = &s_tcp_transport;
+    } else if (strncmp(spec, "udp:", 4) == 0 && linux_host_udp_open(spec + 4)) {
+        transport = &s_udp_transport;
+    }
+    if (transport == NULL) {
+        fprintf(stderr, "BMT: cannot open BMT_TRANSPORT=%s (%s), using stdout\n", spec, strerror(errno));
+        return &s_stdout_transport;
+    }
+    if (transport == &s_tcp_transport) {
+        int one = 1;  // Cada envío sale ya: el buffer de bmt_transport.h agrupa las líneas
+        setsockopt(s_socket, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return transport;
+}
@@ -11,6 +11,8 @@
 #include "platform.h"
 #include "xil_printf.h"
 #include "baremetal_test.h"
+#include "bmt_compress.h"
+#include "bmt_transport.h"
 #include "mathoperations.h"
 #include <string.h>
 #include <stdlib.h>
@@ -209,11 +211,18 @@ TEST(EdgeCasesAndBugs, PotentiallyBuggyFunction_LargeInput) {
     ASSERT_EQ(output, 200);
 }
 
+/**
+ * @brief Valores de los fallos intencionados. `volatile` para que las aserciones no sean
+ *        constantes: una aserción constante y falsa detiene la build (BMT_CONSTANT_CHECK).
+ */
+static volatile int s_demo_one = 1;
+static volatile int s_demo_zero = 0;
+
 /**
  * @brief Suite de pruebas para demostrar las capacidades de fallo del framework.
  */
 TEST(FrameworkDemo, IntentionallyFailingAssert) {
-    ASSERT_EQ(1, 0);
+    ASSERT_EQ(s_demo_one, s_demo_zero);
     bmt_platform_puts("Esta línea NUNCA se imprimirá.\r\n");
 }
 
@@ -221,9 +230,9 @@ TEST(FrameworkDemo, IntentionallyFailingAssert) {
  * @brief Demuestra el comportamiento de las macros EXPECT que reportan fallos pero continúan la ejecución del test.
  */
 TEST(FrameworkDemo, IntentionallyFailingExpect) {
-    EXPECT_EQ(1, 0);
+    EXPECT_EQ(s_demo_one, s_demo_zero);
     bmt_platform_puts("Esta línea SÍ se imprimirá después de EXPECT.\r\n");
-    EXPECT_TRUE(0 > 1);
+    EXPECT_TRUE(s_demo_zero > s_demo_one);
     ASSERT_EQ(5, 5);
 }
 
@@ -252,9 +261,20 @@ int main()
         bmt_platform_puts("ALL TESTS PASSED\r\n");
     } else {
         char buf[30];
+        snprintf(buf, sizeof(buf), "%d", ret);
         bmt_platform_puts(buf);
         bmt_platform_puts(" TESTS FAILED\r\n");
     }
+    // Con la salida comprimida (-DBMT_ZYNQ_COMPRESS), estadísticas y última trama
+    if (bmt_compress_enabled()) {
+        bmt_compress_report();
+    }
+    // Caudal del transporte (UART o red) y últimos bytes en el buffer
+    bmt_transport_report();
+    // Fin de la ejecución para bmt_matrix.py, que lee la UART hasta esta línea
+    bmt_platform_puts("[BMT_DONE_ALL_TESTS]\r\n");
+    bmt_compress_flush();
+    bmt_transport_flush();
     cleanup_platform();
     return 0;
 }
@@ -0,0 +1,55 @@
+/**
+ * @file memtest_tests.c
+ * @brief Tests de RAM (March C-, inversiones móviles, walking ones y dirección en dirección)
+ *        para validar la DDR y la OCM de una placa nueva.
+ *
+ * `MemTest.PlatformRegions` prueba las regiones que declara la plataforma con
+ * bmt_platform_memtest_region(): en el puerto Linux, un buffer de `mmap`; en la Zynq-7000,
+ * las definidas con `BMT_ZYNQ_MEMTEST_DDR_BASE`/`_SIZE` y `BMT_ZYNQ_MEMTEST_OCM_BASE`/`_SIZE`.
+ * `MemTest.StaticBuffer` muestra la API directa sobre un buffer del programa.
+ *
+ * Cada test imprime una línea "[ MEMTEST  ]" con los errores y el throughput, y un error
+ * aparece como fallo "MEMTEST" del test con la primera dirección incorrecta.
+ */
+
+#include "baremetal_test.h"
+#include "bmt_memtest.h"
+
+/** @brief Tests a ejecutar (máscara de BMT_MEMTEST_*). */
+#ifndef MEMTEST_TESTS
+#define MEMTEST_TESTS BMT_MEMTEST_ALL
+#endif
+
+/** @brief Tamaño del buffer de MemTest.StaticBuffer. */
+#ifndef MEMTEST_BUFFER_SIZE
+#define MEMTEST_BUFFER_SIZE (256u * 1024u)
+#endif
+
+static uint8_t s_memtest_buffer[MEMTEST_BUFFER_SIZE] __attribute__((aligned(64)));
+
+/**
+ * @brief Ejecuta los tests en todas las regiones de la plataforma. Los errores ya se
+ *        informan como fallos dentro de bmt_memtest_run().
+ */
+TEST(MemTest, PlatformRegions) {
+    (void)bmt_memtest_run_regions(MEMTEST_TESTS);
+}
+
+/**
+ * @brief Ejecuta los tests en un buffer estático y comprueba que cada uno ha recorrido la memoria.
+ */
+TEST(MemTest, StaticBuffer) {
+    bmt_memtest_result_t results[BMT_MEMTEST_NUM_TESTS];
+    uint64_t errors = bmt_memtest_run("BSS", s_memtest_buffer, sizeof(s_memtest_buffer), MEMTEST_TESTS, results);
+    ASSERT_EQ((long)errors, 0);
+    for (int t = 0; t < BMT_MEMTEST_NUM_TESTS; ++t) {
+        if (MEMTEST_TESTS & (1u << t)) {
+            ASSERT_NOT_NULL(results[t].test);
+            EXPECT_GT((long)results[t].bytes, 0);
+        }
+    }
+    // March C- lee o escribe 10 veces cada celda
+    if (MEMTEST_TESTS & BMT_MEMTEST_MARCH_C_MINUS) {
+        EXPECT_GE((long)results[2].bytes, (long)(10u * sizeof(s_memtest_buffer)));
+    }
+}
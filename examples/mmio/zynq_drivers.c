@@ -0,0 +1,67 @@
+/**
+ * @file zynq_drivers.c
+ * @brief Implementación de los drivers de ejemplo (ver zynq_drivers.h).
+ */
+
+#include "zynq_drivers.h"
+#include "zynq_regs.h"
+
+/** @brief Registro de 32 bits en `base + offset`. */
+#define REG32(base, offset) (*(volatile uint32_t*)((base) + (offset)))
+
+void ps_uart_init(uintptr_t base, uint32_t baudgen, uint32_t bauddiv) {
+    REG32(base, UARTPS_CR_OFFSET) = UARTPS_CR_TX_DIS | UARTPS_CR_RX_DIS;
+    REG32(base, UARTPS_CR_OFFSET) = UARTPS_CR_TX_DIS | UARTPS_CR_RX_DIS | UARTPS_CR_TXRST | UARTPS_CR_RXRST;
+    while (REG32(base, UARTPS_CR_OFFSET) & (UARTPS_CR_TXRST | UARTPS_CR_RXRST)) {
+    }
+    REG32(base, UARTPS_MR_OFFSET) = UARTPS_MR_8N1;
+    REG32(base, UARTPS_BAUDGEN_OFFSET) = baudgen;
+    REG32(base, UARTPS_BAUDDIV_OFFSET) = bauddiv;
+    REG32(base, UARTPS_CR_OFFSET) = UARTPS_CR_TX_EN | UARTPS_CR_RX_EN;
+}
+
+void ps_uart_putc(uintptr_t base, uint8_t c) {
+    while (REG32(base, UARTPS_SR_OFFSET) & UARTPS_SR_TXFULL) {
+    }
+    REG32(base, UARTPS_FIFO_OFFSET) = c;
+}
+
+int ps_uart_getc(uintptr_t base) {
+    if (REG32(base, UARTPS_SR_OFFSET) & UARTPS_SR_RXEMPTY) {
+        return -1;
+    }
+    return (int)(REG32(base, UARTPS_FIFO_OFFSET) & 0xFFu);
+}
+
+void ps_uart_flush(uintptr_t base) {
+    while (!(REG32(base, UARTPS_SR_OFFSET) & UARTPS_SR_TXEMPTY)) {
+    }
+}
+
+uint64_t gtimer_now(uintptr_t base) {
+    uint32_t hi, lo;
+    do {
+        hi = REG32(base, GTIMER_COUNTER_HI);
+        lo = REG32(base, GTIMER_COUNTER_LO);
+    } while (REG32(base, GTIMER_COUNTER_HI) != hi);
+    return ((uint64_t)hi << 32) | lo;
+}
+
+void gtimer_arm(uintptr_t base, uint64_t fire_at) {
+    // Comparador desactivado mientras se escribe el valor de 64 bits
+    uint32_t ctrl = REG32(base, GTIMER_CONTROL) & ~(GTIMER_CTRL_COMP | GTIMER_CTRL_IRQ);
+    REG32(base, GTIMER_CONTROL) = ctrl;
+    REG32(base, GTIMER_ISR) = 0x1u;
+    REG32(base, GTIMER_COMP_LO) = (uint32_t)fire_at;
+    REG32(base, GTIMER_COMP_HI) = (uint32_t)(fire_at >> 32);
+    REG32(base, GTIMER_CONTROL) = ctrl | GTIMER_CTRL_ENABLE | GTIMER_CTRL_COMP | GTIMER_CTRL_IRQ;
+}
+
+void gtimer_cancel(uintptr_t base) {
+    REG32(base, GTIMER_CONTROL) = REG32(base, GTIMER_CONTROL) & ~(GTIMER_CTRL_COMP | GTIMER_CTRL_IRQ);
+    REG32(base, GTIMER_ISR) = 0x1u;
+}
+
+bool gtimer_fired(uintptr_t base) {
+    return (REG32(base, GTIMER_ISR) & 0x1u) != 0;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file zynq_drivers.h
+ * @brief Drivers mínimos a nivel de registro para la UART PS y el global timer del Zynq-7000.
+ *
+ * Acceden al hardware con punteros `volatile`, como los drivers de la BSP. El comparador del
+ * global timer sigue la misma secuencia que bmt_platform_timer_irq_arm() de
+ * `examples/xilinx_zynq7000/platform_uart_zynq7000.c`. En el host se prueban contra los
+ * modelos de `zynq_models.h` (ver `mmio_tests.c`).
+ */
+
+#ifndef ZYNQ_DRIVERS_H
+#define ZYNQ_DRIVERS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Reinicia la UART, la configura en 8N1 con los divisores dados y la habilita.
+ */
+void ps_uart_init(uintptr_t base, uint32_t baudgen, uint32_t bauddiv);
+
+/** @brief Envía un byte (espera si la FIFO de transmisión está llena). */
+void ps_uart_putc(uintptr_t base, uint8_t c);
+
+/** @brief Lee un byte recibido, o -1 si la FIFO de recepción está vacía. */
+int ps_uart_getc(uintptr_t base);
+
+/** @brief Espera a que se haya transmitido todo lo que hay en la FIFO. */
+void ps_uart_flush(uintptr_t base);
+
+/** @brief Lee el contador de 64 bits (alto, bajo, alto, hasta que el alto no cambia). */
+uint64_t gtimer_now(uintptr_t base);
+
+/** @brief Programa el comparador para `fire_at` con interrupción. */
+void gtimer_arm(uintptr_t base, uint64_t fire_at);
+
+/** @brief Desarma el comparador y borra el evento pendiente. */
+void gtimer_cancel(uintptr_t base);
+
+/** @brief El comparador ha disparado (flag del registro ISR). */
+bool gtimer_fired(uintptr_t base);
+
+#endif // ZYNQ_DRIVERS_H
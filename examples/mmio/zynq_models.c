@@ -0,0 +1,173 @@
+/**
+ * @file zynq_models.c
+ * @brief Implementación de los modelos de periféricos (ver zynq_models.h).
+ */
+
+#include "zynq_models.h"
+#include <string.h>
+
+/** @brief Cada `sr_reads_per_byte` lecturas de SR se transmite un byte: pasa a la línea. */
+static void uart_shift_out(zynq_uart_model_t* m) {
+    if (m->tx_count == 0 || ++m->sr_reads < m->sr_reads_per_byte) {
+        return;
+    }
+    m->sr_reads = 0;
+    if (m->wire_len < ZYNQ_UART_MODEL_WIRE) {
+        m->wire[m->wire_len++] = m->tx_fifo[0];
+    }
+    memmove(m->tx_fifo, m->tx_fifo + 1, --m->tx_count);
+}
+
+static uint32_t uart_read(mmio_sim_device_t* dev, uint32_t offset) {
+    zynq_uart_model_t* m = (zynq_uart_model_t*)dev->state;
+    switch (offset) {
+    case UARTPS_CR_OFFSET:
+        return (m->rx_enabled ? UARTPS_CR_RX_EN : UARTPS_CR_RX_DIS) | (m->tx_enabled ? UARTPS_CR_TX_EN : UARTPS_CR_TX_DIS);
+    case UARTPS_MR_OFFSET:
+        return m->mode;
+    case UARTPS_BAUDGEN_OFFSET:
+        return m->baudgen;
+    case UARTPS_BAUDDIV_OFFSET:
+        return m->bauddiv;
+    case UARTPS_SR_OFFSET: {
+        uint32_t sr = (m->rx_count == 0 ? UARTPS_SR_RXEMPTY : 0u) |
+                      (m->tx_count == 0 ? UARTPS_SR_TXEMPTY : 0u) |
+                      (m->tx_count == UARTPS_FIFO_DEPTH ? UARTPS_SR_TXFULL : 0u);
+        uart_shift_out(m);
+        return sr;
+    }
+    case UARTPS_FIFO_OFFSET: {
+        if (m->rx_count == 0) {
+            return 0;
+        }
+        uint8_t c = m->rx_fifo[m->rx_head];
+        m->rx_head = (m->rx_head + 1u) % UARTPS_FIFO_DEPTH;
+        m->rx_count--;
+        return c;
+    }
+    default:
+        return 0;
+    }
+}
+
+static void uart_write(mmio_sim_device_t* dev, uint32_t offset, uint32_t value) {
+    zynq_uart_model_t* m = (zynq_uart_model_t*)dev->state;
+    switch (offset) {
+    case UARTPS_CR_OFFSET:
+        if (value & (UARTPS_CR_TXRST | UARTPS_CR_RXRST)) {
+            m->resets++;
+        }
+        if (value & UARTPS_CR_TXRST) m->tx_count = 0;
+        if (value & UARTPS_CR_RXRST) m->rx_count = 0;
+        // Como en el hardware, DIS tiene prioridad sobre EN
+        if (value & UARTPS_CR_TX_DIS) m->tx_enabled = false; else if (value & UARTPS_CR_TX_EN) m->tx_enabled = true;
+        if (value & UARTPS_CR_RX_DIS) m->rx_enabled = false; else if (value & UARTPS_CR_RX_EN) m->rx_enabled = true;
+        break;
+    case UARTPS_MR_OFFSET:
+        m->mode = value;
+        break;
+    case UARTPS_BAUDGEN_OFFSET:
+        m->baudgen = value;
+        break;
+    case UARTPS_BAUDDIV_OFFSET:
+        m->bauddiv = value;
+        break;
+    case UARTPS_FIFO_OFFSET:
+        if (!m->tx_enabled || m->tx_count == UARTPS_FIFO_DEPTH) {
+            m->tx_dropped++;
+        } else {
+            m->tx_fifo[m->tx_count++] = (uint8_t)value;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void zynq_uart_model_init(zynq_uart_model_t* m) {
+    memset(m, 0, sizeof(*m));
+    m->sr_reads_per_byte = 1;
+    m->dev.read = uart_read;
+    m->dev.write = uart_write;
+    m->dev.state = m;
+}
+
+size_t zynq_uart_model_inject(zynq_uart_model_t* m, const uint8_t* data, size_t size) {
+    size_t n = 0;
+    while (m->rx_enabled && n < size && m->rx_count < UARTPS_FIFO_DEPTH) {
+        m->rx_fifo[(m->rx_head + m->rx_count) % UARTPS_FIFO_DEPTH] = data[n++];
+        m->rx_count++;
+    }
+    return n;
+}
+
+/** @brief Evento del comparador: se activa al alcanzar el valor con ENABLE y COMP activos. */
+static void gtimer_update(zynq_gtimer_model_t* m) {
+    uint32_t armed = GTIMER_CTRL_ENABLE | GTIMER_CTRL_COMP;
+    if ((m->control & armed) == armed && m->counter >= m->compare) {
+        m->isr |= 0x1u;
+    }
+}
+
+static uint32_t gtimer_read(mmio_sim_device_t* dev, uint32_t offset) {
+    zynq_gtimer_model_t* m = (zynq_gtimer_model_t*)dev->state;
+    switch (offset) {
+    case GTIMER_COUNTER_LO:
+        if (m->control & GTIMER_CTRL_ENABLE) {
+            m->counter += m->ticks_per_read;
+        }
+        gtimer_update(m);
+        return (uint32_t)m->counter;
+    case GTIMER_COUNTER_HI:
+        return (uint32_t)(m->counter >> 32);
+    case GTIMER_CONTROL:
+        return m->control;
+    case GTIMER_ISR:
+        gtimer_update(m);
+        return m->isr;
+    case GTIMER_COMP_LO:
+        return (uint32_t)m->compare;
+    case GTIMER_COMP_HI:
+        return (uint32_t)(m->compare >> 32);
+    default:
+        return 0;
+    }
+}
+
+static void gtimer_write(mmio_sim_device_t* dev, uint32_t offset, uint32_t value) {
+    zynq_gtimer_model_t* m = (zynq_gtimer_model_t*)dev->state;
+    switch (offset) {
+    case GTIMER_COUNTER_LO:
+        m->counter = (m->counter & 0xFFFFFFFF00000000ull) | value;
+        break;
+    case GTIMER_COUNTER_HI:
+        m->counter = (m->counter & 0xFFFFFFFFull) | ((uint64_t)value << 32);
+        break;
+    case GTIMER_CONTROL:
+        m->control = value;
+        break;
+    case GTIMER_ISR:
+        m->isr &= ~value;  // Se borra escribiendo 1
+        break;
+    case GTIMER_COMP_LO:
+        m->compare = (m->compare & 0xFFFFFFFF00000000ull) | value;
+        break;
+    case GTIMER_COMP_HI:
+        m->compare = (m->compare & 0xFFFFFFFFull) | ((uint64_t)value << 32);
+        break;
+    default:
+        break;
+    }
+}
+
+void zynq_gtimer_model_init(zynq_gtimer_model_t* m, uint32_t ticks_per_read) {
+    memset(m, 0, sizeof(*m));
+    m->ticks_per_read = ticks_per_read;
+    m->dev.read = gtimer_read;
+    m->dev.write = gtimer_write;
+    m->dev.state = m;
+}
+
+bool zynq_gtimer_model_irq_pending(const zynq_gtimer_model_t* m) {
+    return (m->isr & 0x1u) && (m->control & GTIMER_CTRL_IRQ);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file zynq_models.h
+ * @brief Modelos de la UART PS y del global timer del Zynq-7000 para la simulación de
+ *        registros del puerto Linux (`linux_host/mmio_linux_host.h`).
+ *
+ * Modelan lo que ve un driver, no la temporización real: la UART saca un byte de la FIFO
+ * de transmisión cada `sr_reads_per_byte` lecturas del registro de estado (el driver que
+ * espera con un bucle ve la FIFO vaciarse), y el contador del global timer avanza `ticks_per_read` en cada
+ * lectura de su parte baja.
+ */
+
+#ifndef ZYNQ_MODELS_H
+#define ZYNQ_MODELS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "linux_host/mmio_linux_host.h"
+#include "zynq_regs.h"
+
+/** @brief Bytes transmitidos que guarda el modelo de la UART. */
+#define ZYNQ_UART_MODEL_WIRE 256u
+
+/**
+ * @brief Estado de una UART PS simulada.
+ */
+typedef struct {
+    mmio_sim_device_t dev;          /**< Para mmio_sim_map(). */
+    bool rx_enabled;
+    bool tx_enabled;
+    uint32_t mode;                  /**< Registro MR. */
+    uint32_t baudgen;
+    uint32_t bauddiv;
+    uint32_t resets;                /**< Reinicios de TX/RX pedidos por CR. */
+    uint32_t sr_reads_per_byte;     /**< Velocidad de la línea: lecturas de SR por byte transmitido. */
+    uint32_t sr_reads;
+    uint8_t tx_fifo[UARTPS_FIFO_DEPTH];
+    uint32_t tx_count;
+    uint32_t tx_dropped;            /**< Escrituras con la FIFO llena o TX deshabilitada. */
+    uint8_t rx_fifo[UARTPS_FIFO_DEPTH];
+    uint32_t rx_head;
+    uint32_t rx_count;
+    uint8_t wire[ZYNQ_UART_MODEL_WIRE];  /**< Bytes ya transmitidos, en orden. */
+    uint32_t wire_len;
+} zynq_uart_model_t;
+
+/** @brief Inicializa el modelo en el estado de reset (TX y RX deshabilitadas, un byte por lectura de SR). */
+void zynq_uart_model_init(zynq_uart_model_t* m);
+
+/**
+ * @brief Simula bytes recibidos por la línea (con RX deshabilitada se pierden).
+ * @return Bytes que han cabido en la FIFO de recepción.
+ */
+size_t zynq_uart_model_inject(zynq_uart_model_t* m, const uint8_t* data, size_t size);
+
+/**
+ * @brief Estado de un global timer simulado.
+ */
+typedef struct {
+    mmio_sim_device_t dev;          /**< Para mmio_sim_map(). */
+    uint64_t counter;
+    uint32_t ticks_per_read;        /**< Avance por lectura de COUNTER_LO con el timer habilitado. */
+    uint32_t control;
+    uint32_t isr;
+    uint64_t compare;
+} zynq_gtimer_model_t;
+
+/** @brief Inicializa el modelo (contador a 0, deshabilitado). */
+void zynq_gtimer_model_init(zynq_gtimer_model_t* m, uint32_t ticks_per_read);
+
+/** @brief Hay una interrupción pendiente (evento del comparador con IRQ habilitada). */
+bool zynq_gtimer_model_irq_pending(const zynq_gtimer_model_t* m);
+
+#endif // ZYNQ_MODELS_H
@@ -0,0 +1,51 @@
+/**
+ * @file zynq_regs.h
+ * @brief Direcciones y registros de la UART PS y del global timer del Zynq-7000 (los mismos
+ *        valores que `xparameters.h`, `xuartps_hw.h` y `xscutimer_hw.h` de la BSP), para los
+ *        drivers y modelos de ejemplo de `examples/mmio/`.
+ */
+
+#ifndef ZYNQ_REGS_H
+#define ZYNQ_REGS_H
+
+/** @brief UART1 de la PS (la consola en la mayoría de placas). */
+#define ZYNQ_UART1_BASEADDR     0xE0001000u
+
+#define UARTPS_CR_OFFSET        0x00u   /**< Control. */
+#define UARTPS_MR_OFFSET        0x04u   /**< Modo (formato de trama). */
+#define UARTPS_BAUDGEN_OFFSET   0x18u   /**< Divisor del generador de baudios. */
+#define UARTPS_SR_OFFSET        0x2Cu   /**< Estado. */
+#define UARTPS_FIFO_OFFSET      0x30u   /**< FIFO de transmisión (escritura) y recepción (lectura). */
+#define UARTPS_BAUDDIV_OFFSET   0x34u   /**< Divisor de bit. */
+
+#define UARTPS_CR_RXRST         0x01u   /**< Reinicia la ruta de recepción (se borra solo). */
+#define UARTPS_CR_TXRST         0x02u   /**< Reinicia la ruta de transmisión (se borra solo). */
+#define UARTPS_CR_RX_EN         0x04u
+#define UARTPS_CR_RX_DIS        0x08u
+#define UARTPS_CR_TX_EN         0x10u
+#define UARTPS_CR_TX_DIS        0x20u
+
+#define UARTPS_MR_8N1           0x20u   /**< 8 bits, sin paridad, 1 bit de parada. */
+
+#define UARTPS_SR_RXEMPTY       0x02u
+#define UARTPS_SR_TXEMPTY       0x08u
+#define UARTPS_SR_TXFULL        0x10u
+
+/** @brief Profundidad de las FIFO de la UART PS. */
+#define UARTPS_FIFO_DEPTH       64u
+
+/** @brief Global timer de los periféricos privados del Cortex-A9 (el contador de XTime_GetTime). */
+#define ZYNQ_GTIMER_BASEADDR    0xF8F00200u
+
+#define GTIMER_COUNTER_LO       0x00u
+#define GTIMER_COUNTER_HI       0x04u
+#define GTIMER_CONTROL          0x08u
+#define GTIMER_ISR              0x0Cu
+#define GTIMER_COMP_LO          0x10u
+#define GTIMER_COMP_HI          0x14u
+
+#define GTIMER_CTRL_ENABLE      0x1u
+#define GTIMER_CTRL_COMP        0x2u
+#define GTIMER_CTRL_IRQ         0x4u
+
+#endif // ZYNQ_REGS_H
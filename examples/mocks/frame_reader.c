@@ -0,0 +1,48 @@
+/**
+ * @file frame_reader.c
+ * @brief Implementación del lector de tramas de ejemplo (ver frame_reader.h).
+ */
+
+#include "frame_reader.h"
+#include "uart_hal.h"
+
+/**
+ * @brief Espera un byte hasta que pasan `timeout_ms` desde `start`.
+ * @return El byte, o -1 si se agota el tiempo.
+ */
+static int frame_next_byte(uint32_t start, uint32_t timeout_ms) {
+    while (!uart_hal_rx_ready()) {
+        if (uart_hal_millis() - start >= timeout_ms) {
+            return -1;
+        }
+    }
+    return uart_hal_read_byte();
+}
+
+int frame_read(uint8_t* payload, size_t capacity, uint32_t timeout_ms) {
+    uint32_t start = uart_hal_millis();
+    int c;
+    do {
+        c = frame_next_byte(start, timeout_ms);
+        if (c < 0) {
+            return FRAME_ERR_TIMEOUT;
+        }
+    } while (c != (int)FRAME_START);
+
+    uart_hal_led(true);
+    int result = frame_next_byte(start, timeout_ms);  // Longitud
+    size_t length = (size_t)result;
+    for (size_t i = 0; result >= 0 && i < length; ++i) {
+        c = frame_next_byte(start, timeout_ms);
+        if (c < 0) {
+            result = FRAME_ERR_TIMEOUT;
+        } else if (i < capacity) {
+            payload[i] = (uint8_t)c;
+        }
+    }
+    if (result >= 0 && length > capacity) {
+        result = FRAME_ERR_TOO_LONG;
+    }
+    uart_hal_led(false);
+    return result;
+}
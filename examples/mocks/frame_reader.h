@@ -0,0 +1,32 @@
+/**
+ * @file frame_reader.h
+ * @brief Lector de tramas de la UART de ejemplo, el tipo de código que depende de la BSP.
+ *
+ * Una trama es `[0x7E][longitud:1][carga:longitud]`; los bytes anteriores al 0x7E se
+ * descartan. El LED de actividad se enciende al empezar una trama y se apaga al terminarla.
+ *
+ * Es el código que prueban los tests de `mock_tests.c`.
+ */
+
+#ifndef FRAME_READER_H
+#define FRAME_READER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/** @brief Byte de inicio de trama. */
+#define FRAME_START 0x7Eu
+
+/** @brief No ha llegado una trama completa antes del timeout. */
+#define FRAME_ERR_TIMEOUT  (-1)
+/** @brief La carga no cabe en el búfer (la trama se consume igualmente). */
+#define FRAME_ERR_TOO_LONG (-2)
+
+/**
+ * @brief Espera una trama y copia su carga en `payload`.
+ * @param timeout_ms Tiempo máximo de espera, desde la llamada.
+ * @return Longitud de la carga, o FRAME_ERR_TIMEOUT / FRAME_ERR_TOO_LONG.
+ */
+int frame_read(uint8_t* payload, size_t capacity, uint32_t timeout_ms);
+
+#endif // FRAME_READER_H
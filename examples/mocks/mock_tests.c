@@ -0,0 +1,72 @@
+/**
+ * @file mock_tests.c
+ * @brief Ejemplo de mocks (`bmt_mock.h`): el lector de tramas se prueba en el host con la
+ *        capa `uart_hal.h` sustituida por mocks.
+ *
+ * Cada mock guarda sus llamadas y argumentos en memoria estática y se pone a cero antes de
+ * cada test. Los bytes que "llegan" por la UART son la secuencia de retornos de
+ * uart_hal_read_byte(), y el paso del tiempo lo simula un custom_fake de uart_hal_millis().
+ */
+
+#include "baremetal_test.h"
+#include "bmt_mock.h"
+#include "frame_reader.h"
+#include "uart_hal.h"
+
+BMT_MOCK_VALUE(bool, uart_hal_rx_ready);
+BMT_MOCK_VALUE(uint8_t, uart_hal_read_byte);
+BMT_MOCK_VALUE(uint32_t, uart_hal_millis);
+BMT_MOCK_VOID(uart_hal_led, bool);
+
+/** @brief Reloj simulado: cada lectura avanza 1 ms. */
+static uint32_t mock_clock_ms = 0;
+
+static uint32_t mock_millis_advance(void) {
+    return mock_clock_ms++;
+}
+
+TEST(FrameReader, SkipsNoiseAndReadsPayload) {
+    uint8_t payload[8];
+    uart_hal_rx_ready_mock.return_val = true;
+    BMT_MOCK_RETURNS(uart_hal_read_byte, 0x55, 0x00, FRAME_START, 2, 'h', 'i');
+
+    ASSERT_EQ(frame_read(payload, sizeof(payload), 100), 2);
+    EXPECT_EQ(payload[0], 'h');
+    EXPECT_EQ(payload[1], 'i');
+    EXPECT_MOCK_CALLS(uart_hal_read_byte, 6);
+    EXPECT_MOCK_CALLS(uart_hal_led, 2);
+    EXPECT_MOCK_CALLED_WITH(uart_hal_led, 0, true);
+    EXPECT_MOCK_CALLED_WITH(uart_hal_led, 1, false);
+    EXPECT_MOCK_CALL_ORDER(uart_hal_led, uart_hal_read_byte, uart_hal_read_byte, uart_hal_led);
+}
+
+TEST(FrameReader, WaitsForTheFifo) {
+    uint8_t payload[4];
+    BMT_MOCK_RETURNS(uart_hal_rx_ready, false, false, true);  // Luego siempre true
+    BMT_MOCK_RETURNS(uart_hal_read_byte, FRAME_START, 1, 0xAB);
+
+    ASSERT_EQ(frame_read(payload, sizeof(payload), 100), 1);
+    EXPECT_EQ(payload[0], 0xAB);
+    EXPECT_MOCK_CALLS(uart_hal_rx_ready, 5);
+}
+
+TEST(FrameReader, TimesOutWithoutData) {
+    uint8_t payload[4];
+    mock_clock_ms = 1000;
+    uart_hal_millis_mock.custom_fake = mock_millis_advance;  // uart_hal_rx_ready() devuelve 0
+
+    EXPECT_EQ(frame_read(payload, sizeof(payload), 50), FRAME_ERR_TIMEOUT);
+    EXPECT_MOCK_CALLS(uart_hal_led, 0);
+    EXPECT_MOCK_CALLS(uart_hal_read_byte, 0);
+    EXPECT_EQ(mock_clock_ms, 1000 + 1 + 50);  // Lectura inicial y una por espera
+}
+
+TEST(FrameReader, RejectsPayloadLongerThanBuffer) {
+    uint8_t payload[2];
+    uart_hal_rx_ready_mock.return_val = true;
+    BMT_MOCK_RETURNS(uart_hal_read_byte, FRAME_START, 4, 'a', 'b', 'c', 'd');
+
+    EXPECT_EQ(frame_read(payload, sizeof(payload), 100), FRAME_ERR_TOO_LONG);
+    EXPECT_MOCK_CALLS(uart_hal_read_byte, 6);  // La trama se consume entera
+    EXPECT_MOCK_CALLED_WITH(uart_hal_led, 1, false);
+}
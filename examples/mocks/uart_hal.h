@@ -0,0 +1,28 @@
+/**
+ * @file uart_hal.h
+ * @brief Capa de acceso al hardware que usa `frame_reader.c`.
+ *
+ * En la placa se implementa sobre la BSP (XUartPs_IsReceiveData(), XUartPs_RecvByte(), el
+ * timer, un GPIO). En el host no se implementa: `mock_tests.c` la sustituye por mocks
+ * (`bmt_mock.h`), así que la lógica del lector se prueba sin la placa.
+ */
+
+#ifndef UART_HAL_H
+#define UART_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Hay al menos un byte en la FIFO de recepción. */
+bool uart_hal_rx_ready(void);
+
+/** @brief Lee un byte de la FIFO de recepción (solo si uart_hal_rx_ready()). */
+uint8_t uart_hal_read_byte(void);
+
+/** @brief Milisegundos desde el arranque. */
+uint32_t uart_hal_millis(void);
+
+/** @brief Enciende o apaga el LED de actividad. */
+void uart_hal_led(bool on);
+
+#endif // UART_HAL_H
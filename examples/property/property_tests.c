@@ -0,0 +1,100 @@
+/**
+ * @file property_tests.c
+ * @brief Ejemplos de PROPERTY: propiedades comprobadas con miles de entradas aleatorias.
+ *
+ * En lugar de elegir a mano `add(2, 2)` o `is_prime(7)`, cada propiedad declara de qué
+ * rango salen sus entradas y qué debe cumplirse para todas. Si una entrada falla, se
+ * reduce al contraejemplo mínimo y se imprime junto con la semilla para reproducirlo.
+ *
+ * Compilando con `-DBMT_PROP_DEMO_FAILURE` se añade una propiedad que falla a propósito,
+ * para ver el informe de un contraejemplo reducido.
+ */
+
+#include "baremetal_test.h"
+#include "bmt_property.h"
+#include "mathoperations.h"
+#include <string.h>
+
+/** @brief Tamaño máximo de los búferes generados. */
+#define PROP_MAX_BUF 64u
+
+/**
+ * @brief La suma es conmutativa y la resta la deshace.
+ */
+PROPERTY(MathProperties, AddCommutesAndSubtractUndoes,
+         gen_int32(a, -1000000, 1000000), gen_int32(b, -1000000, 1000000)) {
+    ASSERT_EQ(add(a, b), add(b, a));
+    ASSERT_EQ(subtract(add(a, b), b), a);
+}
+
+/**
+ * @brief is_prime() coincide con una división por tentativa de referencia.
+ */
+PROPERTY(MathProperties, IsPrimeMatchesReference, gen_uint32(n, 0, 200000)) {
+    bool expected = n >= 2;
+    for (uint32_t d = 2; (uint64_t)d * d <= n && expected; ++d) {
+        if (n % d == 0) {
+            expected = false;
+        }
+    }
+    ASSERT_EQ(is_prime(n), expected);
+}
+
+/**
+ * @brief Codificador RLE de ejemplo: pares (longitud, byte) con longitud de 1 a 255.
+ * @return Bytes escritos en `out` (como mucho 2 * len).
+ */
+static size_t rle_encode(const uint8_t* in, size_t len, uint8_t* out) {
+    size_t o = 0;
+    for (size_t i = 0; i < len;) {
+        size_t run = 1;
+        while (i + run < len && in[i + run] == in[i] && run < 255u) {
+            run++;
+        }
+        out[o++] = (uint8_t)run;
+        out[o++] = in[i];
+        i += run;
+    }
+    return o;
+}
+
+/**
+ * @brief Decodificador RLE de ejemplo.
+ * @return Bytes escritos en `out`, o 0 si no caben en `max`.
+ */
+static size_t rle_decode(const uint8_t* in, size_t len, uint8_t* out, size_t max) {
+    size_t o = 0;
+    for (size_t i = 0; i + 1 < len; i += 2) {
+        if (o + in[i] > max) {
+            return 0;
+        }
+        memset(&out[o], in[i + 1], in[i]);
+        o += in[i];
+    }
+    return o;
+}
+
+/**
+ * @brief Decodificar lo codificado devuelve exactamente la entrada.
+ */
+PROPERTY(CodecProperties, RleRoundTrip, gen_buf(data, PROP_MAX_BUF), gen_bool(repeat)) {
+    uint8_t encoded[2u * PROP_MAX_BUF];
+    uint8_t decoded[PROP_MAX_BUF];
+    if (repeat && data_len > 0) {
+        memset(data, data[0], data_len / 2u);  // Rachas largas, que los bytes aleatorios casi nunca dan
+    }
+    size_t enc_len = rle_encode(data, data_len, encoded);
+    ASSERT_TRUE(enc_len <= 2u * data_len);
+    ASSERT_EQ(rle_decode(encoded, enc_len, decoded, sizeof(decoded)), data_len);
+    ASSERT_EQ(memcmp(decoded, data, data_len), 0);
+}
+
+#ifdef BMT_PROP_DEMO_FAILURE
+/**
+ * @brief Falla a propósito: el informe muestra el contraejemplo mínimo (x=1000 y un búfer
+ *        de 3 ceros), no los valores aleatorios con los que se encontró.
+ */
+PROPERTY(PropertyDemo, ShrinksToMinimalCounterexample, gen_int32(x, -100000, 100000), gen_buf(data, 16)) {
+    ASSERT_TRUE(x < 1000 || data_len < 3);
+}
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file selfbench_main.c
+ * @brief Punto de entrada de la autoevaluación del framework en Linux (host). Sustituye a
+ *        `examples/linux_host/main_linux_host.c`: mide el registro de los tests (los
+ *        constructores de TEST()) y RUN_ALL_TESTS() completo, e imprime antes del token de fin:
+ *
+ * @code
+ * [ SELFBENCH] register_ns=734120 run_ns=41532077
+ * @endcode
+ *
+ * `pyton_parser/bmt_selfbench.py` lo enlaza con suites sintéticas de 1k a 100k tests y lo
+ * ejecuta completo, con un filtro que no selecciona nada y con fallos, para repartir el tiempo
+ * por test entre registro, filtro, despacho e informes. Enlazado solo con
+ * `examples/benchmarks/selfbench_tests.c` (perfil `linux_host_selfbench` de flag_matrix.json)
+ * da además el coste de cada aserción.
+ */
+
+#include "baremetal_test.h"
+#include "bmt_transport.h"
+#include "platform_linux_host.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+/** @brief Instante del primer constructor del programa, antes de registrar ningún test. */
+static uint64_t s_first_constructor_ns;
+
+/**
+ * @brief Prioridad 101, la primera que GCC permite a los programas: se ejecuta antes que los
+ *        constructores de TEST(), que no tienen prioridad.
+ */
+__attribute__((constructor(101)))
+static void selfbench_first_constructor(void)
+{
+    s_first_constructor_ns = bmt_platform_get_hires_ticks();
+}
+
+/**
+ * @brief Ejecuta todos los tests, imprime los tiempos y envía el token de fin para el parser.
+ * @return 0 si todas las pruebas pasan, 1 en caso contrario.
+ */
+int main(void)
+{
+    uint64_t main_ns = bmt_platform_get_hires_ticks();
+    int ret = RUN_ALL_TESTS();
+    uint64_t end_ns = bmt_platform_get_hires_ticks();
+
+    char line[96];
+    snprintf(line, sizeof(line), "[ SELFBENCH] register_ns=%" PRIu64 " run_ns=%" PRIu64 "\r\n",
+             main_ns - s_first_constructor_ns, end_ns - main_ns);
+    bmt_platform_puts(line);
+    bmt_transport_report();
+    bmt_platform_puts("[BMT_DONE_ALL_TESTS]\r\n");
+    linux_host_flush();
+    return ret == 0 ? 0 : 1;
+}
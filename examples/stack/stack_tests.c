@@ -0,0 +1,68 @@
+/**
+ * @file stack_tests.c
+ * @brief Ejemplo de pila propia por test (`BMT_TEST_STACK_SIZE`): un test que desborda su pila
+ *        falla como `STACK OVERFLOW` y el runner sigue con el siguiente.
+ *
+ * `StackGuard.IntentionallyFailingOverflow` falla a propósito: recurre hasta pasar
+ * `BMT_TEST_STACK_SIZE` y la mitad de la guarda inferior (con la guarda protegida, el primer
+ * acceso a ella ya es un fallo; con canarios, la guarda queda pisada y se detecta al terminar).
+ * `StackGuard.RunsAfterOverflow` comprueba después, con bmt_test_stack_overflows(), que el
+ * runner ha informado ese desbordamiento, y que la pila del test vuelve a estar entera.
+ *
+ * Solo se compila con `-DBMT_TEST_STACK_SIZE=<bytes>`: sin pila propia, el desbordamiento
+ * rompería toda la ejecución.
+ */
+
+#include "baremetal_test.h"
+
+#if BMT_TEST_STACK_SIZE > 0
+
+/** @brief Bytes de cada marco de la recursión. */
+#define STACK_FRAME_BYTES 256u
+
+/** @brief Lo pone IntentionallyFailingOverflow: RunsAfterOverflow solo comprueba si se ha ejecutado. */
+static bool s_overflow_started;
+
+/** @brief bmt_test_stack_overflows() antes del desbordamiento intencionado. */
+static uint32_t s_overflows_before;
+
+/**
+ * @brief Recurre con marcos de STACK_FRAME_BYTES hasta que la pila usada desde `start` llega a
+ *        `limit` bytes. Escribe todo el marco, para pisar los canarios si no hay guarda protegida.
+ * @return La profundidad alcanzada (usada después de la llamada: no hay recursión de cola).
+ */
+__attribute__((noinline)) static uint32_t stack_recurse(uintptr_t start, uintptr_t limit, uint32_t depth) {
+    volatile uint8_t frame[STACK_FRAME_BYTES];
+    for (size_t i = 0; i < sizeof(frame); ++i) {
+        frame[i] = (uint8_t)depth;
+    }
+    if (start - (uintptr_t)frame < limit) {
+        depth = stack_recurse(start, limit, depth + 1u);
+    }
+    return depth + frame[0];
+}
+
+TEST(StackGuard, IntentionallyFailingOverflow) {
+    s_overflow_started = true;
+    s_overflows_before = bmt_test_stack_overflows();
+    volatile uint8_t here;
+    stack_recurse((uintptr_t)&here, BMT_TEST_STACK_SIZE + BMT_TEST_STACK_GUARD_SIZE / 2u, 0u);
+    // Solo con canarios: el runner detecta el desbordamiento al terminar el test
+    bmt_platform_puts("The lower guard is not protected: overflow left in the canaries\r\n");
+}
+
+/**
+ * @brief Tras el desbordamiento de IntentionallyFailingOverflow, el runner lo ha informado y ha
+ *        seguido: este test corre en una pila nueva y puede usar la mitad sin fallar.
+ */
+TEST(StackGuard, RunsAfterOverflow) {
+    if (!s_overflow_started) {
+        bmt_platform_puts("IntentionallyFailingOverflow has not run yet: nothing to check\r\n");
+        return;
+    }
+    EXPECT_EQ(bmt_test_stack_overflows(), s_overflows_before + 1u);
+    volatile uint8_t here;
+    EXPECT_GT(stack_recurse((uintptr_t)&here, BMT_TEST_STACK_SIZE / 2u, 0u), 0u);
+}
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * @file mpmc_queue.c
+ * @brief Implementación de la cola MPMC de ejemplo (ver mpmc_queue.h).
+ */
+
+#include "mpmc_queue.h"
+
+void mpmc_queue_init(mpmc_queue_t* q) {
+    for (uint32_t i = 0; i < MPMC_QUEUE_CAPACITY; ++i) {
+        q->cells[i].sequence = i;
+        q->cells[i].value = 0;
+    }
+    __atomic_store_n(&q->tail, 0u, __ATOMIC_RELAXED);
+    __atomic_store_n(&q->head, 0u, __ATOMIC_RELEASE);
+}
+
+bool mpmc_queue_push(mpmc_queue_t* q, uint32_t value) {
+    uint32_t pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    for (;;) {
+        mpmc_cell_t* cell = &q->cells[pos & (MPMC_QUEUE_CAPACITY - 1u)];
+        uint32_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            // Celda libre en esta vuelta: reservarla avanzando tail
+            if (__atomic_compare_exchange_n(&q->tail, &pos, pos + 1u, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->value = value;
+                __atomic_store_n(&cell->sequence, pos + 1u, __ATOMIC_RELEASE);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // Llena: el consumidor de la vuelta anterior aún no la ha liberado
+        } else {
+            pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+bool mpmc_queue_pop(mpmc_queue_t* q, uint32_t* value) {
+    uint32_t pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+    for (;;) {
+        mpmc_cell_t* cell = &q->cells[pos & (MPMC_QUEUE_CAPACITY - 1u)];
+        uint32_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(seq - (pos + 1u));
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&q->head, &pos, pos + 1u, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *value = cell->value;
+                __atomic_store_n(&cell->sequence, pos + MPMC_QUEUE_CAPACITY, __ATOMIC_RELEASE);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // Vacía
+        } else {
+            pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+        }
+    }
+}
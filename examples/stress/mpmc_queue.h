@@ -0,0 +1,50 @@
+/**
+ * @file mpmc_queue.h
+ * @brief Cola acotada lock-free MPMC (varios productores, varios consumidores) de ejemplo.
+ *
+ * Algoritmo de D. Vyukov: cada celda lleva un número de secuencia que indica si está
+ * libre para el productor o lista para el consumidor de una vuelta concreta, así que
+ * productores y consumidores solo compiten por `head`/`tail` con CAS. Sin memoria
+ * dinámica: la capacidad es fija (`MPMC_QUEUE_CAPACITY`, potencia de dos).
+ *
+ * Es la estructura que ejercitan los STRESS_TEST de `stress_tests.c`.
+ */
+
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Capacidad de la cola. Debe ser potencia de dos. */
+#ifndef MPMC_QUEUE_CAPACITY
+#define MPMC_QUEUE_CAPACITY 256u
+#endif
+
+/**
+ * @brief Celda de la cola: número de secuencia y valor.
+ */
+typedef struct {
+    uint32_t sequence;
+    uint32_t value;
+} mpmc_cell_t;
+
+/**
+ * @brief Cola MPMC. `head` y `tail` en líneas de caché distintas para evitar false sharing.
+ */
+typedef struct {
+    uint32_t tail __attribute__((aligned(64)));  /**< Siguiente posición a escribir. */
+    uint32_t head __attribute__((aligned(64)));  /**< Siguiente posición a leer. */
+    mpmc_cell_t cells[MPMC_QUEUE_CAPACITY] __attribute__((aligned(64)));
+} mpmc_queue_t;
+
+/** @brief Deja la cola vacía. No es seguro llamarla con otros núcleos usando la cola. */
+void mpmc_queue_init(mpmc_queue_t* q);
+
+/** @brief Encola un valor. @return false si la cola está llena. */
+bool mpmc_queue_push(mpmc_queue_t* q, uint32_t value);
+
+/** @brief Desencola un valor. @return false si la cola está vacía. */
+bool mpmc_queue_pop(mpmc_queue_t* q, uint32_t* value);
+
+#endif // MPMC_QUEUE_H
@@ -0,0 +1,87 @@
+/**
+ * @file stress_tests.c
+ * @brief Ejemplos de STRESS_TEST: el mismo cuerpo ejecutado a la vez en todos los núcleos.
+ *
+ * En cada iteración todos los núcleos salen a la vez de una barrera, lo que maximiza la
+ * contención real sobre la estructura compartida. En la placa hace falta que los núcleos
+ * secundarios estén aparcados en bmt_stress_secondary_main(); en el host se usan hilos.
+ */
+
+#include "baremetal_test.h"
+#include "bmt_stress.h"
+#include "mpmc_queue.h"
+#include <stddef.h>
+
+/** @brief Operaciones por núcleo e iteración. */
+#define STRESS_OPS_PER_ITER 64u
+
+static uint32_t s_shared_counter;
+static uint32_t s_per_core_count[BMT_STRESS_MAX_CORES];
+
+/**
+ * @brief Incremento atómico compartido: al final de cada iteración el total debe ser exacto.
+ */
+STRESS_TEST(Stress, AtomicCounter, 2000) {
+    if (bmt_core == 0) {
+        s_shared_counter = 0;
+    }
+    bmt_stress_barrier();
+    for (uint32_t i = 0; i < STRESS_OPS_PER_ITER; ++i) {
+        __atomic_fetch_add(&s_shared_counter, 1u, __ATOMIC_RELAXED);
+    }
+    bmt_stress_barrier();
+    if (bmt_core == 0) {
+        ASSERT_EQ(__atomic_load_n(&s_shared_counter, __ATOMIC_RELAXED), STRESS_OPS_PER_ITER * bmt_stress_num_cores());
+    }
+    (void)bmt_iteration;
+}
+
+static mpmc_queue_t s_queue;
+static uint64_t s_pushed_sum[BMT_STRESS_MAX_CORES];
+static uint64_t s_popped_sum[BMT_STRESS_MAX_CORES];
+
+/**
+ * @brief Todos los núcleos encolan y desencolan a la vez. Cada valor codifica núcleo,
+ *        iteración y secuencia; ningún valor se puede perder ni duplicar, así que la suma
+ *        de lo desencolado debe coincidir con la de lo encolado.
+ */
+STRESS_TEST(Stress, MpmcQueuePushPop, 500) {
+    if (bmt_core == 0) {
+        mpmc_queue_init(&s_queue);
+    }
+    s_pushed_sum[bmt_core] = 0;
+    s_popped_sum[bmt_core] = 0;
+    s_per_core_count[bmt_core] = 0;
+    bmt_stress_barrier();
+
+    for (uint32_t i = 0; i < STRESS_OPS_PER_ITER; ++i) {
+        uint32_t value = (bmt_core << 24) | ((bmt_iteration & 0xFFFu) << 12) | i;
+        while (!mpmc_queue_push(&s_queue, value)) {
+            // Llena: otros núcleos están consumiendo
+        }
+        s_pushed_sum[bmt_core] += value;
+        uint32_t out;
+        if (mpmc_queue_pop(&s_queue, &out)) {
+            s_popped_sum[bmt_core] += out;
+            s_per_core_count[bmt_core]++;
+        }
+    }
+    bmt_stress_barrier();
+
+    if (bmt_core == 0) {
+        uint32_t out;
+        uint64_t pushed = 0, popped = 0;
+        uint32_t count = 0;
+        while (mpmc_queue_pop(&s_queue, &out)) {
+            popped += out;
+            count++;
+        }
+        for (uint32_t c = 0; c < bmt_stress_num_cores(); ++c) {
+            pushed += s_pushed_sum[c];
+            popped += s_popped_sum[c];
+            count += s_per_core_count[c];
+        }
+        ASSERT_EQ(count, STRESS_OPS_PER_ITER * bmt_stress_num_cores());
+        ASSERT_TRUE(pushed == popped);
+    }
+}
@@ -0,0 +1,44 @@
+/**
+ * @file link_monitor.c
+ * @brief Supervisor de enlace de ejemplo (ver link_monitor.h).
+ */
+
+#include "link_monitor.h"
+#include "bmt_platform_io.h"
+
+void link_monitor_init(link_monitor_t* m) {
+    m->last_rx_ms = bmt_platform_get_msec_ticks();
+    m->last_tx_ms = m->last_rx_ms;
+    m->keepalives_sent = 0;
+    m->state = LINK_UP;
+}
+
+void link_monitor_on_rx(link_monitor_t* m) {
+    m->last_rx_ms = bmt_platform_get_msec_ticks();
+    m->last_tx_ms = m->last_rx_ms;
+    m->state = LINK_UP;
+}
+
+link_state_t link_monitor_poll(link_monitor_t* m) {
+    uint32_t now = bmt_platform_get_msec_ticks();
+    if (m->state == LINK_DOWN) {
+        return LINK_DOWN;
+    }
+    if ((uint32_t)(now - m->last_rx_ms) >= LINK_TIMEOUT_MS) {
+        m->state = LINK_DOWN;
+    } else if ((uint32_t)(now - m->last_tx_ms) >= LINK_KEEPALIVE_MS) {
+        m->keepalives_sent++;  // En la placa, aquí se enviaría la trama de keepalive
+        m->last_tx_ms = now;
+    }
+    return m->state;
+}
+
+link_state_t link_monitor_wait(link_monitor_t* m, bool (*rx_ready)(void)) {
+    while (link_monitor_poll(m) == LINK_UP) {
+        if (rx_ready()) {
+            link_monitor_on_rx(m);
+            return LINK_UP;
+        }
+    }
+    return LINK_DOWN;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file link_monitor.h
+ * @brief Supervisor de enlace de ejemplo, el tipo de código con timeouts largos.
+ *
+ * Si no llega nada durante LINK_KEEPALIVE_MS se envía un keepalive (y otro por cada
+ * LINK_KEEPALIVE_MS más de silencio); si no llega nada durante LINK_TIMEOUT_MS el enlace
+ * se da por caído. El tiempo sale de bmt_platform_get_msec_ticks(), que en la placa es el
+ * timer de la BSP.
+ *
+ * Es el código que prueban los tests de `vclock_tests.c`: con el reloj virtual, los 30 s
+ * de timeout pasan sin esperar.
+ */
+
+#ifndef LINK_MONITOR_H
+#define LINK_MONITOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Silencio tras el que se envía un keepalive. */
+#define LINK_KEEPALIVE_MS 10000u
+/** @brief Silencio tras el que el enlace se da por caído. */
+#define LINK_TIMEOUT_MS   30000u
+
+/** @brief Estado del enlace. */
+typedef enum {
+    LINK_UP,
+    LINK_DOWN
+} link_state_t;
+
+/** @brief Estado del supervisor. */
+typedef struct {
+    uint32_t last_rx_ms;
+    uint32_t last_tx_ms;
+    uint32_t keepalives_sent;
+    link_state_t state;
+} link_monitor_t;
+
+/** @brief Empieza a supervisar, con el enlace activo desde este instante. */
+void link_monitor_init(link_monitor_t* m);
+
+/** @brief Ha llegado una trama. */
+void link_monitor_on_rx(link_monitor_t* m);
+
+/**
+ * @brief Revisa los temporizadores sin bloquear (se llama desde el bucle principal).
+ * @return Estado del enlace.
+ */
+link_state_t link_monitor_poll(link_monitor_t* m);
+
+/**
+ * @brief Espera bloqueando hasta que `rx_ready()` indique una trama o el enlace caiga.
+ * @return LINK_UP si llegó una trama, LINK_DOWN si venció el timeout.
+ */
+link_state_t link_monitor_wait(link_monitor_t* m, bool (*rx_ready)(void));
+
+#endif // LINK_MONITOR_H
@@ -0,0 +1,65 @@
+/**
+ * @file vclock_tests.c
+ * @brief Ejemplo de reloj virtual (`bmt_vclock.h`): los timeouts de 10 y 30 s del
+ *        supervisor de enlace se prueban sin esperarlos.
+ *
+ * En modo manual el tiempo solo avanza cuando el test lo pide (bmt_vclock_sleep_us()) o
+ * mientras espera con EXPECT_EVENTUALLY; en modo avance rápido también avanza en cada
+ * lectura del reloj, así que un bucle que espera un timeout llega a él enseguida. Tras cada
+ * test, la línea `[ VCLOCK   ]` compara el tiempo virtual con el real.
+ */
+
+#include "baremetal_test.h"
+#include "bmt_vclock.h"
+#include "link_monitor.h"
+
+static bool never_ready(void) {
+    return false;
+}
+
+TEST(LinkMonitor, KeepaliveAfterTenSecondsOfSilence) {
+    link_monitor_t m;
+    bmt_vclock_enable(BMT_VCLOCK_MANUAL);
+    link_monitor_init(&m);
+
+    bmt_vclock_sleep_us((LINK_KEEPALIVE_MS - 1u) * 1000u);
+    EXPECT_EQ(link_monitor_poll(&m), LINK_UP);
+    EXPECT_EQ(m.keepalives_sent, 0);
+
+    bmt_vclock_sleep_us(1000u);
+    EXPECT_EQ(link_monitor_poll(&m), LINK_UP);
+    EXPECT_EQ(m.keepalives_sent, 1);
+}
+
+TEST(LinkMonitor, TrafficKeepsLinkUp) {
+    link_monitor_t m;
+    bmt_vclock_enable(BMT_VCLOCK_MANUAL);
+    link_monitor_init(&m);
+
+    for (int i = 0; i < 10; ++i) {
+        bmt_vclock_sleep_us(20000u * 1000u);
+        ASSERT_EQ(link_monitor_poll(&m), LINK_UP);
+        link_monitor_on_rx(&m);
+    }
+}
+
+TEST(LinkMonitor, DownAfterThirtySecondsOfSilence) {
+    link_monitor_t m;
+    bmt_vclock_enable(BMT_VCLOCK_MANUAL);
+    link_monitor_init(&m);
+    uint32_t start = bmt_platform_get_msec_ticks();
+
+    ASSERT_EVENTUALLY(link_monitor_poll(&m) == LINK_DOWN, LINK_TIMEOUT_MS + 1000u);
+    EXPECT_EQ(bmt_platform_get_msec_ticks() - start, LINK_TIMEOUT_MS);
+    EXPECT_EQ(m.keepalives_sent, 2);  // A los 10 y a los 20 s
+}
+
+TEST(LinkMonitor, BlockingWaitTimesOut) {
+    link_monitor_t m;
+    bmt_vclock_enable(BMT_VCLOCK_FAST_FORWARD);
+    link_monitor_init(&m);
+    uint32_t start = bmt_platform_get_msec_ticks();
+
+    EXPECT_EQ(link_monitor_wait(&m, never_ready), LINK_DOWN);
+    EXPECT_GE(bmt_platform_get_msec_ticks() - start, LINK_TIMEOUT_MS);
+}
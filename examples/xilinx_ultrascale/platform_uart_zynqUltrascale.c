@@ -1,35 +1,155 @@
 #include "bmt_platform_io.h"
 #include "xuartps.h"
-#include "xscutimer.h"
 #include "xparameters.h"
+#include "xtime_l.h"
+#include "xscugic.h"
+#include "xil_exception.h"
+#include "bmt_compress.h"
+#include "bmt_vclock.h"
+#include <string.h>
 
 
-#define TIMER_DEVICE_ID     XPAR_SCUTIMER_DEVICE_ID
+#define GIC_DEVICE_ID       XPAR_SCUGIC_SINGLE_DEVICE_ID
 
-static XScuTimer TimerInstance;
+// Timer físico no seguro del Generic Timer (PPI 30): compara con CNTPCT, el contador de XTime_GetTime
+#define GENERIC_TIMER_INT_ID    30U
+#define CNTP_CTL_ENABLE         0x1U
+#define CNTP_CTL_IMASK          0x2U
 
+static XScuGic GicInstance;
+static int GicReady = 0;
+static volatile bmt_platform_irq_handler_t IrqHandler = NULL;
 
-void bmt_platform_io_init(void) {
 
-    XScuTimer_Config *TimerConfig = XScuTimer_LookupConfig(TIMER_DEVICE_ID);
-    int Status = XScuTimer_CfgInitialize(&TimerInstance, TimerConfig, TimerConfig->BaseAddr);
-    if (Status != XST_SUCCESS) {
-        return;
+#ifdef BMT_ZYNQ_COMPRESS
+// outbyte() lo genera la BSP para el STDOUT configurado (la UART), igual que inbyte()
+extern void outbyte(char c);
+
+/**
+ * @brief Envía una trama de la salida comprimida (bmt_compress.h) directamente a la UART.
+ */
+static void CompressSink(const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        outbyte((char)data[i]);
     }
-    XScuTimer_SetPrescaler(&TimerInstance, 0);
-    XScuTimer_LoadTimer(&TimerInstance, 0xFFFFFFFF);
-    XScuTimer_Start(&TimerInstance);
+}
+#endif
+
+void bmt_platform_io_init(void) {
+#ifdef BMT_ZYNQ_COMPRESS
+    // Salida comprimida: main() debe llamar a bmt_compress_flush() al terminar
+    bmt_compress_init(CompressSink);
+#endif
 }
 
 void bmt_platform_putchar(char c) {
+#ifdef BMT_ZYNQ_COMPRESS
+    bmt_compress_write(&c, 1);
+#else
     putchar(c);
+#endif
 }
 
 void bmt_platform_puts(const char *str) {
+#ifdef BMT_ZYNQ_COMPRESS
+    bmt_compress_write(str, strlen(str));
+#else
 	printf("%s", str);
+#endif
 }
 
 uint32_t bmt_platform_get_msec_ticks(void) {
-    uint32_t raw_ticks = XScuTimer_GetCounterValue(&TimerInstance);
-    return 0xFFFFFFFF - raw_ticks;
-}
\ No newline at end of file
+    // Mismo contador que bmt_platform_get_hires_ticks(): el reloj virtual no salta al activarse
+    return (uint32_t)(bmt_platform_get_hires_ticks() / (COUNTS_PER_SECOND / 1000u));
+}
+
+uint64_t bmt_platform_get_hires_ticks(void) {
+    uint64_t virtual_ticks;
+    if (bmt_vclock_read(&virtual_ticks)) {
+        return virtual_ticks;
+    }
+    XTime now;
+    XTime_GetTime(&now); // Global timer de 64 bits, no desborda durante una ejecución
+    return (uint64_t)now;
+}
+
+uint32_t bmt_platform_get_hires_tick_hz(void) {
+    return (uint32_t)COUNTS_PER_SECOND;
+}
+
+bool bmt_platform_cpu_info(bmt_platform_cpu_info_t *info) {
+    // Cortex-A53 de la Zynq UltraScale+: L1 de 32 KB + 32 KB por núcleo y L2 de 1 MB compartida
+    info->cpu_khz = (uint32_t)(XPAR_CPU_CORTEXA53_0_CPU_CLK_FREQ_HZ / 1000U);
+    info->l1d_bytes = 32U * 1024U;
+    info->l1i_bytes = 32U * 1024U;
+    info->l2_bytes = 1024U * 1024U;
+    info->line_bytes = 64U;
+    return true;
+}
+
+/**
+ * @brief Escribe CNTP_CTL_EL0 (control del timer físico).
+ */
+static inline void GenericTimerSetCtl(uint64_t ctl) {
+    __asm__ __volatile__("msr cntp_ctl_el0, %0\n\tisb" : : "r"(ctl) : "memory");
+}
+
+/**
+ * @brief ISR del timer físico: lo desarma y llama al handler de BMT.
+ */
+static void GenericTimerIsr(void *CallBackRef) {
+    (void)CallBackRef;
+    bmt_platform_irq_handler_t handler = IrqHandler;
+    IrqHandler = NULL;
+    // El handler se llama primero: su marca de tiempo de entrada es la que mide la latencia
+    if (handler) {
+        handler();
+    }
+    GenericTimerSetCtl(CNTP_CTL_IMASK);
+}
+
+/**
+ * @brief Inicializa el GIC y conecta la interrupción del timer físico la primera vez.
+ */
+static int GicSetup(void) {
+    XScuGic_Config *GicConfig = XScuGic_LookupConfig(GIC_DEVICE_ID);
+    if (GicConfig == NULL ||
+        XScuGic_CfgInitialize(&GicInstance, GicConfig, GicConfig->CpuBaseAddress) != XST_SUCCESS) {
+        return 0;
+    }
+    Xil_ExceptionInit();
+    Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT, (Xil_ExceptionHandler)XScuGic_InterruptHandler, &GicInstance);
+    if (XScuGic_Connect(&GicInstance, GENERIC_TIMER_INT_ID, GenericTimerIsr, NULL) != XST_SUCCESS) {
+        return 0;
+    }
+    XScuGic_Enable(&GicInstance, GENERIC_TIMER_INT_ID);
+    Xil_ExceptionEnable();
+    return 1;
+}
+
+bool bmt_platform_timer_irq_arm(uint64_t fire_at, bmt_platform_irq_handler_t handler) {
+    if (!GicReady) {
+        GicReady = GicSetup();
+        if (!GicReady) {
+            return false;
+        }
+    }
+    GenericTimerSetCtl(CNTP_CTL_IMASK);
+    __asm__ __volatile__("msr cntp_cval_el0, %0" : : "r"(fire_at) : "memory");
+    IrqHandler = handler;
+    GenericTimerSetCtl(CNTP_CTL_ENABLE);
+    return true;
+}
+
+void bmt_platform_timer_irq_cancel(void) {
+    GenericTimerSetCtl(CNTP_CTL_IMASK);
+    IrqHandler = NULL;
+}
+
+// inbyte() lo genera la BSP para el STDIN configurado, pero no lo declara en ninguna cabecera
+extern char inbyte(void);
+
+int bmt_platform_getchar(void) {
+    bmt_compress_flush();  // El host no responde hasta ver la trama pendiente
+    return (unsigned char)inbyte();
+}
@@ -1,35 +1,416 @@
 #include "bmt_platform_io.h"
 #include "xuartps.h"
-#include "xscutimer.h"
 #include "xparameters.h"
+#include "xtime_l.h"
+#include "xscugic.h"
+#include "xil_exception.h"
+#include "xil_io.h"
+#include "xil_mmu.h"
+#include "bmt_stress.h"
+#include "bmt_compress.h"
+#include "bmt_transport.h"
+#include "bmt_fuzz.h"
+#include "bmt_vclock.h"
+#include <string.h>
 
 
-#define TIMER_DEVICE_ID     XPAR_SCUTIMER_DEVICE_ID
+#define GIC_DEVICE_ID       XPAR_SCUGIC_SINGLE_DEVICE_ID
 
-static XScuTimer TimerInstance;
+// Registros del comparador del global timer (el mismo contador que lee XTime_GetTime)
+#define GTIMER_CONTROL      (XPS_GLOBAL_TMR_BASEADDR + 0x08U)
+#define GTIMER_ISR          (XPS_GLOBAL_TMR_BASEADDR + 0x0CU)
+#define GTIMER_COMP_LO      (XPS_GLOBAL_TMR_BASEADDR + 0x10U)
+#define GTIMER_COMP_HI      (XPS_GLOBAL_TMR_BASEADDR + 0x14U)
+#define GTIMER_CTRL_ENABLE  0x1U
+#define GTIMER_CTRL_COMP    0x2U
+#define GTIMER_CTRL_IRQ     0x4U
 
+static XScuGic GicInstance;
+static int GicReady = 0;
+static volatile bmt_platform_irq_handler_t IrqHandler = NULL;
+
+// Tabla de traducción de la BSP (translation_table.S): una entrada de sección por cada MB
+extern u32 MMUTable;
+
+#ifdef BMT_ZYNQ_SMP
+// CPU1 espera en la BootROM (WFE) hasta que se escribe su punto de entrada en esta dirección
+#define CPU1_START_ADDR     0xFFFFFFF0U
+#ifndef BMT_ZYNQ_CPU1_STACK_SIZE
+#define BMT_ZYNQ_CPU1_STACK_SIZE 0x4000U
+#endif
+static uint8_t Cpu1Stack[BMT_ZYNQ_CPU1_STACK_SIZE] __attribute__((aligned(16)));
+uint8_t *const Cpu1StackTop = &Cpu1Stack[BMT_ZYNQ_CPU1_STACK_SIZE];
+
+/**
+ * @brief Arranque de CPU1 en la misma imagen que CPU0 (SMP).
+ *
+ * Reutiliza la tabla de traducción que la BSP ya ha construido en CPU0, activa la
+ * coherencia con el SCU (ACTLR.SMP), las cachés y la MMU, y aparca el núcleo en
+ * bmt_stress_secondary_main(1) a la espera de STRESS_TEST.
+ */
+__attribute__((naked)) void Cpu1Start(void) {
+    __asm__ volatile(
+        "mov   r0, #0\n"
+        "mcr   p15, 0, r0, c8, c7, 0\n"      // Invalida TLB
+        "mcr   p15, 0, r0, c7, c5, 0\n"      // Invalida caché de instrucciones
+        "mov   r2, #0\n"                     // Invalida la D-cache L1 por set/way (4 vías, 256 sets de 32 B)
+        "1:    mov r1, #0\n"
+        "2:    orr r0, r1, r2, lsl #30\n"
+        "mcr   p15, 0, r0, c7, c6, 2\n"
+        "add   r1, r1, #32\n"
+        "cmp   r1, #0x2000\n"
+        "bne   2b\n"
+        "add   r2, r2, #1\n"
+        "cmp   r2, #4\n"
+        "bne   1b\n"
+        "ldr   r0, =MMUTable\n"
+        "orr   r0, r0, #0x5B\n"              // Mismos atributos de TTBR0 que boot.S
+        "mcr   p15, 0, r0, c2, c0, 0\n"
+        "mvn   r0, #0\n"
+        "mcr   p15, 0, r0, c3, c0, 0\n"      // DACR: todos los dominios en modo manager
+        "mrc   p15, 0, r0, c1, c0, 1\n"
+        "orr   r0, r0, #0x41\n"              // ACTLR: SMP + FW (coherente con CPU0)
+        "mcr   p15, 0, r0, c1, c0, 1\n"
+        "mrc   p15, 0, r0, c1, c0, 0\n"
+        "ldr   r1, =0x1805\n"                // SCTLR: MMU, D-cache, predicción de saltos, I-cache
+        "orr   r0, r0, r1\n"
+        "mcr   p15, 0, r0, c1, c0, 0\n"
+        "dsb\n"
+        "isb\n"
+        "ldr   r0, =Cpu1StackTop\n"
+        "ldr   sp, [r0]\n"
+        "mov   r0, #1\n"
+        "b     bmt_stress_secondary_main\n");
+}
+#endif
+
+
+// outbyte() e inbyte() los genera la BSP para el STDOUT/STDIN configurados (la UART), pero no
+// los declara en ninguna cabecera
+extern void outbyte(char c);
+extern char inbyte(void);
+
+/**
+ * @brief Envía un bloque de la salida (bmt_transport.h) por la UART, byte a byte.
+ */
+static void UartWrite(const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        outbyte((char)data[i]);
+    }
+}
+
+static int UartRead(void) {
+    return (unsigned char)inbyte();
+}
+
+static const bmt_transport_t UartTransport = { "uart", UartWrite, UartRead };
+
+#ifdef BMT_ZYNQ_TRANSPORT_LWIP
+// transport_lwip_zynq7000.c
+extern const bmt_transport_t *ZynqLwipTransportOpen(void);
+static int GicSetup(void);
+#endif
 
 void bmt_platform_io_init(void) {
+    // Toda la salida pasa por bmt_transport.h: main() debe llamar a bmt_transport_flush() al terminar
+    bmt_transport_set(&UartTransport);
 
-    XScuTimer_Config *TimerConfig = XScuTimer_LookupConfig(TIMER_DEVICE_ID);
-    int Status = XScuTimer_CfgInitialize(&TimerInstance, TimerConfig, TimerConfig->BaseAddr);
-    if (Status != XST_SUCCESS) {
-        return;
+#ifdef BMT_ZYNQ_SMP
+    // Despierta a CPU1: queda aparcado en bmt_stress_secondary_main() para los STRESS_TEST
+    Xil_Out32(CPU1_START_ADDR, (u32)Cpu1Start);
+    dmb();
+    __asm__ volatile("sev");
+#endif
+#ifdef BMT_ZYNQ_TRANSPORT_LWIP
+    // La GEM recibe por interrupción: el GIC tiene que estar listo antes de levantar la interfaz
+    GicReady = GicReady || GicSetup();
+    const bmt_transport_t *Network = GicReady ? ZynqLwipTransportOpen() : NULL;
+    if (Network != NULL) {
+        bmt_transport_set(Network);
+    } else {
+        bmt_platform_puts("BMT: no network transport, using the UART\r\n");
     }
-    XScuTimer_SetPrescaler(&TimerInstance, 0);
-    XScuTimer_LoadTimer(&TimerInstance, 0xFFFFFFFF);
-    XScuTimer_Start(&TimerInstance);
+#endif
+#ifdef BMT_ZYNQ_COMPRESS
+    // Salida comprimida: main() debe llamar a bmt_compress_flush() al terminar
+    bmt_compress_init(bmt_transport_write);
+#endif
 }
 
 void bmt_platform_putchar(char c) {
-    putchar(c);
+#ifdef BMT_ZYNQ_COMPRESS
+    bmt_compress_write(&c, 1);
+#else
+    bmt_transport_write((const uint8_t *)&c, 1);
+#endif
 }
 
 void bmt_platform_puts(const char *str) {
-	printf("%s", str);
+#ifdef BMT_ZYNQ_COMPRESS
+    bmt_compress_write(str, strlen(str));
+#else
+    bmt_transport_write((const uint8_t *)str, strlen(str));
+#endif
 }
 
 uint32_t bmt_platform_get_msec_ticks(void) {
-    uint32_t raw_ticks = XScuTimer_GetCounterValue(&TimerInstance);
-    return 0xFFFFFFFF - raw_ticks;
-}
\ No newline at end of file
+    // Mismo contador que bmt_platform_get_hires_ticks(): el reloj virtual no salta al activarse
+    return (uint32_t)(bmt_platform_get_hires_ticks() / (COUNTS_PER_SECOND / 1000u));
+}
+
+uint64_t bmt_platform_get_hires_ticks(void) {
+    uint64_t virtual_ticks;
+    if (bmt_vclock_read(&virtual_ticks)) {
+        return virtual_ticks;
+    }
+    XTime now;
+    XTime_GetTime(&now); // Global timer de 64 bits, no desborda durante una ejecución
+    return (uint64_t)now;
+}
+
+uint32_t bmt_platform_get_hires_tick_hz(void) {
+    return (uint32_t)COUNTS_PER_SECOND;
+}
+
+bool bmt_platform_cpu_info(bmt_platform_cpu_info_t *info) {
+    // Cortex-A9 de la Zynq-7000: L1 de 32 KB + 32 KB por núcleo y L2 (PL310) de 512 KB compartida
+    info->cpu_khz = (uint32_t)(XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / 1000U);
+    info->l1d_bytes = 32U * 1024U;
+    info->l1i_bytes = 32U * 1024U;
+    info->l2_bytes = 512U * 1024U;
+    info->line_bytes = 32U;
+    return true;
+}
+
+/**
+ * @brief ISR del comparador del global timer: lo desarma y llama al handler de BMT.
+ */
+static void GlobalTimerIsr(void *CallBackRef) {
+    (void)CallBackRef;
+    bmt_platform_irq_handler_t handler = IrqHandler;
+    IrqHandler = NULL;
+    // El handler se llama primero: su marca de tiempo de entrada es la que mide la latencia
+    if (handler) {
+        handler();
+    }
+    Xil_Out32(GTIMER_CONTROL, Xil_In32(GTIMER_CONTROL) & ~(GTIMER_CTRL_COMP | GTIMER_CTRL_IRQ));
+    Xil_Out32(GTIMER_ISR, 0x1U);
+}
+
+/**
+ * @brief Inicializa el GIC y conecta la interrupción del global timer (ID 27) la primera vez.
+ */
+static int GicSetup(void) {
+    XScuGic_Config *GicConfig = XScuGic_LookupConfig(GIC_DEVICE_ID);
+    if (GicConfig == NULL ||
+        XScuGic_CfgInitialize(&GicInstance, GicConfig, GicConfig->CpuBaseAddress) != XST_SUCCESS) {
+        return 0;
+    }
+    Xil_ExceptionInit();
+    Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT, (Xil_ExceptionHandler)XScuGic_InterruptHandler, &GicInstance);
+    if (XScuGic_Connect(&GicInstance, XPS_GLOBAL_TMR_INT_ID, GlobalTimerIsr, NULL) != XST_SUCCESS) {
+        return 0;
+    }
+    XScuGic_Enable(&GicInstance, XPS_GLOBAL_TMR_INT_ID);
+    Xil_ExceptionEnable();
+    return 1;
+}
+
+bool bmt_platform_timer_irq_arm(uint64_t fire_at, bmt_platform_irq_handler_t handler) {
+    if (!GicReady) {
+        GicReady = GicSetup();
+        if (!GicReady) {
+            return false;
+        }
+    }
+    // Comparador desactivado mientras se escribe el valor de 64 bits
+    uint32_t ctrl = Xil_In32(GTIMER_CONTROL) & ~(GTIMER_CTRL_COMP | GTIMER_CTRL_IRQ);
+    Xil_Out32(GTIMER_CONTROL, ctrl);
+    Xil_Out32(GTIMER_ISR, 0x1U);
+    Xil_Out32(GTIMER_COMP_LO, (uint32_t)fire_at);
+    Xil_Out32(GTIMER_COMP_HI, (uint32_t)(fire_at >> 32));
+    IrqHandler = handler;
+    Xil_Out32(GTIMER_CONTROL, ctrl | GTIMER_CTRL_ENABLE | GTIMER_CTRL_COMP | GTIMER_CTRL_IRQ);
+    return true;
+}
+
+void bmt_platform_timer_irq_cancel(void) {
+    Xil_Out32(GTIMER_CONTROL, Xil_In32(GTIMER_CONTROL) & ~(GTIMER_CTRL_COMP | GTIMER_CTRL_IRQ));
+    Xil_Out32(GTIMER_ISR, 0x1U);
+    IrqHandler = NULL;
+}
+
+#ifdef BMT_ZYNQ_SMP
+uint32_t bmt_platform_num_cores(void) {
+    return 2;
+}
+
+uint32_t bmt_platform_core_id(void) {
+    uint32_t mpidr;
+    __asm__ volatile("mrc p15, 0, %0, c0, c0, 5" : "=r"(mpidr));
+    return mpidr & 0x3U;
+}
+#endif
+
+int bmt_platform_getchar(void) {
+    bmt_compress_flush();  // El host no responde hasta ver la trama pendiente
+    return bmt_transport_getchar();
+}
+
+// Símbolos de la BSP: dirección que provocó la excepción (asm_vectors.S) y pilas de los modos (lscript.ld)
+extern u32 DataAbortAddr;
+extern u32 PrefetchAbortAddr;
+extern u32 UndefinedExceptionAddr;
+extern u8 __abort_stack;
+extern u8 __undef_stack;
+
+static const u32 FaultIds[] = {
+    XIL_EXCEPTION_ID_UNDEFINED_INT, XIL_EXCEPTION_ID_PREFETCH_ABORT_INT, XIL_EXCEPTION_ID_DATA_ABORT_INT
+};
+static XExc_VectorTableEntry FaultPrevious[sizeof(FaultIds) / sizeof(FaultIds[0])];
+
+/**
+ * @brief Sale del modo de la excepción hacia bmt_fuzz_fault(cause, address) sin volver.
+ *
+ * Deja la pila del modo abort/undef en su tope (el handler de la BSP no hará el ldmia) y
+ * vuelve al modo y a las máscaras de interrupción que tenía la CPU al fallar (SPSR sin el bit T,
+ * que msr no puede cambiar), cuya pila restaura el longjmp de bmt_fuzz_fault().
+ */
+__attribute__((naked)) static void FuzzFaultEscape(u32 cause, u32 address, u8 *exc_stack_top) {
+    __asm__ volatile(
+        "mov   sp, r2\n"
+        "mrs   r3, spsr\n"
+        "bic   r3, r3, #0x20\n"
+        "msr   cpsr_c, r3\n"
+        "b     bmt_fuzz_fault\n");
+}
+
+/**
+ * @brief Handler de data abort, prefetch abort e instrucción indefinida durante bmt_fuzz_serve().
+ *        Sin entrada en curso se comporta como el handler por defecto de la BSP (se queda parado).
+ */
+static void FuzzFaultHandler(void *Data) {
+    u32 id = (u32)(uintptr_t)Data;
+    if (!bmt_fuzz_fault_recoverable()) {
+        for (;;) {
+        }
+    }
+    if (id == XIL_EXCEPTION_ID_DATA_ABORT_INT) {
+        FuzzFaultEscape(id, DataAbortAddr, &__abort_stack);
+    } else if (id == XIL_EXCEPTION_ID_PREFETCH_ABORT_INT) {
+        FuzzFaultEscape(id, PrefetchAbortAddr, &__abort_stack);
+    } else {
+        FuzzFaultEscape(id, UndefinedExceptionAddr, &__undef_stack);
+    }
+}
+
+void bmt_platform_fuzz_fault_guard(bool enable) {
+    for (size_t i = 0; i < sizeof(FaultIds) / sizeof(FaultIds[0]); ++i) {
+        if (enable) {
+            FaultPrevious[i] = XExc_VectorTable[FaultIds[i]];
+            Xil_ExceptionRegisterHandler(FaultIds[i], FuzzFaultHandler, (void *)(uintptr_t)FaultIds[i]);
+        } else {
+            Xil_ExceptionRegisterHandler(FaultIds[i], FaultPrevious[i].Handler, FaultPrevious[i].Data);
+        }
+    }
+}
+
+#define SECTION_SIZE        0x100000U
+#define SECTION_ATTR_MASK   0x000FFFFFU
+
+/** @brief Guardas de la pila del test protegidas, con los atributos que tenía su sección. */
+static struct {
+    uintptr_t Addr;
+    u32 Attr;
+} StackGuard[2];
+static u32 StackGuards = 0U;
+static XExc_VectorTableEntry StackPrevious;
+
+/**
+ * @brief Sale del modo abort hacia bmt_stack_fault() sin volver, como FuzzFaultEscape(), pero
+ *        cambiando además la pila del modo interrumpido por `safe_sp`: la del test está agotada.
+ */
+__attribute__((naked)) static void StackFaultEscape(u32 safe_sp, u8 *exc_stack_top) {
+    __asm__ volatile(
+        "mov   sp, r1\n"
+        "mrs   r3, spsr\n"
+        "bic   r3, r3, #0x20\n"
+        "msr   cpsr_c, r3\n"
+        "mov   sp, r0\n"
+        "b     bmt_stack_fault\n");
+}
+
+/**
+ * @brief Handler de data abort mientras hay guardas de pila: un acceso a una guarda falla el
+ *        test en curso; cualquier otro fallo va al handler anterior.
+ */
+static void StackFaultHandler(void *Data) {
+    (void)Data;
+    uintptr_t safe_sp = bmt_stack_guard_hit(DataAbortAddr);
+    if (safe_sp != 0U) {
+        StackFaultEscape((u32)safe_sp, &__abort_stack);
+    }
+    StackPrevious.Handler(StackPrevious.Data);
+}
+
+bool bmt_platform_stack_guard(void *base, size_t size, bool enable) {
+    // La tabla de la BSP solo tiene secciones de 1 MB: cada guarda debe ser una sección entera
+    // (-DBMT_TEST_STACK_GUARD_SIZE=0x100000U; el pool, de algo más de 2 MB, va en DDR)
+    uintptr_t addr = (uintptr_t)base;
+    if ((addr & SECTION_ATTR_MASK) != 0U || size != SECTION_SIZE) {
+        return false;
+    }
+    if (enable) {
+        if (StackGuards == 2U) {
+            return false;
+        }
+        StackGuard[StackGuards].Addr = addr;
+        StackGuard[StackGuards].Attr = (&MMUTable)[addr >> 20] & SECTION_ATTR_MASK;
+        if (StackGuards++ == 0U) {
+            StackPrevious = XExc_VectorTable[XIL_EXCEPTION_ID_DATA_ABORT_INT];
+            Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_DATA_ABORT_INT, StackFaultHandler, NULL);
+        }
+        Xil_SetTlbAttributes(addr, 0U);  // Descriptor de tipo "fault": sin acceso
+        return true;
+    }
+    for (u32 i = 0U; i < StackGuards; ++i) {
+        if (StackGuard[i].Addr == addr) {
+            Xil_SetTlbAttributes(addr, StackGuard[i].Attr);
+            StackGuard[i] = StackGuard[--StackGuards];
+            if (StackGuards == 0U) {
+                Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_DATA_ABORT_INT, StackPrevious.Handler, StackPrevious.Data);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Regiones de los tests de RAM (bmt_memtest.h): la parte de la DDR que no usa el
+ *        programa (`BMT_ZYNQ_MEMTEST_DDR_BASE`/`_SIZE`) y la OCM (`BMT_ZYNQ_MEMTEST_OCM_BASE`/`_SIZE`,
+ *        p. ej. 0xFFFC0000 y 0x40000 si el programa no la usa).
+ */
+static const struct {
+    const char *Name;
+    uintptr_t Base;
+    size_t Size;
+} MemTestRegions[] = {
+#if defined(BMT_ZYNQ_MEMTEST_DDR_BASE) && defined(BMT_ZYNQ_MEMTEST_DDR_SIZE)
+    { "DDR", BMT_ZYNQ_MEMTEST_DDR_BASE, BMT_ZYNQ_MEMTEST_DDR_SIZE },
+#endif
+#if defined(BMT_ZYNQ_MEMTEST_OCM_BASE) && defined(BMT_ZYNQ_MEMTEST_OCM_SIZE)
+    { "OCM", BMT_ZYNQ_MEMTEST_OCM_BASE, BMT_ZYNQ_MEMTEST_OCM_SIZE },
+#endif
+    { NULL, 0U, 0U }
+};
+
+bool bmt_platform_memtest_region(uint32_t index, const char **name, void **base, size_t *size) {
+    if (index >= sizeof(MemTestRegions) / sizeof(MemTestRegions[0]) - 1U) {
+        return false;
+    }
+    *name = MemTestRegions[index].Name;
+    *base = (void *)MemTestRegions[index].Base;
+    *size = MemTestRegions[index].Size;
+    return true;
+}
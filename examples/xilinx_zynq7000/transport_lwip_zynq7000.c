@@ -0,0 +1,247 @@
+/**
+ * @file transport_lwip_zynq7000.c
+ * @brief Transporte de la salida (`bmt_transport.h`) por Ethernet para Zynq-7000, con la API raw
+ *        de lwIP (sin RTOS, `NO_SYS=1`) sobre la GEM del PS.
+ *
+ * Se compila con `-DBMT_ZYNQ_TRANSPORT_LWIP` y la biblioteca lwip211 en la BSP. La placa es
+ * cliente: se conecta por TCP al parser (`parse_bmt_output.py --listen PUERTO`), o le envía
+ * datagramas UDP con `-DBMT_ZYNQ_LWIP_UDP` (`--listen PUERTO --udp`). El parser debe estar
+ * escuchando antes de arrancar la placa.
+ *
+ * No hay hilo de red: lwIP avanza (recepción, ACK, retransmisiones, ARP) solo mientras la placa
+ * escribe o espera una lectura. Un test que cuelga sin imprimir deja de retransmitir, pero lo ya
+ * enviado ha salido por el cable en cuanto se escribió.
+ */
+
+#ifdef BMT_ZYNQ_TRANSPORT_LWIP
+
+#include "bmt_transport.h"
+#include "xparameters.h"
+#include "xtime_l.h"
+#include "netif/xadapter.h"
+#include "lwip/init.h"
+#include "lwip/tcp.h"
+#include "lwip/udp.h"
+#include "lwip/etharp.h"
+#include "lwip/priv/tcp_priv.h"
+#include <string.h>
+
+/** @brief IP del PC donde escucha el parser. */
+#ifndef BMT_ZYNQ_LWIP_HOST_IP
+#define BMT_ZYNQ_LWIP_HOST_IP "192.168.1.100"
+#endif
+/** @brief Puerto del parser. */
+#ifndef BMT_ZYNQ_LWIP_PORT
+#define BMT_ZYNQ_LWIP_PORT 5555
+#endif
+/** @brief IP estática de la placa (sin DHCP: el arranque no depende de un servidor). */
+#ifndef BMT_ZYNQ_LWIP_BOARD_IP
+#define BMT_ZYNQ_LWIP_BOARD_IP "192.168.1.10"
+#endif
+#ifndef BMT_ZYNQ_LWIP_NETMASK
+#define BMT_ZYNQ_LWIP_NETMASK "255.255.255.0"
+#endif
+#ifndef BMT_ZYNQ_LWIP_GATEWAY
+#define BMT_ZYNQ_LWIP_GATEWAY "192.168.1.1"
+#endif
+/** @brief MAC de la placa (prefijo de Xilinx, como en los ejemplos de lwIP). */
+#ifndef BMT_ZYNQ_LWIP_MAC
+#define BMT_ZYNQ_LWIP_MAC { 0x00, 0x0a, 0x35, 0x00, 0x01, 0x02 }
+#endif
+/** @brief Tiempo máximo para conectar con el parser; después se usa la UART. */
+#ifndef BMT_ZYNQ_LWIP_CONNECT_MS
+#define BMT_ZYNQ_LWIP_CONNECT_MS 10000U
+#endif
+
+#define MS_TO_COUNTS(ms)    ((XTime)COUNTS_PER_SECOND * (ms) / 1000U)
+
+static struct netif Netif;
+static XTime LastTcpTimer;
+static XTime LastArpTimer;
+
+/**
+ * @brief Procesa los paquetes recibidos y los timers de TCP y ARP. Se llama en todas las esperas.
+ */
+static void LwipPoll(void) {
+    xemacif_input(&Netif);
+    XTime Now;
+    XTime_GetTime(&Now);
+    if (Now - LastTcpTimer >= MS_TO_COUNTS(TCP_TMR_INTERVAL)) {
+        LastTcpTimer = Now;
+        tcp_tmr();
+    }
+    if (Now - LastArpTimer >= MS_TO_COUNTS(ARP_TMR_INTERVAL)) {
+        LastArpTimer = Now;
+        etharp_tmr();
+    }
+}
+
+#ifndef BMT_ZYNQ_LWIP_UDP
+
+static struct tcp_pcb *TcpPcb = NULL;
+/** @brief 0 conectando, 1 conectado, -1 cerrado o error. */
+static volatile int TcpState = 0;
+/** @brief Bytes recibidos del host aún no leídos (respuestas de fuzzing, entradas interactivas). */
+static uint8_t RxBuf[256];
+static uint32_t RxHead = 0U;
+static uint32_t RxTail = 0U;
+
+static err_t TcpConnected(void *Arg, struct tcp_pcb *Pcb, err_t Err) {
+    (void)Arg;
+    (void)Pcb;
+    TcpState = (Err == ERR_OK) ? 1 : -1;
+    return ERR_OK;
+}
+
+static void TcpError(void *Arg, err_t Err) {
+    (void)Arg;
+    (void)Err;
+    TcpPcb = NULL;  // lwIP ya ha liberado el PCB
+    TcpState = -1;
+}
+
+static err_t TcpReceived(void *Arg, struct tcp_pcb *Pcb, struct pbuf *P, err_t Err) {
+    (void)Arg;
+    (void)Err;
+    if (P == NULL) {
+        TcpState = -1;  // El host ha cerrado
+        return ERR_OK;
+    }
+    if (P->tot_len > sizeof(RxBuf) - (RxHead - RxTail)) {
+        return ERR_MEM;  // No cabe: lwIP lo guarda y lo vuelve a entregar cuando la placa lea
+    }
+    for (struct pbuf *Q = P; Q != NULL; Q = Q->next) {
+        for (u16_t i = 0U; i < Q->len; ++i) {
+            RxBuf[RxHead++ % sizeof(RxBuf)] = ((const uint8_t *)Q->payload)[i];
+        }
+    }
+    tcp_recved(Pcb, P->tot_len);
+    pbuf_free(P);
+    return ERR_OK;
+}
+
+static void TcpWrite(const uint8_t *data, size_t size) {
+    while (size > 0U && TcpState == 1) {
+        u16_t Room = tcp_sndbuf(TcpPcb);
+        u16_t Chunk = (size < Room) ? (u16_t)size : Room;
+        if (Chunk == 0U || tcp_write(TcpPcb, data, Chunk, TCP_WRITE_FLAG_COPY) != ERR_OK) {
+            LwipPoll();  // Cola de envío llena: espera a los ACK
+            continue;
+        }
+        data += Chunk;
+        size -= Chunk;
+    }
+    if (TcpState == 1) {
+        tcp_output(TcpPcb);
+    }
+    LwipPoll();
+}
+
+static int TcpRead(void) {
+    while (RxHead == RxTail && TcpState == 1) {
+        LwipPoll();
+    }
+    if (RxHead == RxTail) {
+        return -1;
+    }
+    return RxBuf[RxTail++ % sizeof(RxBuf)];
+}
+
+static const bmt_transport_t TcpTransport = { "tcp", TcpWrite, TcpRead };
+
+#else // BMT_ZYNQ_LWIP_UDP
+
+static struct udp_pcb *UdpPcb = NULL;
+/** @brief Número de secuencia del siguiente datagrama (BMT_TRANSPORT_UDP_HEADER). */
+static u16_t UdpSeq = 0U;
+
+static void UdpWrite(const uint8_t *data, size_t size) {
+    while (size > 0U) {
+        size_t Chunk = (size < BMT_TRANSPORT_BUFFER) ? size : BMT_TRANSPORT_BUFFER;
+        struct pbuf *P = pbuf_alloc(PBUF_TRANSPORT, (u16_t)(BMT_TRANSPORT_UDP_HEADER + Chunk), PBUF_RAM);
+        if (P == NULL) {
+            LwipPoll();  // Sin pbufs: espera a que el DMA libere los enviados
+            continue;
+        }
+        uint8_t *Payload = (uint8_t *)P->payload;
+        Payload[0] = (uint8_t)(UdpSeq >> 8);
+        Payload[1] = (uint8_t)UdpSeq;
+        memcpy(Payload + BMT_TRANSPORT_UDP_HEADER, data, Chunk);
+        udp_send(UdpPcb, P);
+        pbuf_free(P);
+        UdpSeq++;
+        data += Chunk;
+        size -= Chunk;
+    }
+    LwipPoll();
+}
+
+static const bmt_transport_t UdpTransport = { "udp", UdpWrite, NULL };
+
+#endif // BMT_ZYNQ_LWIP_UDP
+
+/**
+ * @brief Levanta la interfaz y conecta con el parser. Necesita el GIC inicializado y las
+ *        excepciones habilitadas (la GEM recibe por interrupción).
+ * @return El transporte, o NULL si no se ha podido conectar (el llamador usa la UART).
+ */
+const bmt_transport_t *ZynqLwipTransportOpen(void) {
+    static const unsigned char Mac[6] = BMT_ZYNQ_LWIP_MAC;
+    ip_addr_t BoardIp, Netmask, Gateway, HostIp;
+    if (!ipaddr_aton(BMT_ZYNQ_LWIP_BOARD_IP, &BoardIp) || !ipaddr_aton(BMT_ZYNQ_LWIP_NETMASK, &Netmask) ||
+        !ipaddr_aton(BMT_ZYNQ_LWIP_GATEWAY, &Gateway) || !ipaddr_aton(BMT_ZYNQ_LWIP_HOST_IP, &HostIp)) {
+        return NULL;
+    }
+
+    lwip_init();
+    // xemac_add() espera a la autonegociación del PHY
+    if (xemac_add(&Netif, &BoardIp, &Netmask, &Gateway, (unsigned char *)Mac, XPAR_XEMACPS_0_BASEADDR) == NULL) {
+        return NULL;
+    }
+    netif_set_default(&Netif);
+    netif_set_up(&Netif);
+    XTime_GetTime(&LastTcpTimer);
+    LastArpTimer = LastTcpTimer;
+
+#ifdef BMT_ZYNQ_LWIP_UDP
+    UdpPcb = udp_new();
+    if (UdpPcb == NULL || udp_connect(UdpPcb, &HostIp, BMT_ZYNQ_LWIP_PORT) != ERR_OK) {
+        return NULL;
+    }
+    etharp_request(&Netif, &HostIp);  // Resuelve la MAC del host antes del primer datagrama
+    XTime Start, Now;
+    XTime_GetTime(&Start);
+    do {
+        LwipPoll();
+        XTime_GetTime(&Now);
+    } while (Now - Start < MS_TO_COUNTS(100U));
+    return &UdpTransport;
+#else
+    TcpPcb = tcp_new();
+    if (TcpPcb == NULL) {
+        return NULL;
+    }
+    tcp_err(TcpPcb, TcpError);
+    tcp_recv(TcpPcb, TcpReceived);
+    tcp_nagle_disable(TcpPcb);  // Cada envío sale ya: el buffer de bmt_transport.h agrupa las líneas
+    if (tcp_connect(TcpPcb, &HostIp, BMT_ZYNQ_LWIP_PORT, TcpConnected) != ERR_OK) {
+        tcp_abort(TcpPcb);
+        TcpPcb = NULL;
+        return NULL;
+    }
+    XTime Start, Now;
+    XTime_GetTime(&Start);
+    while (TcpState == 0) {
+        LwipPoll();
+        XTime_GetTime(&Now);
+        if (Now - Start >= MS_TO_COUNTS(BMT_ZYNQ_LWIP_CONNECT_MS)) {
+            tcp_abort(TcpPcb);
+            TcpPcb = NULL;
+            TcpState = -1;
+        }
+    }
+    return (TcpState == 1) ? &TcpTransport : NULL;
+#endif
+}
+
+#endif // BMT_ZYNQ_TRANSPORT_LWIP
@@ -11,23 +11,100 @@
 #define BAREMETAL_TEST_H
 
 #include <stdbool.h>
-#include <setjmp.h>     
 #include "bmt_platform_io.h"
 
+/**
+ * @def BMT_FREESTANDING
+ * @brief Define it (`-DBMT_FREESTANDING`) to build the runner without the C library, e.g. with
+ *        `-ffreestanding -nostdlib`: the string assertions use the framework's own routines
+ *        (bmt_strcmp() and family), the floating-point ones use compiler built-ins, and
+ *        ASSERT_* unwinds with `__builtin_setjmp()` / `__builtin_longjmp()`.
+ */
+#ifdef BMT_FREESTANDING
+typedef void* bmt_jmp_buf[5];
+#define bmt_setjmp(env)       __builtin_setjmp(env)
+#define bmt_longjmp(env, val) __builtin_longjmp(env, 1)
+#define BMT_STRCMP(s1, s2)        bmt_strcmp((s1), (s2))
+#define BMT_STRNCMP(s1, s2, n)    bmt_strncmp((s1), (s2), (n))
+#define BMT_STRCASECMP(s1, s2)    bmt_strcasecmp((s1), (s2))
+#define BMT_FABS(x)               __builtin_fabs(x)
+#define BMT_FABSF(x)              __builtin_fabsf(x)
+#else
+#include <setjmp.h>
+typedef jmp_buf bmt_jmp_buf;
+#define bmt_setjmp(env)       setjmp(env)
+#define bmt_longjmp(env, val) longjmp(env, val)
+#define BMT_STRCMP(s1, s2)        strcmp((s1), (s2))
+#define BMT_STRNCMP(s1, s2, n)    strncmp((s1), (s2), (n))
+#define BMT_STRCASECMP(s1, s2)    strcasecmp((s1), (s2))
+#define BMT_FABS(x)               fabs(x)
+#define BMT_FABSF(x)              fabsf(x)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Version of the framework, printed in the run metadata. Matches PROJECT_NUMBER in the Doxyfile.
+ */
+#define BMT_VERSION "1.0"
+
+/**
+ * @def BMT_BUILD_GIT_SHA
+ * @brief Commit of the image, printed in the run metadata when defined while building
+ *        bmt_runner.c (e.g. `-DBMT_BUILD_GIT_SHA="\"$(git rev-parse --short HEAD)\""`).
+ *
+ * @def BMT_BUILD_FLAGS
+ * @brief Compiler flags of the image, printed in the run metadata when defined while building
+ *        bmt_runner.c (e.g. `-DBMT_BUILD_FLAGS="\"$CFLAGS\""`).
+ */
+
 /**
  * @brief Maximum number of test cases that can be registered.
+ * Can be overridden from the build (e.g. `-DBMT_MAX_TEST_CASES=256`).
  */
+#ifndef BMT_MAX_TEST_CASES
 #define BMT_MAX_TEST_CASES 64
+#endif
 
 /**
- * @brief Maximum length of a test case name.
+ * @brief Maximum length of a test case name. Longer names are truncated.
  */
+#ifndef BMT_MAX_TEST_NAME_LEN
 #define BMT_MAX_TEST_NAME_LEN 64
+#endif
 
 /**
- * @brief Maximum length of a test suite name.
+ * @brief Maximum length of a test suite name. Longer names are truncated.
  */
+#ifndef BMT_MAX_SUITE_NAME_LEN
 #define BMT_MAX_SUITE_NAME_LEN 64
+#endif
+
+/**
+ * @brief Size in bytes of the dedicated stack each test runs on, or 0 to run the tests on the
+ *        runner's own stack (default).
+ *
+ * With a size, bmt_run_all_tests() switches every test onto a stack carved from a static pool,
+ * between two guard regions of BMT_TEST_STACK_GUARD_SIZE bytes that bmt_platform_stack_guard()
+ * makes inaccessible. An overflow faults in the lower guard and fails the test with
+ * "STACK OVERFLOW" instead of corrupting the runner; without platform support the guards are
+ * checked as canaries after the test. Each test prints its peak stack usage. Supported on
+ * x86-64, AArch64 and AArch32. Must be a multiple of 16.
+ */
+#ifndef BMT_TEST_STACK_SIZE
+#define BMT_TEST_STACK_SIZE 0
+#endif
+
+/**
+ * @brief Size and alignment of each guard region around the test stack: a power of two and
+ *        the granule the platform can protect (a 4 KiB page on Linux, a 1 MiB section with the
+ *        Zynq-7000 BSP translation table, 32 B for an ARMv7-M MPU region).
+ */
+#ifndef BMT_TEST_STACK_GUARD_SIZE
+#define BMT_TEST_STACK_GUARD_SIZE 4096
+#endif
 
 /**
  * @brief Typedef for a test function pointer.
@@ -36,6 +113,30 @@
  */
 typedef void (*bmt_test_func_ptr_t)(void);
 
+/**
+ * @brief Name of the linker section holding constant test descriptors (bmt_test_desc_t).
+ *
+ * Tests placed there (the C++ TEST of baremetal_test.hpp) need no static constructor:
+ * bmt_run_all_tests() registers them from the section, between the `__start_bmt_tests` and
+ * `__stop_bmt_tests` symbols that GNU ld defines for it. A linker script that places the
+ * section itself must define both symbols and `KEEP()` it.
+ *
+ * The tests of each source file run in declaration order (by `sequence`), whatever order the
+ * compiler emits their descriptors in (g++ emits them in reverse).
+ */
+#define BMT_TEST_SECTION "bmt_tests"
+
+/**
+ * @brief Constant descriptor of a test, as stored in BMT_TEST_SECTION.
+ */
+typedef struct {
+    const char* suite_name;   /**< Name of the test suite. */
+    const char* test_name;    /**< Name of the test case. */
+    bmt_test_func_ptr_t func; /**< Pointer to the test function. */
+    const void* unit;         /**< Any address unique to the source file: descriptors are ordered per file. */
+    unsigned sequence;        /**< Increasing within the file (`__COUNTER__`): declaration order. */
+} bmt_test_desc_t;
+
 /**
  * @struct bmt_test_case_t
  * @brief Structure to hold information about a single test case.
@@ -89,13 +190,46 @@ void bmt_report_failure(const char* file, int line, const char* assertion_type,
  */
 void bmt_terminate_current_test(void);
 
+/**
+ * @brief Runs `func(ctx)` with the failure state of the current test isolated: the failures of
+ *        its EXPECT_* and ASSERT_* (an ASSERT_* comes back here) are neither printed nor counted
+ *        for the test. For code that fails on purpose, e.g. a benchmark of the failure path.
+ *        Defined in src/bmt_isolate.c, so the runner alone does not carry it.
+ * @param func Function to run.
+ * @param ctx Passed to `func`.
+ * @return true if `func` did not fail.
+ */
+bool bmt_run_isolated(void (*func)(void* ctx), void* ctx);
+
+/**
+ * @brief Tells the platform's fault handler (MMU abort, SIGSEGV...) whether a fault at
+ *        `address` is an overflow of the running test's stack (BMT_TEST_STACK_SIZE).
+ * @param address Faulting data address.
+ * @return 0 if it is not; otherwise a stack pointer on which bmt_stack_fault() can be called,
+ *         since the overflowed stack cannot take another frame.
+ */
+uintptr_t bmt_stack_guard_hit(uintptr_t address);
+
+/**
+ * @brief Ends the current test as a "STACK OVERFLOW" failure. Called by the platform's fault
+ *        handler after bmt_stack_guard_hit(), in the interrupted mode (not the exception mode)
+ *        and on the stack it returned or an alternate signal stack. Does not return.
+ */
+void bmt_stack_fault(void);
+
+/**
+ * @brief Number of tests that have overflowed their stack so far (BMT_TEST_STACK_SIZE), counted
+ *        by the runner when it reports the overflow. Always 0 without per-test stacks.
+ */
+uint32_t bmt_test_stack_overflows(void);
+
 /**
  * @brief Jump buffer used for handling assertion failures.
  *
  * When an ASSERT_* macro fails, it calls bmt_terminate_current_test(),
  * which uses this buffer to longjmp back to the test runner.
  */
-extern jmp_buf g_bmt_assert_jmp_buf;
+extern bmt_jmp_buf g_bmt_assert_jmp_buf;
 
 /**
  * @brief Flag indicating if the current test has failed an EXPECT_* macro.
@@ -105,6 +239,35 @@ extern jmp_buf g_bmt_assert_jmp_buf;
  */
 extern bool g_bmt_current_test_failed_expect;
 
+/**
+ * @brief True while a C++ TEST body (baremetal_test.hpp) runs directly under the runner, so a
+ *        failed ASSERT_* may unwind it (BMT_CPP_ASSERT_MODE) instead of calling
+ *        bmt_terminate_current_test(). Modules that run test code under their own
+ *        bmt_setjmp() (PROPERTY, FUZZ_TEST, STRESS_TEST) clear it meanwhile.
+ */
+extern bool g_bmt_assert_unwinds;
+
+/**
+ * @brief String length, reading a machine word at a time once aligned.
+ */
+size_t bmt_strlen(const char* s);
+
+/**
+ * @brief Like strcmp(): compares a machine word at a time when both strings share alignment.
+ * @return <0, 0 or >0 as `s1` sorts before, equal to or after `s2` (bytes as unsigned char).
+ */
+int bmt_strcmp(const char* s1, const char* s2);
+
+/**
+ * @brief Like strncmp(): compares at most `n` characters.
+ */
+int bmt_strncmp(const char* s1, const char* s2, size_t n);
+
+/**
+ * @brief Like strcasecmp(): compares ignoring ASCII case.
+ */
+int bmt_strcasecmp(const char* s1, const char* s2);
+
 // --- Macros para el Usuario ---
 
 /**
@@ -132,11 +295,50 @@ extern bool g_bmt_current_test_failed_expect;
     } \
     static void bmt_test_##TestSuiteName##_##TestName(void)
 
+/**
+ * @internal
+ * @brief Non-zero if `x` is an integer constant expression (e.g. `sizeof(hdr_t) == 16`), without
+ *        evaluating it: only then is `(void*)((long)(x) * 0l)` a null pointer constant, which
+ *        makes the conditional expression an `int*` instead of a `void*`. (`__extension__` hides the
+ *        `sizeof(void)` of the other case from -Wpedantic.)
+ */
+#define BMT_IS_ICE(x) (__extension__(sizeof(int) == sizeof(*(8 ? ((void*)((long)(x) * 0l)) : (int*)8))))
+
+/**
+ * @internal
+ * @brief Checks at compile time an assertion whose condition is a constant expression, such as
+ *        `ASSERT_EQ(sizeof(hdr_t), 16)` or a table length: if false, the build stops with the
+ *        text of the assertion ("ASSERT_EQ(sizeof(hdr_t) == 16) is always false"); if true,
+ *        the runtime check folds away and leaves no code or strings. Any other condition is
+ *        left to the runtime check. It does not depend on the optimization level: C checks
+ *        for an integer constant expression (BMT_IS_ICE), C++ for a constant expression.
+ */
+#ifdef __cplusplus
+#define BMT_CONSTANT_CHECK(condition, assertion_type, expr_str) \
+    static_assert(__builtin_constant_p(!!(condition)) ? !!(condition) : true, \
+                  assertion_type "(" expr_str ") is always false")
+#else
+#define BMT_CONSTANT_CHECK(condition, assertion_type, expr_str) \
+    _Static_assert(__builtin_choose_expr(BMT_IS_ICE(condition), !!(condition), 1), \
+                   assertion_type "(" expr_str ") is always false")
+#endif
+
 /**
  * @brief Internal common logic for ASSERT_* macros.
  * Reports a failure if the condition is false and terminates the test.
  */
 #define BMT_ASSERT_COMMON(condition, assertion_type, expr_str, ...) \
+    do { \
+        BMT_CONSTANT_CHECK(condition, assertion_type, expr_str); \
+        BMT_ASSERT_RUNTIME(condition, assertion_type, expr_str, ##__VA_ARGS__); \
+    } while (0)
+
+/**
+ * @internal
+ * @brief Runtime part of BMT_ASSERT_COMMON. FAIL() uses it alone, since its condition is
+ *        constant false on purpose.
+ */
+#define BMT_ASSERT_RUNTIME(condition, assertion_type, expr_str, ...) \
     do { \
         if (!(condition)) { \
             bmt_report_failure(__FILE__, __LINE__, assertion_type, expr_str, ##__VA_ARGS__); \
@@ -255,7 +457,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param s2 The second string.
  */
 #define ASSERT_STREQ(s1, s2) \
-    BMT_ASSERT_COMMON(((s1) != NULL && (s2) != NULL && strcmp((s1), (s2)) == 0), "ASSERT_STREQ", #s1 " STREQ " #s2, \
+    BMT_ASSERT_COMMON(((s1) != NULL && (s2) != NULL && BMT_STRCMP((s1), (s2)) == 0), "ASSERT_STREQ", #s1 " STREQ " #s2, \
                       "Expected: \"%s\", Actual: \"%s\"", (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 /**
@@ -266,7 +468,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param s2 The second string.
  */
 #define ASSERT_STRNE(s1, s2) \
-    BMT_ASSERT_COMMON(!((s1) != NULL && (s2) != NULL && strcmp((s1), (s2)) == 0), "ASSERT_STRNE", #s1 " STRNE " #s2, \
+    BMT_ASSERT_COMMON(!((s1) != NULL && (s2) != NULL && BMT_STRCMP((s1), (s2)) == 0), "ASSERT_STRNE", #s1 " STRNE " #s2, \
                       "Expected strings to be different. s1: \"%s\", s2: \"%s\"", (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 /**
@@ -277,7 +479,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param s2 The second string.
  */
 #define ASSERT_STRCASEEQ(s1, s2) \
-    BMT_ASSERT_COMMON(((s1) != NULL && (s2) != NULL && strcasecmp((s1), (s2)) == 0), "ASSERT_STRCASEEQ", #s1 " STRCASEEQ " #s2, \
+    BMT_ASSERT_COMMON(((s1) != NULL && (s2) != NULL && BMT_STRCASECMP((s1), (s2)) == 0), "ASSERT_STRCASEEQ", #s1 " STRCASEEQ " #s2, \
                       "Expected (ignore case): \"%s\", Actual: \"%s\"", (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 /**
@@ -288,7 +490,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param s2 The second string.
  */
 #define ASSERT_STRCASENE(s1, s2) \
-    BMT_ASSERT_COMMON(!((s1) != NULL && (s2) != NULL && strcasecmp((s1), (s2)) == 0), "ASSERT_STRCASENE", #s1 " STRCASENE " #s2, \
+    BMT_ASSERT_COMMON(!((s1) != NULL && (s2) != NULL && BMT_STRCASECMP((s1), (s2)) == 0), "ASSERT_STRCASENE", #s1 " STRCASENE " #s2, \
                       "Expected strings to be different (ignore case). s1: \"%s\", s2: \"%s\"", (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 // Versiones con N caracteres (requieren strncmp, strncasecmp)
@@ -302,7 +504,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param n The number of characters to compare.
  */
 #define ASSERT_STRNEQ(s1, s2, n) \
-    BMT_ASSERT_COMMON(((s1) != NULL && (s2) != NULL && strncmp((s1), (s2), (n)) == 0), "ASSERT_STRNEQ", #s1 " STRNEQ(" #n ") " #s2, \
+    BMT_ASSERT_COMMON(((s1) != NULL && (s2) != NULL && BMT_STRNCMP((s1), (s2), (n)) == 0), "ASSERT_STRNEQ", #s1 " STRNEQ(" #n ") " #s2, \
                       "Expected first %u chars: \"%s\", Actual: \"%s\"", (unsigned int)(n), (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 /**
@@ -314,7 +516,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param n The number of characters to compare.
  */
 #define ASSERT_STRNNE(s1, s2, n) \
-    BMT_ASSERT_COMMON(!((s1) != NULL && (s2) != NULL && strncmp((s1), (s2), (n)) == 0), "ASSERT_STRNNE", #s1 " STRNNE(" #n ") " #s2, \
+    BMT_ASSERT_COMMON(!((s1) != NULL && (s2) != NULL && BMT_STRNCMP((s1), (s2), (n)) == 0), "ASSERT_STRNNE", #s1 " STRNNE(" #n ") " #s2, \
                       "Expected first %u chars of strings to be different. s1: \"%s\", s2: \"%s\"", (unsigned int)(n), (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 // **Aserciones de Punto Flotante (Requieren fabsf/fabs y soporte %f/%g en bmt_report_failure)**
@@ -361,9 +563,9 @@ extern bool g_bmt_current_test_failed_expect;
  * @param abs_error The maximum allowed absolute difference.
  */
 #define ASSERT_NEAR(val1, val2, abs_error) \
-    BMT_ASSERT_COMMON(fabs((val1) - (val2)) <= fabs(abs_error), "ASSERT_NEAR", #val1 " NEAR " #val2 ", error " #abs_error, \
+    BMT_ASSERT_COMMON(BMT_FABS((val1) - (val2)) <= BMT_FABS(abs_error), "ASSERT_NEAR", #val1 " NEAR " #val2 ", error " #abs_error, \
                       "Value1: %g, Value2: %g, Diff: %g, Max Abs Error: %g", \
-                      (double)(val1), (double)(val2), fabs((double)(val1) - (double)(val2)), fabs((double)(abs_error)))
+                      (double)(val1), (double)(val2), BMT_FABS((double)(val1) - (double)(val2)), BMT_FABS((double)(abs_error)))
 
 // Para floats especÃ­ficamente (usa fabsf si estÃ¡ disponible y es diferente de fabs)
 
@@ -377,9 +579,9 @@ extern bool g_bmt_current_test_failed_expect;
  * @param abs_error The maximum allowed absolute difference (as a float).
  */
 #define ASSERT_FLOAT_NEAR(val1, val2, abs_error) \
-    BMT_ASSERT_COMMON(fabsf((val1) - (val2)) <= fabsf(abs_error), "ASSERT_FLOAT_NEAR", #val1 " NEAR " #val2 ", error " #abs_error, \
+    BMT_ASSERT_COMMON(BMT_FABSF((val1) - (val2)) <= BMT_FABSF(abs_error), "ASSERT_FLOAT_NEAR", #val1 " NEAR " #val2 ", error " #abs_error, \
                       "Value1: %f, Value2: %f, Diff: %f, Max Abs Error: %f", \
-                      (float)(val1), (float)(val2), fabsf((float)(val1) - (float)(val2)), fabsf((float)(abs_error)))
+                      (float)(val1), (float)(val2), BMT_FABSF((float)(val1) - (float)(val2)), BMT_FABSF((float)(abs_error)))
 
 // **Aserciones de Fallo ExplÃ­cito**
 
@@ -388,7 +590,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @brief Explicitly fails the current test.
  * This macro will always terminate the current test case.
  */
-#define FAIL() BMT_ASSERT_COMMON(0, "FAIL", "Explicit failure triggered by FAIL()", NULL)
+#define FAIL() BMT_ASSERT_RUNTIME(0, "FAIL", "Explicit failure triggered by FAIL()", NULL)
 
 /**
  * @def ADD_FAILURE()
@@ -419,6 +621,7 @@ extern bool g_bmt_current_test_failed_expect;
  */
 #define BMT_EXPECT_COMMON(condition, assertion_type, expr_str, ...) \
     do { \
+        BMT_CONSTANT_CHECK(condition, assertion_type, expr_str); \
         if (!(condition)) { \
             bmt_report_failure(__FILE__, __LINE__, assertion_type, expr_str, ##__VA_ARGS__); \
             g_bmt_current_test_failed_expect = true; \
@@ -533,7 +736,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param s2 The second string.
  */
 #define EXPECT_STREQ(s1, s2) \
-    BMT_EXPECT_COMMON(((s1) != NULL && (s2) != NULL && strcmp((s1), (s2)) == 0), "EXPECT_STREQ", #s1 " STREQ " #s2, \
+    BMT_EXPECT_COMMON(((s1) != NULL && (s2) != NULL && BMT_STRCMP((s1), (s2)) == 0), "EXPECT_STREQ", #s1 " STREQ " #s2, \
                       "Expected: \"%s\", Actual: \"%s\"", (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 /**
@@ -544,7 +747,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param s2 The second string.
  */
 #define EXPECT_STRNE(s1, s2) \
-    BMT_EXPECT_COMMON(!((s1) != NULL && (s2) != NULL && strcmp((s1), (s2)) == 0), "EXPECT_STRNE", #s1 " STRNE " #s2, \
+    BMT_EXPECT_COMMON(!((s1) != NULL && (s2) != NULL && BMT_STRCMP((s1), (s2)) == 0), "EXPECT_STRNE", #s1 " STRNE " #s2, \
                       "Expected strings to be different. s1: \"%s\", s2: \"%s\"", (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 /**
@@ -555,7 +758,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param s2 The second string.
  */
 #define EXPECT_STRCASEEQ(s1, s2) \
-    BMT_EXPECT_COMMON(((s1) != NULL && (s2) != NULL && strcasecmp((s1), (s2)) == 0), "EXPECT_STRCASEEQ", #s1 " STRCASEEQ " #s2, \
+    BMT_EXPECT_COMMON(((s1) != NULL && (s2) != NULL && BMT_STRCASECMP((s1), (s2)) == 0), "EXPECT_STRCASEEQ", #s1 " STRCASEEQ " #s2, \
                       "Expected (ignore case): \"%s\", Actual: \"%s\"", (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 /**
@@ -566,7 +769,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param s2 The second string.
  */
 #define EXPECT_STRCASENE(s1, s2) \
-    BMT_EXPECT_COMMON(!((s1) != NULL && (s2) != NULL && strcasecmp((s1), (s2)) == 0), "EXPECT_STRCASENE", #s1 " STRCASENE " #s2, \
+    BMT_EXPECT_COMMON(!((s1) != NULL && (s2) != NULL && BMT_STRCASECMP((s1), (s2)) == 0), "EXPECT_STRCASENE", #s1 " STRCASENE " #s2, \
                       "Expected strings to be different (ignore case). s1: \"%s\", s2: \"%s\"", (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 /**
@@ -578,7 +781,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param n The number of characters to compare.
  */
 #define EXPECT_STRNEQ(s1, s2, n) \
-    BMT_EXPECT_COMMON(((s1) != NULL && (s2) != NULL && strncmp((s1), (s2), (n)) == 0), "EXPECT_STRNEQ", #s1 " STRNEQ(" #n ") " #s2, \
+    BMT_EXPECT_COMMON(((s1) != NULL && (s2) != NULL && BMT_STRNCMP((s1), (s2), (n)) == 0), "EXPECT_STRNEQ", #s1 " STRNEQ(" #n ") " #s2, \
                       "Expected first %u chars: \"%s\", Actual: \"%s\"", (unsigned int)(n), (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 /**
@@ -590,7 +793,7 @@ extern bool g_bmt_current_test_failed_expect;
  * @param n The number of characters to compare.
  */
 #define EXPECT_STRNNE(s1, s2, n) \
-    BMT_EXPECT_COMMON(!((s1) != NULL && (s2) != NULL && strncmp((s1), (s2), (n)) == 0), "EXPECT_STRNNE", #s1 " STRNNE(" #n ") " #s2, \
+    BMT_EXPECT_COMMON(!((s1) != NULL && (s2) != NULL && BMT_STRNCMP((s1), (s2), (n)) == 0), "EXPECT_STRNNE", #s1 " STRNNE(" #n ") " #s2, \
                       "Expected first %u chars of strings to be different. s1: \"%s\", s2: \"%s\"", (unsigned int)(n), (s1) ? (s1) : "NULL", (s2) ? (s2) : "NULL")
 
 // **Expectativas de Punto Flotante**
@@ -629,9 +832,9 @@ extern bool g_bmt_current_test_failed_expect;
  * @param abs_error The maximum allowed absolute difference.
  */
 #define EXPECT_NEAR(val1, val2, abs_error) \
-    BMT_EXPECT_COMMON(fabs((val1) - (val2)) <= fabs(abs_error), "EXPECT_NEAR", #val1 " NEAR " #val2 ", error " #abs_error, \
+    BMT_EXPECT_COMMON(BMT_FABS((val1) - (val2)) <= BMT_FABS(abs_error), "EXPECT_NEAR", #val1 " NEAR " #val2 ", error " #abs_error, \
                       "Value1: %g, Value2: %g, Diff: %g, Max Abs Error: %g", \
-                      (double)(val1), (double)(val2), fabs((double)(val1) - (double)(val2)), fabs((double)(abs_error)))
+                      (double)(val1), (double)(val2), BMT_FABS((double)(val1) - (double)(val2)), BMT_FABS((double)(abs_error)))
 
 /**
  * @def EXPECT_FLOAT_NEAR(val1, val2, abs_error)
@@ -643,9 +846,9 @@ extern bool g_bmt_current_test_failed_expect;
  * @param abs_error The maximum allowed absolute difference (as a float).
  */
 #define EXPECT_FLOAT_NEAR(val1, val2, abs_error) \
-    BMT_EXPECT_COMMON(fabsf((val1) - (val2)) <= fabsf(abs_error), "EXPECT_FLOAT_NEAR", #val1 " NEAR " #val2 ", error " #abs_error, \
+    BMT_EXPECT_COMMON(BMT_FABSF((val1) - (val2)) <= BMT_FABSF(abs_error), "EXPECT_FLOAT_NEAR", #val1 " NEAR " #val2 ", error " #abs_error, \
                       "Value1: %f, Value2: %f, Diff: %f, Max Abs Error: %f", \
-                      (float)(val1), (float)(val2), fabsf((float)(val1) - (float)(val2)), fabsf((float)(abs_error)))
+                      (float)(val1), (float)(val2), BMT_FABSF((float)(val1) - (float)(val2)), BMT_FABSF((float)(abs_error)))
 
 /**
  * @def RUN_ALL_TESTS()
@@ -0,0 +1,795 @@
+// include/baremetal_test.hpp
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BAREMETAL_TEST_HPP
+#define BAREMETAL_TEST_HPP
+
+#if __cplusplus < 201703L
+#error "baremetal_test.hpp requires C++17"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+#include <utility>
+#include "baremetal_test.h"
+
+/**
+ * @file baremetal_test.hpp
+ * @brief Header-only C++17 layer over the C runner.
+ *
+ * - `TEST` places a constant descriptor in BMT_TEST_SECTION instead of registering the test
+ *   from a static constructor.
+ * - `ASSERT_EQ`, `ASSERT_NE`, `ASSERT_LT`, `ASSERT_LE`, `ASSERT_GT`, `ASSERT_GE` (and their
+ *   `EXPECT_` forms) compare the values with their own types (integers of different
+ *   signedness are compared by value) and print them as such on failure.
+ * - `ASSERT_THAT(value, matcher)` / `EXPECT_THAT` check a value against matchers (Eq, Ne, Lt,
+ *   Le, Gt, Ge, Near, Not, AllOf, AnyOf, Each, ElementsAre) that are constexpr objects,
+ *   composed at compile time.
+ *
+ * - A failed `ASSERT_*` (these and the C ones: ASSERT_TRUE, ASSERT_STREQ, ASSERT_NEAR...)
+ *   leaves the test body running its destructors, as chosen by BMT_CPP_ASSERT_MODE, instead
+ *   of the longjmp of the C runner.
+ *
+ * Nothing allocates or uses RTTI, and it builds with `-fno-exceptions -fno-rtti` (and with
+ * BMT_FREESTANDING). The checks are inlined; only the failure report is an out-of-line (cold)
+ * call.
+ */
+
+/**
+ * @brief Size of the buffer in which a failure message (the values or the matcher
+ *        description) is formatted; longer messages are truncated.
+ */
+#ifndef BMT_CPP_MESSAGE_SIZE
+#define BMT_CPP_MESSAGE_SIZE 160
+#endif
+
+/** @brief ASSERT_* failures longjmp to the runner, as in C: destructors of the test do not run. */
+#define BMT_CPP_ASSERT_LONGJMP 0
+/** @brief ASSERT_* failures throw bmt::test_aborted, caught by the TEST wrapper. */
+#define BMT_CPP_ASSERT_THROW 1
+/** @brief ASSERT_* failures `return;` from the enclosing function; see ASSERT_NO_FATAL_FAILURE. */
+#define BMT_CPP_ASSERT_RETURN 2
+
+/**
+ * @brief How a failed ASSERT_* ends a C++ test. By default, BMT_CPP_ASSERT_THROW when the build
+ *        has exceptions and BMT_CPP_ASSERT_RETURN otherwise; both run the destructors of the
+ *        objects of the test, so a failed assertion does not leak pool blocks, locks or
+ *        handles into the following tests.
+ *
+ * Pass path: in all three modes a passing check compiles to the same compare and branch to
+ * cold code (`AssertModes.PassPath` in examples/cpp measures it). The modes differ in the cold
+ * code and in size: THROW adds the exception tables and the try/catch of each TEST, RETURN a
+ * flag store per failure site. RETURN, as in GoogleTest, only compiles in functions that
+ * return `void`.
+ *
+ * Within the bodies that other modules call through C (PROPERTY, FUZZ_TEST, STRESS_TEST),
+ * ASSERT_* keeps the longjmp of that module (see g_bmt_assert_unwinds). With THROW, other C
+ * callbacks (e.g. a bmt_bench_run() body) must not fail an ASSERT_*, since the exception
+ * cannot cross C frames built without `-fexceptions`.
+ */
+#ifndef BMT_CPP_ASSERT_MODE
+#if defined(__cpp_exceptions)
+#define BMT_CPP_ASSERT_MODE BMT_CPP_ASSERT_THROW
+#else
+#define BMT_CPP_ASSERT_MODE BMT_CPP_ASSERT_RETURN
+#endif
+#endif
+
+#if BMT_CPP_ASSERT_MODE == BMT_CPP_ASSERT_THROW && !defined(__cpp_exceptions)
+#error "BMT_CPP_ASSERT_THROW needs exceptions (remove -fno-exceptions)"
+#endif
+
+/** @internal @brief Forces the pass path of a check to be inlined. */
+#define BMT_CPP_INLINE __attribute__((always_inline)) inline
+
+namespace bmt {
+
+/** @brief Base of all matchers: a type deriving from it is a matcher, anything else a value. */
+struct matcher_base {};
+
+namespace detail {
+
+/**
+ * @internal
+ * @brief Fixed-capacity text on the stack, always terminated.
+ */
+class text {
+public:
+    void put(char c) {
+        if (len_ + 1 < sizeof(buf_)) {
+            buf_[len_++] = c;
+            buf_[len_] = '\0';
+        }
+    }
+    void put(const char* s) {
+        while (*s != '\0') {
+            put(*s++);
+        }
+    }
+    const char* c_str() const { return buf_; }
+
+private:
+    char buf_[BMT_CPP_MESSAGE_SIZE] = {};
+    size_t len_ = 0;
+};
+
+inline void put_unsigned(text& out, unsigned long long v) {
+    char digits[20];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + v % 10u);
+        v /= 10u;
+    } while (v != 0);
+    while (n > 0) {
+        out.put(digits[--n]);
+    }
+}
+
+inline void put_hex(text& out, uintptr_t v) {
+    out.put("0x");
+    for (int shift = (int)(sizeof(v) * 8) - 4; shift >= 0; shift -= 4) {
+        out.put("0123456789abcdef"[(v >> shift) & 0xFu]);
+    }
+}
+
+/** @internal @brief Prints with six decimals, without printf. */
+inline void put_double(text& out, double v) {
+    if (v != v) {
+        out.put("nan");
+        return;
+    }
+    if (v < 0) {
+        out.put('-');
+        v = -v;
+    }
+    if (v > 1e18) {
+        out.put("inf");  // Or too large for the integer part: the comparison is what matters
+        return;
+    }
+    unsigned long long micro = (unsigned long long)(v * 1e6 + 0.5);
+    put_unsigned(out, micro / 1000000u);
+    out.put('.');
+    unsigned long long frac = micro % 1000000u;
+    for (unsigned long long div = 100000u; div > 0; div /= 10u) {
+        out.put((char)('0' + (frac / div) % 10u));
+    }
+}
+
+template <typename T, typename = void>
+struct is_range : std::false_type {};
+template <typename T>
+struct is_range<T, std::void_t<decltype(std::declval<const T&>().begin()),
+                               decltype(std::declval<const T&>().end())>> : std::true_type {};
+template <typename T, size_t N>
+struct is_range<T[N], void> : std::true_type {};
+
+template <typename R>
+constexpr auto begin_of(const R& r) {
+    if constexpr (std::is_array_v<R>) {
+        return r + 0;
+    } else {
+        return r.begin();
+    }
+}
+
+template <typename R>
+constexpr auto end_of(const R& r) {
+    if constexpr (std::is_array_v<R>) {
+        return r + std::extent_v<R>;
+    } else {
+        return r.end();
+    }
+}
+
+/** @internal @brief Prints a value with its own type (ranges as `{a, b, ...}`). */
+template <typename T>
+void print(text& out, const T& v) {
+    using D = std::decay_t<T>;
+    if constexpr (std::is_same_v<D, bool>) {
+        out.put(v ? "true" : "false");
+    } else if constexpr (std::is_enum_v<D>) {
+        print(out, static_cast<std::underlying_type_t<D>>(v));
+    } else if constexpr (std::is_same_v<D, decltype(nullptr)>) {
+        out.put("nullptr");
+    } else if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>) {
+        const char* s = v;
+        if (s == nullptr) {
+            out.put("NULL");
+        } else {
+            out.put('"');
+            out.put(s);
+            out.put('"');
+        }
+    } else if constexpr (std::is_integral_v<D>) {
+        if constexpr (std::is_signed_v<D>) {
+            if (v < 0) {
+                out.put('-');
+                put_unsigned(out, 0ull - (unsigned long long)(long long)v);
+                return;
+            }
+        }
+        put_unsigned(out, (unsigned long long)v);
+    } else if constexpr (std::is_floating_point_v<D>) {
+        put_double(out, (double)v);
+    } else if constexpr (std::is_pointer_v<D> && !std::is_array_v<T>) {
+        put_hex(out, reinterpret_cast<uintptr_t>(v));
+    } else if constexpr (is_range<T>::value) {
+        out.put('{');
+        size_t i = 0;
+        for (auto it = begin_of(v); it != end_of(v); ++it, ++i) {
+            if (i == 8) {
+                out.put(", ...");
+                break;
+            }
+            if (i != 0) {
+                out.put(", ");
+            }
+            print(out, *it);
+        }
+        out.put('}');
+    } else {
+        out.put("<");
+        put_unsigned(out, sizeof(T));
+        out.put("-byte object>");
+    }
+}
+
+/** @internal @brief Keeps a parameter out of template argument deduction (C++20 std::type_identity). */
+template <typename T>
+struct identity {
+    using type = T;
+};
+
+template <typename T>
+constexpr bool is_int_v = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+/** @internal @brief a == b, by value across integer signedness (like C++20 std::cmp_equal). */
+template <typename A, typename B>
+BMT_CPP_INLINE constexpr bool cmp_eq(const A& a, const B& b) {
+    if constexpr (is_int_v<A> && is_int_v<B> && std::is_signed_v<A> != std::is_signed_v<B>) {
+        if constexpr (std::is_signed_v<A>) {
+            return a >= 0 && static_cast<std::make_unsigned_t<A>>(a) == b;
+        } else {
+            return b >= 0 && a == static_cast<std::make_unsigned_t<B>>(b);
+        }
+    } else {
+        return a == b;
+    }
+}
+
+/** @internal @brief a < b, by value across integer signedness (like C++20 std::cmp_less). */
+template <typename A, typename B>
+BMT_CPP_INLINE constexpr bool cmp_lt(const A& a, const B& b) {
+    if constexpr (is_int_v<A> && is_int_v<B> && std::is_signed_v<A> != std::is_signed_v<B>) {
+        if constexpr (std::is_signed_v<A>) {
+            return a < 0 || static_cast<std::make_unsigned_t<A>>(a) < b;
+        } else {
+            return b >= 0 && a < static_cast<std::make_unsigned_t<B>>(b);
+        }
+    } else {
+        return a < b;
+    }
+}
+
+template <typename A, typename B> BMT_CPP_INLINE constexpr bool cmp_ne(const A& a, const B& b) { return !cmp_eq(a, b); }
+template <typename A, typename B> BMT_CPP_INLINE constexpr bool cmp_le(const A& a, const B& b) { return !cmp_lt(b, a); }
+template <typename A, typename B> BMT_CPP_INLINE constexpr bool cmp_gt(const A& a, const B& b) { return cmp_lt(b, a); }
+template <typename A, typename B> BMT_CPP_INLINE constexpr bool cmp_ge(const A& a, const B& b) { return !cmp_lt(a, b); }
+
+/**
+ * @internal
+ * @brief Failure report of ASSERT_EQ and family, out of line so the pass path stays small.
+ */
+template <typename A, typename B>
+__attribute__((cold, noinline)) void report_cmp(const char* file, int line, const char* type, const char* expr,
+                                                const char* op, const A& a, const B& b) {
+    text msg;
+    msg.put("Expected: ");
+    print(msg, a);
+    if (op[0] == '=') {
+        msg.put(", Actual: ");
+    } else {
+        msg.put(' ');
+        msg.put(op);
+        msg.put(' ');
+    }
+    print(msg, b);
+    if (op[0] == '!') {
+        msg.put(", but they are equal");
+    }
+    ::bmt_report_failure(file, line, type, expr, "%s", msg.c_str());
+}
+
+/** @internal @brief Failure report of ASSERT_THAT / EXPECT_THAT. */
+template <typename M, typename V>
+__attribute__((cold, noinline)) void report_that(const char* file, int line, const char* type, const char* expr,
+                                                 const M& matcher, const V& value) {
+    text msg;
+    msg.put("Expected: ");
+    matcher.describe(msg);
+    msg.put(", Actual: ");
+    print(msg, value);
+    ::bmt_report_failure(file, line, type, expr, "%s", msg.c_str());
+}
+
+/** @internal @brief Heterogeneous list of matchers, stored by value. */
+template <typename... Ms>
+struct pack {};
+
+template <typename M, typename... Rest>
+struct pack<M, Rest...> {
+    M head;
+    pack<Rest...> tail;
+};
+
+constexpr pack<> make_pack() { return {}; }
+
+template <typename M, typename... Rest>
+constexpr pack<M, Rest...> make_pack(const M& m, const Rest&... rest) {
+    return {m, make_pack(rest...)};
+}
+
+template <typename V>
+BMT_CPP_INLINE constexpr bool all_match(const pack<>&, const V&) { return true; }
+
+template <typename V, typename M, typename... R>
+BMT_CPP_INLINE constexpr bool all_match(const pack<M, R...>& p, const V& v) {
+    return p.head.matches(v) && all_match(p.tail, v);
+}
+
+template <typename V>
+BMT_CPP_INLINE constexpr bool any_match(const pack<>&, const V&) { return false; }
+
+template <typename V, typename M, typename... R>
+BMT_CPP_INLINE constexpr bool any_match(const pack<M, R...>& p, const V& v) {
+    return p.head.matches(v) || any_match(p.tail, v);
+}
+
+/** @internal @brief Matches the elements from `it` to `end` one to one with the matchers. */
+template <typename It, typename End>
+BMT_CPP_INLINE constexpr bool match_seq(It it, End end, const pack<>&) { return it == end; }
+
+template <typename It, typename End, typename M, typename... R>
+BMT_CPP_INLINE constexpr bool match_seq(It it, End end, const pack<M, R...>& p) {
+    return it != end && p.head.matches(*it) && match_seq(++it, end, p.tail);
+}
+
+inline void describe_all(text&, const pack<>&, const char*) {}
+
+template <typename M, typename... R>
+void describe_all(text& out, const pack<M, R...>& p, const char* sep) {
+    out.put('(');
+    p.head.describe(out);
+    out.put(')');
+    if constexpr (sizeof...(R) > 0) {
+        out.put(sep);
+        describe_all(out, p.tail, sep);
+    }
+}
+
+enum class cmp_op { eq, ne, lt, le, gt, ge };
+
+} // namespace detail
+
+/** @brief Matcher of Eq, Ne, Lt, Le, Gt and Ge. */
+template <detail::cmp_op Op, typename T>
+class CmpMatcher : public matcher_base {
+public:
+    constexpr explicit CmpMatcher(const T& bound) : bound_(bound) {}
+
+    template <typename V>
+    BMT_CPP_INLINE constexpr bool matches(const V& v) const {
+        if constexpr (Op == detail::cmp_op::eq) return detail::cmp_eq(v, bound_);
+        else if constexpr (Op == detail::cmp_op::ne) return detail::cmp_ne(v, bound_);
+        else if constexpr (Op == detail::cmp_op::lt) return detail::cmp_lt(v, bound_);
+        else if constexpr (Op == detail::cmp_op::le) return detail::cmp_le(v, bound_);
+        else if constexpr (Op == detail::cmp_op::gt) return detail::cmp_gt(v, bound_);
+        else return detail::cmp_ge(v, bound_);
+    }
+
+    void describe(detail::text& out) const {
+        static const char* const ops[] = {"== ", "!= ", "< ", "<= ", "> ", ">= "};
+        out.put(ops[(int)Op]);
+        detail::print(out, bound_);
+    }
+
+private:
+    T bound_;
+};
+
+template <typename T> constexpr auto Eq(const T& v) { return CmpMatcher<detail::cmp_op::eq, std::decay_t<T>>(v); }
+template <typename T> constexpr auto Ne(const T& v) { return CmpMatcher<detail::cmp_op::ne, std::decay_t<T>>(v); }
+template <typename T> constexpr auto Lt(const T& v) { return CmpMatcher<detail::cmp_op::lt, std::decay_t<T>>(v); }
+template <typename T> constexpr auto Le(const T& v) { return CmpMatcher<detail::cmp_op::le, std::decay_t<T>>(v); }
+template <typename T> constexpr auto Gt(const T& v) { return CmpMatcher<detail::cmp_op::gt, std::decay_t<T>>(v); }
+template <typename T> constexpr auto Ge(const T& v) { return CmpMatcher<detail::cmp_op::ge, std::decay_t<T>>(v); }
+
+namespace detail {
+/** @internal @brief A matcher as is; any other value as Eq(value). */
+template <typename T>
+constexpr auto as_matcher(const T& v) {
+    if constexpr (std::is_base_of_v<matcher_base, T>) {
+        return v;
+    } else {
+        return Eq(v);
+    }
+}
+} // namespace detail
+
+/** @brief Matcher of Near(). */
+template <typename T>
+class NearMatcher : public matcher_base {
+public:
+    constexpr NearMatcher(const T& expected, const T& max_error) : expected_(expected), max_error_(max_error) {}
+
+    template <typename V>
+    BMT_CPP_INLINE constexpr bool matches(const V& v) const {
+        return (v > expected_ ? v - expected_ : expected_ - v) <= max_error_;  // false for NaN
+    }
+
+    void describe(detail::text& out) const {
+        out.put("is near ");
+        detail::print(out, expected_);
+        out.put(" (+/- ");
+        detail::print(out, max_error_);
+        out.put(')');
+    }
+
+private:
+    T expected_;
+    T max_error_;
+};
+
+/** @brief |value - expected| <= max_error. */
+template <typename T>
+constexpr auto Near(const T& expected, const typename detail::identity<T>::type& max_error) {
+    return NearMatcher<T>(expected, max_error);
+}
+
+/** @brief Matcher of Not(). */
+template <typename M>
+class NotMatcher : public matcher_base {
+public:
+    constexpr explicit NotMatcher(const M& m) : m_(m) {}
+
+    template <typename V>
+    BMT_CPP_INLINE constexpr bool matches(const V& v) const { return !m_.matches(v); }
+
+    void describe(detail::text& out) const {
+        out.put("not (");
+        m_.describe(out);
+        out.put(')');
+    }
+
+private:
+    M m_;
+};
+
+template <typename M> constexpr auto Not(const M& m) { return NotMatcher<decltype(detail::as_matcher(m))>(detail::as_matcher(m)); }
+
+/** @brief Matcher of AllOf() and AnyOf(). */
+template <bool All, typename... Ms>
+class JunctionMatcher : public matcher_base {
+public:
+    constexpr explicit JunctionMatcher(const detail::pack<Ms...>& ms) : ms_(ms) {}
+
+    template <typename V>
+    BMT_CPP_INLINE constexpr bool matches(const V& v) const {
+        if constexpr (All) {
+            return detail::all_match(ms_, v);
+        } else {
+            return detail::any_match(ms_, v);
+        }
+    }
+
+    void describe(detail::text& out) const { detail::describe_all(out, ms_, All ? " and " : " or "); }
+
+private:
+    detail::pack<Ms...> ms_;
+};
+
+/** @brief The value matches all the matchers (plain values mean Eq). */
+template <typename... Ms>
+constexpr auto AllOf(const Ms&... ms) {
+    return JunctionMatcher<true, decltype(detail::as_matcher(ms))...>(detail::make_pack(detail::as_matcher(ms)...));
+}
+
+/** @brief The value matches at least one of the matchers (plain values mean Eq). */
+template <typename... Ms>
+constexpr auto AnyOf(const Ms&... ms) {
+    return JunctionMatcher<false, decltype(detail::as_matcher(ms))...>(detail::make_pack(detail::as_matcher(ms)...));
+}
+
+/** @brief Matcher of Each(). */
+template <typename M>
+class EachMatcher : public matcher_base {
+public:
+    constexpr explicit EachMatcher(const M& m) : m_(m) {}
+
+    template <typename R>
+    BMT_CPP_INLINE constexpr bool matches(const R& range) const {
+        for (auto it = detail::begin_of(range); it != detail::end_of(range); ++it) {
+            if (!m_.matches(*it)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void describe(detail::text& out) const {
+        out.put("each element (");
+        m_.describe(out);
+        out.put(')');
+    }
+
+private:
+    M m_;
+};
+
+/** @brief Every element of a range (array or container with begin()/end()) matches. */
+template <typename M> constexpr auto Each(const M& m) { return EachMatcher<decltype(detail::as_matcher(m))>(detail::as_matcher(m)); }
+
+/** @brief Matcher of ElementsAre(). */
+template <typename... Ms>
+class ElementsAreMatcher : public matcher_base {
+public:
+    constexpr explicit ElementsAreMatcher(const detail::pack<Ms...>& ms) : ms_(ms) {}
+
+    template <typename R>
+    BMT_CPP_INLINE constexpr bool matches(const R& range) const {
+        return detail::match_seq(detail::begin_of(range), detail::end_of(range), ms_);
+    }
+
+    void describe(detail::text& out) const {
+        out.put("elements are ");
+        detail::describe_all(out, ms_, ", ");
+    }
+
+private:
+    detail::pack<Ms...> ms_;
+};
+
+/** @brief The range has exactly these elements, in order, each matching its matcher (or equal to its value). */
+template <typename... Ms>
+constexpr auto ElementsAre(const Ms&... ms) {
+    return ElementsAreMatcher<decltype(detail::as_matcher(ms))...>(detail::make_pack(detail::as_matcher(ms)...));
+}
+
+/** @brief Thrown by a failed ASSERT_* in BMT_CPP_ASSERT_THROW mode (failure already reported). */
+struct test_aborted {};
+
+namespace detail {
+
+/** @internal @brief Set by a failed ASSERT_* of the current test in BMT_CPP_ASSERT_RETURN mode. */
+inline bool fatal_failure = false;
+
+/**
+ * @internal
+ * @brief Runs a TEST body with ASSERT_* unwinding enabled. Once the body is gone (destructors
+ *        run), a fatal failure goes back to the runner through the usual longjmp, which now
+ *        skips no C++ frame with state.
+ */
+inline void run_test_body(void (*body)(), const char* file, int line) {
+    fatal_failure = false;
+    ::g_bmt_assert_unwinds = true;
+#if BMT_CPP_ASSERT_MODE == BMT_CPP_ASSERT_THROW
+    try {
+        body();
+    } catch (const test_aborted&) {
+        fatal_failure = true;
+    } catch (...) {
+        ::bmt_report_failure(file, line, "TEST", "body", "Uncaught exception");
+        fatal_failure = true;
+    }
+#else
+    (void)file;
+    (void)line;
+    body();
+#endif
+    ::g_bmt_assert_unwinds = false;
+    if (fatal_failure) {
+        ::bmt_terminate_current_test();
+    }
+}
+
+namespace {
+/** @internal @brief One per source file: its address tells the runner which TESTs share a file. */
+constexpr char unit_key = 0;
+} // namespace
+
+} // namespace detail
+
+/**
+ * @brief Runs `body` (e.g. a lambda) the way the runner runs a TEST body: a failed ASSERT_* in it
+ *        ends `body` as BMT_CPP_ASSERT_MODE ends a test (throw, return or longjmp), and control
+ *        comes back here. The failure counts for the test, which goes on as after an EXPECT_*.
+ *        Lets a test check what a failure leaves behind, e.g. that destructors released resources.
+ * @return true if no ASSERT_* failed in `body`.
+ */
+template <typename Body>
+bool run_as_test_body(Body&& body) {
+    bool completed = true;
+#if BMT_CPP_ASSERT_MODE == BMT_CPP_ASSERT_LONGJMP
+    bmt_jmp_buf runner_jmp;
+    __builtin_memcpy(runner_jmp, ::g_bmt_assert_jmp_buf, sizeof(bmt_jmp_buf));
+    if (bmt_setjmp(::g_bmt_assert_jmp_buf) == 0) {
+        body();
+    } else {
+        completed = false;
+    }
+    __builtin_memcpy(::g_bmt_assert_jmp_buf, runner_jmp, sizeof(bmt_jmp_buf));
+#else
+    const bool unwinds = ::g_bmt_assert_unwinds;
+    const bool fatal = detail::fatal_failure;
+    ::g_bmt_assert_unwinds = true;
+    detail::fatal_failure = false;
+#if BMT_CPP_ASSERT_MODE == BMT_CPP_ASSERT_THROW
+    try {
+        body();
+    } catch (const test_aborted&) {
+        detail::fatal_failure = true;
+    }
+#else
+    body();
+#endif
+    completed = !detail::fatal_failure;
+    detail::fatal_failure = fatal;
+    ::g_bmt_assert_unwinds = unwinds;
+#endif
+    if (!completed) {
+        ::g_bmt_current_test_failed_expect = true;
+    }
+    return completed;
+}
+
+} // namespace bmt
+
+/**
+ * @def TEST(TestSuiteName, TestName)
+ * @brief Defines a test and registers it with a constant descriptor in BMT_TEST_SECTION
+ *        (no static constructor; bmt_run_all_tests() finds it in the section).
+ */
+#undef TEST
+#define TEST(TestSuiteName, TestName) \
+    static void bmt_body_##TestSuiteName##_##TestName(); \
+    static void bmt_test_##TestSuiteName##_##TestName() { \
+        ::bmt::detail::run_test_body(&bmt_body_##TestSuiteName##_##TestName, __FILE__, __LINE__); \
+    } \
+    [[gnu::used, gnu::section(BMT_TEST_SECTION)]] alignas(::bmt_test_desc_t) \
+    static constexpr ::bmt_test_desc_t bmt_desc_##TestSuiteName##_##TestName = { \
+        #TestSuiteName, #TestName, &bmt_test_##TestSuiteName##_##TestName, &::bmt::detail::unit_key, __COUNTER__}; \
+    static void bmt_body_##TestSuiteName##_##TestName()
+
+/**
+ * @internal
+ * @brief Action of a failed ASSERT_* (after the report): unwinds while a TEST body runs
+ *        directly under the runner, longjmps otherwise.
+ */
+#if BMT_CPP_ASSERT_MODE == BMT_CPP_ASSERT_THROW
+#define BMT_CPP_ASSERT_FAIL \
+    do { \
+        if (::g_bmt_assert_unwinds) { \
+            throw ::bmt::test_aborted{}; \
+        } \
+        ::bmt_terminate_current_test(); \
+    } while (0)
+#elif BMT_CPP_ASSERT_MODE == BMT_CPP_ASSERT_RETURN
+#define BMT_CPP_ASSERT_FAIL \
+    do { \
+        if (::g_bmt_assert_unwinds) { \
+            ::bmt::detail::fatal_failure = true; \
+            return; \
+        } \
+        ::bmt_terminate_current_test(); \
+    } while (0)
+#else
+#define BMT_CPP_ASSERT_FAIL ::bmt_terminate_current_test()
+#endif
+
+/** @internal @brief Action of a failed EXPECT_* of this header. */
+#define BMT_CPP_EXPECT_FAIL (void)(::g_bmt_current_test_failed_expect = true)
+
+/** @internal @brief The C assertions (ASSERT_TRUE, ASSERT_STREQ...) end the test the same way. */
+#undef BMT_ASSERT_RUNTIME
+#define BMT_ASSERT_RUNTIME(condition, assertion_type, expr_str, ...) \
+    do { \
+        if (__builtin_expect(!(condition), 0)) { \
+            ::bmt_report_failure(__FILE__, __LINE__, assertion_type, expr_str, ##__VA_ARGS__); \
+            BMT_CPP_ASSERT_FAIL; \
+        } \
+    } while (0)
+
+/**
+ * @def ASSERT_NO_FATAL_FAILURE(statement)
+ * @brief Runs `statement` (typically a helper function with ASSERT_* inside) and, if an
+ *        ASSERT_* failed in it, ends the calling function too. Only needed in
+ *        BMT_CPP_ASSERT_RETURN mode, where a failure returns from the helper alone; in the
+ *        other modes the test has already ended.
+ */
+#define ASSERT_NO_FATAL_FAILURE(statement) \
+    do { \
+        statement; \
+        if (::bmt::detail::fatal_failure) { \
+            return; \
+        } \
+    } while (0)
+
+/**
+ * @internal
+ * @brief Shared by the comparison checks: evaluates each operand once and keeps its type (or, if
+ *        the comparison is a constant expression, checks it at compile time: BMT_CONSTANT_CHECK).
+ */
+#define BMT_CPP_CHECK_CMP(on_fail, assertion_type, cmp, op, val1, val2) \
+    do { \
+        BMT_CONSTANT_CHECK(::bmt::detail::cmp((val1), (val2)), assertion_type, #val1 " " op " " #val2); \
+        if constexpr (!__builtin_constant_p(::bmt::detail::cmp((val1), (val2)))) { \
+            auto&& bmt_lhs = (val1); \
+            auto&& bmt_rhs = (val2); \
+            if (__builtin_expect(!::bmt::detail::cmp(bmt_lhs, bmt_rhs), 0)) { \
+                ::bmt::detail::report_cmp(__FILE__, __LINE__, assertion_type, #val1 " " op " " #val2, op, bmt_lhs, bmt_rhs); \
+                on_fail; \
+            } \
+        } \
+    } while (0)
+
+/** @internal @brief Shared by ASSERT_THAT / EXPECT_THAT. */
+#define BMT_CPP_CHECK_THAT(on_fail, assertion_type, value, matcher) \
+    do { \
+        BMT_CONSTANT_CHECK((matcher).matches(value), assertion_type, #value " THAT " #matcher); \
+        if constexpr (!__builtin_constant_p((matcher).matches(value))) { \
+            auto&& bmt_value = (value); \
+            const auto& bmt_matcher = (matcher); \
+            if (__builtin_expect(!bmt_matcher.matches(bmt_value), 0)) { \
+                ::bmt::detail::report_that(__FILE__, __LINE__, assertion_type, #value " THAT " #matcher, bmt_matcher, bmt_value); \
+                on_fail; \
+            } \
+        } \
+    } while (0)
+
+#undef ASSERT_EQ
+#undef ASSERT_NE
+#undef ASSERT_LT
+#undef ASSERT_LE
+#undef ASSERT_GT
+#undef ASSERT_GE
+#undef EXPECT_EQ
+#undef EXPECT_NE
+#undef EXPECT_LT
+#undef EXPECT_LE
+#undef EXPECT_GT
+#undef EXPECT_GE
+
+#define ASSERT_EQ(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_ASSERT_FAIL, "ASSERT_EQ", cmp_eq, "==", val1, val2)
+#define ASSERT_NE(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_ASSERT_FAIL, "ASSERT_NE", cmp_ne, "!=", val1, val2)
+#define ASSERT_LT(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_ASSERT_FAIL, "ASSERT_LT", cmp_lt, "<", val1, val2)
+#define ASSERT_LE(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_ASSERT_FAIL, "ASSERT_LE", cmp_le, "<=", val1, val2)
+#define ASSERT_GT(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_ASSERT_FAIL, "ASSERT_GT", cmp_gt, ">", val1, val2)
+#define ASSERT_GE(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_ASSERT_FAIL, "ASSERT_GE", cmp_ge, ">=", val1, val2)
+#define EXPECT_EQ(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_EXPECT_FAIL, "EXPECT_EQ", cmp_eq, "==", val1, val2)
+#define EXPECT_NE(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_EXPECT_FAIL, "EXPECT_NE", cmp_ne, "!=", val1, val2)
+#define EXPECT_LT(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_EXPECT_FAIL, "EXPECT_LT", cmp_lt, "<", val1, val2)
+#define EXPECT_LE(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_EXPECT_FAIL, "EXPECT_LE", cmp_le, "<=", val1, val2)
+#define EXPECT_GT(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_EXPECT_FAIL, "EXPECT_GT", cmp_gt, ">", val1, val2)
+#define EXPECT_GE(val1, val2) BMT_CPP_CHECK_CMP(BMT_CPP_EXPECT_FAIL, "EXPECT_GE", cmp_ge, ">=", val1, val2)
+
+/**
+ * @def ASSERT_THAT(value, matcher)
+ * @brief Asserts that `value` matches `matcher`, e.g.
+ *        `ASSERT_THAT(samples, Each(AllOf(Ge(0), Lt(4096))))`. Terminates the test on failure.
+ */
+#define ASSERT_THAT(value, matcher) BMT_CPP_CHECK_THAT(BMT_CPP_ASSERT_FAIL, "ASSERT_THAT", value, matcher)
+
+/**
+ * @def EXPECT_THAT(value, matcher)
+ * @brief Like ASSERT_THAT, but the test continues after a failure.
+ */
+#define EXPECT_THAT(value, matcher) BMT_CPP_CHECK_THAT(BMT_CPP_EXPECT_FAIL, "EXPECT_THAT", value, matcher)
+
+#endif // BAREMETAL_TEST_HPP
@@ -0,0 +1,248 @@
+// include/bmt_bench.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_BENCH_H
+#define BMT_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bmt_platform_io.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of timed samples taken by bmt_bench_run().
+ * Can be overridden from the build (e.g. `-DBMT_BENCH_DEFAULT_SAMPLES=11`).
+ */
+#ifndef BMT_BENCH_DEFAULT_SAMPLES
+#define BMT_BENCH_DEFAULT_SAMPLES 5
+#endif
+
+/**
+ * @brief Maximum number of samples a single benchmark can record.
+ */
+#define BMT_BENCH_MAX_SAMPLES 32
+
+/**
+ * @brief Number of untimed warm-up samples run before measuring (caches, branch predictors, DVFS).
+ */
+#ifndef BMT_BENCH_DEFAULT_WARMUP
+#define BMT_BENCH_DEFAULT_WARMUP 1
+#endif
+
+/**
+ * @brief Coefficient of variation (in hundredths of a percent) above which a result is flagged as noisy.
+ * The default, 500, means 5.00 %.
+ */
+#ifndef BMT_BENCH_DEFAULT_CV_MAX
+#define BMT_BENCH_DEFAULT_CV_MAX 500
+#endif
+
+/**
+ * @struct bmt_bench_config_t
+ * @brief Runtime configuration of the benchmark helpers.
+ */
+typedef struct {
+    uint32_t samples;       /**< Timed samples per benchmark (clamped to BMT_BENCH_MAX_SAMPLES). */
+    uint32_t warmup;        /**< Untimed warm-up samples per benchmark. */
+    uint32_t cv_max_x100;   /**< Noise threshold: results with a higher CV (in 0.01 %) are flagged "noisy". */
+} bmt_bench_config_t;
+
+/**
+ * @brief Typedef for a benchmark body.
+ *
+ * The body performs exactly one iteration of the operation being measured.
+ *
+ * @param ctx User context passed through bmt_bench_run().
+ */
+typedef void (*bmt_bench_func_t)(void* ctx);
+
+/**
+ * @struct bmt_bench_result_t
+ * @brief Result of a benchmark run. All times are per iteration, in picoseconds.
+ */
+typedef struct {
+    const char* name;        /**< Name of the benchmark, as printed in the report. */
+    uint32_t iterations;     /**< Iterations per sample. */
+    uint32_t samples;        /**< Number of samples taken. */
+    uint32_t bytes_per_iter; /**< Bytes processed per iteration (0 if throughput does not apply). */
+    uint64_t min_ps;         /**< Fastest sample. */
+    uint64_t mean_ps;        /**< Mean of all samples. */
+    uint64_t max_ps;         /**< Slowest sample. */
+    uint64_t median_ps;      /**< Median of all samples. */
+    uint32_t cv_x100;        /**< Coefficient of variation (stddev / mean) in hundredths of a percent. */
+    bool noisy;              /**< True if cv_x100 exceeds the configured threshold: do not trust the result. */
+} bmt_bench_result_t;
+
+/**
+ * @brief Replaces the benchmark configuration (samples, warm-up, noise threshold).
+ *
+ * Ports can call this from bmt_platform_io_init() (e.g. the Linux host port does it
+ * in low-noise mode) or tests can call it before measuring.
+ *
+ * @param config The new configuration. Zero `samples` is treated as 1.
+ */
+void bmt_bench_set_config(const bmt_bench_config_t* config);
+
+/**
+ * @brief Gets the current benchmark configuration.
+ * @return Pointer to the active configuration.
+ */
+const bmt_bench_config_t* bmt_bench_get_config(void);
+
+/**
+ * @brief Measures a benchmark body and prints a "[ BENCH    ]" report line.
+ *
+ * After the configured warm-up samples, the body is called `iterations` times per sample,
+ * for the configured number of samples, timed with bmt_platform_get_hires_ticks().
+ * The report line is made of `key=value` pairs so it can be extended without breaking
+ * the Python parser; `noisy=1` is appended when the CV exceeds the threshold:
+ *
+ * @code
+ * [ BENCH    ] crc32_slice8/4096 iters=200 samples=5 ns_min=3.120 ns_mean=3.190 ns_max=3.410 ns_median=3.180 cv_pct=1.12 bytes=4096 mbps=1312.82
+ * @endcode
+ *
+ * @param name Name of the benchmark (no spaces). Usually "kernel/size".
+ * @param func Body of the benchmark.
+ * @param ctx User context passed to `func`.
+ * @param iterations Iterations per sample. Must be greater than 0.
+ * @param bytes_per_iter Bytes processed per iteration, used to report MB/s. 0 to omit it.
+ * @param result Optional output with the measured values. Can be NULL.
+ */
+void bmt_bench_run(const char* name, bmt_bench_func_t func, void* ctx, uint32_t iterations,
+                   uint32_t bytes_per_iter, bmt_bench_result_t* result);
+
+/**
+ * @brief Measures two benchmark bodies with interleaved samples (A B B A A B ...).
+ *
+ * Interleaving makes slow drifts (thermal throttling, frequency changes, other load on a
+ * shared machine) affect both sides equally, which makes the ratio far more stable than
+ * two back-to-back bmt_bench_run() calls. Prints one "[ BENCH    ]" line per side plus:
+ *
+ * @code
+ * [ BENCH AB ] crc32_table/4096:crc32_slice8/4096 ratio=0.187 cv_pct=0.85
+ * @endcode
+ *
+ * where `ratio` is median(B) / median(A) (below 1 means B is faster).
+ *
+ * @param name_a Name of variant A.
+ * @param func_a Body of variant A.
+ * @param ctx_a Context for variant A.
+ * @param name_b Name of variant B.
+ * @param func_b Body of variant B.
+ * @param ctx_b Context for variant B.
+ * @param iterations Iterations per sample (same for both).
+ * @param bytes_per_iter Bytes processed per iteration, 0 to omit throughput.
+ * @param result_a Optional output for variant A. Can be NULL.
+ * @param result_b Optional output for variant B. Can be NULL.
+ * @return median(B) / median(A) multiplied by 1000.
+ */
+uint32_t bmt_bench_compare(const char* name_a, bmt_bench_func_t func_a, void* ctx_a,
+                           const char* name_b, bmt_bench_func_t func_b, void* ctx_b,
+                           uint32_t iterations, uint32_t bytes_per_iter,
+                           bmt_bench_result_t* result_a, bmt_bench_result_t* result_b);
+
+/**
+ * @brief Prints a "[ BENCH    ]" report line for an already measured result.
+ * @param result The result to print.
+ */
+void bmt_bench_report(const bmt_bench_result_t* result);
+
+/**
+ * @brief Sub-buckets per power of two in a bmt_hist_t, as a power of two (4 -> 16 sub-buckets).
+ *
+ * Values below 2^BMT_HIST_SUB_BITS get one exact bucket each; above that every power of two
+ * is split in 2^BMT_HIST_SUB_BITS equal buckets, so the relative error of a recorded value
+ * is at most 1 / 2^BMT_HIST_SUB_BITS (6.25 %) over the whole 32-bit range.
+ */
+#define BMT_HIST_SUB_BITS 4
+
+/**
+ * @brief Number of buckets of a bmt_hist_t.
+ */
+#define BMT_HIST_BUCKETS ((32 - BMT_HIST_SUB_BITS + 1) << BMT_HIST_SUB_BITS)
+
+/**
+ * @struct bmt_hist_t
+ * @brief Log-linear histogram of 32-bit values (usually nanoseconds).
+ *
+ * Fixed size and allocation-free, so it can record thousands of samples on targets
+ * that cannot keep every sample (e.g. interrupt latencies). Percentiles are derived
+ * from the buckets.
+ */
+typedef struct {
+    const char* name;                   /**< Name printed in the report. */
+    uint32_t count;                     /**< Number of recorded values. */
+    uint32_t min;                       /**< Smallest recorded value. */
+    uint32_t max;                       /**< Largest recorded value. */
+    uint64_t sum;                       /**< Sum of all recorded values (for the mean). */
+    uint32_t buckets[BMT_HIST_BUCKETS]; /**< Counts per bucket. */
+} bmt_hist_t;
+
+/**
+ * @brief Empties a histogram.
+ * @param hist The histogram.
+ * @param name Name printed in the report (no spaces).
+ */
+void bmt_hist_init(bmt_hist_t* hist, const char* name);
+
+/**
+ * @brief Records one value.
+ * @param hist The histogram.
+ * @param value The value (e.g. a latency in ns).
+ */
+void bmt_hist_add(bmt_hist_t* hist, uint32_t value);
+
+/**
+ * @brief Gets a percentile of the recorded values.
+ *
+ * Returns the upper bound of the bucket holding the percentile (clamped to the maximum),
+ * so the result never underestimates the true value.
+ *
+ * @param hist The histogram.
+ * @param per_mille Percentile in tenths of a percent (500 = median, 990 = p99, 999 = p99.9).
+ * @return The percentile, or 0 if the histogram is empty.
+ */
+uint32_t bmt_hist_percentile(const bmt_hist_t* hist, uint32_t per_mille);
+
+/**
+ * @brief Prints a histogram: one summary line followed by one line per non-empty bucket.
+ *
+ * @code
+ * [ HIST     ] irq/latency unit=ns count=5000 min=412 mean=455 p50=447 p90=479 p99=543 p999=1087 max=2310
+ * [ HIST BIN ] irq/latency lo=408 hi=416 count=118
+ * @endcode
+ *
+ * `lo` is inclusive and `hi` exclusive.
+ *
+ * @param hist The histogram.
+ * @param unit Unit of the values, printed as `unit=` (e.g. "ns", "cycles").
+ */
+void bmt_hist_report(const bmt_hist_t* hist, const char* unit);
+
+/**
+ * @def BMT_BENCH_DO_NOT_OPTIMIZE(value)
+ * @brief Forces the compiler to materialize `value`, so the computation producing
+ *        it is not removed as dead code.
+ */
+#define BMT_BENCH_DO_NOT_OPTIMIZE(value) __asm__ __volatile__("" : : "r"(value) : "memory")
+
+/**
+ * @def BMT_BENCH_CLOBBER_MEMORY()
+ * @brief Compiler barrier: all pending memory writes are considered observable.
+ */
+#define BMT_BENCH_CLOBBER_MEMORY() __asm__ __volatile__("" : : : "memory")
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_BENCH_H
@@ -0,0 +1,135 @@
+// include/bmt_compress.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_COMPRESS_H
+#define BMT_COMPRESS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief log2 of the window (how far back a match may start), from 4 to 12. Larger windows
+ *        find more matches but cost RAM (two windows) and search time per byte.
+ */
+#ifndef BMT_COMPRESS_WINDOW_BITS
+#define BMT_COMPRESS_WINDOW_BITS 8
+#endif
+
+/**
+ * @brief Bits of a match length, from 3 to 8: matches are 2 to 2^bits + 1 bytes long.
+ */
+#ifndef BMT_COMPRESS_LENGTH_BITS
+#define BMT_COMPRESS_LENGTH_BITS 4
+#endif
+
+/**
+ * @brief Largest payload of a frame, in compressed bytes. A frame is sent when it is full.
+ */
+#ifndef BMT_COMPRESS_FRAME_MAX
+#define BMT_COMPRESS_FRAME_MAX 256u
+#endif
+
+/**
+ * @brief At the end of a line, send a frame if the previous one is older than this, so the host
+ *        sees the progress of slow tests. 0 sends frames only when full or on bmt_compress_flush().
+ */
+#ifndef BMT_COMPRESS_FLUSH_MS
+#define BMT_COMPRESS_FLUSH_MS 200u
+#endif
+
+/** @name Frames of the compressed output
+ *
+ * `1E flags length_bits len_lo len_hi payload[len]`, with the window bits in the low nibble
+ * of `flags` and bit 7 set in the first frame after bmt_compress_init() (the host clears its
+ * window). The payload is an LZSS bit stream, MSB first: `1` + 8-bit literal, or `0` + window
+ * bits of (distance - 1) + length bits of (length - 2). It is padded with zeros to a byte, and
+ * the window carries over to the next frame. Text outside frames is passed through as is.
+ *  @{ */
+#define BMT_COMPRESS_SYNC         0x1Eu   /**< ASCII RS: never part of the text output. */
+#define BMT_COMPRESS_FLAG_RESET   0x80u
+/** @} */
+
+/**
+ * @brief Sends the bytes of a frame over the link, without going back through the compressor
+ *        (e.g. straight to the UART).
+ */
+typedef void (*bmt_compress_sink_t)(const uint8_t* data, size_t size);
+
+/**
+ * @struct bmt_compress_stats_t
+ * @brief Counters of the compressor since bmt_compress_init().
+ */
+typedef struct {
+    uint64_t in_bytes;      /**< Text bytes written. */
+    uint64_t out_bytes;     /**< Bytes sent to the sink, frame headers included. */
+    uint64_t frames;        /**< Frames sent. */
+    uint64_t ticks;         /**< High-resolution ticks spent compressing (sink time excluded). */
+} bmt_compress_stats_t;
+
+/**
+ * @brief Starts (or restarts) compressing the output. Static state, no allocation.
+ *
+ * The platform routes its bmt_platform_puts() and bmt_platform_putchar() through
+ * bmt_compress_write() once this has been called (see bmt_compress_enabled()).
+ *
+ * @param sink Function that sends the frames.
+ */
+void bmt_compress_init(bmt_compress_sink_t sink);
+
+/**
+ * @brief Whether bmt_compress_init() has been called.
+ * @return true if the output is compressed.
+ */
+bool bmt_compress_enabled(void);
+
+/**
+ * @brief Compresses text. Frames are sent when full, and at the end of a line if the last one
+ *        is older than BMT_COMPRESS_FLUSH_MS.
+ * @param data The text.
+ * @param size Bytes of `data`.
+ */
+void bmt_compress_write(const char* data, size_t size);
+
+/**
+ * @brief Compresses all pending text and sends it as a frame. Call it before the program stops
+ *        printing (end of the run, waiting for input, reset), or the host misses the tail.
+ * @note Does nothing before bmt_compress_init().
+ */
+void bmt_compress_flush(void);
+
+/**
+ * @brief Gets the counters of the compressor.
+ * @param stats Output.
+ */
+void bmt_compress_get_stats(bmt_compress_stats_t* stats);
+
+/**
+ * @brief Prints the counters (itself compressed, like the rest of the output) and flushes:
+ *
+ * @code
+ * [ COMPRESS ] in=182344 out=41022 frames=163 ratio=0.224 ns_per_byte=312.500 window=256 max_match=17
+ * @endcode
+ *
+ * `ratio` is out / in and `ns_per_byte` the CPU cost of the compressor per text byte. The filler of
+ * bmt_transport_bench() goes straight to the transport and is not counted. When the
+ * compressor and the link do not overlap, compression pays off if
+ * `ns_per_byte < (1 - ratio) * link ns per byte` (10^10 / baud on an 8N1 UART).
+ */
+void bmt_compress_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_COMPRESS_H
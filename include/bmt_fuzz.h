@@ -0,0 +1,290 @@
+// include/bmt_fuzz.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_FUZZ_H
+#define BMT_FUZZ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "baremetal_test.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief An AFL++ persistent-mode build (`-DBMT_FUZZ_AFL`) is a fuzz build.
+ */
+#if defined(BMT_FUZZ_AFL) && !defined(BMT_FUZZ_BUILD)
+#define BMT_FUZZ_BUILD
+#endif
+
+/**
+ * @brief Largest input read from a corpus file (longer files are truncated) or from stdin.
+ */
+#ifndef BMT_FUZZ_MAX_INPUT
+#define BMT_FUZZ_MAX_INPUT 4096u
+#endif
+
+/**
+ * @brief Maximum number of FUZZ_TEST targets.
+ */
+#ifndef BMT_FUZZ_MAX_TARGETS
+#define BMT_FUZZ_MAX_TARGETS 16
+#endif
+
+/**
+ * @brief Maximum number of FUZZ_CORPUS blocks.
+ */
+#ifndef BMT_FUZZ_MAX_CORPORA
+#define BMT_FUZZ_MAX_CORPORA 16
+#endif
+
+/**
+ * @brief Bytes of a failing input printed in the report.
+ */
+#ifndef BMT_FUZZ_REPORT_BYTES
+#define BMT_FUZZ_REPORT_BYTES 64u
+#endif
+
+/**
+ * @brief Bits of the on-target coverage map (power of two). bmt_fuzz_serve() keeps two: the
+ *        edges of the current input and all edges seen so far.
+ */
+#ifndef BMT_FUZZ_MAP_BITS
+#define BMT_FUZZ_MAP_BITS 8192u
+#endif
+
+/**
+ * @brief Largest frame bmt_fuzz_serve() accepts (a batch of inputs with their headers).
+ */
+#ifndef BMT_FUZZ_FRAME_MAX
+#define BMT_FUZZ_FRAME_MAX 8192u
+#endif
+
+/** @name Frames of the remote fuzzing protocol (bmt_fuzz_serve())
+ *
+ * Host to target: `B7 7E type len_lo len_hi payload[len] crc_lo crc_hi`, with the
+ * CRC-16/CCITT (poly 0x1021, init 0xFFFF) over type, length and payload.
+ *  @{ */
+#define BMT_FUZZ_SYNC0        0xB7u
+#define BMT_FUZZ_SYNC1        0x7Eu
+#define BMT_FUZZ_FRAME_SELECT 'S'   /**< Payload: target name ("Suite.Name"). */
+#define BMT_FUZZ_FRAME_BATCH  'B'   /**< Payload: seq u16, flags u8, count u8, then count x (len u16, bytes). */
+#define BMT_FUZZ_FRAME_END    'E'   /**< No payload: ends bmt_fuzz_serve(). */
+#define BMT_FUZZ_BATCH_VERBOSE 0x01u /**< Batch flag: print the failure reports of the batch. */
+/** @} */
+
+/**
+ * @brief Typedef for the body of a FUZZ_TEST.
+ */
+typedef void (*bmt_fuzz_func_t)(const uint8_t* data, size_t size);
+
+/**
+ * @struct bmt_fuzz_input_t
+ * @brief One input of a built-in corpus (see FUZZ_CORPUS).
+ */
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+} bmt_fuzz_input_t;
+
+/**
+ * @struct bmt_fuzz_target_t
+ * @brief A registered FUZZ_TEST.
+ */
+typedef struct {
+    const char* name;       /**< "Suite.Name". */
+    bmt_fuzz_func_t func;   /**< The body. */
+} bmt_fuzz_target_t;
+
+/**
+ * @brief Registers a fuzz target. Called by the FUZZ_TEST macro.
+ * @param name "Suite.Name".
+ * @param func The body.
+ */
+void bmt_fuzz_register(const char* name, bmt_fuzz_func_t func);
+
+/**
+ * @brief Registers built-in corpus inputs for a target. Called by the FUZZ_CORPUS macro.
+ * @param name "Suite.Name" of the target.
+ * @param inputs The inputs.
+ * @param count Number of inputs.
+ */
+void bmt_fuzz_register_corpus(const char* name, const bmt_fuzz_input_t* inputs, uint32_t count);
+
+/**
+ * @brief Finds a fuzz target by name.
+ * @param name "Suite.Name", or NULL for the only registered target.
+ * @return The target, or NULL if there is no such target (or NULL was given and there are several).
+ */
+const bmt_fuzz_target_t* bmt_fuzz_find(const char* name);
+
+/**
+ * @brief Gets a registered fuzz target by index, in registration order.
+ * @param index From 0.
+ * @return The target, or NULL past the last one.
+ */
+const bmt_fuzz_target_t* bmt_fuzz_target_at(uint32_t index);
+
+/**
+ * @brief Runs the body once on one input, with the runner's assertion jump redirected so that
+ *        a failing ASSERT_* returns here instead of ending the test.
+ * @param func The body.
+ * @param data The input.
+ * @param size Bytes in `data`.
+ * @return true if no ASSERT_* or EXPECT_* failed.
+ */
+bool bmt_fuzz_run_input(bmt_fuzz_func_t func, const uint8_t* data, size_t size);
+
+/**
+ * @brief Replays the corpus of a target as a regular test. Called by FUZZ_TEST in normal builds.
+ *
+ * Runs the FUZZ_CORPUS inputs and then every input bmt_platform_fuzz_corpus_entry() provides
+ * (on the Linux host, the files of `$BMT_FUZZ_CORPUS/Suite.Name/`, the same directory that
+ * libFuzzer or AFL++ use as corpus). All inputs run even if one fails; each failing input is
+ * printed after its failure report, and the test fails. Prints one summary line:
+ *
+ * @code
+ * [ FUZZ     ] TlvParser.RoundTrip inputs=7 builtin=4 files=3 failures=0 ns_per_input=210.500
+ * [ FUZZ IN  ] TlvParser.RoundTrip source=file index=2 len=5 data=0103414243
+ * @endcode
+ *
+ * @param name "Suite.Name".
+ * @param func The body.
+ */
+void bmt_fuzz_replay(const char* name, bmt_fuzz_func_t func);
+
+/**
+ * @brief Runs the selected target on one input and aborts on failure, so the fuzzer records a
+ *        crash. Entry point shared by LLVMFuzzerTestOneInput() and the AFL++ loop.
+ *
+ * The target is the one named by bmt_platform_fuzz_target(), or the only registered one.
+ *
+ * @param data The input.
+ * @param size Bytes in `data`.
+ * @return 0 (the value libFuzzer expects).
+ */
+int bmt_fuzz_one_input(const uint8_t* data, size_t size);
+
+/**
+ * @brief Serves inputs from a host-side mutator over the platform link (on-target fuzzing).
+ *
+ * Reads frames with bmt_platform_getchar() and runs each input of a batch on the selected
+ * FUZZ_TEST, with failure reports muted (unless the batch is verbose) and the platform fault
+ * guard enabled, so a failing assertion or a crash (data abort, segfault...) costs one input,
+ * not the session. Each batch is answered with one line:
+ *
+ * @code
+ * [ FUZZ SRV ] ready targets=TlvParser.RoundTrip map_bits=8192 frame_max=8192 max_input=4096
+ * [ FUZZ RES ] seq=7 results=P:0:14:5d1f02aa,P:2:17:0e9b3c41,C:0:9:77aa1203
+ * @endcode
+ *
+ * Each result is `status:new:edges:hash`: status P (pass), F (assertion failed) or C (crash),
+ * the edges not seen before, the edges the input hit and a hash of them. The host keeps the
+ * inputs that found new edges, and re-sends failing ones in a verbose batch to get the report.
+ * Edges are only recorded from code built with `-fsanitize-coverage=trace-pc` (GCC) or
+ * `trace-pc-guard` (Clang) and the library built with `-DBMT_FUZZ_COVERAGE`; without it,
+ * `new`, `edges` and `hash` are 0 and the host fuzzes blind. Batches are answered in order,
+ * so the host can send the next one before the previous answer arrives if the receive path
+ * buffers it. See `pyton_parser/bmt_fuzz_host.py`.
+ *
+ * @return Number of inputs that failed or crashed.
+ */
+uint32_t bmt_fuzz_serve(void);
+
+/**
+ * @brief Whether a fault now can be recovered by bmt_fuzz_fault() (an input is running).
+ * @return true while bmt_fuzz_serve() runs an input.
+ */
+bool bmt_fuzz_fault_recoverable(void);
+
+/**
+ * @brief Called from the platform fault handler (see bmt_platform_fuzz_fault_guard()): marks
+ *        the running input as crashed and longjmps back to bmt_fuzz_serve(). Returns only if no
+ *        input is running (the handler should then do what it did before).
+ * @param cause Platform-specific cause (signal number, exception type...), printed verbosely.
+ * @param address Faulting address or PC, if known.
+ */
+void bmt_fuzz_fault(uint32_t cause, uintptr_t address);
+
+/**
+ * @def BMT_FUZZ_INPUT(literal)
+ * @brief A FUZZ_CORPUS entry from a string literal, without its terminating '\0'
+ *        (binary bytes can be written as "\x01\x02").
+ */
+#define BMT_FUZZ_INPUT(literal) { (const uint8_t*)(literal), sizeof(literal) - 1u }
+
+/**
+ * @def FUZZ_CORPUS(TestSuiteName, TestName, ...)
+ * @brief Built-in seed corpus of a FUZZ_TEST, replayed in normal builds on any target
+ *        (it needs no filesystem). The arguments are BMT_FUZZ_INPUT() entries.
+ */
+#define FUZZ_CORPUS(TestSuiteName, TestName, ...) \
+    static const bmt_fuzz_input_t bmt_fuzz_corpus_##TestSuiteName##_##TestName[] = { __VA_ARGS__ }; \
+    __attribute__((constructor)) \
+    static void bmt_fuzz_register_corpus_##TestSuiteName##_##TestName(void) { \
+        bmt_fuzz_register_corpus(#TestSuiteName "." #TestName, bmt_fuzz_corpus_##TestSuiteName##_##TestName, \
+                                 (uint32_t)(sizeof(bmt_fuzz_corpus_##TestSuiteName##_##TestName) / \
+                                            sizeof(bmt_fuzz_corpus_##TestSuiteName##_##TestName[0]))); \
+    }
+
+/** @internal @brief Registration shared by both forms of FUZZ_TEST. */
+#define BMT_FUZZ_DECLARE(TestSuiteName, TestName) \
+    static void bmt_fuzz_body_##TestSuiteName##_##TestName(const uint8_t* data, size_t size); \
+    __attribute__((constructor)) \
+    static void bmt_fuzz_register_##TestSuiteName##_##TestName(void) { \
+        bmt_fuzz_register(#TestSuiteName "." #TestName, bmt_fuzz_body_##TestSuiteName##_##TestName); \
+    }
+
+/**
+ * @def FUZZ_TEST(TestSuiteName, TestName)
+ * @brief Defines a fuzz target. The parameter list follows the macro:
+ *
+ * @code
+ * FUZZ_TEST(TlvParser, RoundTrip)(const uint8_t* data, size_t n) {
+ *     tlv_record_t rec[8];
+ *     int count = tlv_parse(data, n, rec, 8);
+ *     ASSERT_TRUE(count <= 8);
+ * }
+ * @endcode
+ *
+ * - Normal builds: a TEST that replays the corpus (see bmt_fuzz_replay()).
+ * - `-DBMT_FUZZ_BUILD` with `clang -fsanitize=fuzzer,address`: the library defines
+ *   LLVMFuzzerTestOneInput() for the target, and a failing ASSERT_* or EXPECT_* aborts, which
+ *   the fuzzer reports as a crash and saves the input. The same binary runs under AFL++
+ *   (`afl-clang-fast -fsanitize=fuzzer`).
+ * - `-DBMT_FUZZ_AFL` with `afl-clang-fast` and the host main: AFL++ persistent mode
+ *   (`__AFL_LOOP`), reading inputs from shared memory without a fork per input.
+ *
+ * The body should not keep state between inputs: in fuzz builds it runs millions of times in
+ * the same process.
+ *
+ * @param TestSuiteName The name of the test suite.
+ * @param TestName The name of the test case.
+ */
+#ifdef BMT_FUZZ_BUILD
+#define FUZZ_TEST(TestSuiteName, TestName) \
+    BMT_FUZZ_DECLARE(TestSuiteName, TestName) \
+    static void bmt_fuzz_body_##TestSuiteName##_##TestName
+#else
+#define FUZZ_TEST(TestSuiteName, TestName) \
+    BMT_FUZZ_DECLARE(TestSuiteName, TestName) \
+    TEST(TestSuiteName, TestName) { \
+        bmt_fuzz_replay(#TestSuiteName "." #TestName, bmt_fuzz_body_##TestSuiteName##_##TestName); \
+    } \
+    static void bmt_fuzz_body_##TestSuiteName##_##TestName
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_FUZZ_H
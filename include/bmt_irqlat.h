@@ -0,0 +1,114 @@
+// include/bmt_irqlat.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_IRQLAT_H
+#define BMT_IRQLAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bmt_platform_io.h"
+#include "bmt_bench.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Default number of interrupts measured by bmt_irqlat_run().
+ */
+#ifndef BMT_IRQLAT_DEFAULT_ITERATIONS
+#define BMT_IRQLAT_DEFAULT_ITERATIONS 5000
+#endif
+
+/**
+ * @brief Default delay between arming the timer and its fire time, in microseconds.
+ */
+#ifndef BMT_IRQLAT_DEFAULT_DELAY_US
+#define BMT_IRQLAT_DEFAULT_DELAY_US 100
+#endif
+
+/**
+ * @brief Default time to wait past the fire time before counting an interrupt as missed, in microseconds.
+ */
+#ifndef BMT_IRQLAT_DEFAULT_TIMEOUT_US
+#define BMT_IRQLAT_DEFAULT_TIMEOUT_US 100000
+#endif
+
+/**
+ * @brief Maximum length of the histogram names ("<name>/latency"), including the terminator.
+ */
+#define BMT_IRQLAT_NAME_MAX 48
+
+/**
+ * @struct bmt_irqlat_config_t
+ * @brief Configuration of an interrupt latency measurement.
+ *
+ * Initialize it with bmt_irqlat_default_config() and change only the needed fields.
+ */
+typedef struct {
+    uint32_t iterations;       /**< Number of interrupts to measure. */
+    uint32_t delay_us;         /**< Nominal delay from arming to fire time. A pseudo-random jitter of up to
+                                    half of it is added so the fire time does not lock to the load's period. */
+    uint32_t timeout_us;       /**< Wait past the fire time before counting the interrupt as missed. */
+    const char* load_name;     /**< Name of the background load, printed in the report ("none" if NULL). */
+    bmt_bench_func_t load;     /**< Background load, called repeatedly while waiting for the interrupt. NULL to spin. */
+    void* load_ctx;            /**< Context for `load`. */
+    bmt_bench_func_t isr_body; /**< Work done inside the handler, to measure ISR duration. NULL for an empty ISR. */
+    void* isr_ctx;             /**< Context for `isr_body`. */
+} bmt_irqlat_config_t;
+
+/**
+ * @struct bmt_irqlat_result_t
+ * @brief Distributions measured by bmt_irqlat_run(), in nanoseconds.
+ *
+ * Large (two bmt_hist_t): declare it static on targets with small stacks.
+ */
+typedef struct {
+    bmt_hist_t latency;        /**< Scheduled fire time to handler entry. */
+    bmt_hist_t isr_duration;   /**< Handler entry to handler exit (includes `isr_body`). */
+    uint32_t missed;           /**< Interrupts that did not arrive within the timeout. */
+    uint32_t timestamp_ns;     /**< Cost of one bmt_platform_get_hires_ticks() call, already subtracted
+                                    from isr_duration. Latencies below it are not meaningful. */
+    char latency_name[BMT_IRQLAT_NAME_MAX]; /**< Storage for latency.name. */
+    char isr_name[BMT_IRQLAT_NAME_MAX];     /**< Storage for isr_duration.name. */
+} bmt_irqlat_result_t;
+
+/**
+ * @brief Fills a configuration with the defaults (no load, empty ISR).
+ * @param config The configuration to fill.
+ */
+void bmt_irqlat_default_config(bmt_irqlat_config_t* config);
+
+/**
+ * @brief Measures interrupt latency and ISR duration.
+ *
+ * For each iteration it arms a one-shot timer interrupt with bmt_platform_timer_irq_arm()
+ * at a known fire time, runs the background load until the handler has run, and records
+ * the time from the scheduled fire time to the handler entry and the time spent in the
+ * handler. Prints a summary line followed by both histograms (see bmt_hist_report()):
+ *
+ * @code
+ * [ IRQLAT   ] gic_timer iters=5000 missed=0 delay_us=100 load=memcpy timestamp_ns=21
+ * [ HIST     ] gic_timer/latency unit=ns count=5000 min=412 mean=455 p50=447 p90=479 p99=543 p999=1087 max=2310
+ * ...
+ * [ HIST     ] gic_timer/isr unit=ns count=5000 ...
+ * @endcode
+ *
+ * @param name Name of the measurement (no spaces). The histograms are named "<name>/latency" and "<name>/isr".
+ * @param config The configuration.
+ * @param result Output with the distributions.
+ * @return false if the platform has no timer interrupt (nothing is measured), true otherwise.
+ */
+bool bmt_irqlat_run(const char* name, const bmt_irqlat_config_t* config, bmt_irqlat_result_t* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_IRQLAT_H
@@ -0,0 +1,239 @@
+// include/bmt_linearize.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_LINEARIZE_H
+#define BMT_LINEARIZE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "baremetal_test.h"
+#include "bmt_platform_io.h"
+#include "bmt_stress.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Search steps allowed per bmt_lin_check() call. When exhausted, the result is
+ *        BMT_LIN_INCONCLUSIVE instead of spinning for minutes on a pathological history.
+ */
+#ifndef BMT_LIN_MAX_STEPS
+#define BMT_LIN_MAX_STEPS 50000000ULL
+#endif
+
+/**
+ * @brief Slots probed in the search cache before overwriting one.
+ */
+#ifndef BMT_LIN_CACHE_PROBES
+#define BMT_LIN_CACHE_PROBES 8u
+#endif
+
+/**
+ * @brief Operations printed around the one that could not be linearized.
+ */
+#ifndef BMT_LIN_REPORT_OPS
+#define BMT_LIN_REPORT_OPS 8
+#endif
+
+/**
+ * @brief Workspace bytes bmt_lin_check() needs for a history of `ops` operations.
+ *        Whatever is left over after the fixed arrays is used as the search cache.
+ */
+#define BMT_LIN_WORKSPACE_BYTES(ops) ((size_t)(ops) * 160u + 4096u)
+
+/** @name Operation codes of the built-in specifications
+ *  @{ */
+#define BMT_LIN_QUEUE_ENQ  0u  /**< Enqueue `arg`. Record only enqueues that succeeded. */
+#define BMT_LIN_QUEUE_DEQ  1u  /**< Dequeue: `ok` true and the value in `ret`, or `ok` false if it found the queue empty. */
+#define BMT_LIN_STACK_PUSH 0u  /**< Push `arg`. Record only pushes that succeeded. */
+#define BMT_LIN_STACK_POP  1u  /**< Pop: `ok` true and the value in `ret`, or `ok` false if it found the stack empty. */
+#define BMT_LIN_REG_WRITE  0u  /**< Write `arg`. */
+#define BMT_LIN_REG_READ   1u  /**< Read, value in `ret`. The register starts at 0. */
+/** @} */
+
+/**
+ * @struct bmt_lin_op_t
+ * @brief One recorded operation: what was called, what it returned and when.
+ */
+typedef struct {
+    uint64_t invoke;    /**< Timestamp (hires ticks) taken just before the call. */
+    uint64_t response;  /**< Timestamp taken just after it returned. 0 while pending. */
+    uint32_t key;       /**< Object the operation acts on. Operations with different keys are checked
+                             independently (e.g. queue index, register address, set element). */
+    uint32_t arg;       /**< Argument (value enqueued, pushed, written...). */
+    uint32_t ret;       /**< Returned value (value dequeued, popped, read...). */
+    uint8_t op;         /**< Operation code, defined by the specification. */
+    uint8_t ok;         /**< Whether the operation succeeded (e.g. false for a dequeue on an empty queue). */
+    uint8_t core;       /**< Core that ran it. */
+} bmt_lin_op_t;
+
+/**
+ * @struct bmt_lin_log_t
+ * @brief Operation log of one core. Only written by its own core, so recording needs no atomics.
+ */
+typedef struct {
+    bmt_lin_op_t* ops;   /**< This core's share of the buffer. */
+    uint32_t capacity;   /**< Entries in `ops`. */
+    uint32_t count;      /**< Entries used. */
+    uint32_t dropped;    /**< Operations not recorded because the log was full. */
+} __attribute__((aligned(64))) bmt_lin_log_t;
+
+/**
+ * @struct bmt_lin_history_t
+ * @brief A concurrent history: one log per core over a caller-provided buffer.
+ */
+typedef struct {
+    bmt_lin_log_t logs[BMT_STRESS_MAX_CORES];
+    uint32_t cores;      /**< Number of logs in use. */
+} bmt_lin_history_t;
+
+/**
+ * @struct bmt_lin_spec_t
+ * @brief Sequential specification of an object, as an undoable state machine.
+ *
+ * The checker keeps a single state and moves it forwards with apply() and backwards with
+ * undo() while it searches, so the state is never copied.
+ */
+typedef struct {
+    const char* name;                   /**< Printed in the report ("queue"...). */
+    const char* const* op_names;        /**< Names of the operation codes, for the report. */
+    uint32_t num_op_names;              /**< Entries in `op_names`. */
+    /** Bytes of state needed for a sub-history of `ops` operations. */
+    size_t (*state_size)(uint32_t ops);
+    /** Sets the initial state. */
+    void (*init)(void* state, uint32_t ops);
+    /** Applies `op` if its result is valid in `state`; saves what undo() needs in `*undo`. */
+    bool (*apply)(void* state, const bmt_lin_op_t* op, uint64_t* undo);
+    /** Reverts a successful apply() of `op`. */
+    void (*undo)(void* state, const bmt_lin_op_t* op, uint64_t undo);
+    /** Hash of the state (two states with the same behaviour must hash the same). */
+    uint64_t (*hash)(const void* state);
+} bmt_lin_spec_t;
+
+/** @brief FIFO queue of uint32_t values (BMT_LIN_QUEUE_ENQ / BMT_LIN_QUEUE_DEQ). */
+extern const bmt_lin_spec_t bmt_lin_queue_spec;
+/** @brief LIFO stack of uint32_t values (BMT_LIN_STACK_PUSH / BMT_LIN_STACK_POP). */
+extern const bmt_lin_spec_t bmt_lin_stack_spec;
+/** @brief Read/write register of one uint32_t, initially 0 (BMT_LIN_REG_WRITE / BMT_LIN_REG_READ). */
+extern const bmt_lin_spec_t bmt_lin_register_spec;
+
+/**
+ * @brief Result of bmt_lin_check().
+ */
+typedef enum {
+    BMT_LIN_OK = 0,           /**< A linearization exists. */
+    BMT_LIN_VIOLATION,        /**< No linearization exists: the object returned a result that no sequential order explains. */
+    BMT_LIN_INCONCLUSIVE,     /**< Not decided: step budget exhausted, or operations were dropped from a full log. */
+    BMT_LIN_ERROR             /**< The workspace is too small. */
+} bmt_lin_result_t;
+
+/**
+ * @brief Prepares an empty history, splitting `buffer` evenly between `cores` logs.
+ * @param history The history.
+ * @param buffer Preallocated operation storage (usually a static array).
+ * @param capacity Entries in `buffer`.
+ * @param cores Cores that will record (e.g. bmt_stress_num_cores()).
+ */
+void bmt_lin_history_init(bmt_lin_history_t* history, bmt_lin_op_t* buffer, uint32_t capacity, uint32_t cores);
+
+/**
+ * @brief Records the invocation of an operation and takes its invoke timestamp.
+ *        Call it right before the operation, from the core that runs it.
+ * @param history The history.
+ * @param core Calling core (`bmt_core` in a STRESS_TEST).
+ * @param key Object the operation acts on (0 if there is only one).
+ * @param op Operation code.
+ * @param arg Argument.
+ * @return The record to pass to bmt_lin_respond(), or NULL if the log is full (the drop is counted).
+ */
+static inline bmt_lin_op_t* bmt_lin_invoke(bmt_lin_history_t* history, uint32_t core, uint32_t key,
+                                           uint8_t op, uint32_t arg) {
+    bmt_lin_log_t* log = &history->logs[core];
+    if (log->count >= log->capacity) {
+        log->dropped++;
+        return NULL;
+    }
+    bmt_lin_op_t* rec = &log->ops[log->count++];
+    rec->key = key;
+    rec->arg = arg;
+    rec->ret = 0;
+    rec->op = op;
+    rec->ok = 0;
+    rec->core = (uint8_t)core;
+    rec->response = 0;
+    rec->invoke = bmt_platform_get_hires_ticks();
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    return rec;
+}
+
+/**
+ * @brief Records the response of an operation and takes its response timestamp.
+ *        Call it right after the operation returns.
+ * @param rec Record returned by bmt_lin_invoke() (NULL is ignored).
+ * @param ok Whether the operation succeeded.
+ * @param ret Returned value.
+ */
+static inline void bmt_lin_respond(bmt_lin_op_t* rec, bool ok, uint32_t ret) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    uint64_t now = bmt_platform_get_hires_ticks();
+    if (rec) {
+        rec->ok = ok ? 1u : 0u;
+        rec->ret = ret;
+        rec->response = now;
+    }
+}
+
+/**
+ * @brief Checks that a recorded history is linearizable with respect to a specification.
+ *
+ * Run it after the concurrent part has finished (e.g. after bmt_stress_run()). Operations
+ * are grouped by `key` and each object is checked on its own, since a history is
+ * linearizable if and only if every per-object sub-history is (locality, the base case of
+ * P-compositionality). Each sub-history is checked with the Wing & Gong search, with the
+ * cache of visited (linearized set, state) pairs of Lowe's variant. A history of ~10^4
+ * operations from a handful of cores takes milliseconds on a host; the cost grows with how
+ * many operations overlap and, for queues and stacks, with how long the elements stay inside
+ * (keep them short, e.g. each core pushes and then pops). If the step budget runs out the
+ * result is BMT_LIN_INCONCLUSIVE. Pending operations (no response) are ignored.
+ *
+ * Prints a "[ LINCHECK ]" line, and on a violation the operation that could not be placed
+ * together with the operations concurrent with it:
+ *
+ * @code
+ * [ LINCHECK ] queue spec=queue ops=6400 objects=1 steps=6400 evictions=0 result=ok
+ * @endcode
+ *
+ * @param name Name printed in the report.
+ * @param history The history.
+ * @param spec The sequential specification.
+ * @param workspace Scratch memory, at least BMT_LIN_WORKSPACE_BYTES(number of operations) bytes.
+ * @param workspace_size Bytes in `workspace`.
+ * @return The verdict.
+ */
+bmt_lin_result_t bmt_lin_check(const char* name, const bmt_lin_history_t* history, const bmt_lin_spec_t* spec,
+                               void* workspace, size_t workspace_size);
+
+/**
+ * @def ASSERT_LINEARIZABLE(history, spec, workspace)
+ * @brief Asserts that a history is linearizable (see bmt_lin_check()).
+ * @param history The bmt_lin_history_t (not a pointer); its name is used in the report.
+ * @param spec Pointer to the specification (e.g. &bmt_lin_queue_spec).
+ * @param workspace An array used as scratch memory (its size is taken with sizeof).
+ */
+#define ASSERT_LINEARIZABLE(history, spec, workspace) \
+    BMT_ASSERT_COMMON(bmt_lin_check(#history, &(history), (spec), (workspace), sizeof(workspace)) == BMT_LIN_OK, \
+                      "ASSERT_LINEARIZABLE", #history, NULL)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_LINEARIZE_H
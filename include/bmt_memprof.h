@@ -0,0 +1,115 @@
+// include/bmt_memprof.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_MEMPROF_H
+#define BMT_MEMPROF_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "bmt_platform_io.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum number of working-set sizes measured per region (powers of two).
+ */
+#define BMT_MEMPROF_MAX_POINTS 24
+
+/**
+ * @brief Maximum number of regions kept by the calibration registry.
+ */
+#define BMT_MEMPROF_MAX_REGIONS 4
+
+/**
+ * @brief Stride of the pointer chase, in bytes. One node per cache line so that every
+ *        load touches a new line. 64 covers Cortex-A9/A53 and x86.
+ */
+#ifndef BMT_MEMPROF_LINE_SIZE
+#define BMT_MEMPROF_LINE_SIZE 64
+#endif
+
+/**
+ * @brief Minimum number of bytes (or loads x line size) timed per measurement, so short
+ *        working sets are repeated long enough to dominate the timer resolution.
+ */
+#ifndef BMT_MEMPROF_MIN_BYTES
+#define BMT_MEMPROF_MIN_BYTES (1u << 20)
+#endif
+
+/**
+ * @struct bmt_memprof_point_t
+ * @brief Measurements for one working-set size.
+ */
+typedef struct {
+    uint32_t working_set;     /**< Working-set size in bytes. */
+    uint32_t latency_ps;      /**< Load-to-use latency of a dependent load (randomized pointer chase). */
+    uint32_t read_mbps;       /**< Sequential read bandwidth, MB/s (10^6 bytes). */
+    uint32_t write_mbps;      /**< Sequential write bandwidth, MB/s. */
+    uint32_t copy_mbps;       /**< Copy bandwidth (bytes copied), MB/s. */
+} bmt_memprof_point_t;
+
+/**
+ * @struct bmt_memprof_profile_t
+ * @brief Memory profile of one region: one point per working-set size.
+ */
+typedef struct {
+    const char* region;                              /**< Name of the region (e.g. "DDR", "OCM"). */
+    uint32_t num_points;                             /**< Valid entries in `points`. */
+    bmt_memprof_point_t points[BMT_MEMPROF_MAX_POINTS]; /**< Sorted by increasing working set. */
+} bmt_memprof_profile_t;
+
+/**
+ * @brief Measures a memory region and prints its profile.
+ *
+ * For each power-of-two working set from `min_working_set` up to `size` it runs a
+ * randomized pointer chase (latency) and read/write/copy sweeps (bandwidth), timed with
+ * bmt_platform_get_hires_ticks(), and prints one line per working set:
+ *
+ * @code
+ * [ MEMPROF  ] region=DDR ws=32768 latency_ns=1.402 read_mbps=21034 write_mbps=15220 copy_mbps=9876
+ * @endcode
+ *
+ * The buffer contents are destroyed. The profile is also stored in the calibration
+ * registry (see bmt_memprof_find()) so later performance tests can use it.
+ *
+ * @param region Name of the region, without spaces.
+ * @param buffer Start of the region. Should be aligned to BMT_MEMPROF_LINE_SIZE.
+ * @param size Size of the region in bytes.
+ * @param min_working_set Smallest working set to measure (rounded up to a power of two, at least 1 KiB).
+ * @return The stored profile, or NULL if the registry is full (results are still printed).
+ */
+const bmt_memprof_profile_t* bmt_memprof_run(const char* region, void* buffer, size_t size, size_t min_working_set);
+
+/**
+ * @brief Finds the calibration profile of a region measured earlier with bmt_memprof_run().
+ * @param region Name of the region.
+ * @return The profile, or NULL if the region has not been measured.
+ */
+const bmt_memprof_profile_t* bmt_memprof_find(const char* region);
+
+/**
+ * @brief Looks up the point of a profile that covers a given working set: the smallest
+ *        measured working set greater than or equal to `bytes` (or the largest one).
+ *
+ * Performance tests use it to derive expectations from the calibration, e.g.
+ * "copying 64 KiB must reach at least 80 % of the measured copy bandwidth".
+ *
+ * @param profile The profile.
+ * @param bytes Working set of the code under test.
+ * @return The matching point, or NULL if the profile is empty.
+ */
+const bmt_memprof_point_t* bmt_memprof_lookup(const bmt_memprof_profile_t* profile, size_t bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_MEMPROF_H
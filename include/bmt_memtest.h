@@ -0,0 +1,101 @@
+// include/bmt_memtest.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_MEMTEST_H
+#define BMT_MEMTEST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "bmt_platform_io.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Data and address bus test: walking ones and zeros through one cell, then one
+ *        address line at a time (power-of-two offsets). Fast; run first on a new board.
+ */
+#define BMT_MEMTEST_WALKING_ONES    (1u << 0)
+
+/**
+ * @brief Address-in-address: every cell holds its own address, then its complement.
+ *        Finds address decoder faults (aliased or unreachable cells).
+ */
+#define BMT_MEMTEST_ADDRESS         (1u << 1)
+
+/**
+ * @brief March C-: {⇕(w0); ⇑(r0,w1); ⇑(r1,w0); ⇓(r0,w1); ⇓(r1,w0); ⇕(r0)}, with all-zero
+ *        and all-one cells. Finds stuck-at, transition and coupling faults.
+ */
+#define BMT_MEMTEST_MARCH_C_MINUS   (1u << 2)
+
+/**
+ * @brief Moving inversions: {⇑(w p); ⇑(r p,w ~p); ⇓(r ~p,w p)} for the patterns 0x55..,
+ *        0x33.., 0x0F.. and 0x00FF.., then ⇑(r p) of the last one. Finds pattern-sensitive faults.
+ */
+#define BMT_MEMTEST_MOVING_INV      (1u << 3)
+
+/** @brief All the tests above. */
+#define BMT_MEMTEST_ALL             0xFu
+
+/** @brief Number of tests (entries of the `results` array of bmt_memtest_run()). */
+#define BMT_MEMTEST_NUM_TESTS       4
+
+/**
+ * @struct bmt_memtest_result_t
+ * @brief Result of one test on one region.
+ */
+typedef struct {
+    const char* test;       /**< Name of the test ("walking_ones", "address", "march_c-", "moving_inv"), NULL if not run. */
+    uint64_t errors;        /**< 64-bit words that read back wrong. */
+    uintptr_t first_addr;   /**< Address of the first wrong word. */
+    uint64_t expected;      /**< Value expected at `first_addr`. */
+    uint64_t actual;        /**< Value read at `first_addr`. */
+    uint64_t bytes;         /**< Bytes read plus bytes written. */
+    uint32_t mbps;          /**< Throughput, MB/s (10^6 bytes) of reads plus writes. */
+} bmt_memtest_result_t;
+
+/**
+ * @brief Runs RAM tests on a region and prints one line per test:
+ *
+ * @code
+ * [ MEMTEST  ] region=DDR algo=march_c- size=16777216 cell=16 errors=0 mbps=9340
+ * @endcode
+ *
+ * Accesses are as wide as the target allows (16-byte NEON or SSE2 cells, otherwise 64-bit
+ * words). A test with errors adds `first_addr`, `expected` and `actual` (hex) to its line and
+ * reports a non-fatal "MEMTEST" failure (like an EXPECT_*), so the rest of the tests still run.
+ *
+ * The contents of the region are destroyed. The tests go through the data cache: to test the
+ * memory rather than the cache, the region must be several times larger than the last cache
+ * level, or mapped as non-cacheable.
+ *
+ * @param region Name of the region, without spaces.
+ * @param base Start of the region. Rounded up to the cell size.
+ * @param size Size of the region in bytes. Rounded down to whole cells.
+ * @param tests Bitmask of BMT_MEMTEST_* tests to run.
+ * @param results Optional array of BMT_MEMTEST_NUM_TESTS entries, in the order of the bits above.
+ * @return Total number of wrong words.
+ */
+uint64_t bmt_memtest_run(const char* region, void* base, size_t size, uint32_t tests,
+                         bmt_memtest_result_t* results);
+
+/**
+ * @brief Runs bmt_memtest_run() on every region declared by bmt_platform_memtest_region().
+ * @param tests Bitmask of BMT_MEMTEST_* tests to run.
+ * @return Total number of wrong words in all regions.
+ */
+uint64_t bmt_memtest_run_regions(uint32_t tests);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_MEMTEST_H
@@ -0,0 +1,372 @@
+// include/bmt_mock.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_MOCK_H
+#define BMT_MOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "baremetal_test.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Calls whose arguments each mock records (later calls are only counted).
+ */
+#ifndef BMT_MOCK_MAX_HISTORY
+#define BMT_MOCK_MAX_HISTORY 16
+#endif
+
+/**
+ * @brief Length of a scripted return sequence (BMT_MOCK_RETURNS).
+ */
+#ifndef BMT_MOCK_MAX_RETURNS
+#define BMT_MOCK_MAX_RETURNS 16
+#endif
+
+/**
+ * @brief Maximum number of mocks in the image (each registers itself to be reset per test).
+ */
+#ifndef BMT_MOCK_MAX_MOCKS
+#define BMT_MOCK_MAX_MOCKS 64
+#endif
+
+/**
+ * @brief Calls kept in the global call log, across all mocks, for EXPECT_MOCK_CALL_ORDER.
+ */
+#ifndef BMT_MOCK_LOG_SIZE
+#define BMT_MOCK_LOG_SIZE 64
+#endif
+
+/**
+ * @brief Registers the state of a mock so bmt_mock_reset_all() clears it.
+ *        Called from a constructor generated by BMT_MOCK_VALUE / BMT_MOCK_VOID.
+ * @param name Name of the mocked function.
+ * @param state The `<name>_mock` structure.
+ * @param size Its size.
+ */
+void bmt_mock_register(const char* name, void* state, size_t size);
+
+/**
+ * @brief Counts a call of a mock and appends it to the global call log. Called by the fakes.
+ * @param name Name of the mocked function (the pointer registered by the mock).
+ * @param call_count The `call_count` field of the mock.
+ * @return Index of this call (the call count before it).
+ */
+uint32_t bmt_mock_record(const char* name, uint32_t* call_count);
+
+/**
+ * @brief Zeroes every registered mock (counts, histories, return values, custom fakes) and
+ *        the call log. The runner calls it before each test.
+ */
+void bmt_mock_reset_all(void);
+
+/**
+ * @brief Checks that the mocks were called in this order. Other calls may come in between,
+ *        so `{"a", "c"}` matches the log `a b c`.
+ * @param names Mocked function names, in the expected order.
+ * @param count Number of names.
+ * @return true if the call log contains them as a subsequence.
+ */
+bool bmt_mock_called_in_order(const char* const* names, uint32_t count);
+
+/** @internal @brief Helpers to expand one mock per arity (0 to 6 arguments). */
+#define BMT_MOCK_CAT_(a, b) a##b
+#define BMT_MOCK_CAT(a, b) BMT_MOCK_CAT_(a, b)
+#define BMT_MOCK_NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+#define BMT_MOCK_NARGS(...) BMT_MOCK_NARGS_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define BMT_MOCK_FIRST_(a, ...) a
+#define BMT_MOCK_FIRST(...) BMT_MOCK_FIRST_(__VA_ARGS__, ~)
+#define BMT_MOCK_EXPAND(kind, ...) BMT_MOCK_CAT(kind, BMT_MOCK_NARGS(__VA_ARGS__))
+#define BMT_MOCK_APPLY(macro, args) macro args  // Expands `args` before `macro` pastes them
+
+// Parameter list of the fake; the first argument (the function name) is ignored
+#define BMT_MOCK_P_1(n) void
+#define BMT_MOCK_P_2(n, t0) t0 bmt_a0
+#define BMT_MOCK_P_3(n, t0, t1) t0 bmt_a0, t1 bmt_a1
+#define BMT_MOCK_P_4(n, t0, t1, t2) t0 bmt_a0, t1 bmt_a1, t2 bmt_a2
+#define BMT_MOCK_P_5(n, t0, t1, t2, t3) t0 bmt_a0, t1 bmt_a1, t2 bmt_a2, t3 bmt_a3
+#define BMT_MOCK_P_6(n, t0, t1, t2, t3, t4) t0 bmt_a0, t1 bmt_a1, t2 bmt_a2, t3 bmt_a3, t4 bmt_a4
+#define BMT_MOCK_P_7(n, t0, t1, t2, t3, t4, t5) t0 bmt_a0, t1 bmt_a1, t2 bmt_a2, t3 bmt_a3, t4 bmt_a4, t5 bmt_a5
+#define BMT_MOCK_PARAMS(...) BMT_MOCK_EXPAND(BMT_MOCK_P_, __VA_ARGS__)(__VA_ARGS__)
+
+// Argument list, to forward the call to a custom fake
+#define BMT_MOCK_A_1(n)
+#define BMT_MOCK_A_2(n, t0) bmt_a0
+#define BMT_MOCK_A_3(n, t0, t1) bmt_a0, bmt_a1
+#define BMT_MOCK_A_4(n, t0, t1, t2) bmt_a0, bmt_a1, bmt_a2
+#define BMT_MOCK_A_5(n, t0, t1, t2, t3) bmt_a0, bmt_a1, bmt_a2, bmt_a3
+#define BMT_MOCK_A_6(n, t0, t1, t2, t3, t4) bmt_a0, bmt_a1, bmt_a2, bmt_a3, bmt_a4
+#define BMT_MOCK_A_7(n, t0, t1, t2, t3, t4, t5) bmt_a0, bmt_a1, bmt_a2, bmt_a3, bmt_a4, bmt_a5
+#define BMT_MOCK_ARGS(...) BMT_MOCK_EXPAND(BMT_MOCK_A_, __VA_ARGS__)(__VA_ARGS__)
+
+// One history array per argument
+#define BMT_MOCK_HIST(t, i) t arg##i##_history[BMT_MOCK_MAX_HISTORY];
+#define BMT_MOCK_F_1(n)
+#define BMT_MOCK_F_2(n, t0) BMT_MOCK_HIST(t0, 0)
+#define BMT_MOCK_F_3(n, t0, t1) BMT_MOCK_F_2(n, t0) BMT_MOCK_HIST(t1, 1)
+#define BMT_MOCK_F_4(n, t0, t1, t2) BMT_MOCK_F_3(n, t0, t1) BMT_MOCK_HIST(t2, 2)
+#define BMT_MOCK_F_5(n, t0, t1, t2, t3) BMT_MOCK_F_4(n, t0, t1, t2) BMT_MOCK_HIST(t3, 3)
+#define BMT_MOCK_F_6(n, t0, t1, t2, t3, t4) BMT_MOCK_F_5(n, t0, t1, t2, t3) BMT_MOCK_HIST(t4, 4)
+#define BMT_MOCK_F_7(n, t0, t1, t2, t3, t4, t5) BMT_MOCK_F_6(n, t0, t1, t2, t3, t4) BMT_MOCK_HIST(t5, 5)
+#define BMT_MOCK_FIELDS(...) BMT_MOCK_EXPAND(BMT_MOCK_F_, __VA_ARGS__)(__VA_ARGS__)
+
+// Stores the arguments of call `c` of mock state `m`
+#define BMT_MOCK_SET(m, c, i) (m).arg##i##_history[c] = bmt_a##i;
+#define BMT_MOCK_R_1(m, c, n)
+#define BMT_MOCK_R_2(m, c, n, t0) BMT_MOCK_SET(m, c, 0)
+#define BMT_MOCK_R_3(m, c, n, t0, t1) BMT_MOCK_R_2(m, c, n, t0) BMT_MOCK_SET(m, c, 1)
+#define BMT_MOCK_R_4(m, c, n, t0, t1, t2) BMT_MOCK_R_3(m, c, n, t0, t1) BMT_MOCK_SET(m, c, 2)
+#define BMT_MOCK_R_5(m, c, n, t0, t1, t2, t3) BMT_MOCK_R_4(m, c, n, t0, t1, t2) BMT_MOCK_SET(m, c, 3)
+#define BMT_MOCK_R_6(m, c, n, t0, t1, t2, t3, t4) BMT_MOCK_R_5(m, c, n, t0, t1, t2, t3) BMT_MOCK_SET(m, c, 4)
+#define BMT_MOCK_R_7(m, c, n, t0, t1, t2, t3, t4, t5) BMT_MOCK_R_6(m, c, n, t0, t1, t2, t3, t4) BMT_MOCK_SET(m, c, 5)
+#define BMT_MOCK_STORE(m, c, ...) BMT_MOCK_EXPAND(BMT_MOCK_R_, __VA_ARGS__)(m, c, __VA_ARGS__)
+
+// Compares the arguments of call `c` of mock state `m` with the expected values
+#define BMT_MOCK_CMP(m, c, i, v) ((m).arg##i##_history[c] == (v))
+#define BMT_MOCK_M_1(m, c, v0) BMT_MOCK_CMP(m, c, 0, v0)
+#define BMT_MOCK_M_2(m, c, v0, v1) BMT_MOCK_M_1(m, c, v0) && BMT_MOCK_CMP(m, c, 1, v1)
+#define BMT_MOCK_M_3(m, c, v0, v1, v2) BMT_MOCK_M_2(m, c, v0, v1) && BMT_MOCK_CMP(m, c, 2, v2)
+#define BMT_MOCK_M_4(m, c, v0, v1, v2, v3) BMT_MOCK_M_3(m, c, v0, v1, v2) && BMT_MOCK_CMP(m, c, 3, v3)
+#define BMT_MOCK_M_5(m, c, v0, v1, v2, v3, v4) BMT_MOCK_M_4(m, c, v0, v1, v2, v3) && BMT_MOCK_CMP(m, c, 4, v4)
+#define BMT_MOCK_M_6(m, c, v0, v1, v2, v3, v4, v5) BMT_MOCK_M_5(m, c, v0, v1, v2, v3, v4) && BMT_MOCK_CMP(m, c, 5, v5)
+#define BMT_MOCK_MATCH(m, c, ...) (BMT_MOCK_CAT(BMT_MOCK_M_, BMT_MOCK_NARGS(__VA_ARGS__))(m, c, __VA_ARGS__))
+
+#define BMT_MOCK_DECLARE_VALUE_(ret, name, ...) \
+    typedef ret name##_mock_ret_t; \
+    typedef struct { \
+        uint32_t call_count; \
+        ret return_val; \
+        ret return_seq[BMT_MOCK_MAX_RETURNS]; \
+        uint32_t return_seq_len; \
+        ret (*custom_fake)(BMT_MOCK_PARAMS(__VA_ARGS__)); \
+        BMT_MOCK_FIELDS(__VA_ARGS__) \
+    } name##_mock_t; \
+    extern name##_mock_t name##_mock
+
+#define BMT_MOCK_DECLARE_VOID_(name, ...) \
+    typedef struct { \
+        uint32_t call_count; \
+        void (*custom_fake)(BMT_MOCK_PARAMS(__VA_ARGS__)); \
+        BMT_MOCK_FIELDS(__VA_ARGS__) \
+    } name##_mock_t; \
+    extern name##_mock_t name##_mock
+
+#define BMT_MOCK_STATE_(name) \
+    name##_mock_t name##_mock; \
+    __attribute__((constructor)) \
+    static void bmt_mock_register_##name(void) { \
+        bmt_mock_register(#name, &name##_mock, sizeof(name##_mock)); \
+    }
+
+#define BMT_MOCK_DEFINE_VALUE_(symbol, ret, name, ...) \
+    BMT_MOCK_STATE_(name) \
+    ret symbol(BMT_MOCK_PARAMS(__VA_ARGS__)) { \
+        uint32_t bmt_call = bmt_mock_record(#name, &name##_mock.call_count); \
+        if (bmt_call < BMT_MOCK_MAX_HISTORY) { \
+            BMT_MOCK_STORE(name##_mock, bmt_call, __VA_ARGS__) \
+        } \
+        if (name##_mock.custom_fake != NULL) { \
+            return name##_mock.custom_fake(BMT_MOCK_ARGS(__VA_ARGS__)); \
+        } \
+        if (name##_mock.return_seq_len > 0) { \
+            uint32_t bmt_last = name##_mock.return_seq_len - 1u; \
+            return name##_mock.return_seq[(bmt_call < bmt_last) ? bmt_call : bmt_last]; \
+        } \
+        return name##_mock.return_val; \
+    } \
+    extern name##_mock_t name##_mock  /* Takes the ';' after the macro */
+
+#define BMT_MOCK_DEFINE_VOID_(symbol, name, ...) \
+    BMT_MOCK_STATE_(name) \
+    void symbol(BMT_MOCK_PARAMS(__VA_ARGS__)) { \
+        uint32_t bmt_call = bmt_mock_record(#name, &name##_mock.call_count); \
+        if (bmt_call < BMT_MOCK_MAX_HISTORY) { \
+            BMT_MOCK_STORE(name##_mock, bmt_call, __VA_ARGS__) \
+        } \
+        if (name##_mock.custom_fake != NULL) { \
+            name##_mock.custom_fake(BMT_MOCK_ARGS(__VA_ARGS__)); \
+        } \
+    } \
+    extern name##_mock_t name##_mock
+
+/**
+ * @def BMT_MOCK_DECLARE_VALUE(ret, name, arg_types...)
+ * @brief Declares the state `<name>_mock` of a mock defined in another file (for a header
+ *        shared by several test files). The defining file uses BMT_MOCK_DEFINE_VALUE.
+ */
+#define BMT_MOCK_DECLARE_VALUE(ret, ...) \
+    BMT_MOCK_APPLY(BMT_MOCK_DECLARE_VALUE_, (ret, BMT_MOCK_FIRST(__VA_ARGS__), __VA_ARGS__))
+
+/**
+ * @def BMT_MOCK_DECLARE_VOID(name, arg_types...)
+ * @brief Like BMT_MOCK_DECLARE_VALUE, for a function returning void.
+ */
+#define BMT_MOCK_DECLARE_VOID(...) \
+    BMT_MOCK_APPLY(BMT_MOCK_DECLARE_VOID_, (BMT_MOCK_FIRST(__VA_ARGS__), __VA_ARGS__))
+
+/**
+ * @def BMT_MOCK_DEFINE_VALUE(ret, name, arg_types...)
+ * @brief Defines a mock declared with BMT_MOCK_DECLARE_VALUE (see BMT_MOCK_VALUE).
+ */
+#define BMT_MOCK_DEFINE_VALUE(ret, ...) \
+    BMT_MOCK_APPLY(BMT_MOCK_DEFINE_VALUE_, (BMT_MOCK_FIRST(__VA_ARGS__), ret, BMT_MOCK_FIRST(__VA_ARGS__), __VA_ARGS__))
+
+/**
+ * @def BMT_MOCK_DEFINE_VOID(name, arg_types...)
+ * @brief Defines a mock declared with BMT_MOCK_DECLARE_VOID (see BMT_MOCK_VOID).
+ */
+#define BMT_MOCK_DEFINE_VOID(...) \
+    BMT_MOCK_APPLY(BMT_MOCK_DEFINE_VOID_, (BMT_MOCK_FIRST(__VA_ARGS__), BMT_MOCK_FIRST(__VA_ARGS__), __VA_ARGS__))
+
+/**
+ * @def BMT_MOCK_VALUE(ret, name, arg_types...)
+ * @brief Defines a fake of `ret name(arg_types...)` (0 to 6 arguments) and its state `name_mock`.
+ *
+ * The fake replaces the real function at link time: build the test image without the
+ * object that defines it (e.g. the BSP driver), or declare the real one weak. Each call is
+ * counted, its arguments are stored in `name_mock.argN_history[call]` (first
+ * BMT_MOCK_MAX_HISTORY calls) and it returns, in order of priority:
+ * - `name_mock.custom_fake(args...)` if set;
+ * - the sequence given with BMT_MOCK_RETURNS, whose last value repeats once exhausted;
+ * - `name_mock.return_val` (0 unless set).
+ *
+ * Nothing is allocated: the state is one static structure per mock, zeroed by the runner
+ * before each test. Mocks are not thread-safe (do not call them from a STRESS_TEST body).
+ *
+ * @code
+ * BMT_MOCK_VALUE(s32, XUartPs_Recv, XUartPs*, u8*, u32);
+ *
+ * TEST(Link, ReadsHeader) {
+ *     BMT_MOCK_RETURNS(XUartPs_Recv, 0, 0, 4);
+ *     ASSERT_EQ(link_read_header(&uart), 0);
+ *     EXPECT_MOCK_CALLS(XUartPs_Recv, 3);
+ *     EXPECT_MOCK_CALLED_WITH(XUartPs_Recv, 2, &uart, BMT_MOCK_ARG(XUartPs_Recv, 2, 1), 4u);
+ * }
+ * @endcode
+ *
+ * Argument types that are arrays or function pointers need a typedef.
+ */
+#define BMT_MOCK_VALUE(ret, ...) \
+    BMT_MOCK_DECLARE_VALUE(ret, __VA_ARGS__); \
+    BMT_MOCK_DEFINE_VALUE(ret, __VA_ARGS__)
+
+/**
+ * @def BMT_MOCK_VOID(name, arg_types...)
+ * @brief Like BMT_MOCK_VALUE, for a function returning void (only custom_fake applies).
+ */
+#define BMT_MOCK_VOID(...) \
+    BMT_MOCK_DECLARE_VOID(__VA_ARGS__); \
+    BMT_MOCK_DEFINE_VOID(__VA_ARGS__)
+
+/**
+ * @def BMT_MOCK_WRAP_VALUE(ret, name, arg_types...)
+ * @brief Like BMT_MOCK_VALUE, but defines `__wrap_name` for `-Wl,--wrap=name`, so the real
+ *        function stays linked and a custom fake can call it as `__real_name`.
+ *
+ * With `--wrap`, only calls from other translation units go through the mock.
+ */
+#define BMT_MOCK_WRAP_VALUE(ret, ...) \
+    BMT_MOCK_DECLARE_VALUE(ret, __VA_ARGS__); \
+    ret BMT_MOCK_CAT(__real_, BMT_MOCK_FIRST(__VA_ARGS__))(BMT_MOCK_PARAMS(__VA_ARGS__)); \
+    BMT_MOCK_APPLY(BMT_MOCK_DEFINE_VALUE_, \
+                   (BMT_MOCK_CAT(__wrap_, BMT_MOCK_FIRST(__VA_ARGS__)), ret, BMT_MOCK_FIRST(__VA_ARGS__), __VA_ARGS__))
+
+/**
+ * @def BMT_MOCK_WRAP_VOID(name, arg_types...)
+ * @brief Like BMT_MOCK_WRAP_VALUE, for a function returning void.
+ */
+#define BMT_MOCK_WRAP_VOID(...) \
+    BMT_MOCK_DECLARE_VOID(__VA_ARGS__); \
+    void BMT_MOCK_CAT(__real_, BMT_MOCK_FIRST(__VA_ARGS__))(BMT_MOCK_PARAMS(__VA_ARGS__)); \
+    BMT_MOCK_APPLY(BMT_MOCK_DEFINE_VOID_, \
+                   (BMT_MOCK_CAT(__wrap_, BMT_MOCK_FIRST(__VA_ARGS__)), BMT_MOCK_FIRST(__VA_ARGS__), __VA_ARGS__))
+
+/**
+ * @def BMT_MOCK_RETURNS(name, values...)
+ * @brief Scripts the values returned by the next calls (up to BMT_MOCK_MAX_RETURNS; the
+ *        last one repeats). Counts from the first call of the test.
+ */
+#define BMT_MOCK_RETURNS(name, ...) \
+    do { \
+        const name##_mock_ret_t bmt_seq[] = { __VA_ARGS__ }; \
+        uint32_t bmt_n = (uint32_t)(sizeof(bmt_seq) / sizeof(bmt_seq[0])); \
+        if (bmt_n > BMT_MOCK_MAX_RETURNS) { \
+            bmt_n = BMT_MOCK_MAX_RETURNS; \
+        } \
+        for (uint32_t bmt_i = 0; bmt_i < bmt_n; ++bmt_i) { \
+            name##_mock.return_seq[bmt_i] = bmt_seq[bmt_i]; \
+        } \
+        name##_mock.return_seq_len = bmt_n; \
+    } while (0)
+
+/**
+ * @def BMT_MOCK_ARG(name, call, index)
+ * @brief Argument `index` (0-based) of call `call` (0-based, < BMT_MOCK_MAX_HISTORY).
+ */
+#define BMT_MOCK_ARG(name, call, index) (name##_mock.arg##index##_history[(call)])
+
+/**
+ * @def EXPECT_MOCK_CALLS(name, count)
+ * @brief Expects the mock to have been called exactly `count` times in this test.
+ */
+#define EXPECT_MOCK_CALLS(name, count) \
+    BMT_EXPECT_COMMON(name##_mock.call_count == (uint32_t)(count), "EXPECT_MOCK_CALLS", #name " called " #count " times", \
+                      "Expected: %ld, Actual: %ld", (long)(count), (long)name##_mock.call_count)
+
+/**
+ * @def ASSERT_MOCK_CALLS(name, count)
+ * @brief Like EXPECT_MOCK_CALLS, but terminates the test on failure.
+ */
+#define ASSERT_MOCK_CALLS(name, count) \
+    BMT_ASSERT_COMMON(name##_mock.call_count == (uint32_t)(count), "ASSERT_MOCK_CALLS", #name " called " #count " times", \
+                      "Expected: %ld, Actual: %ld", (long)(count), (long)name##_mock.call_count)
+
+/**
+ * @def EXPECT_MOCK_CALLED_WITH(name, call, values...)
+ * @brief Expects call `call` (0-based) of the mock to have received these arguments
+ *        (compared with ==; give as many values as the function has arguments).
+ */
+#define EXPECT_MOCK_CALLED_WITH(name, call, ...) \
+    BMT_EXPECT_COMMON((call) < name##_mock.call_count && (call) < BMT_MOCK_MAX_HISTORY && \
+                          BMT_MOCK_MATCH(name##_mock, (call), __VA_ARGS__), \
+                      "EXPECT_MOCK_CALLED_WITH", #name " call " #call " with (" #__VA_ARGS__ ")", \
+                      "Calls: %ld", (long)name##_mock.call_count)
+
+/**
+ * @def EXPECT_MOCK_CALL_ORDER(names...)
+ * @brief Expects the named mocks to have been called in this order (see bmt_mock_called_in_order()).
+ *        Names are given as identifiers: `EXPECT_MOCK_CALL_ORDER(led_on, uart_send, led_off)`.
+ */
+#define EXPECT_MOCK_CALL_ORDER(...) \
+    do { \
+        static const char* const bmt_order[] = { BMT_MOCK_STRINGS(__VA_ARGS__) }; \
+        BMT_EXPECT_COMMON(bmt_mock_called_in_order(bmt_order, (uint32_t)(sizeof(bmt_order) / sizeof(bmt_order[0]))), \
+                          "EXPECT_MOCK_CALL_ORDER", #__VA_ARGS__, NULL); \
+    } while (0)
+
+// Stringifies up to 8 names for EXPECT_MOCK_CALL_ORDER
+#define BMT_MOCK_Q_1(a) #a
+#define BMT_MOCK_Q_2(a, ...) #a, BMT_MOCK_Q_1(__VA_ARGS__)
+#define BMT_MOCK_Q_3(a, ...) #a, BMT_MOCK_Q_2(__VA_ARGS__)
+#define BMT_MOCK_Q_4(a, ...) #a, BMT_MOCK_Q_3(__VA_ARGS__)
+#define BMT_MOCK_Q_5(a, ...) #a, BMT_MOCK_Q_4(__VA_ARGS__)
+#define BMT_MOCK_Q_6(a, ...) #a, BMT_MOCK_Q_5(__VA_ARGS__)
+#define BMT_MOCK_Q_7(a, ...) #a, BMT_MOCK_Q_6(__VA_ARGS__)
+#define BMT_MOCK_Q_8(a, ...) #a, BMT_MOCK_Q_7(__VA_ARGS__)
+#define BMT_MOCK_STRINGS(...) BMT_MOCK_CAT(BMT_MOCK_Q_, BMT_MOCK_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_MOCK_H
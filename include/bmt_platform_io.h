@@ -11,6 +11,8 @@
 #define BMT_PLATFORM_IO_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,8 +47,208 @@ void bmt_platform_puts(const char *str);
  */
 uint32_t bmt_platform_get_msec_ticks(void);
 
+/**
+ * @brief Gets a free-running high-resolution timestamp (CPU cycles, global timer ticks, ns...).
+ *        Used by the benchmark helpers declared in bmt_bench.h.
+ * @return Current high-resolution timestamp. Must be monotonic and must not wrap during a run.
+ * @note Optional. The framework provides a weak default that falls back to
+ *       bmt_platform_get_msec_ticks(), which is far too coarse for micro-benchmarks.
+ *       To support virtual time (bmt_vclock.h), return the value of bmt_vclock_read()
+ *       here and in bmt_platform_get_msec_ticks() when it returns true.
+ */
+uint64_t bmt_platform_get_hires_ticks(void);
+
+/**
+ * @brief Gets the frequency of the timestamp returned by bmt_platform_get_hires_ticks().
+ * @return Ticks per second.
+ * @note Optional. The weak default returns 1000 to match the millisecond fallback.
+ */
+uint32_t bmt_platform_get_hires_tick_hz(void);
+
+/**
+ * @brief Handler called from interrupt context by a timer armed with bmt_platform_timer_irq_arm().
+ */
+typedef void (*bmt_platform_irq_handler_t)(void);
+
+/**
+ * @brief Arms a one-shot timer interrupt that fires when bmt_platform_get_hires_ticks()
+ *        reaches `fire_at`. Used by the interrupt latency harness (bmt_irqlat.h).
+ *
+ * The platform ISR must call `handler` as early as possible (it timestamps its own entry)
+ * and leave the timer disarmed. A comparator on the same counter as
+ * bmt_platform_get_hires_ticks() (e.g. the Cortex-A9 global timer) gives exact fire times.
+ *
+ * @param fire_at Absolute fire time, in high-resolution ticks.
+ * @param handler Function to call from the ISR.
+ * @return true if the timer was armed, false if the platform has no timer interrupt.
+ * @note Optional. The weak default returns false.
+ */
+bool bmt_platform_timer_irq_arm(uint64_t fire_at, bmt_platform_irq_handler_t handler);
+
+/**
+ * @brief Disarms the timer interrupt armed with bmt_platform_timer_irq_arm(), if pending.
+ * @note Optional. The weak default does nothing.
+ */
+void bmt_platform_timer_irq_cancel(void);
+
+/**
+ * @brief Gets the number of cores available for stress tests (bmt_stress.h), including core 0.
+ * @return Number of cores.
+ * @note Optional. The weak default returns 1 (stress tests run on core 0 only).
+ */
+uint32_t bmt_platform_num_cores(void);
+
+/**
+ * @brief Gets the index of the calling core (0 for the core running the test runner).
+ * @return Core index, from 0 to bmt_platform_num_cores() - 1.
+ * @note Optional. The weak default returns 0. Must be implemented when bmt_platform_num_cores() > 1.
+ */
+uint32_t bmt_platform_core_id(void);
+
+/**
+ * @brief Starts `entry(core)` on cores 1 .. num_cores - 1 for one stress test.
+ *
+ * Platforms whose secondary cores are parked in bmt_stress_secondary_main() (the usual
+ * SMP bare-metal setup) do not need it. Hosted ports use it to create worker threads.
+ *
+ * @param num_cores Number of cores of the stress test, including core 0.
+ * @param entry Function each secondary core must run once, with its index.
+ * @return true if the workers were started, false if the secondary cores are parked in
+ *         bmt_stress_secondary_main() (or there are none).
+ * @note Optional. The weak default returns false.
+ */
+bool bmt_platform_start_secondary_cores(uint32_t num_cores, void (*entry)(uint32_t core));
+
+/**
+ * @brief Hint called inside spin-wait loops (barriers).
+ * @note Optional. The weak default issues the CPU's spin-wait hint (`yield` on ARM, `pause` on x86).
+ *       Hosted ports with more threads than CPUs should yield the CPU instead.
+ */
+void bmt_platform_cpu_relax(void);
+
+/**
+ * @struct bmt_platform_cpu_info_t
+ * @brief Clock and cache geometry of the core running the tests. Unknown fields are 0.
+ */
+typedef struct {
+    uint32_t cpu_khz;      /**< Core clock, kHz. */
+    uint32_t l1d_bytes;    /**< L1 data cache size. */
+    uint32_t l1i_bytes;    /**< L1 instruction cache size. */
+    uint32_t l2_bytes;     /**< L2 cache size. */
+    uint32_t l3_bytes;     /**< L3 cache size. */
+    uint32_t line_bytes;   /**< Cache line size. */
+} bmt_platform_cpu_info_t;
+
+/**
+ * @brief Describes the CPU for the run metadata printed by bmt_run_all_tests().
+ * @param info Output, zero-filled by the caller.
+ * @return true if `info` was filled, false if the platform does not know it.
+ * @note Optional. The weak default returns false.
+ */
+bool bmt_platform_cpu_info(bmt_platform_cpu_info_t* info);
+
+/**
+ * @brief Gets the GNU build ID of the running image (the `.note.gnu.build-id` note written by
+ *        `ld --build-id`), printed in the run metadata so the host can match the output to its ELF.
+ * @param size Output: bytes of the ID.
+ * @return The ID, or NULL if unknown.
+ * @note Optional. The weak default reads the note at `__bmt_build_id_note` if the linker script
+ *       defines that symbol at the start of `.note.gnu.build-id`, otherwise returns NULL.
+ */
+const uint8_t* bmt_platform_build_id(size_t* size);
+
+/**
+ * @brief Gets the tests bmt_run_all_tests() runs, as "Suite.Name" patterns separated by ':',
+ *        with '*' and '?' wildcards (e.g. "BasicMath.*:Parser.RejectsEmpty").
+ * @return The filter, or NULL (or "") to run all registered tests.
+ * @note Optional. The weak default returns `BMT_TEST_FILTER` if defined at build time, otherwise NULL.
+ */
+const char* bmt_platform_test_filter(void);
+
+/**
+ * @brief Gets the base seed for PROPERTY tests (bmt_property.h).
+ * @return The seed. Each property derives its case seeds from it and its own name.
+ * @note Optional. The weak default returns `BMT_PROP_SEED` if defined at build time, otherwise
+ *       the high-resolution timer.
+ */
+uint64_t bmt_platform_prop_seed(void);
+
+/**
+ * @brief Gets the case seed to replay, as printed in a "[ PROPERTY ] ... failed" line.
+ * @return The case seed, or 0 to run all cases normally.
+ * @note Optional. The weak default returns `BMT_PROP_REPLAY` if defined at build time, otherwise 0.
+ */
+uint64_t bmt_platform_prop_replay(void);
+
+/**
+ * @brief Gets the FUZZ_TEST a fuzz build (bmt_fuzz.h) runs, as "Suite.Name".
+ * @return The name, or NULL for the only registered target.
+ * @note Optional. The weak default returns `BMT_FUZZ_TARGET` if defined at build time, otherwise NULL.
+ */
+const char* bmt_platform_fuzz_target(void);
+
+/**
+ * @brief Reads one input of the external corpus of a FUZZ_TEST (e.g. the files of a directory).
+ * @param name "Suite.Name" of the target.
+ * @param index Input index, from 0. Inputs must be returned in a stable order.
+ * @param buffer Storage for the input.
+ * @param capacity Bytes in `buffer` (longer inputs are truncated).
+ * @param size Output: bytes stored.
+ * @return true if the input exists, false past the last one.
+ * @note Optional. The weak default returns false (only the FUZZ_CORPUS inputs are replayed).
+ */
+bool bmt_platform_fuzz_corpus_entry(const char* name, uint32_t index, uint8_t* buffer, size_t capacity, size_t* size);
+
+/**
+ * @brief Reads one byte from the host link (the UART that carries the output), waiting for it.
+ *        Used by bmt_fuzz_serve() to receive inputs.
+ * @return The byte (0-255), or -1 if the link is closed or the platform has no input.
+ * @note Optional. The weak default returns -1. Platforms that buffer output must flush it
+ *       before waiting, or the host will not see the answer it is waiting for.
+ */
+int bmt_platform_getchar(void);
+
+/**
+ * @brief Installs (or removes) handlers for crashes (data/prefetch abort, undefined
+ *        instruction, segfault...) that call bmt_fuzz_fault(), so bmt_fuzz_serve() survives
+ *        crashing inputs. The handler must return to the interrupted mode and stack before
+ *        calling bmt_fuzz_fault(), which does not return while an input is running.
+ * @param enable true to install, false to restore the previous handlers.
+ * @note Optional. The weak default does nothing: a crash ends the session, and the host sees
+ *       a timeout.
+ */
+void bmt_platform_fuzz_fault_guard(bool enable);
+
+/**
+ * @brief Makes a guard region of the test stack pool (BMT_TEST_STACK_SIZE) inaccessible, or
+ *        accessible again, with the MPU/MMU (a no-access page on hosted ports).
+ *
+ * While a guard is active, the platform's fault handler must call bmt_stack_guard_hit() with
+ * the faulting address and, if it returns non-zero, bmt_stack_fault() (see their notes).
+ *
+ * @param base Start of the region, aligned to BMT_TEST_STACK_GUARD_SIZE.
+ * @param size Size of the region (BMT_TEST_STACK_GUARD_SIZE).
+ * @param enable true to protect it before the first test, false to release it after the run.
+ * @return true if the region is protected (or released). false if the platform cannot protect
+ *         it: the runner then checks the guards as canaries after each test.
+ * @note Optional. The weak default returns false.
+ */
+bool bmt_platform_stack_guard(void* base, size_t size, bool enable);
+
+/**
+ * @brief Describes the memory regions that bmt_memtest_run_regions() (bmt_memtest.h) may
+ *        overwrite (e.g. the DDR not used by the program, the OCM).
+ * @param index Region index, from 0.
+ * @param name Output: name of the region, without spaces (e.g. "DDR").
+ * @param base Output: start of the region.
+ * @param size Output: size of the region in bytes.
+ * @return true if the region exists, false past the last one.
+ * @note Optional. The weak default returns false (no regions).
+ */
+bool bmt_platform_memtest_region(uint32_t index, const char** name, void** base, size_t* size);
+
 #ifdef __cplusplus
 }
 #endif
 
-#endif // BMT_PLATFORM_IO_H
\ No newline at end of file
+#endif // BMT_PLATFORM_IO_H
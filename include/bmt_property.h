@@ -0,0 +1,180 @@
+// include/bmt_property.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_PROPERTY_H
+#define BMT_PROPERTY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "baremetal_test.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Cases run by PROPERTY when no count is given.
+ */
+#ifndef BMT_PROP_DEFAULT_CASES
+#define BMT_PROP_DEFAULT_CASES 1000
+#endif
+
+/**
+ * @brief Random draws one case can make (each integer takes one, a buffer one per byte plus
+ *        one for its length). Draws past the limit return the simplest value.
+ */
+#ifndef BMT_PROP_MAX_CHOICES
+#define BMT_PROP_MAX_CHOICES 256
+#endif
+
+/**
+ * @brief Property executions allowed while shrinking a counterexample.
+ */
+#ifndef BMT_PROP_MAX_SHRINK_RUNS
+#define BMT_PROP_MAX_SHRINK_RUNS 2000
+#endif
+
+/**
+ * @brief Typedef for the function that draws the inputs of one case and checks the property.
+ *        Generated by the PROPERTY macro.
+ */
+typedef void (*bmt_prop_case_func_t)(void);
+
+/**
+ * @brief Runs a property: generates `cases` inputs and, on the first failing one, shrinks it.
+ *        Called by the PROPERTY macro.
+ *
+ * Each case is generated from its own 64-bit seed with xoshiro128**. Every random draw is
+ * recorded, and shrinking works on that record (shorter, then smaller draws), so any
+ * generator shrinks towards its simplest value without type-specific code. Failures are not
+ * printed while searching; the minimal counterexample is then run once more with normal
+ * reporting:
+ *
+ * @code
+ * [ PROPERTY ] Codec.RoundTrip failed case=212 seed=8419213775601162451 shrinks=41
+ * [ PROP VAL ] data=000080 len=3
+ * tests.c:42: Failure
+ * ...
+ * @endcode
+ *
+ * On success prints `[ PROPERTY ] Codec.RoundTrip cases=1000 seed=... ns_per_case=...`.
+ * To replay a failure, pass the printed seed to bmt_platform_prop_replay(): every property
+ * then runs only the case with that seed, which fails and shrinks to the same values.
+ *
+ * @param name Name printed in the report ("Suite.Name").
+ * @param case_func Draws the inputs and runs the property body.
+ * @param cases Number of cases.
+ */
+void bmt_prop_run(const char* name, bmt_prop_case_func_t case_func, uint32_t cases);
+
+/**
+ * @brief Draws an integer in [lo, hi]. Shrinks towards 0 (or the bound closest to it).
+ *        Boundaries (lo, hi, 0, +-1) are drawn more often than uniformly.
+ * @param name Name printed in the report.
+ * @param lo Lower bound (inclusive).
+ * @param hi Upper bound (inclusive).
+ * @return The value.
+ */
+int64_t bmt_prop_int(const char* name, int64_t lo, int64_t hi);
+
+/**
+ * @brief Fills `buf` with a random byte buffer. Shrinks towards shorter buffers of zeros.
+ * @param name Name printed in the report.
+ * @param buf Storage for the bytes.
+ * @param max_len Maximum length (size of `buf`).
+ * @return The length drawn, from 0 to max_len.
+ */
+size_t bmt_prop_buf(const char* name, uint8_t* buf, size_t max_len);
+
+/**
+ * @internal
+ * @brief Expansion of each generator in the three places PROPERTY needs it: declaration with
+ *        the draw, parameter of the body (marked unused, the body may ignore some) and argument
+ *        of the call. The generators are tags (`gen_int32(...)`) pasted onto these prefixes,
+ *        not macros or functions of their own.
+ */
+#define BMT_PROP_DECL_gen_int32(n, lo, hi)  int32_t n = (int32_t)bmt_prop_int(#n, (lo), (hi));
+#define BMT_PROP_PARAM_gen_int32(n, lo, hi) , int32_t n __attribute__((unused))
+#define BMT_PROP_ARG_gen_int32(n, lo, hi)   , n
+#define BMT_PROP_DECL_gen_uint32(n, lo, hi)  uint32_t n = (uint32_t)bmt_prop_int(#n, (lo), (hi));
+#define BMT_PROP_PARAM_gen_uint32(n, lo, hi) , uint32_t n __attribute__((unused))
+#define BMT_PROP_ARG_gen_uint32(n, lo, hi)   , n
+#define BMT_PROP_DECL_gen_bool(n)  bool n = bmt_prop_int(#n, 0, 1) != 0;
+#define BMT_PROP_PARAM_gen_bool(n) , bool n __attribute__((unused))
+#define BMT_PROP_ARG_gen_bool(n)   , n
+#define BMT_PROP_DECL_gen_buf(n, max_len)  uint8_t n[max_len]; size_t n##_len = bmt_prop_buf(#n, n, (max_len));
+#define BMT_PROP_PARAM_gen_buf(n, max_len) , uint8_t* n __attribute__((unused)), size_t n##_len __attribute__((unused))
+#define BMT_PROP_ARG_gen_buf(n, max_len)   , n, n##_len
+
+/** @internal @brief Applies context `c` (DECL, PARAM or ARG) to each of up to 8 generators. */
+#define BMT_PROP_APPLY(c, g) BMT_PROP_##c##_##g
+#define BMT_PROP_EACH_1(c, g) BMT_PROP_APPLY(c, g)
+#define BMT_PROP_EACH_2(c, g, ...) BMT_PROP_APPLY(c, g) BMT_PROP_EACH_1(c, __VA_ARGS__)
+#define BMT_PROP_EACH_3(c, g, ...) BMT_PROP_APPLY(c, g) BMT_PROP_EACH_2(c, __VA_ARGS__)
+#define BMT_PROP_EACH_4(c, g, ...) BMT_PROP_APPLY(c, g) BMT_PROP_EACH_3(c, __VA_ARGS__)
+#define BMT_PROP_EACH_5(c, g, ...) BMT_PROP_APPLY(c, g) BMT_PROP_EACH_4(c, __VA_ARGS__)
+#define BMT_PROP_EACH_6(c, g, ...) BMT_PROP_APPLY(c, g) BMT_PROP_EACH_5(c, __VA_ARGS__)
+#define BMT_PROP_EACH_7(c, g, ...) BMT_PROP_APPLY(c, g) BMT_PROP_EACH_6(c, __VA_ARGS__)
+#define BMT_PROP_EACH_8(c, g, ...) BMT_PROP_APPLY(c, g) BMT_PROP_EACH_7(c, __VA_ARGS__)
+#define BMT_PROP_COUNT(...) BMT_PROP_COUNT_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define BMT_PROP_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+#define BMT_PROP_CAT(a, b) BMT_PROP_CAT_(a, b)
+#define BMT_PROP_CAT_(a, b) a##b
+#define BMT_PROP_EACH(c, ...) BMT_PROP_CAT(BMT_PROP_EACH_, BMT_PROP_COUNT(__VA_ARGS__))(c, __VA_ARGS__)
+
+/**
+ * @def PROPERTY_CASES(TestSuiteName, TestName, cases, ...)
+ * @brief Like PROPERTY, with an explicit number of cases.
+ */
+#define PROPERTY_CASES(TestSuiteName, TestName, cases, ...) \
+    static void bmt_prop_body_##TestSuiteName##_##TestName( \
+        int bmt_prop_unused __attribute__((unused)) BMT_PROP_EACH(PARAM, __VA_ARGS__)); \
+    static void bmt_prop_case_##TestSuiteName##_##TestName(void) { \
+        BMT_PROP_EACH(DECL, __VA_ARGS__) \
+        bmt_prop_body_##TestSuiteName##_##TestName(0 BMT_PROP_EACH(ARG, __VA_ARGS__)); \
+    } \
+    TEST(TestSuiteName, TestName) { \
+        bmt_prop_run(#TestSuiteName "." #TestName, bmt_prop_case_##TestSuiteName##_##TestName, (cases)); \
+    } \
+    static void bmt_prop_body_##TestSuiteName##_##TestName( \
+        int bmt_prop_unused __attribute__((unused)) BMT_PROP_EACH(PARAM, __VA_ARGS__))
+
+/**
+ * @def PROPERTY(TestSuiteName, TestName, ...)
+ * @brief Defines and registers a property-based test: the body runs BMT_PROP_DEFAULT_CASES
+ *        times with random inputs, and a failing input is shrunk to a minimal counterexample.
+ *
+ * The remaining arguments (1 to 8) declare the inputs, which the body receives as variables:
+ * - `gen_int32(name, lo, hi)`: `int32_t name` in [lo, hi].
+ * - `gen_uint32(name, lo, hi)`: `uint32_t name` in [lo, hi].
+ * - `gen_bool(name)`: `bool name`.
+ * - `gen_buf(name, max_len)`: `uint8_t* name` with `size_t name_len` bytes (0 .. max_len).
+ *
+ * All assertion macros can be used in the body. Nothing is allocated: buffers live on the
+ * stack of the case function and the generator state is static.
+ *
+ * Example usage:
+ * @code
+ * PROPERTY(BasicMath, AddCommutes, gen_int32(a, -1000, 1000), gen_int32(b, -1000, 1000)) {
+ *     ASSERT_EQ(add(a, b), add(b, a));
+ * }
+ * @endcode
+ *
+ * @param TestSuiteName The name of the test suite.
+ * @param TestName The name of the test case.
+ */
+#define PROPERTY(TestSuiteName, TestName, ...) \
+    PROPERTY_CASES(TestSuiteName, TestName, BMT_PROP_DEFAULT_CASES, __VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_PROPERTY_H
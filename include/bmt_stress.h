@@ -0,0 +1,133 @@
+// include/bmt_stress.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_STRESS_H
+#define BMT_STRESS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "baremetal_test.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum number of cores (or host threads) a stress test can use.
+ * Can be overridden from the build (e.g. `-DBMT_STRESS_MAX_CORES=16`).
+ */
+#ifndef BMT_STRESS_MAX_CORES
+#define BMT_STRESS_MAX_CORES 8
+#endif
+
+/**
+ * @brief Failures printed per stress test. Further failures (usually the same bug hit by
+ *        every core on every iteration) are only counted.
+ */
+#ifndef BMT_STRESS_MAX_REPORTS
+#define BMT_STRESS_MAX_REPORTS 8
+#endif
+
+/**
+ * @brief Time core 0 waits at the first barrier for the other cores, in milliseconds.
+ *        If they do not arrive (secondary cores not started), the stress test fails instead of hanging.
+ */
+#ifndef BMT_STRESS_START_TIMEOUT_MS
+#define BMT_STRESS_START_TIMEOUT_MS 2000
+#endif
+
+/**
+ * @brief Typedef for a stress test body.
+ * @param core Index of the core running the body, from 0 to bmt_stress_num_cores() - 1.
+ * @param iteration Current iteration, from 0 to the iteration count - 1.
+ */
+typedef void (*bmt_stress_func_t)(uint32_t core, uint32_t iteration);
+
+/**
+ * @brief Runs a stress test body on all cores. Called by the STRESS_TEST macro.
+ *
+ * For each iteration, all cores wait on a spin barrier and are released at the same
+ * instant to run `body`. ASSERT_* failures on any core end that core's body and stop the
+ * run after the current iteration; failures are counted per core. Prints one
+ * "[ STRESS   ]" line with the totals plus one per core:
+ *
+ * @code
+ * [ STRESS   ] MpmcQueue.PushPop cores=4 iters=1000 failures=0 ns_per_iter=1840.250
+ * [ STRESS   ] MpmcQueue.PushPop/core0 iters=1000 failures=0 ns_per_iter=1839.125
+ * @endcode
+ *
+ * The test fails if any core reported a failure.
+ *
+ * @param name Name printed in the report ("Suite.Name").
+ * @param body The body.
+ * @param iterations Number of synchronized iterations.
+ */
+void bmt_stress_run(const char* name, bmt_stress_func_t body, uint32_t iterations);
+
+/**
+ * @brief Number of cores taking part in the current stress test or, outside one, in the next
+ *        (e.g. to size per-core buffers before calling bmt_stress_run()).
+ * @return The number of cores (1 if the platform has no secondary cores).
+ */
+uint32_t bmt_stress_num_cores(void);
+
+/**
+ * @brief Spin barrier for the cores of the current stress test, to be used inside the body
+ *        (e.g. core 0 resets the structure, barrier, all cores hammer it, barrier, core 0 checks it).
+ *
+ * If another core fails an ASSERT_* while this one is waiting, this core's body is
+ * terminated too, so a failure never leaves the rest of the cores stuck.
+ */
+void bmt_stress_barrier(void);
+
+/**
+ * @brief Parking loop for secondary cores on SMP bare-metal targets. Never returns.
+ *
+ * Each secondary core must call it after its own start-up (stack, MMU, caches with
+ * coherency enabled). It waits for stress tests published by core 0 and runs its share.
+ * Not needed on platforms that start their own workers with
+ * bmt_platform_start_secondary_cores() (e.g. the Linux host port, with pthreads).
+ *
+ * @param core Index of this core (1 .. bmt_platform_num_cores() - 1). Must match bmt_platform_core_id().
+ */
+void bmt_stress_secondary_main(uint32_t core);
+
+/**
+ * @def STRESS_TEST(TestSuiteName, TestName, iterations)
+ * @brief Defines and registers a test whose body runs simultaneously on all cores.
+ *
+ * Inside the body, `bmt_core` is the index of the core running it (0 .. bmt_stress_num_cores() - 1)
+ * and `bmt_iteration` the current iteration. All assertion macros can be used on any core.
+ *
+ * Example usage:
+ * @code
+ * STRESS_TEST(Counter, AtomicIncrement, 1000) {
+ *     (void)bmt_iteration;
+ *     for (int i = 0; i < 100; ++i) {
+ *         __atomic_fetch_add(&counters[bmt_core], 1, __ATOMIC_RELAXED);
+ *     }
+ * }
+ * @endcode
+ *
+ * @param TestSuiteName The name of the test suite.
+ * @param TestName The name of the test case.
+ * @param iterations Number of synchronized iterations.
+ */
+#define STRESS_TEST(TestSuiteName, TestName, iterations) \
+    static void bmt_stress_##TestSuiteName##_##TestName(uint32_t bmt_core, uint32_t bmt_iteration); \
+    TEST(TestSuiteName, TestName) { \
+        bmt_stress_run(#TestSuiteName "." #TestName, bmt_stress_##TestSuiteName##_##TestName, (iterations)); \
+    } \
+    static void bmt_stress_##TestSuiteName##_##TestName(uint32_t bmt_core, uint32_t bmt_iteration)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_STRESS_H
@@ -0,0 +1,139 @@
+// include/bmt_transport.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_TRANSPORT_H
+#define BMT_TRANSPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bytes buffered before they are handed to the transport (one send, one UDP datagram).
+ */
+#ifndef BMT_TRANSPORT_BUFFER
+#define BMT_TRANSPORT_BUFFER 1024u
+#endif
+
+/**
+ * @brief At the end of a line, send the buffer if its oldest byte is older than this. 0 sends
+ *        every line, like a line-buffered stdout: the host sees "[ RUN ]" before a test hangs.
+ *        Larger values batch lines into fewer, bigger sends.
+ */
+#ifndef BMT_TRANSPORT_FLUSH_MS
+#define BMT_TRANSPORT_FLUSH_MS 0u
+#endif
+
+/**
+ * @brief Bytes of the header of each UDP datagram: a big-endian sequence number (from 0, per
+ *        bmt_transport_set()), so the host can tell lost datagrams from a quiet target.
+ */
+#define BMT_TRANSPORT_UDP_HEADER 2u
+
+/**
+ * @struct bmt_transport_t
+ * @brief A link that carries the output (UART, TCP, UDP...), opened by the platform.
+ */
+typedef struct {
+    const char* name;   /**< Short name for the report, without spaces ("uart", "tcp", "udp"). */
+    /** Sends all bytes, blocking until the link has taken them. One call per buffer. */
+    void (*write)(const uint8_t* data, size_t size);
+    /** Reads one byte, waiting for it: 0-255, or -1 if the link is closed. NULL if output only. */
+    int (*read)(void);
+} bmt_transport_t;
+
+/**
+ * @struct bmt_transport_stats_t
+ * @brief Counters of the active transport since bmt_transport_set().
+ */
+typedef struct {
+    uint64_t bytes;     /**< Bytes handed to the transport. */
+    uint64_t sends;     /**< Calls to its `write`. */
+    uint64_t ticks;     /**< High-resolution ticks spent inside `write`. */
+} bmt_transport_stats_t;
+
+/**
+ * @brief Selects the transport bmt_transport_write() sends through. The platform calls it from
+ *        bmt_platform_io_init() and routes bmt_platform_puts()/bmt_platform_putchar() (or the
+ *        sink of bmt_compress.h) to bmt_transport_write().
+ * @param transport The transport, or NULL to drop the output. Must outlive its use.
+ */
+void bmt_transport_set(const bmt_transport_t* transport);
+
+/**
+ * @brief Gets the transport selected with bmt_transport_set().
+ * @return The transport, or NULL.
+ */
+const bmt_transport_t* bmt_transport_get(void);
+
+/**
+ * @brief Buffers output. The buffer is sent when full and at line ends (see BMT_TRANSPORT_FLUSH_MS).
+ *        Same signature as bmt_compress_sink_t, so it can be the sink of the compressor.
+ * @param data The bytes.
+ * @param size Number of bytes.
+ */
+void bmt_transport_write(const uint8_t* data, size_t size);
+
+/**
+ * @brief Sends the buffered bytes now.
+ */
+void bmt_transport_flush(void);
+
+/**
+ * @brief Flushes the output, then reads one byte from the transport (for bmt_platform_getchar()).
+ * @return The byte (0-255), or -1 if the transport cannot read or is closed.
+ */
+int bmt_transport_getchar(void);
+
+/**
+ * @brief Gets the counters of the active transport.
+ * @param stats Output.
+ */
+void bmt_transport_get_stats(bmt_transport_stats_t* stats);
+
+/**
+ * @brief Prints the counters of the active transport and flushes:
+ *
+ * @code
+ * [ TRANSPORT] name=tcp bytes=25873 sends=391 send_ms=1.847 bytes_per_s=14008121
+ * @endcode
+ *
+ * `bytes_per_s` is bytes over the time spent in `write`: what the link costs the target. On a
+ * UART with blocking writes it is close to baud / 10, so running the same suite over the UART
+ * and over Ethernet compares both paths.
+ */
+void bmt_transport_report(void);
+
+/**
+ * @brief Measures the throughput of the output path: sends `bytes` of 64-byte filler lines
+ *        ("[ TX FILL  ] ...", which the parser counts but does not show) straight to the
+ *        transport, waits for the last send and prints:
+ *
+ * @code
+ * [ TRANSPORT] name=tcp bench_bytes=65536 bench_ms=4.518 bench_bytes_per_s=14505533
+ * @endcode
+ *
+ * Pending compressed output (bmt_compress.h) is flushed first, so the filler does not split a line.
+ * The filler bypasses the compressor: it counts in the "[ TRANSPORT]" bytes, not in the
+ * "[ COMPRESS ]" in/out/ratio.
+ *
+ * @param bytes Bytes to send (rounded down to whole lines).
+ * @return Bytes per second, or 0 if there is no transport or the time was too short to measure.
+ */
+uint64_t bmt_transport_bench(uint32_t bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_TRANSPORT_H
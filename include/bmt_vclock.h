@@ -0,0 +1,121 @@
+// include/bmt_vclock.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_VCLOCK_H
+#define BMT_VCLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "baremetal_test.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Virtual time that passes on each idle step (bmt_vclock_idle(), and every clock read
+ *        in BMT_VCLOCK_FAST_FORWARD mode), in microseconds.
+ */
+#ifndef BMT_VCLOCK_STEP_US
+#define BMT_VCLOCK_STEP_US 1000
+#endif
+
+/**
+ * @brief Time source seen through bmt_platform_get_hires_ticks() / bmt_platform_get_msec_ticks().
+ */
+typedef enum {
+    BMT_VCLOCK_OFF = 0,       /**< Real time. */
+    BMT_VCLOCK_MANUAL,        /**< Virtual time that only moves with bmt_vclock_sleep_us() / bmt_vclock_idle(). */
+    BMT_VCLOCK_FAST_FORWARD   /**< Virtual time that also moves BMT_VCLOCK_STEP_US on every clock read, so
+                                   code that busy-waits on the clock reaches its timeout at once. */
+} bmt_vclock_mode_t;
+
+/**
+ * @brief Switches the clock of the current test to virtual time, starting from the current
+ *        real time (so code that already took a timestamp sees no jump).
+ *
+ * The runner switches back to real time after each test and, if the test used virtual time,
+ * prints its virtual and real duration:
+ *
+ * @code
+ * [ VCLOCK   ] LinkMonitor.BlockingWaitTimesOut virtual_ms=30000.000 real_ms=0.214
+ * @endcode
+ *
+ * Virtual time is what the platform port returns from its clock functions when
+ * bmt_vclock_read() says so (the Linux and Xilinx ports do). It is not thread-safe: do not
+ * use it in a STRESS_TEST.
+ *
+ * @param mode BMT_VCLOCK_MANUAL or BMT_VCLOCK_FAST_FORWARD. BMT_VCLOCK_OFF goes back to real
+ *        time before the end of the test (the clock jumps back to the real time); enabling it
+ *        again restarts from the real time, and `virtual_ms` adds up the virtual spans.
+ */
+void bmt_vclock_enable(bmt_vclock_mode_t mode);
+
+/**
+ * @brief Current mode.
+ */
+bmt_vclock_mode_t bmt_vclock_mode(void);
+
+/**
+ * @brief Lets `us` microseconds pass: instantly in virtual time, busy-waiting in real time.
+ *        Tests and mocks (e.g. a fake `usleep()` of the HAL) use it to drive time.
+ */
+void bmt_vclock_sleep_us(uint64_t us);
+
+/**
+ * @brief Called from a polling loop that has nothing to do: in virtual time, lets
+ *        BMT_VCLOCK_STEP_US pass; in real time, calls bmt_platform_cpu_relax().
+ */
+void bmt_vclock_idle(void);
+
+/**
+ * @brief For platform ports: gives the virtual time, if active. A port supports virtual time
+ *        by returning this value from bmt_platform_get_hires_ticks() (and the equivalent in
+ *        milliseconds from bmt_platform_get_msec_ticks()) when the function returns true.
+ * @param ticks Receives the virtual time in ticks of bmt_platform_get_hires_ticks().
+ * @return true if virtual time is active.
+ */
+bool bmt_vclock_read(uint64_t* ticks);
+
+/**
+ * @internal
+ * @brief Shared by EXPECT_EVENTUALLY / ASSERT_EVENTUALLY: polls `condition` until it is true
+ *        or `timeout_ms` pass (of the test clock, real or virtual), idling in between.
+ */
+#define BMT_EVENTUALLY_COMMON(common, assertion_type, condition, timeout_ms) \
+    do { \
+        uint32_t bmt_ev_start = bmt_platform_get_msec_ticks(); \
+        bool bmt_ev_ok; \
+        while (!(bmt_ev_ok = !!(condition)) && \
+               (uint32_t)(bmt_platform_get_msec_ticks() - bmt_ev_start) < (uint32_t)(timeout_ms)) { \
+            bmt_vclock_idle(); \
+        } \
+        common(bmt_ev_ok, assertion_type, #condition " within " #timeout_ms " ms", NULL); \
+    } while (0)
+
+/**
+ * @def EXPECT_EVENTUALLY(condition, timeout_ms)
+ * @brief Expects `condition` to become true within `timeout_ms` milliseconds (polled).
+ *        With virtual time, the wait advances the virtual clock and takes no real time.
+ */
+#define EXPECT_EVENTUALLY(condition, timeout_ms) \
+    BMT_EVENTUALLY_COMMON(BMT_EXPECT_COMMON, "EXPECT_EVENTUALLY", condition, timeout_ms)
+
+/**
+ * @def ASSERT_EVENTUALLY(condition, timeout_ms)
+ * @brief Like EXPECT_EVENTUALLY, but terminates the test on failure.
+ */
+#define ASSERT_EVENTUALLY(condition, timeout_ms) \
+    BMT_EVENTUALLY_COMMON(BMT_ASSERT_COMMON, "ASSERT_EVENTUALLY", condition, timeout_ms)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMT_VCLOCK_H
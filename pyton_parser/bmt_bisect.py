@@ -0,0 +1,427 @@
+#  SPDX-License-Identifier: MIT
+# Copyright (c) 2025 Alejandro Avila Marcos
+
+# Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+#  BMT se distribuye bajo los términos de la Licencia MIT.
+#  Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+#  o en <https://opensource.org/licenses/MIT>.
+
+"""Performance bisection: finds the commit where a benchmark or a test got slower, with git bisect.
+
+The target is a benchmark (the name of a [ BENCH    ] line, e.g. crc32_table/16384) or a test
+(Suite.Name, timed in ms by the runner). Given a good and a bad commit and a threshold, the
+history is checked out in a separate git worktree (the working tree is not touched) and, at each
+step of `git bisect run`, the Linux host port of a flag_matrix.json profile is built and only the
+test that prints the target is run (BMT_TEST_FILTER), --samples times, each in a new process.
+
+Each step is compared with the samples of both ends (--max_samples runs each). It is bad when
+its median is slower than the good end by more than half the threshold and a one-sided
+Mann-Whitney U test says it is slower than the good end (p < --alpha); good when it is below
+that and the test says it is faster than the bad end. Otherwise the samples are doubled, up to --max_samples; then the
+nearest end (by log ratio of the medians) decides and the step is marked uncertain. Commits
+that do not build, or where the target is missing or fails, are skipped. The ends themselves
+must differ by the whole threshold, with significance, or there is nothing to bisect.
+
+Objects are cached by the hash of their inputs (as in bmt_mutate.py), executables by their
+objects and samples by their executable: commits that do not change the build (docs, tools,
+other ports) cost one hash, and running the tool again reuses all the measurements.
+
+The report gives the first bad commit and the distribution (min, quartiles, max) of the good
+end, the parent of the first bad commit, the first bad commit and the bad end.
+"""
+
+import os
+import re
+import sys
+import json
+import math
+import shutil
+import difflib
+import argparse
+import itertools
+import statistics
+import subprocess
+from collections import Counter
+from concurrent.futures import ThreadPoolExecutor
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from parse_bmt_output import parse_bench_fields  # noqa: E402
+from bmt_matrix import REPO, RE_RESULT, RE_BENCH, source_files, run_host  # noqa: E402
+from bmt_mutate import Builder, digest  # noqa: E402
+
+RE_RUN = re.compile(r"^\[ RUN\s+\] (\S+)")
+RE_FIRST_BAD = re.compile(r"^([0-9a-f]{40}) is the first bad commit")
+# Benchmark fields where more is better; in all the others (ns_*, ms) less is better
+HIGHER_IS_BETTER = {"mbps"}
+# Up to this many splits of the pooled samples the U test is exact
+EXACT_SPLITS = 200000
+
+
+def git(*args, cwd=REPO, check=True):
+    result = subprocess.run(["git", *args], cwd=cwd, capture_output=True, text=True)
+    if check and result.returncode != 0:
+        sys.exit(f"ERROR: git {' '.join(args)}: {result.stderr.strip()}")
+    return result.stdout.strip()
+
+
+def describe(commit):
+    return git("log", "-1", "--format=%h %s", commit)
+
+
+def rank_sum_p(a, b):
+    """One-sided p-value of the Mann-Whitney U test that the values of `a` tend to be larger
+    than those of `b`. Exact over all the splits of the pooled midranks (so ties count) while
+    there are at most EXACT_SPLITS of them; normal approximation with tie correction beyond."""
+    pooled = sorted(a + b)
+    midrank, i = {}, 0
+    while i < len(pooled):
+        j = i
+        while j < len(pooled) and pooled[j] == pooled[i]:
+            j += 1
+        midrank[pooled[i]] = (i + 1 + j) / 2.0
+        i = j
+    n, m = len(a), len(b)
+    observed = sum(midrank[v] for v in a)
+    if math.comb(n + m, n) <= EXACT_SPLITS:
+        ranks = [midrank[v] for v in a + b]
+        splits = list(itertools.combinations(ranks, n))
+        return sum(sum(s) >= observed - 1e-9 for s in splits) / len(splits)
+    total = n + m
+    ties = sum(t ** 3 - t for t in Counter(pooled).values())
+    var = n * m / 12.0 * ((total + 1) - ties / (total * (total - 1)))
+    if var <= 0:
+        return 1.0
+    z = (observed - n * (total + 1) / 2.0 - 0.5) / math.sqrt(var)
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
+
+def distribution(values):
+    q1, median, q3 = statistics.quantiles(values, n=4, method="inclusive") if len(values) > 1 else values * 3
+    return {"n": len(values), "min": min(values), "q1": q1, "median": median, "q3": q3,
+            "max": max(values), "mean": statistics.fmean(values)}
+
+
+def format_distribution(values):
+    d = distribution(values)
+    return (f"n={d['n']} min={d['min']:.3f} q1={d['q1']:.3f} median={d['median']:.3f} "
+            f"q3={d['q3']:.3f} max={d['max']:.3f}")
+
+
+def build_at(state, root):
+    """Builds the checkout at `root`. Returns (executable, None) or (None, error)."""
+    profile, cache = state["profile"], state["cache"]
+    try:
+        sources = source_files(profile, root)
+    except SystemExit as e:  # A source pattern of the profile matches nothing at this commit
+        return None, str(e)
+    builder = Builder(profile, state["variant"], cache, root=root, sources=sources)
+    with ThreadPoolExecutor(max_workers=os.cpu_count() or 1) as pool:
+        built = list(pool.map(builder.compile, sources))
+    errors = [err for _, err in built if err]
+    if errors:
+        return None, errors[0]
+    objects = [obj for obj, _ in built]
+    exe = os.path.join(cache, "exe", digest(*objects, *builder.ldflags) + ".elf")
+    if not os.path.exists(exe):
+        os.makedirs(os.path.dirname(exe), exist_ok=True)
+        tmp = exe[:-4] + ".tmp.elf"  # Renamed when complete, as the objects
+        error = builder.link(objects, tmp)
+        if error:
+            return None, error
+        os.replace(tmp, exe)
+    return exe, None
+
+
+def extract(state, output):
+    """The value of the target in the output of one run. Returns (value, None) or (None, why)."""
+    for line in output.splitlines():
+        if state["kind"] == "test":
+            m = RE_RESULT.match(line)
+            if m and f"{m.group(2)}.{m.group(3)}" == state["target"]:
+                return (int(m.group(4)), None) if m.group(1) == "OK" else (None, "the test fails")
+        else:
+            m = RE_BENCH.match(line)
+            if m and m.group(1) == state["target"]:
+                value = parse_bench_fields(m.group(2)).get(state["metric"])
+                return (value, None) if isinstance(value, (int, float)) else (None, f"no field {state['metric']}")
+    return None, "target not in the output"
+
+
+def sample(state, exe, count):
+    """At least `count` values of the target with `exe`, the cached ones first.
+    Returns (values, None) or (values so far, error)."""
+    with open(exe, "rb") as f:
+        key = digest(f.read(), state["filter"], state["target"], state["metric"],
+                     json.dumps(state["profile"].get("env", {}), sort_keys=True), state["profile"].get("run", ""))
+    path = os.path.join(state["cache"], "samples", key + ".json")
+    values = []
+    if os.path.exists(path):
+        with open(path, encoding="utf-8") as f:
+            values = json.load(f)
+    os.environ["BMT_TEST_FILTER"] = state["filter"]
+    error = None
+    while len(values) < count and error is None:
+        output, error = run_host(state["profile"], exe)
+        if error is None:
+            value, error = extract(state, output)
+            if value is not None:
+                values.append(value)
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "w", encoding="utf-8") as f:
+        json.dump(values, f)
+    return values, error
+
+
+def slowdown(state, a, b):
+    """How many times slower the median of `a` is than the median of `b`."""
+    ratio = statistics.median(a) / statistics.median(b)
+    return 1.0 / ratio if state["higher_is_better"] else ratio
+
+
+def slower_p(state, a, b):
+    """p-value of `a` being slower than `b`."""
+    return rank_sum_p(b, a) if state["higher_is_better"] else rank_sum_p(a, b)
+
+
+def classify(state, values):
+    """'bad', 'good' or None (not significant yet), and the statistics of the decision."""
+    good, bad = state["good_values"], state["bad_values"]
+    stats = {"slowdown": slowdown(state, values, good), "p_slower_than_good": slower_p(state, values, good),
+             "p_faster_than_bad": slower_p(state, bad, values)}
+    middle = 1.0 + state["threshold"] / 200.0
+    if stats["slowdown"] >= middle and stats["p_slower_than_good"] < state["alpha"]:
+        return "bad", stats
+    if stats["slowdown"] < middle and stats["p_faster_than_bad"] < state["alpha"]:
+        return "good", stats
+    return None, stats
+
+
+def step(state_file):
+    """One step of `git bisect run`, in the worktree: 0 good, 1 bad, 125 skip."""
+    with open(state_file, encoding="utf-8") as f:
+        state = json.load(f)
+    commit = git("rev-parse", "HEAD", cwd=os.getcwd())
+    record = {"commit": commit}
+    exe, error = build_at(state, os.getcwd())
+    count = state["samples"]
+    while error is None:
+        values, error = sample(state, exe, count)
+        if error is None:
+            verdict, stats = classify(state, values)
+            if verdict is not None or count >= state["max_samples"]:
+                break
+            count = min(2 * count, state["max_samples"])
+    if error is not None:
+        lines = error.strip().splitlines() or ["error"]
+        print(f"bisect: {commit[:10]} skipped: {next((l for l in lines if 'error' in l), lines[0])}")
+        record.update(verdict="skip", error=error)
+        code = 125
+    else:
+        uncertain = verdict is None
+        if uncertain:
+            median = statistics.median(values)
+            to_good = abs(math.log(median / statistics.median(state["good_values"])))
+            to_bad = abs(math.log(median / statistics.median(state["bad_values"])))
+            verdict = "bad" if to_bad < to_good else "good"
+        print(f"bisect: {commit[:10]} {state['metric']} {format_distribution(values)} "
+              f"({100.0 * (stats['slowdown'] - 1.0):+.1f} % vs good) -> {verdict}{' (uncertain)' if uncertain else ''}")
+        record.update(verdict=verdict, uncertain=uncertain, values=values, **stats)
+        code = 1 if verdict == "bad" else 0
+    steps = os.path.join(state["cache"], "steps")
+    os.makedirs(steps, exist_ok=True)
+    with open(os.path.join(steps, commit + ".json"), "w", encoding="utf-8") as f:
+        json.dump(record, f)
+    return code
+
+
+def measure(state, worktree, commit, what):
+    """Checks out `commit` in the worktree, builds it and samples the target; exits on error."""
+    git("checkout", "-q", "--detach", commit, cwd=worktree)
+    exe, error = build_at(state, worktree)
+    if error:
+        sys.exit(f"ERROR: the {what} commit {commit[:10]} does not build:\n{error}")
+    return exe
+
+
+def find_target(state, exe):
+    """Runs the whole suite once and returns (kind, filter): the test the target is, or the one
+    that prints it."""
+    os.environ.pop("BMT_TEST_FILTER", None)
+    if state["filter"]:
+        os.environ["BMT_TEST_FILTER"] = state["filter"]
+    output, error = run_host(state["profile"], exe)
+    if error:
+        sys.exit(f"ERROR: the bad commit: {error}")
+    current, tests, benches = None, [], {}
+    for line in output.splitlines():
+        m = RE_RUN.match(line)
+        if m:
+            current = m.group(1)
+        m = RE_RESULT.match(line)
+        if m:
+            tests.append(f"{m.group(2)}.{m.group(3)}")
+        m = RE_BENCH.match(line)
+        if m:
+            benches.setdefault(m.group(1), current)
+    if state["target"] in tests:
+        return "test", state["filter"] or state["target"]
+    if state["target"] in benches:
+        return "bench", state["filter"] or benches[state["target"]]
+    close = difflib.get_close_matches(state["target"], tests + list(benches), n=5)
+    sys.exit(f"ERROR: no test or benchmark '{state['target']}' at the bad commit"
+             + (f" (did you mean: {', '.join(close)}?)" if close else ""))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Finds the commit where a benchmark or test got slower (git bisect).")
+    ap.add_argument("target", nargs="?", help="Benchmark ([ BENCH    ] name) or test (Suite.Name)")
+    ap.add_argument("--good", help="Commit without the regression")
+    ap.add_argument("--bad", default="HEAD", help="Commit with the regression (default: HEAD)")
+    ap.add_argument("--threshold", type=float, default=10.0,
+                    help="Slowdown (%%) of the bad commit over the good one to look for (default: 10)")
+    ap.add_argument("--metric", default="ns_median",
+                    help="Field of the [ BENCH    ] line (default: ns_median); tests always use ms")
+    ap.add_argument("--filter", help="BMT_TEST_FILTER of each run (default: the test that prints the target)")
+    ap.add_argument("--samples", type=int, default=5, help="Runs per commit (default: 5)")
+    ap.add_argument("--max_samples", type=int, default=20,
+                    help="Runs per commit when the first ones do not decide (default: 20)")
+    ap.add_argument("--alpha", type=float, default=0.01, help="Significance level of each decision (default: 0.01)")
+    ap.add_argument("--profile", default="linux_host_examples",
+                    help="Profile of the matrix file (default: linux_host_examples)")
+    ap.add_argument("--matrix", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "flag_matrix.json"))
+    ap.add_argument("--variant", help="Variant of the profile to build with (default: its first one)")
+    ap.add_argument("--cache", default=os.path.join(REPO, ".bmt_bisect_cache"), help="Cache directory")
+    ap.add_argument("--json", help="Write the first bad commit and every step to this JSON file")
+    ap.add_argument("--step", help=argparse.SUPPRESS)  # Called back by git bisect run
+    args = ap.parse_args()
+    if args.step:
+        return step(args.step)
+    if not args.target or not args.good:
+        ap.error("a target and --good are required")
+    if args.samples < 2 or args.max_samples < args.samples:
+        ap.error("--samples must be at least 2 and --max_samples at least --samples")
+
+    with open(args.matrix, encoding="utf-8") as f:
+        matrix = json.load(f)
+    if args.profile not in matrix:
+        sys.exit(f"ERROR: profile '{args.profile}' not in {args.matrix} (available: {', '.join(matrix)})")
+    profile = matrix[args.profile]
+    if "load" in profile:
+        sys.exit(f"ERROR: profile '{args.profile}' runs on a board; bisection needs a host profile")
+    variant = args.variant or next(iter(profile["variants"]))
+    if variant not in profile["variants"]:
+        sys.exit(f"ERROR: unknown variant {variant} (available: {', '.join(profile['variants'])})")
+    good = git("rev-parse", "--verify", args.good + "^{commit}")
+    bad = git("rev-parse", "--verify", args.bad + "^{commit}")
+    if subprocess.run(["git", "merge-base", "--is-ancestor", good, bad], cwd=REPO).returncode != 0:
+        sys.exit(f"ERROR: {args.good} is not an ancestor of {args.bad}")
+
+    cache = os.path.abspath(args.cache)
+    worktree = os.path.join(cache, "worktree")
+    state_file = os.path.join(cache, "state.json")
+    if os.path.exists(worktree):
+        git("worktree", "remove", "--force", worktree, check=False)
+        shutil.rmtree(worktree, ignore_errors=True)
+    git("worktree", "prune")
+    shutil.rmtree(os.path.join(cache, "steps"), ignore_errors=True)
+    os.makedirs(cache, exist_ok=True)
+    git("worktree", "add", "-q", "--detach", worktree, bad)
+    state = {"target": args.target, "metric": args.metric, "filter": args.filter, "threshold": args.threshold,
+             "alpha": args.alpha, "samples": args.samples, "max_samples": args.max_samples,
+             "profile": profile, "variant": variant, "cache": cache}
+    try:
+        bad_exe = measure(state, worktree, bad, "bad")
+        state["kind"], state["filter"] = find_target(state, bad_exe)
+        if state["kind"] == "test":
+            state["metric"] = "ms"
+        state["higher_is_better"] = state["metric"] in HIGHER_IS_BETTER
+        print(f"Target {state['target']} ({state['metric']}), filter {state['filter']}, "
+              f"profile {args.profile} ({variant}), {args.samples}-{args.max_samples} samples per commit")
+        ends = {}
+        for name, commit, exe in (("bad", bad, bad_exe), ("good", good, None)):
+            exe = exe or measure(state, worktree, commit, name)
+            values, error = sample(state, exe, args.max_samples)
+            if error:
+                sys.exit(f"ERROR: the {name} commit {commit[:10]}: {error}")
+            ends[name] = values
+            print(f"  {name:4} {describe(commit)}\n       {format_distribution(values)}")
+        state["good_values"], state["bad_values"] = ends["good"], ends["bad"]
+        total = slowdown(state, ends["bad"], ends["good"])
+        p = slower_p(state, ends["bad"], ends["good"])
+        if total < 1.0 + args.threshold / 100.0 or p >= args.alpha:
+            print(f"\nNo regression to bisect: the bad commit is {100.0 * (total - 1.0):+.1f} % from the good one "
+                  f"(p={p:.4f}), below the threshold of {args.threshold:g} % or not significant.")
+            return 2
+        print(f"  slowdown {100.0 * (total - 1.0):+.1f} % (p={p:.2g})\n")
+        with open(state_file, "w", encoding="utf-8") as f:
+            json.dump(state, f)
+
+        git("bisect", "start", bad, good, cwd=worktree)
+        run = subprocess.Popen(["git", "bisect", "run", sys.executable, os.path.abspath(__file__), "--step", state_file],
+                               cwd=worktree, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+        first_bad, candidates, lines = None, [], []
+        for line in run.stdout:
+            lines.append(line.rstrip("\n"))
+            if line.startswith("bisect: "):
+                print("  " + line[len("bisect: "):], end="")
+            m = RE_FIRST_BAD.match(line)
+            if m:
+                first_bad = m.group(1)
+        run.wait()
+        if first_bad is None:
+            candidates = [line.split()[0] for line in lines if re.match(r"^[0-9a-f]{40}\b", line)]
+        git("bisect", "reset", "--quiet", cwd=worktree, check=False)
+
+        steps = {}
+        steps_dir = os.path.join(cache, "steps")
+        for name in sorted(os.listdir(steps_dir)) if os.path.isdir(steps_dir) else []:
+            with open(os.path.join(steps_dir, name), encoding="utf-8") as f:
+                record = json.load(f)
+                steps[record["commit"]] = record
+        report = {"target": state["target"], "metric": state["metric"], "filter": state["filter"],
+                  "threshold_pct": args.threshold, "good": good, "bad": bad, "first_bad": first_bad,
+                  "candidates": candidates, "steps": list(steps.values()),
+                  "distributions": {"good": distribution(ends["good"]), "bad": distribution(ends["bad"])}}
+        print("\n--- Bisection ---")
+        if first_bad is None:
+            print("  No single first bad commit" + (", it is one of:" if candidates else
+                                                       f" (git bisect run failed):\n" + "\n".join(lines[-10:])))
+            for commit in candidates:
+                print(f"    {describe(commit)}")
+        else:
+            parent = git("rev-parse", first_bad + "^")
+            before = ends["good"]
+            if parent != good:
+                if "values" not in steps.get(parent, {}):
+                    values, _ = sample(state, measure(state, worktree, parent, "parent"), args.samples)
+                    steps[parent] = {"commit": parent, "values": values}
+                before = steps[parent]["values"]
+            first_values = ends["bad"] if first_bad == bad else steps[first_bad]["values"]
+            rows = [("good", good, ends["good"]), ("parent", parent, before), ("first bad", first_bad, first_values),
+                    ("bad", bad, ends["bad"])]
+            print(f"  first bad commit: {describe(first_bad)}")
+            if steps.get(first_bad, {}).get("uncertain") or steps.get(parent, {}).get("uncertain"):
+                print("  WARNING: decided without significance (see --max_samples, --alpha)")
+            print(f"  {state['target']} {state['metric']}:")
+            shown = set()
+            for name, commit, values in rows:
+                if commit not in shown and values:
+                    shown.add(commit)
+                    print(f"    {name:9} {commit[:10]}  {format_distribution(values)}")
+                    report["distributions"][name.replace(" ", "_")] = distribution(values)
+            if before and first_values:
+                print(f"  slowdown at the first bad commit: {100.0 * (slowdown(state, first_values, before) - 1.0):+.1f} % "
+                      f"(p={slower_p(state, first_values, before):.2g})")
+        print(f"  {len(steps)} commits tested")
+        if args.json:
+            with open(args.json, "w", encoding="utf-8") as f:
+                json.dump(report, f, indent=2)
+            print(f"\nBisection JSON report generated at {args.json}")
+        return 0 if first_bad else 1
+    finally:
+        git("bisect", "reset", "--quiet", cwd=worktree, check=False)
+        git("worktree", "remove", "--force", worktree, check=False)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,129 @@
+#  SPDX-License-Identifier: MIT
+# Copyright (c) 2025 Alejandro Avila Marcos
+
+# Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+#  BMT se distribuye bajo los términos de la Licencia MIT.
+#  Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+#  o en <https://opensource.org/licenses/MIT>.
+
+"""ROM/RAM footprint check of the freestanding runner (BMT_FREESTANDING).
+
+Compiles the runner sources with -DBMT_FREESTANDING -ffreestanding for a profile of
+footprint_budget.json (compiler, flags and framework limits), checks that the objects only need
+the platform hooks and compiler runtime helpers (no libc), and compares ROM (code, constants and
+initialized data) and RAM (initialized and zeroed data) with the recorded budget. Exits with 1 if
+a budget is exceeded, so it can gate a CI job; --update records the measured values instead.
+"""
+
+import os
+import re
+import sys
+import json
+import shlex
+import argparse
+import tempfile
+import subprocess
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCES = ["src/bmt_runner.c", "src/bmt_string.c"]
+COMMON_FLAGS = ["-DBMT_FREESTANDING", "-ffreestanding", "-fno-stack-protector",
+                "-fno-asynchronous-unwind-tables", "-fno-unwind-tables"]
+# Symbols an object may leave undefined: the platform hooks, the bounds of the test section and
+# the build ID note (from the linker) and the compiler runtime (libgcc / compiler-rt division,
+# shifts... e.g. __aeabi_uidiv on a Cortex-M0)
+ALLOWED_UNDEFINED = re.compile(r"^(bmt_platform_\w+|__(start|stop)_bmt_tests|__bmt_build_id_note|__aeabi_\w+|__gnu_\w+|__(u?(div|mod)|mul|ash|lsh|clz|ctz|popcount)\w*)$")
+ROM_SECTIONS = re.compile(r"^\.(text|rodata|data|init_array|ctors)")
+RAM_SECTIONS = re.compile(r"^\.(data|bss)|^COMMON$")
+
+
+def tool(cc, name):
+    """The binutils tool of the same toolchain as cc (arm-none-eabi-gcc -> arm-none-eabi-size)."""
+    prefix = cc[:-len("gcc")] if cc.endswith("gcc") else ""
+    return prefix + name
+
+
+def run(cmd):
+    try:
+        result = subprocess.run(cmd, capture_output=True, text=True)
+    except FileNotFoundError:
+        sys.exit(f"ERROR: {cmd[0]} not found (install the toolchain of the profile or pass --cc)")
+    if result.returncode != 0:
+        sys.exit(f"ERROR: {' '.join(cmd)}\n{result.stderr}")
+    return result.stdout
+
+
+def measure(profile):
+    cc = profile["cc"]
+    flags = shlex.split(profile.get("cflags", ""))
+    per_file = {}
+    defined, undefined = set(), set()
+    with tempfile.TemporaryDirectory() as tmp:
+        for src in SOURCES:
+            obj = os.path.join(tmp, os.path.basename(src) + ".o")
+            run([cc, *COMMON_FLAGS, *flags, "-I" + os.path.join(REPO, "include"), "-c", os.path.join(REPO, src), "-o", obj])
+            rom = ram = 0
+            for line in run([tool(cc, "size"), "-A", "-d", obj]).splitlines():
+                fields = line.split()
+                if len(fields) >= 2 and fields[1].isdigit():
+                    rom += int(fields[1]) if ROM_SECTIONS.match(fields[0]) else 0
+                    ram += int(fields[1]) if RAM_SECTIONS.match(fields[0]) else 0
+            per_file[src] = {"rom": rom, "ram": ram}
+            for line in run([tool(cc, "nm"), obj]).splitlines():
+                fields = line.split()
+                if len(fields) == 2 and fields[0] in ("U", "w"):
+                    undefined.add(fields[1])
+                elif len(fields) == 3:
+                    defined.add(fields[2])
+    libc = sorted(sym for sym in undefined - defined if not ALLOWED_UNDEFINED.match(sym))
+    return per_file, libc
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Measure and check the ROM/RAM footprint of the freestanding runner.")
+    ap.add_argument("--profile", default="cortex-m0", help="Profile of the budget file (default: cortex-m0)")
+    ap.add_argument("--budget", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "footprint_budget.json"))
+    ap.add_argument("--cc", help="Override the compiler of the profile")
+    ap.add_argument("--tolerance", type=int, default=0, help="Bytes over budget still accepted")
+    ap.add_argument("--update", action="store_true", help="Record the measured footprint as the new budget")
+    args = ap.parse_args()
+
+    with open(args.budget, encoding="utf-8") as f:
+        budgets = json.load(f)
+    if args.profile not in budgets:
+        sys.exit(f"ERROR: profile '{args.profile}' not in {args.budget} (available: {', '.join(budgets)})")
+    profile = budgets[args.profile]
+    if args.cc:
+        profile["cc"] = args.cc
+
+    per_file, libc = measure(profile)
+    rom = sum(f["rom"] for f in per_file.values())
+    ram = sum(f["ram"] for f in per_file.values())
+    print(f"Profile {args.profile}: {profile['cc']} {profile.get('cflags', '')}")
+    for src, f in per_file.items():
+        print(f"  {src:<22} ROM {f['rom']:>6} B  RAM {f['ram']:>6} B")
+    print(f"  {'total':<22} ROM {rom:>6} B  RAM {ram:>6} B")
+
+    if libc:
+        print(f"FAIL: the runner needs symbols outside the platform hooks: {', '.join(libc)}")
+        return 1
+    if args.update:
+        profile["rom"], profile["ram"] = rom, ram
+        with open(args.budget, "w", encoding="utf-8") as f:
+            json.dump(budgets, f, indent=2)
+            f.write("\n")
+        print(f"Budget of '{args.profile}' updated in {args.budget}")
+        return 0
+    if profile.get("rom") is None or profile.get("ram") is None:
+        print(f"No budget recorded for '{args.profile}' yet: run with --update to record it.")
+        return 0
+    failed = False
+    for name, measured in (("ROM", rom), ("RAM", ram)):
+        budget = profile[name.lower()]
+        status = "ok" if measured <= budget + args.tolerance else "OVER BUDGET"
+        failed |= status != "ok"
+        print(f"  {name}: {measured} B (budget {budget} B, {measured - budget:+d} B) {status}")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,335 @@
+#  SPDX-License-Identifier: MIT
+# Copyright (c) 2025 Alejandro Avila Marcos
+
+# Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+#  BMT se distribuye bajo los términos de la Licencia MIT.
+#  Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+#  o en <https://opensource.org/licenses/MIT>.
+
+"""Host-side mutator for on-target fuzzing (bmt_fuzz_serve() in bmt_fuzz.h).
+
+Mutates inputs from a corpus directory, sends them to the target in batched frames over the
+serial link (or to the Linux host port through a pipe with --cmd), and reads one
+"[ FUZZ RES ]" line per batch with the status and coverage of each input. Passing inputs that
+reach new edges are added to the corpus; failing or crashing ones are saved to the crashes
+directory (one per coverage path) and replayed once in a verbose batch, to print the failure
+report.
+"""
+
+import os
+import re
+import sys
+import time
+import shlex
+import queue
+import random
+import struct
+import hashlib
+import argparse
+import threading
+import subprocess
+
+try:
+    import serial
+except ImportError:  # Only needed for --port
+    serial = None
+
+SYNC = b"\xb7\x7e"
+FRAME_SELECT, FRAME_BATCH, FRAME_END = ord('S'), ord('B'), ord('E')
+BATCH_VERBOSE = 0x01
+INTERESTING = [0x00, 0x01, 0x7f, 0x80, 0xff]
+INTERESTING16 = [0x0000, 0x0080, 0x00ff, 0x0100, 0x7fff, 0x8000, 0xffff]
+
+re_ready = re.compile(r"\[ FUZZ SRV \] ready targets=(\S*) map_bits=(\d+) frame_max=(\d+) max_input=(\d+)")
+re_res = re.compile(r"\[ FUZZ RES \] seq=(\d+) results=(\S*)")
+re_target = re.compile(r"\[ FUZZ SRV \] target=(\S+) ok=(\d)")
+re_error = re.compile(r"\[ FUZZ SRV \] error=(\S+)")
+
+
+def crc16(data):
+    """CRC-16/CCITT (poly 0x1021, init 0xFFFF), as bmt_fuzz_crc16()."""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def frame(ftype, payload=b""):
+    body = bytes([ftype]) + struct.pack("<H", len(payload)) + payload
+    return SYNC + body + struct.pack("<H", crc16(body))
+
+
+def batch_frame(seq, inputs, flags=0):
+    payload = struct.pack("<HBB", seq & 0xFFFF, flags, len(inputs))
+    for data in inputs:
+        payload += struct.pack("<H", len(data)) + data
+    return frame(FRAME_BATCH, payload)
+
+
+class Link:
+    """Line-oriented connection to the target. A reader thread queues the received lines."""
+    def __init__(self, reader, writer, echo):
+        self.writer = writer
+        self.echo = echo
+        self.lines = queue.Queue()
+        threading.Thread(target=self._read, args=(reader,), daemon=True).start()
+
+    def _read(self, reader):
+        buf = b""
+        while True:
+            chunk = reader()
+            if not chunk:
+                if chunk is None:
+                    self.lines.put(None)
+                    return
+                continue
+            buf += chunk
+            while b"\n" in buf:
+                line, buf = buf.split(b"\n", 1)
+                self.lines.put(line.decode("utf-8", errors="replace").strip())
+
+    def send(self, data):
+        self.writer(data)
+
+    def readline(self, timeout):
+        """Next line, or None on timeout / closed link. Lines that are not fuzz results are echoed."""
+        try:
+            line = self.lines.get(timeout=timeout)
+        except queue.Empty:
+            return None
+        if line is not None and self.echo and not line.startswith("[ FUZZ RES ]"):
+            print(f"DUT: {line}")
+        return line
+
+
+def open_link(args):
+    if args.cmd:
+        env = dict(os.environ, BMT_FUZZ_SERVE="1")
+        proc = subprocess.Popen(shlex.split(args.cmd), stdin=subprocess.PIPE, stdout=subprocess.PIPE, env=env)
+
+        def reader():
+            data = proc.stdout.read1(4096)
+            return data if data else None
+
+        def writer(data):
+            proc.stdin.write(data)
+            proc.stdin.flush()
+        link = Link(reader, writer, args.verbose)
+        link.proc = proc
+        return link
+    if serial is None:
+        sys.exit("Error: pyserial is not installed (pip install pyserial). Use --cmd for the Linux host port.")
+    ser = serial.Serial(args.port, args.baud, timeout=0.1)
+
+    def serial_reader():
+        return ser.read(4096)
+    link = Link(serial_reader, ser.write, args.verbose)
+    link.proc = None
+    return link
+
+
+def mutate(data, corpus, max_len, rng):
+    """Applies 1-4 random mutations (bit/byte changes, inserts, deletes, splices)."""
+    out = bytearray(data)
+    for _ in range(rng.randint(1, 4)):
+        op = rng.randrange(8)
+        pos = rng.randrange(len(out)) if out else 0
+        if op == 0 and out:
+            out[pos] ^= 1 << rng.randrange(8)
+        elif op == 1 and out:
+            out[pos] = rng.randrange(256)
+        elif op == 2 and out:
+            out[pos] = rng.choice(INTERESTING)
+        elif op == 3 and len(out) >= 2:
+            pos = rng.randrange(len(out) - 1)
+            out[pos:pos + 2] = struct.pack("<H", rng.choice(INTERESTING16))
+        elif op == 4:
+            out[pos:pos] = bytes(rng.randrange(256) for _ in range(rng.randint(1, 8)))
+        elif op == 5 and out:
+            del out[pos:pos + rng.randint(1, 8)]
+        elif op == 6 and out:
+            n = rng.randint(1, min(16, len(out) - pos))
+            dst = rng.randrange(len(out) + 1)
+            out[dst:dst] = out[pos:pos + n]
+        elif op == 7 and corpus:
+            other = rng.choice(corpus)
+            cut = rng.randint(0, len(other))
+            out = out[:pos] + bytearray(other[cut:])
+    return bytes(out[:max_len])
+
+
+def save(directory, prefix, data):
+    os.makedirs(directory, exist_ok=True)
+    path = os.path.join(directory, prefix + hashlib.sha1(data).hexdigest()[:16])
+    with open(path, "wb") as f:
+        f.write(data)
+    return path
+
+
+def wait_for(link, regex, timeout):
+    end = time.time() + timeout
+    while time.time() < end:
+        line = link.readline(end - time.time())
+        if line is None:
+            if not link.lines.empty():
+                continue
+            return None
+        m = regex.match(line)
+        if m:
+            return m
+    return None
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Feed mutated inputs to a FUZZ_TEST running on the target (bmt_fuzz_serve()).")
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--port", help="Serial port of the board (e.g. /dev/ttyUSB0)")
+    src.add_argument("--cmd", help="Command of the Linux host port (run with BMT_FUZZ_SERVE=1), e.g. ./bmt_host")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--target", help="FUZZ_TEST to fuzz (Suite.Name); default: the only one")
+    ap.add_argument("--corpus", required=True, help="Corpus directory: seeds are read from it, new inputs are added to it")
+    ap.add_argument("--crashes", default="fuzz_crashes", help="Where failing, crashing and hanging inputs are saved")
+    ap.add_argument("--batch", type=int, default=32, help="Inputs per frame (max 255)")
+    ap.add_argument("--window", type=int, default=1,
+                    help="Batches in flight; >1 only if the target buffers its UART input (e.g. interrupt-driven RX)")
+    ap.add_argument("--max_len", type=int, default=256, help="Maximum input length")
+    ap.add_argument("--runs", type=int, default=0, help="Stop after this many inputs (0: no limit)")
+    ap.add_argument("--time", type=float, default=0, help="Stop after this many seconds (0: no limit)")
+    ap.add_argument("--timeout", type=float, default=10.0, help="Seconds to wait for a batch result before declaring a hang")
+    ap.add_argument("--seed", type=int, default=None, help="Seed of the mutator")
+    ap.add_argument("--verbose", action="store_true", help="Echo all target output")
+    args = ap.parse_args()
+
+    rng = random.Random(args.seed)
+    link = open_link(args)
+    ready = wait_for(link, re_ready, 30)
+    if not ready:
+        sys.exit("Error: the target did not announce '[ FUZZ SRV ] ready'")
+    targets = [t for t in ready.group(1).split(",") if t]
+    frame_max, max_input = int(ready.group(3)), int(ready.group(4))
+    max_len = min(args.max_len, max_input)
+    print(f"Target ready: {len(targets)} fuzz target(s) {targets}, map of {ready.group(2)} bits")
+
+    target = args.target or (targets[0] if len(targets) == 1 else None)
+    if target is None:
+        sys.exit(f"Error: choose a target with --target ({', '.join(targets)})")
+    link.send(frame(FRAME_SELECT, target.encode()))
+    selected = wait_for(link, re_target, args.timeout)
+    if not selected or selected.group(2) != "1":
+        sys.exit(f"Error: the target does not know {target}")
+
+    os.makedirs(args.corpus, exist_ok=True)
+    corpus = []
+    for name in sorted(os.listdir(args.corpus)):
+        with open(os.path.join(args.corpus, name), "rb") as f:
+            corpus.append(f.read()[:max_len])
+    if not corpus:
+        corpus.append(b"")
+    known = {hashlib.sha1(c).digest() for c in corpus}
+
+    seq, execs, edges, failures, hangs = 0, 0, 0, 0, 0
+    in_flight = []
+    to_replay = []
+    failing_paths = set()
+    start = last_stats = time.time()
+
+    def send_batch():
+        nonlocal seq
+        inputs, size = [], 4
+        while len(inputs) < min(args.batch, 255):
+            data = mutate(rng.choice(corpus), corpus, max_len, rng)
+            if size + 2 + len(data) > frame_max:
+                break
+            inputs.append(data)
+            size += 2 + len(data)
+        link.send(batch_frame(seq, inputs))
+        in_flight.append((seq & 0xFFFF, inputs))
+        seq += 1
+
+    def collect():
+        """Waits for the result of the oldest batch in flight. False on a hang."""
+        nonlocal execs, edges, failures
+        seq_expected, inputs = in_flight[0]
+        end = time.time() + args.timeout
+        while time.time() < end:
+            line = link.readline(end - time.time())
+            if line is None:
+                break
+            m = re_res.match(line)
+            if not m or int(m.group(1)) != seq_expected:
+                continue
+            in_flight.pop(0)
+            for data, result in zip(inputs, m.group(2).split(",")):
+                status, new, _, path_hash = result.split(":")
+                execs += 1
+                if status == "P" and int(new) > 0:
+                    edges += int(new)
+                    digest = hashlib.sha1(data).digest()
+                    if digest not in known:
+                        known.add(digest)
+                        corpus.append(data)
+                        save(args.corpus, "", data)
+                if status != "P" and (status, path_hash) not in failing_paths:
+                    failing_paths.add((status, path_hash))  # One report per failing coverage path
+                    failures += 1
+                    path = save(args.crashes, "crash-" if status == "C" else "fail-", data)
+                    print(f"{'CRASH' if status == 'C' else 'FAILURE'}: input saved to {path}")
+                    to_replay.append(data)
+            return True
+        return False
+
+    def replay(data):
+        """Runs one failing input in a verbose batch, so the target prints its failure report."""
+        link.send(batch_frame(0xFFFF, [data], BATCH_VERBOSE))
+        end = time.time() + args.timeout
+        while time.time() < end:
+            line = link.readline(end - time.time())
+            if line is None:
+                break
+            if not line.startswith("[ FUZZ RES ]"):
+                print(f"  {line}")
+            else:
+                break
+
+    try:
+        while (not args.runs or execs < args.runs) and (not args.time or time.time() - start < args.time):
+            while len(in_flight) < max(1, args.window):
+                send_batch()
+            if not collect():
+                hangs += 1
+                for _, inputs in in_flight:
+                    for data in inputs:
+                        save(args.crashes, "hang-", data)
+                print(f"HANG: no result within {args.timeout} s; batch saved to {args.crashes}. Reset the target.")
+                return 2
+            if to_replay:
+                while in_flight and collect():
+                    pass
+                for data in to_replay:
+                    replay(data)
+                to_replay.clear()
+            if time.time() - last_stats >= 2.0:
+                last_stats = time.time()
+                rate = execs / (last_stats - start)
+                print(f"execs={execs} exec_per_s={rate:.0f} corpus={len(corpus)} edges={edges} failures={failures}")
+        while in_flight and collect():
+            pass
+        link.send(frame(FRAME_END))
+        wait_for(link, re.compile(r"\[ FUZZ SRV \] done"), args.timeout)
+    finally:
+        if link.proc:
+            try:
+                link.proc.stdin.close()
+                link.proc.wait(timeout=5)
+            except (OSError, subprocess.TimeoutExpired):
+                link.proc.kill()  # Hung input
+    elapsed = time.time() - start
+    print(f"Done: {execs} inputs in {elapsed:.1f} s ({execs / max(elapsed, 1e-9):.0f}/s), corpus {len(corpus)}, "
+          f"{edges} edges, {failures} failure(s), {hangs} hang(s)")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,337 @@
+#  SPDX-License-Identifier: MIT
+# Copyright (c) 2025 Alejandro Avila Marcos
+
+# Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+#  BMT se distribuye bajo los términos de la Licencia MIT.
+#  Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+#  o en <https://opensource.org/licenses/MIT>.
+
+"""Compiler/flag matrix: the same BMT suite built and run once per variant of flag_matrix.json.
+
+A profile of the matrix file gives the compiler, the sources and how to run the result: on the
+Linux host port ("run": a command line, "{exe}" being the binary) or on a board ("load": a
+command that downloads {exe} to the board, whose UART on "port" is then read until the end of
+the run). Each variant adds its flags (e.g. -O2, -O3 -flto, -mfpu=neon).
+
+Variants are built in parallel (--jobs). Runs are sequential by default, since benchmarks that
+share the machine disturb each other; --run_jobs allows parallel runs on the host when there
+are idle cores to spare. Each result is cached under the hash of the sources, the headers of
+the include directories, the compiler version and the flags, so only variants whose inputs
+changed are built and run again.
+
+The report compares, per test, the time (ms, from the runner) and the code size of the test
+function; per benchmark, the median ns per iteration and its ratio to the first variant; and
+per variant, the total code size against the geometric mean of the benchmark ratios. Entries
+on the Pareto front (no other variant is both faster and smaller) are marked with '*'.
+"""
+
+import os
+import re
+import sys
+import glob
+import json
+import math
+import time
+import shlex
+import hashlib
+import argparse
+import subprocess
+from threading import BoundedSemaphore
+from concurrent.futures import ThreadPoolExecutor
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from parse_bmt_output import parse_bench_fields  # noqa: E402
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+HEADER_EXT = (".h", ".hpp")
+DONE_MARKER = "[BMT_DONE_ALL_TESTS]"
+RE_RESULT = re.compile(r"^\[\s+(OK|FAILED)\s+\] (\S+)\.(\S+) \((\d+) ms\)")
+RE_BENCH = re.compile(r"^\[ BENCH    \] (\S+) (.*)$")
+RE_TEST_SYMBOL = re.compile(r"^bmt_(?:test|body)_(\w+?)(?:\.\w+)*$")
+
+
+def expand(value):
+    return os.path.expandvars(value) if isinstance(value, str) else value
+
+
+def tool(cc, name):
+    """The binutils tool of the same toolchain as cc (arm-none-eabi-gcc -> arm-none-eabi-size)."""
+    prefix = cc[:-len("gcc")] if cc.endswith("gcc") else ""
+    return prefix + name
+
+
+def variant_flags(variant):
+    """A variant is a string of flags, or {"cflags": ..., "ldflags": ...}."""
+    if isinstance(variant, str):
+        return variant, ""
+    return variant.get("cflags", ""), variant.get("ldflags", "")
+
+
+def source_files(profile, root=REPO):
+    """Sources of the profile in the checkout at `root` (another worktree for bmt_bisect.py)."""
+    files = []
+    for pattern in profile["sources"]:
+        matched = sorted(glob.glob(os.path.join(root, expand(pattern))))
+        if not matched:
+            sys.exit(f"ERROR: no sources match '{pattern}'")
+        files += matched
+    return files
+
+
+def cache_key(profile, name, sources):
+    """Hash of everything that decides the binary and its results."""
+    h = hashlib.sha256()
+    cc = expand(profile["cc"])
+    try:
+        h.update(subprocess.run([cc, "--version"], capture_output=True, text=True).stdout.encode())
+    except FileNotFoundError:
+        sys.exit(f"ERROR: {cc} not found (install the toolchain of the profile)")
+    cflags, ldflags = variant_flags(profile["variants"][name])
+    for text in (profile.get("cflags", ""), cflags, profile.get("ldflags", ""), ldflags,
+                 profile.get("run", ""), json.dumps(profile.get("env", {}), sort_keys=True)):
+        h.update(expand(text).encode() + b"\0")
+    inputs = list(sources)
+    for inc in profile.get("includes", []):
+        inc_dir = os.path.join(REPO, expand(inc))
+        if os.path.isdir(inc_dir):
+            inputs += sorted(os.path.join(inc_dir, f) for f in os.listdir(inc_dir) if f.endswith(HEADER_EXT))
+    for path in inputs:
+        h.update(os.path.relpath(path, REPO).encode() + b"\0")
+        with open(path, "rb") as f:
+            h.update(hashlib.sha256(f.read()).digest())
+    return h.hexdigest()[:16]
+
+
+def build(profile, name, sources, exe):
+    cc = expand(profile["cc"])
+    cflags, ldflags = variant_flags(profile["variants"][name])
+    cmd = [cc, *shlex.split(expand(profile.get("cflags", ""))), *shlex.split(cflags)]
+    cmd += ["-I" + os.path.join(REPO, expand(inc)) for inc in profile.get("includes", [])]
+    cmd += [*sources, "-o", exe, *shlex.split(expand(profile.get("ldflags", ""))), *shlex.split(ldflags)]
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        return f"{' '.join(cmd)}\n{result.stderr}"
+    return None
+
+
+def measure_size(profile, exe):
+    """Total code (.text) of the binary and the size of each test function, from nm."""
+    cc = expand(profile["cc"])
+    text = 0
+    out = subprocess.run([tool(cc, "size"), "-A", "-d", exe], capture_output=True, text=True).stdout
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[1].isdigit() and fields[0].startswith(".text"):
+            text += int(fields[1])
+    functions = {}
+    out = subprocess.run([tool(cc, "nm"), "-S", exe], capture_output=True, text=True).stdout
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in "tT":
+            m = RE_TEST_SYMBOL.match(fields[3])
+            if m:
+                functions[m.group(1)] = functions.get(m.group(1), 0) + int(fields[1], 16)
+    return text, functions
+
+
+def run_host(profile, exe):
+    cmd = [part.replace("{exe}", exe) for part in shlex.split(expand(profile.get("run", "{exe}")))]
+    env = dict(os.environ, **{k: expand(v) for k, v in profile.get("env", {}).items()})
+    try:
+        result = subprocess.run(cmd, capture_output=True, text=True, env=env, timeout=profile.get("timeout", 300))
+    except subprocess.TimeoutExpired:
+        return None, "timeout"
+    return result.stdout, None
+
+
+def run_board(profile, exe):
+    try:
+        import serial
+    except ImportError:
+        sys.exit("ERROR: pyserial is not installed (pip install pyserial); it is needed to read the board")
+    ser = serial.Serial(expand(profile["port"]), profile.get("baud", 115200), timeout=0.5)
+    ser.reset_input_buffer()
+    cmd = [part.replace("{exe}", exe) for part in shlex.split(expand(profile["load"]))]
+    load = subprocess.run(cmd, capture_output=True, text=True)
+    if load.returncode != 0:
+        ser.close()
+        return None, f"load failed: {load.stderr.strip()}"
+    lines = []
+    deadline = time.time() + profile.get("timeout", 600)
+    while time.time() < deadline:
+        line = ser.readline().decode("utf-8", errors="replace").rstrip("\r\n")
+        if line:
+            lines.append(line)
+            if DONE_MARKER in line:
+                break
+    ser.close()
+    if not lines or DONE_MARKER not in lines[-1]:
+        return "\n".join(lines), "timeout"
+    return "\n".join(lines), None
+
+
+def parse_output(output):
+    tests, benches = {}, {}
+    for line in output.splitlines():
+        m = RE_RESULT.match(line)
+        if m:
+            tests[f"{m.group(2)}.{m.group(3)}"] = {"passed": m.group(1) == "OK", "ms": int(m.group(4))}
+            continue
+        m = RE_BENCH.match(line)
+        if m:
+            fields = parse_bench_fields(m.group(2))
+            if "ns_median" in fields:
+                benches[m.group(1)] = fields["ns_median"]
+    return tests, benches
+
+
+def run_variant(profile, name, sources, cache_dir, force, run_lock):
+    key = cache_key(profile, name, sources)
+    vdir = os.path.join(cache_dir, f"{name}-{key}")
+    result_file = os.path.join(vdir, "result.json")
+    if not force and os.path.exists(result_file):
+        with open(result_file, encoding="utf-8") as f:
+            result = json.load(f)
+        result["cached"] = True
+        return result
+    os.makedirs(vdir, exist_ok=True)
+    exe = os.path.join(vdir, "bmt_suite.elf")
+    error = build(profile, name, sources, exe)
+    if error:
+        return {"variant": name, "key": key, "error": f"build failed: {error}"}
+    text, functions = measure_size(profile, exe)
+    with run_lock:
+        output, error = run_board(profile, exe) if profile.get("load") is not None else run_host(profile, exe)
+    with open(os.path.join(vdir, "output.txt"), "w", encoding="utf-8") as f:
+        f.write(output or "")
+    if error:
+        return {"variant": name, "key": key, "error": error}
+    tests, benches = parse_output(output)
+    result = {"variant": name, "key": key, "text": text, "tests": tests, "benchmarks": benches,
+              "functions": {t: functions.get(t.replace(".", "_")) for t in tests}}
+    with open(result_file, "w", encoding="utf-8") as f:
+        json.dump(result, f, indent=2)
+    result["cached"] = False
+    return result
+
+
+def pareto(points):
+    """Indices of the points (time, size) not dominated by another one (None = no data)."""
+    front = set()
+    for i, (t, s) in enumerate(points):
+        if t is None or s is None:
+            continue
+        dominated = any(t2 is not None and s2 is not None and t2 <= t and s2 <= s and (t2 < t or s2 < s)
+                        for j, (t2, s2) in enumerate(points) if j != i)
+        if not dominated:
+            front.add(i)
+    return front
+
+
+def print_table(title, header, rows):
+    widths = [max(len(str(r[i])) for r in [header] + rows) for i in range(len(header))]
+    print(f"\n--- {title} ---")
+    for r in [header] + rows:
+        print("  " + "  ".join(str(c).ljust(w) if i == 0 else str(c).rjust(w) for i, (c, w) in enumerate(zip(r, widths))))
+
+
+def report(results):
+    names = [r["variant"] for r in results]
+    base = results[0]
+
+    rows = []
+    for test in sorted({t for r in results for t in r["tests"]}):
+        points = [(r["tests"].get(test, {}).get("ms"), r["functions"].get(test)) for r in results]
+        front = pareto(points)
+        row = [test]
+        for i, (r, (ms, size)) in enumerate(zip(results, points)):
+            state = r["tests"].get(test)
+            if state is None:
+                row.append("-")
+            else:
+                cell = f"{ms}ms/{size if size is not None else '?'}B" + ("" if state["passed"] else " FAIL")
+                row.append(cell + ("*" if i in front else " "))
+        rows.append(row)
+    print_table("Tests: time / size of the test function (* = Pareto front)", ["test"] + names, rows)
+
+    rows = []
+    ratios = {r["variant"]: [] for r in results}
+    for bench in sorted({b for r in results for b in r["benchmarks"]}):
+        row = [bench]
+        base_ns = base["benchmarks"].get(bench)
+        for r in results:
+            ns = r["benchmarks"].get(bench)
+            if ns is None:
+                row.append("-")
+                continue
+            if base_ns:
+                ratios[r["variant"]].append(ns / base_ns)
+                row.append(f"{ns:.3f} ({ns / base_ns:.2f}x)")
+            else:
+                row.append(f"{ns:.3f}")
+        rows.append(row)
+    if rows:
+        print_table(f"Benchmarks: ns per iteration (ratio to {base['variant']})", ["benchmark"] + names, rows)
+
+    geomeans = [math.exp(sum(map(math.log, ratios[n])) / len(ratios[n])) if ratios[n] else None for n in names]
+    totals_ms = [sum(t["ms"] for t in r["tests"].values()) for r in results]
+    points = [(g if g is not None else ms, r["text"]) for g, ms, r in zip(geomeans, totals_ms, results)]
+    front = pareto(points)
+    rows = []
+    for i, (r, g, ms) in enumerate(zip(results, geomeans, totals_ms)):
+        failed = sum(not t["passed"] for t in r["tests"].values())
+        rows.append([r["variant"] + (" *" if i in front else ""), r["text"], ms,
+                     f"{g:.3f}" if g is not None else "-", failed, "yes" if r.get("cached") else "no"])
+    print_table("Variants (* = Pareto front of time and size)",
+                ["variant", "text_bytes", "tests_ms", "bench_geomean", "failed", "cached"], rows)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Build and run a BMT suite under a compiler/flag matrix and compare time and size.")
+    ap.add_argument("--profile", default="linux_host", help="Profile of the matrix file (default: linux_host)")
+    ap.add_argument("--matrix", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "flag_matrix.json"))
+    ap.add_argument("--variants", help="Comma-separated subset of variants (the first is the baseline)")
+    ap.add_argument("--jobs", type=int, default=os.cpu_count() or 1, help="Variants built in parallel")
+    ap.add_argument("--run_jobs", type=int, default=1,
+                    help="Variants run in parallel on the host (default 1: parallel runs disturb the timings)")
+    ap.add_argument("--cache", default=os.path.join(REPO, ".bmt_matrix_cache"), help="Cache directory")
+    ap.add_argument("--force", action="store_true", help="Build and run again even if cached")
+    ap.add_argument("--json", help="Write all the results to this JSON file")
+    args = ap.parse_args()
+
+    with open(args.matrix, encoding="utf-8") as f:
+        matrix = json.load(f)
+    if args.profile not in matrix:
+        sys.exit(f"ERROR: profile '{args.profile}' not in {args.matrix} (available: {', '.join(matrix)})")
+    profile = matrix[args.profile]
+    if "load" in profile and profile["load"] is None:
+        sys.exit(f"ERROR: set 'load' of profile '{args.profile}' to the command that downloads {{exe}} to the board")
+    names = args.variants.split(",") if args.variants else list(profile["variants"])
+    unknown = [n for n in names if n not in profile["variants"]]
+    if unknown:
+        sys.exit(f"ERROR: unknown variants {', '.join(unknown)} (available: {', '.join(profile['variants'])})")
+
+    sources = source_files(profile)
+    on_board = profile.get("load") is not None
+    # Builds overlap freely; runs take one of the run_jobs slots
+    run_lock = BoundedSemaphore(1 if on_board else max(1, args.run_jobs))
+    with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        results = list(pool.map(lambda n: run_variant(profile, n, sources, args.cache, args.force, run_lock), names))
+
+    failed = [r for r in results if "error" in r]
+    for r in failed:
+        print(f"ERROR: variant {r['variant']}: {r['error']}")
+    results = [r for r in results if "error" not in r]
+    if not results:
+        return 1
+    print(f"Profile {args.profile}: {expand(profile['cc'])}, {len(results)} variants, baseline {results[0]['variant']}")
+    report(results)
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump({"profile": args.profile, "variants": results}, f, indent=2)
+        print(f"\nMatrix JSON report generated at {args.json}")
+    return 1 if failed or any(not t["passed"] for r in results for t in r["tests"].values()) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
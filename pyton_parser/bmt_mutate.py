@@ -0,0 +1,467 @@
+#  SPDX-License-Identifier: MIT
+# Copyright (c) 2025 Alejandro Avila Marcos
+
+# Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+#  BMT se distribuye bajo los términos de la Licencia MIT.
+#  Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+#  o en <https://opensource.org/licenses/MIT>.
+
+"""Mutation testing of selected sources with the Linux host port.
+
+Source mutants of each selected file (operator swaps, constant tweaks, negated conditions) are
+built one by one against the cached objects of the rest of a flag_matrix.json profile, and run
+with the suite restricted (BMT_TEST_FILTER) to the tests that execute the mutated line. Those
+come from per-test gcov coverage of a --coverage build. A mutant is killed if the run fails,
+crashes or times out; the report gives the mutation score and the surviving mutants, which
+point at behavior the tests do not check (or at equivalent mutants).
+
+Builds are incremental: objects, coverage and the verdict of each mutant are cached under the
+hash of their inputs, so after an edit only the affected mutants are built and run again.
+Mutants are built and run in a pool of --jobs workers (default: all cores).
+"""
+
+import os
+import re
+import sys
+import json
+import time
+import shlex
+import shutil
+import hashlib
+import argparse
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from bmt_matrix import REPO, HEADER_EXT, RE_RESULT, expand, variant_flags, source_files  # noqa: E402
+
+OPERATORS = ("arith", "rel", "logic", "bit", "const", "negate")
+# Binary operators and what each becomes: one mutant per replacement
+SWAPS = {
+    "arith": {"+": ["-"], "-": ["+"], "*": ["/"], "/": ["*"], "%": ["*"],
+              "+=": ["-="], "-=": ["+="], "*=": ["/="], "/=": ["*="], "++": ["--"], "--": ["++"]},
+    "rel": {"<": ["<="], "<=": ["<"], ">": [">="], ">=": [">"], "==": ["!="], "!=": ["=="]},
+    "logic": {"&&": ["||"], "||": ["&&"]},
+    "bit": {"&": ["|"], "|": ["&"], "^": ["&"], "<<": [">>"], ">>": ["<<"], "&=": ["|="], "|=": ["&="]},
+}
+# Tokens that can only be binary after an operand (unary minus, dereference, address-of...)
+BINARY_ONLY = {"+", "-", "*", "&"}
+KEYWORDS = {
+    "auto", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum",
+    "extern", "float", "for", "goto", "if", "inline", "int", "long", "register", "restrict", "return",
+    "short", "signed", "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void",
+    "volatile", "while", "bool", "_Bool",
+}
+TOKEN = re.compile(r"""
+    (?P<ws>\s+)
+  | (?P<comment>//[^\n]*|/\*.*?\*/)
+  | (?P<string>"(?:\\.|[^"\\\n])*"|'(?:\\.|[^'\\\n])*')
+  | (?P<number>(?:0[xX][0-9a-fA-F]+|\d+\.?\d*(?:[eE][+-]?\d+)?|\.\d+(?:[eE][+-]?\d+)?)[uUlLfF]*)
+  | (?P<ident>[A-Za-z_]\w*)
+  | (?P<op><<=|>>=|->|\+\+|--|<<|>>|<=|>=|==|!=|&&|\|\||[-+*/%&|^]=|[-+*/%<>=!&|^~?:;,.(){}\[\]#])
+""", re.S | re.X)
+
+
+def blank_preprocessor(text):
+    """Replaces preprocessor lines (and their continuations) with spaces, keeping offsets."""
+    out, continued = [], False
+    for line in text.splitlines(keepends=True):
+        body = line.rstrip("\r\n")
+        if continued or body.lstrip().startswith("#"):
+            continued = body.endswith("\\")
+            out.append(" " * len(body) + line[len(body):])
+        else:
+            out.append(line)
+    return "".join(out)
+
+
+def tokenize(text):
+    tokens, pos = [], 0
+    clean = blank_preprocessor(text)
+    while pos < len(clean):
+        m = TOKEN.match(clean, pos)
+        if not m:
+            pos += 1  # Stray character (e.g. '\\' or '@' in a macro body): not mutated
+            continue
+        if m.lastgroup not in ("ws", "comment"):
+            tokens.append((m.lastgroup, m.start(), m.end(), m.group()))
+        pos = m.end()
+    return tokens
+
+
+def is_operand_end(token):
+    """Whether a binary operator can follow this token."""
+    if token is None:
+        return False
+    kind, _, _, value = token
+    if kind == "ident":
+        return value not in KEYWORDS and not value.endswith("_t")  # uint32_t* p is a declaration
+    return kind in ("number", "string") or value in (")", "]")
+
+
+def tweak_number(value):
+    """A literal one unit away (0 -> 1, 1 -> 0, n -> n + 1), with the same suffix and base."""
+    m = re.match(r"^(0[xX][0-9a-fA-F]+|[\d.]+(?:[eE][+-]?\d+)?)([uUlLfF]*)$", value)
+    if not m:
+        return None
+    digits, suffix = m.groups()
+    if digits.lower().startswith("0x"):
+        n = int(digits, 16)
+        return f"0x{(0 if n == 1 else n + 1):X}{suffix}"
+    if re.match(r"^\d+$", digits):
+        n = int(digits)
+        return f"{0 if n == 1 else n + 1}{suffix}"
+    f = float(digits)
+    return f"{0.0 if f == 1.0 else f + 1.0!r}{suffix}"
+
+
+def matching_paren(tokens, i):
+    depth = 0
+    for j in range(i, len(tokens)):
+        if tokens[j][3] == "(":
+            depth += 1
+        elif tokens[j][3] == ")":
+            depth -= 1
+            if depth == 0:
+                return j
+    return None
+
+
+def generate_mutants(path, text, operators):
+    """Mutants of one source: (start, end, replacement, operator, original) edits of the text,
+    only inside braces (function bodies and initializers)."""
+    tokens = tokenize(text)
+    mutants, depth = [], 0
+    for i, (kind, start, end, value) in enumerate(tokens):
+        if value == "{":
+            depth += 1
+        elif value == "}":
+            depth -= 1
+        if depth == 0:
+            continue
+        prev = tokens[i - 1] if i > 0 else None
+        if kind == "op":
+            for op in ("arith", "rel", "logic", "bit"):
+                if op not in operators or value not in SWAPS[op]:
+                    continue
+                if value in BINARY_ONLY and not is_operand_end(prev):
+                    continue
+                if value in ("++", "--") and not (is_operand_end(prev) or (i + 1 < len(tokens) and tokens[i + 1][0] == "ident")):
+                    continue
+                for repl in SWAPS[op][value]:
+                    mutants.append((start, end, repl, op, value))
+        elif kind == "number" and "const" in operators:
+            repl = tweak_number(value)
+            if repl is not None and repl != value:
+                mutants.append((start, end, repl, "const", value))
+        elif kind == "ident" and value in ("true", "false") and "const" in operators:
+            mutants.append((start, end, "false" if value == "true" else "true", "const", value))
+        elif kind == "ident" and value in ("if", "while") and "negate" in operators:
+            if i + 1 < len(tokens) and tokens[i + 1][3] == "(":
+                close = matching_paren(tokens, i + 1)
+                if close is not None:
+                    lo, hi = tokens[i + 1][2], tokens[close][1]
+                    mutants.append((lo, hi, f"!({text[lo:hi]})", "negate", text[lo:hi]))
+    result = []
+    for start, end, repl, op, original in mutants:
+        line = text.count("\n", 0, start) + 1
+        col = start - (text.rfind("\n", 0, start) + 1) + 1
+        result.append({"file": os.path.relpath(path, REPO), "line": line, "col": col, "operator": op,
+                       "original": original, "replacement": repl,
+                       "source": text[:start] + repl + text[end:]})
+    return result
+
+
+def digest(*parts):
+    h = hashlib.sha256()
+    for part in parts:
+        h.update(part if isinstance(part, bytes) else str(part).encode())
+        h.update(b"\0")
+    return h.hexdigest()[:16]
+
+
+class Builder:
+    """Compiles and links the profile's sources, caching objects by the hash of their inputs."""
+
+    def __init__(self, profile, variant, cache, root=REPO, sources=()):
+        self.root = root
+        self.cc = expand(profile["cc"])
+        cflags, ldflags = variant_flags(profile["variants"][variant])
+        self.cflags = shlex.split(expand(profile.get("cflags", ""))) + shlex.split(cflags)
+        self.cflags += ["-I" + os.path.join(root, expand(inc)) for inc in profile.get("includes", [])]
+        self.ldflags = shlex.split(expand(profile.get("ldflags", ""))) + shlex.split(ldflags)
+        self.objdir = os.path.join(cache, "obj")
+        os.makedirs(self.objdir, exist_ok=True)
+        try:
+            version = subprocess.run([self.cc, "--version"], capture_output=True, text=True).stdout
+        except FileNotFoundError:
+            sys.exit(f"ERROR: {self.cc} not found (install the toolchain of the profile)")
+        # Any header of an include directory, or next to a source ("" includes), may reach any
+        # source: they all enter every hash
+        headers = []
+        dirs = [os.path.join(root, expand(inc)) for inc in profile.get("includes", [])]
+        dirs += sorted({os.path.dirname(src) for src in sources} - set(dirs))
+        for inc_dir in dirs:
+            if os.path.isdir(inc_dir):
+                headers += sorted(os.path.join(inc_dir, f) for f in os.listdir(inc_dir) if f.endswith(HEADER_EXT))
+        self.base_key = digest(version, *self.cflags, *(open(h, "rb").read() for h in headers))
+
+    def compile(self, src, text=None, extra=(), obj=None):
+        """Compiles src (or `text` in its place) into `obj`, or into the object cache if no
+        `obj` is given. Returns (object, error)."""
+        if text is None:
+            with open(src, "rb") as f:
+                text = f.read().decode("utf-8", errors="replace")
+        out = obj
+        if obj is None:
+            key = digest(self.base_key, os.path.relpath(src, self.root), text, *extra)
+            obj = os.path.join(self.objdir, f"{os.path.splitext(os.path.basename(src))[0]}-{key}.o")
+            if os.path.exists(obj):
+                return obj, None
+            out = obj[:-2] + ".tmp.o"  # Renamed when complete: the cache never holds half an object
+        tmp_src = out[:-2] + ".c"
+        with open(tmp_src, "w", encoding="utf-8") as f:
+            # Diagnostics, __FILE__ and "" includes as if it were the original file
+            f.write(f'#line 1 "{src}"\n{text}')
+        cmd = [self.cc, *self.cflags, *extra, "-iquote", os.path.dirname(src), "-c", tmp_src, "-o", out]
+        result = subprocess.run(cmd, capture_output=True, text=True)
+        os.remove(tmp_src)
+        if result.returncode != 0:
+            return None, result.stderr
+        if out != obj:
+            os.replace(out, obj)
+        return obj, None
+
+    def link(self, objects, exe, extra=()):
+        result = subprocess.run([self.cc, *objects, "-o", exe, *self.ldflags, *extra], capture_output=True, text=True)
+        return None if result.returncode == 0 else result.stderr
+
+
+def run_suite(exe, tests=None, timeout=None, env=None, cwd=None):
+    """Runs the binary (only `tests`, if given). Returns (returncode or 'timeout', stdout)."""
+    run_env = dict(os.environ, **(env or {}))
+    run_env.pop("BMT_LOW_NOISE", None)  # Pinning every worker to the same CPU would serialize them
+    if tests is not None:
+        run_env["BMT_TEST_FILTER"] = ":".join(tests)
+    try:
+        result = subprocess.run([exe], capture_output=True, text=True, env=run_env, timeout=timeout, cwd=cwd)
+    except subprocess.TimeoutExpired:
+        return "timeout", ""
+    return result.returncode, result.stdout
+
+
+def collect_coverage(builder, objects, targets, tests, cache, jobs, env):
+    """Lines of each target executed by each test, and lines that have code at all:
+    {"tests": {test: {file: [lines]}}, "code": {file: [lines]}}."""
+    key = digest(builder.base_key, json.dumps(env, sort_keys=True), *(open(o, "rb").read() for o in sorted(objects.values())),
+                 *(os.path.relpath(t, REPO) for t in sorted(targets)), *tests)
+    cache_file = os.path.join(cache, f"coverage-{key}.json")
+    if os.path.exists(cache_file):
+        with open(cache_file, encoding="utf-8") as f:
+            return json.load(f)
+    covdir = os.path.join(cache, "coverage")
+    shutil.rmtree(covdir, ignore_errors=True)
+    os.makedirs(covdir)
+    cov_objects = dict(objects)
+    for src in targets:
+        obj = os.path.join(covdir, os.path.splitext(os.path.basename(src))[0] + ".o")
+        # -O0: at -O2 the line table of merged or moved code under-reports the covered lines
+        obj, error = builder.compile(src, extra=["-O0", "--coverage"], obj=obj)
+        if error:
+            sys.exit(f"ERROR: coverage build of {src}:\n{error}")
+        cov_objects[src] = obj
+    exe = os.path.join(covdir, "bmt_cov.elf")
+    error = builder.link(list(cov_objects.values()), exe, ["--coverage"])
+    if error:
+        sys.exit(f"ERROR: coverage link:\n{error}")
+    strip = len(os.path.abspath(covdir).strip(os.sep).split(os.sep))
+
+    def one(index_test):
+        index, test = index_test
+        rundir = os.path.join(covdir, f"run{index}")
+        os.makedirs(rundir)
+        run_suite(exe, [test], timeout=600, env=dict(env, GCOV_PREFIX=rundir, GCOV_PREFIX_STRIP=str(strip)))
+        lines, code = {}, {}
+        for src in targets:
+            base = os.path.splitext(os.path.basename(src))[0]
+            if not os.path.exists(os.path.join(rundir, base + ".gcda")):
+                continue
+            shutil.copy(os.path.join(covdir, base + ".gcno"), rundir)
+            out = subprocess.run(["gcov", "--json-format", "--stdout", base + ".gcda"],
+                                 capture_output=True, text=True, cwd=rundir).stdout
+            for entry in json.loads(out or "{}").get("files", []):
+                if os.path.abspath(entry["file"]) == src:
+                    rel = os.path.relpath(src, REPO)
+                    lines[rel] = sorted(l["line_number"] for l in entry["lines"] if l["count"] > 0)
+                    code[rel] = sorted(l["line_number"] for l in entry["lines"])
+        return test, lines, code
+
+    coverage = {"tests": {}, "code": {}}
+    with ThreadPoolExecutor(max_workers=jobs) as pool:
+        for test, lines, code in pool.map(one, enumerate(tests)):
+            coverage["tests"][test] = lines
+            for rel, numbers in code.items():
+                coverage["code"][rel] = sorted(set(coverage["code"].get(rel, [])) | set(numbers))
+    with open(cache_file, "w", encoding="utf-8") as f:
+        json.dump(coverage, f)
+    return coverage
+
+
+def covering_tests(mutant, coverage):
+    """Tests that execute the mutated line; if no test has code on it (e.g. a line of a table
+    initializer), every test that executes any line of the file."""
+    per_test = coverage["tests"]
+    if mutant["line"] in coverage["code"].get(mutant["file"], []):
+        return [t for t, files in per_test.items() if mutant["line"] in files.get(mutant["file"], [])]
+    return [t for t, files in per_test.items() if files.get(mutant["file"])]
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Mutation testing of selected sources with the Linux host port.")
+    ap.add_argument("files", nargs="+", help="Sources to mutate (e.g. examples/mathoperations.c)")
+    ap.add_argument("--profile", default="linux_host_examples",
+                    help="Profile of the matrix file (default: linux_host_examples)")
+    ap.add_argument("--matrix", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "flag_matrix.json"))
+    ap.add_argument("--variant", help="Variant of the profile to build with (default: its first one)")
+    ap.add_argument("--operators", default=",".join(OPERATORS), help=f"Comma-separated subset of {', '.join(OPERATORS)}")
+    ap.add_argument("--jobs", type=int, default=os.cpu_count() or 1, help="Mutants built and run in parallel")
+    ap.add_argument("--timeout_factor", type=float, default=10.0,
+                    help="A mutant times out after this many times the baseline time of its tests (min 2 s)")
+    ap.add_argument("--seed", default="1",
+                    help="BMT_PROP_SEED of every run, so PROPERTY tests draw the same cases each time (default: 1)")
+    ap.add_argument("--cache", default=os.path.join(REPO, ".bmt_mutate_cache"), help="Cache directory")
+    ap.add_argument("--min_score", type=float, help="Exit with 1 if the mutation score (%%) is below this")
+    ap.add_argument("--json", help="Write every mutant and its verdict to this JSON file")
+    args = ap.parse_args()
+    env = {"BMT_PROP_SEED": args.seed}
+
+    with open(args.matrix, encoding="utf-8") as f:
+        matrix = json.load(f)
+    if args.profile not in matrix:
+        sys.exit(f"ERROR: profile '{args.profile}' not in {args.matrix} (available: {', '.join(matrix)})")
+    profile = matrix[args.profile]
+    if "load" in profile:
+        sys.exit(f"ERROR: profile '{args.profile}' runs on a board; mutation testing needs a host profile")
+    variant = args.variant or next(iter(profile["variants"]))
+    if variant not in profile["variants"]:
+        sys.exit(f"ERROR: unknown variant {variant} (available: {', '.join(profile['variants'])})")
+    operators = set(args.operators.split(","))
+    if operators - set(OPERATORS):
+        sys.exit(f"ERROR: unknown operators {', '.join(sorted(operators - set(OPERATORS)))}")
+    sources = source_files(profile)
+    targets = [os.path.abspath(f) for f in args.files]
+    missing = [f for f in targets if f not in sources]
+    if missing:
+        sys.exit(f"ERROR: not in the sources of profile '{args.profile}': {', '.join(missing)}")
+
+    started = time.time()
+    builder = Builder(profile, variant, args.cache, sources=sources)
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        built = dict(zip(sources, pool.map(builder.compile, sources)))
+    errors = [f"{src}:\n{err}" for src, (obj, err) in built.items() if err]
+    if errors:
+        sys.exit("ERROR: the unmutated sources do not build:\n" + "\n".join(errors))
+    objects = {src: obj for src, (obj, _) in built.items()}
+    workdir = os.path.join(args.cache, "work")
+    shutil.rmtree(workdir, ignore_errors=True)
+    os.makedirs(workdir)
+    baseline_exe = os.path.join(workdir, "baseline.elf")
+    error = builder.link(list(objects.values()), baseline_exe)
+    if error:
+        sys.exit(f"ERROR: baseline link:\n{error}")
+    code, output = run_suite(baseline_exe, timeout=profile.get("timeout", 300), env=env)
+    baseline = {f"{m.group(2)}.{m.group(3)}": (m.group(1) == "OK", int(m.group(4)))
+                for m in map(RE_RESULT.match, output.splitlines()) if m}
+    failing = sorted(t for t, (ok, _) in baseline.items() if not ok)
+    if failing:
+        print(f"WARNING: tests failing without mutations are not used: {', '.join(failing)}")
+    tests = sorted(t for t, (ok, _) in baseline.items() if ok)
+    if not tests:
+        sys.exit(f"ERROR: the unmutated suite has no passing test (exit code {code})")
+
+    coverage = collect_coverage(builder, objects, targets, tests, args.cache, args.jobs, env)
+    mutants = []
+    for src in targets:
+        with open(src, encoding="utf-8", errors="replace") as f:
+            mutants += generate_mutants(src, f.read(), operators)
+    link_key = digest(*(open(o, "rb").read() for s, o in sorted(objects.items()) if s not in targets))
+    resultdir = os.path.join(args.cache, "results")
+    os.makedirs(resultdir, exist_ok=True)
+    print(f"Profile {args.profile} ({variant}): {len(mutants)} mutants of {len(targets)} file(s), "
+          f"{len(tests)} tests, {args.jobs} workers")
+
+    def evaluate(index_mutant):
+        index, mutant = index_mutant
+        covering = covering_tests(mutant, coverage)
+        if not covering:
+            return {"status": "no_coverage", "tests": []}
+        key = digest(link_key, builder.base_key, args.seed, mutant["file"], mutant["source"], *covering)
+        cached = os.path.join(resultdir, key + ".json")
+        if os.path.exists(cached):
+            with open(cached, encoding="utf-8") as f:
+                return dict(json.load(f), cached=True)
+        src = os.path.join(REPO, mutant["file"])
+        obj = os.path.join(workdir, f"m{index}.o")
+        obj, error = builder.compile(src, text=mutant["source"], obj=obj)
+        if error:
+            verdict = {"status": "stillborn", "tests": covering}
+        else:
+            exe = os.path.join(workdir, f"m{index}.elf")
+            error = builder.link([obj if s == src else o for s, o in objects.items()], exe)
+            if error:
+                verdict = {"status": "stillborn", "tests": covering}
+            else:
+                budget_ms = sum(baseline[t][1] for t in covering)
+                timeout = max(2.0, args.timeout_factor * budget_ms / 1000.0)
+                rundir = os.path.join(workdir, f"m{index}")
+                os.makedirs(rundir, exist_ok=True)
+                code, _ = run_suite(exe, covering, timeout=timeout, env=env, cwd=rundir)
+                verdict = {"status": "timeout" if code == "timeout" else ("survived" if code == 0 else "killed"),
+                           "tests": covering}
+                shutil.rmtree(rundir, ignore_errors=True)
+                os.remove(exe)
+            os.remove(obj)
+        with open(cached, "w", encoding="utf-8") as f:
+            json.dump(verdict, f)
+        return dict(verdict, cached=False)
+
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        verdicts = list(pool.map(evaluate, enumerate(mutants)))
+    elapsed = time.time() - started
+    for mutant, verdict in zip(mutants, verdicts):
+        mutant.update(verdict)
+
+    counts = {s: sum(m["status"] == s for m in mutants) for s in ("killed", "timeout", "survived", "no_coverage", "stillborn")}
+    valid = len(mutants) - counts["stillborn"]
+    score = 100.0 * (counts["killed"] + counts["timeout"]) / valid if valid else 0.0
+    fresh = sum(not m.get("cached") and m["status"] != "no_coverage" for m in mutants)
+    print("\n--- Mutation score ---")
+    for src in targets:
+        rel = os.path.relpath(src, REPO)
+        ms = [m for m in mutants if m["file"] == rel]
+        dead = sum(m["status"] in ("killed", "timeout") for m in ms)
+        live = sum(m["status"] != "stillborn" for m in ms)
+        print(f"  {rel}: {dead}/{live} killed ({100.0 * dead / live if live else 0.0:.1f} %)")
+    print(f"  total: {score:.1f} % ({counts['killed']} killed, {counts['timeout']} timed out, "
+          f"{counts['survived']} survived, {counts['no_coverage']} not covered, {counts['stillborn']} did not build)")
+    print(f"  {fresh} mutants built and run in {elapsed:.1f} s ({60.0 * fresh / elapsed:.0f} per minute), "
+          f"{len(mutants) - fresh - counts['no_coverage']} cached")
+
+    survivors = [m for m in mutants if m["status"] in ("survived", "no_coverage")]
+    if survivors:
+        print("\n--- Surviving mutants ---")
+        for m in survivors:
+            more = f", +{len(m['tests']) - 4} more" if len(m["tests"]) > 4 else ""
+            how = "no test runs this line" if m["status"] == "no_coverage" else f"tests: {', '.join(m['tests'][:4])}{more}"
+            print(f"  {m['file']}:{m['line']}:{m['col']} [{m['operator']}] '{m['original']}' -> '{m['replacement']}' ({how})")
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump({"profile": args.profile, "variant": variant, "score": score, "counts": counts,
+                       "mutants": [{k: v for k, v in m.items() if k != "source"} for m in mutants]}, f, indent=2)
+        print(f"\nMutation JSON report generated at {args.json}")
+    shutil.rmtree(workdir, ignore_errors=True)
+    return 1 if args.min_score is not None and score < args.min_score else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,334 @@
+#  SPDX-License-Identifier: MIT
+# Copyright (c) 2025 Alejandro Avila Marcos
+
+# Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+#  BMT se distribuye bajo los términos de la Licencia MIT.
+#  Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+#  o en <https://opensource.org/licenses/MIT>.
+
+"""Self-benchmark of the framework: what BMT itself costs per assertion, per test and per failure,
+and how the runner and parse_bmt_output.py scale to suites of 1k-100k tests.
+
+Synthetic suites of each --sizes tests are generated (TEST()s spread over files of
+--tests_per_file, with --assertions passing checks each and a failing EXPECT every --fail_every
+tests), linked with the linux_host_selfbench profile of flag_matrix.json
+(examples/selfbench/selfbench_main.c, which times the registration and RUN_ALL_TESTS(), and the
+SelfBench micro benchmarks of examples/benchmarks/selfbench_tests.c) and run --runs times:
+
+- with BMT_TEST_FILTER=Synth*, for the time per test of the registration (the TEST()
+  constructors) and of the run (filter, dispatch, output and failure reports);
+- with a filter that matches no test, for the time per test of the filter alone;
+- its output through parse_bmt_output.py --input --junit_xml, for the host side (minus the
+  start-up of the parser);
+- with BMT_TEST_FILTER=SelfBench.*, for the cost of each passing and failing assertion.
+
+Per-test times keep the fastest run, the micro benchmarks the median of their medians.
+
+Each result is appended to --history (JSON lines with the commit, the compiler and the CPU) and
+compared with the median of the last --window results of the same machine and configuration: a
+metric more than --tolerance percent slower fails the check (exit 1), so a framework change
+cannot make every suite slower unnoticed. The time per test at the largest size is also compared
+with the smallest one: more than --max_scaling times means work that grows faster than the
+number of tests (e.g. a search of the registry for every test), and fails too.
+"""
+
+import os
+import re
+import sys
+import json
+import time
+import shlex
+import argparse
+import platform
+import statistics
+import subprocess
+from datetime import datetime, timezone
+from concurrent.futures import ThreadPoolExecutor
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from parse_bmt_output import parse_bench_fields  # noqa: E402
+from bmt_matrix import REPO, RE_BENCH, expand, source_files, print_table  # noqa: E402
+from bmt_mutate import Builder, digest  # noqa: E402
+
+RE_SELFBENCH = re.compile(r"^\[ SELFBENCH\] register_ns=(\d+) run_ns=(\d+)")
+RE_RUNNING = re.compile(r"^\[==========\] Running (\d+) tests\.")
+PARSER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "parse_bmt_output.py")
+# Matches no generated name (they end in a digit), but the glob still walks every one of them
+NO_MATCH_FILTER = "Synth*.Case*x"
+# Tests per generated suite name
+TESTS_PER_SUITE = 100
+# Passing checks of the generated tests, used in turn; v is i + 1 for test i
+CHECKS = ["EXPECT_EQ(v, {i}L + 1)", "ASSERT_GT(v, 0)", "EXPECT_NE(v, -1)", "EXPECT_TRUE((v & 1) == {odd})"]
+
+
+def generate_file(first, count, size, assertions, fail_every):
+    lines = [f"// Generated by pyton_parser/bmt_selfbench.py: tests {first} to {first + count - 1} "
+             f"of a synthetic suite of {size}.",
+             '#include "baremetal_test.h"', "",
+             "static volatile long s_base = 1;  // Not a constant: the checks run at run time", ""]
+    for i in range(first, first + count):
+        lines.append(f"TEST(Synth{i // TESTS_PER_SUITE:05d}, Case{i % TESTS_PER_SUITE:03d}) {{")
+        lines.append(f"    long v = s_base + {i}L;")
+        for k in range(assertions):
+            lines.append("    " + CHECKS[k % len(CHECKS)].format(i=i, odd=(i + 1) & 1) + ";")
+        if fail_every and i % fail_every == fail_every - 1:
+            lines.append(f"    EXPECT_EQ(v, {i}L);")
+        lines.append("}")
+        lines.append("")
+    return "\n".join(lines)
+
+
+def generate_suite(cache, size, args):
+    """Writes the generated sources of a suite of `size` tests. Returns their paths."""
+    gen_dir = os.path.join(cache, "gen", str(size))
+    os.makedirs(gen_dir, exist_ok=True)
+    paths = []
+    for n, first in enumerate(range(0, size, args.tests_per_file)):
+        path = os.path.join(gen_dir, f"synth_{n:04d}.c")
+        text = generate_file(first, min(args.tests_per_file, size - first), size, args.assertions, args.fail_every)
+        if not os.path.exists(path) or open(path, encoding="utf-8").read() != text:
+            with open(path, "w", encoding="utf-8") as f:
+                f.write(text)
+        paths.append(path)
+    for name in os.listdir(gen_dir):  # Files of a previous, larger --tests_per_file split
+        if os.path.join(gen_dir, name) not in paths:
+            os.remove(os.path.join(gen_dir, name))
+    return paths
+
+
+def build(profile, variant, cache, sources, jobs):
+    """Builds the sources with the profile. Returns the executable."""
+    builder = Builder(profile, variant, cache, sources=sources)
+    with ThreadPoolExecutor(max_workers=jobs) as pool:
+        built = list(pool.map(builder.compile, sources))
+    errors = [err for _, err in built if err]
+    if errors:
+        sys.exit(f"ERROR: build failed:\n{errors[0]}")
+    objects = [obj for obj, _ in built]
+    exe = os.path.join(cache, "exe", digest(*objects, *builder.ldflags) + ".elf")
+    if not os.path.exists(exe):
+        os.makedirs(os.path.dirname(exe), exist_ok=True)
+        tmp = exe[:-4] + ".tmp.elf"  # Renamed when complete: the cache never holds half a binary
+        error = builder.link(objects, tmp)
+        if error:
+            sys.exit(f"ERROR: link failed:\n{error}")
+        os.replace(tmp, exe)
+    return exe
+
+
+def run(profile, exe, test_filter, out_path):
+    """Runs the binary with its output to `out_path`. Returns (tests run, register_ns, run_ns)."""
+    cmd = [part.replace("{exe}", exe) for part in shlex.split(expand(profile.get("run", "{exe}")))]
+    env = dict(os.environ, **{k: expand(v) for k, v in profile.get("env", {}).items()})
+    env["BMT_TEST_FILTER"] = test_filter
+    env.pop("BMT_TRANSPORT", None)
+    env.pop("BMT_COMPRESS", None)
+    with open(out_path, "w", encoding="utf-8") as out:
+        try:
+            result = subprocess.run(cmd, stdout=out, stderr=subprocess.DEVNULL, env=env, timeout=profile.get("timeout", 300))
+        except subprocess.TimeoutExpired:
+            sys.exit(f"ERROR: {exe} timed out (BMT_TEST_FILTER={test_filter})")
+    tests = times = None
+    with open(out_path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            m = RE_RUNNING.match(line)
+            if m:
+                tests = int(m.group(1))
+            m = RE_SELFBENCH.match(line)
+            if m:
+                times = (int(m.group(1)), int(m.group(2)))
+    if result.returncode not in (0, 1) or times is None:
+        sys.exit(f"ERROR: {exe} exited with {result.returncode} without its [ SELFBENCH] line "
+                 f"(BMT_TEST_FILTER={test_filter}, output in {out_path})")
+    return tests, times[0], times[1]
+
+
+def time_parser(out_path, cache):
+    """Seconds parse_bmt_output.py takes to read the output and write the JUnit XML."""
+    start = time.perf_counter()
+    subprocess.run([sys.executable, PARSER, "--input", out_path, "--junit_xml", os.path.join(cache, "junit.xml")],
+                   stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    return time.perf_counter() - start
+
+
+def micro_benchmarks(profile, exe, cache, runs):
+    """Median ns of each selfbench/ benchmark over `runs` runs."""
+    values = {}
+    out_path = os.path.join(cache, "micro.txt")
+    for _ in range(runs):
+        run(profile, exe, "SelfBench.*", out_path)
+        with open(out_path, encoding="utf-8", errors="replace") as f:
+            for line in f:
+                m = RE_BENCH.match(line.rstrip("\r\n"))
+                if m and m.group(1).startswith("selfbench/"):
+                    values.setdefault(m.group(1), []).append(parse_bench_fields(m.group(2))["ns_median"])
+    return {name: statistics.median(v) for name, v in values.items()}, out_path
+
+
+def measure_size(profile, exe, cache, size, runs, parser_startup):
+    """Per-test costs of the suite of `size` tests, in ns. The fastest of `runs` runs: noise
+    (other processes, page cache, frequency changes) only adds time."""
+    register, full, filtered, parse = [], [], [], []
+    out_path = os.path.join(cache, f"output_{size}.txt")
+    for _ in range(runs):
+        tests, _, run_ns = run(profile, exe, NO_MATCH_FILTER, out_path)
+        if tests != 0:
+            sys.exit(f"ERROR: the filter {NO_MATCH_FILTER} selected {tests} tests")
+        filtered.append(run_ns)
+        tests, register_ns, run_ns = run(profile, exe, "Synth*", out_path)
+        if tests != size:
+            sys.exit(f"ERROR: {tests} of {size} tests registered (is BMT_MAX_TEST_CASES large enough?)")
+        register.append(register_ns)
+        full.append(run_ns)
+        parse.append(time_parser(out_path, cache))
+    return {"register_ns_per_test": min(register) / size,
+            "filter_ns_per_test": min(filtered) / size,
+            "run_ns_per_test": min(full) / size,
+            "parse_ns_per_test": max(min(parse) - parser_startup, 0.0) * 1e9 / size,
+            "output_bytes_per_test": os.path.getsize(out_path) / size}
+
+
+def machine_info(cc):
+    cpu = platform.processor() or platform.machine()
+    try:
+        with open("/proc/cpuinfo", encoding="utf-8") as f:
+            cpu = next((line.split(":", 1)[1].strip() for line in f if line.startswith("model name")), cpu)
+    except OSError:
+        pass
+    try:
+        compiler = subprocess.run([cc, "--version"], capture_output=True, text=True).stdout.splitlines()[0]
+    except (FileNotFoundError, IndexError):
+        compiler = cc
+    return {"cpu": cpu, "cores": os.cpu_count(), "cc": compiler}
+
+
+def git_commit():
+    head = subprocess.run(["git", "rev-parse", "HEAD"], cwd=REPO, capture_output=True, text=True).stdout.strip()
+    dirty = subprocess.run(["git", "status", "--porcelain", "--untracked-files=no"], cwd=REPO,
+                           capture_output=True, text=True).stdout.strip() != ""
+    return head or None, dirty
+
+
+def flatten(record):
+    """{metric name: value} of a history record: 'selfbench/...' and '<size>/<metric>'."""
+    metrics = dict(record["micro"])
+    for size, values in record["sizes"].items():
+        metrics.update({f"{size}/{name}": value for name, value in values.items() if name != "output_bytes_per_test"})
+    return metrics
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Measure the overhead of the framework itself and check it against its history.")
+    ap.add_argument("--sizes", default="1000,10000,100000", help="Tests of each synthetic suite (default: 1000,10000,100000)")
+    ap.add_argument("--assertions", type=int, default=4, help="Passing checks per generated test (default: 4)")
+    ap.add_argument("--fail_every", type=int, default=100, help="One failing EXPECT every N tests, 0 for none (default: 100)")
+    ap.add_argument("--tests_per_file", type=int, default=1000, help="Generated tests per source file (default: 1000)")
+    ap.add_argument("--runs", type=int, default=5, help="Runs of each measurement (default: 5)")
+    ap.add_argument("--profile", default="linux_host_selfbench",
+                    help="Host profile of the matrix file (default: linux_host_selfbench)")
+    ap.add_argument("--matrix", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "flag_matrix.json"))
+    ap.add_argument("--variant", help="Variant of the profile to build with (default: its first one)")
+    ap.add_argument("--jobs", type=int, default=os.cpu_count() or 1, help="Parallel compilations (default: all cores)")
+    ap.add_argument("--cache", default=os.path.join(REPO, ".bmt_selfbench_cache"), help="Cache directory")
+    ap.add_argument("--history", help="JSON lines file of past results (default: history.jsonl in the cache)")
+    ap.add_argument("--window", type=int, default=5, help="Past results of this machine the check compares with (default: 5)")
+    ap.add_argument("--tolerance", type=float, default=15.0, help="Percent slower than the history still accepted (default: 15)")
+    ap.add_argument("--max_scaling", type=float, default=3.0,
+                    help="Largest accepted ratio of the time per test at the largest size to the smallest (default: 3)")
+    ap.add_argument("--no_record", action="store_true", help="Check against the history without appending this result")
+    ap.add_argument("--json", help="Write this result to a JSON file")
+    args = ap.parse_args()
+
+    try:
+        sizes = sorted({int(s) for s in args.sizes.split(",")})
+    except ValueError:
+        ap.error("--sizes must be a comma-separated list of numbers of tests")
+    if not sizes or sizes[0] < 1 or args.runs < 1 or args.tests_per_file < 1:
+        ap.error("--sizes, --runs and --tests_per_file must be positive")
+    with open(args.matrix, encoding="utf-8") as f:
+        matrix = json.load(f)
+    if args.profile not in matrix:
+        sys.exit(f"ERROR: profile '{args.profile}' not in {args.matrix} (available: {', '.join(matrix)})")
+    profile = matrix[args.profile]
+    if "load" in profile:
+        sys.exit(f"ERROR: profile '{args.profile}' runs on a board; the self-benchmark needs a host profile")
+    variant = args.variant or next(iter(profile["variants"]))
+    if variant not in profile["variants"]:
+        sys.exit(f"ERROR: unknown variant {variant} (available: {', '.join(profile['variants'])})")
+    cache = os.path.abspath(args.cache)
+    os.makedirs(cache, exist_ok=True)
+    history_path = args.history or os.path.join(cache, "history.jsonl")
+
+    base_sources = source_files(profile)
+    config = {"profile": args.profile, "variant": variant, "sizes": sizes, "assertions": args.assertions,
+              "fail_every": args.fail_every}
+    print(f"Profile {args.profile} ({variant}): suites of {', '.join(map(str, sizes))} tests, "
+          f"{args.assertions} checks per test, a failure every {args.fail_every or 'no'} tests, {args.runs} runs")
+
+    micro = parser_startup = None
+    results = {}
+    for size in sizes:
+        # The registry is static: room for the synthetic tests and the SelfBench ones
+        sized = dict(profile, cflags=f"{profile.get('cflags', '')} -DBMT_MAX_TEST_CASES={size + 64}")
+        t0 = time.perf_counter()
+        exe = build(sized, variant, cache, base_sources + generate_suite(cache, size, args), args.jobs)
+        print(f"  {size} tests: built in {time.perf_counter() - t0:.1f} s", flush=True)
+        if micro is None:
+            micro, micro_out = micro_benchmarks(profile, exe, cache, args.runs)
+            parser_startup = min(time_parser(micro_out, cache) for _ in range(args.runs))
+        results[str(size)] = measure_size(profile, exe, cache, size, args.runs, parser_startup)
+
+    commit, dirty = git_commit()
+    record = {"date": datetime.now(timezone.utc).isoformat(timespec="seconds"), "commit": commit, "dirty": dirty,
+              "machine": machine_info(expand(profile["cc"])), "config": config, "micro": micro, "sizes": results}
+
+    print_table("Assertions (ns)", ["benchmark", "ns"], [[name, f"{value:.3f}"] for name, value in sorted(micro.items())])
+    metrics = ["register_ns_per_test", "filter_ns_per_test", "run_ns_per_test", "parse_ns_per_test", "output_bytes_per_test"]
+    print_table("Per test", ["tests", "register ns", "filter ns", "run ns", "parse ns", "output B"],
+                [[size] + [f"{values[m]:.1f}" for m in metrics] for size, values in results.items()])
+
+    failed = False
+    if len(sizes) > 1:
+        rows = []
+        small, large = results[str(sizes[0])], results[str(sizes[-1])]
+        for m in metrics[:-1]:
+            ratio = large[m] / small[m] if small[m] > 0 else 0.0
+            status = "ok" if ratio <= args.max_scaling else "SUPERLINEAR"
+            failed |= status != "ok"
+            rows.append([m, f"{ratio:.2f}", status])
+        print_table(f"Scaling {sizes[0]} -> {sizes[-1]} tests (time per test, ratio)", ["metric", "ratio", ""], rows)
+
+    past = []
+    if os.path.exists(history_path):
+        with open(history_path, encoding="utf-8") as f:
+            past = [json.loads(line) for line in f if line.strip()]
+    past = [r for r in past if r.get("machine") == record["machine"] and r.get("config") == config][-args.window:]
+    if past:
+        current = flatten(record)
+        rows = []
+        for name, value in current.items():
+            previous = [flatten(r)[name] for r in past if name in flatten(r)]
+            if not previous:
+                continue
+            reference = statistics.median(previous)
+            change = 100.0 * (value / reference - 1.0) if reference > 0 else 0.0
+            status = "ok" if change <= args.tolerance else "REGRESSION"
+            failed |= status != "ok"
+            rows.append([name, f"{value:.3f}", f"{reference:.3f}", f"{change:+.1f} %", status])
+        print_table(f"Against the last {len(past)} results of this machine", ["metric", "now", "history", "change", ""], rows)
+    else:
+        print(f"\nNo results of this machine and configuration in {history_path} yet: nothing to compare with.")
+
+    if not args.no_record:
+        with open(history_path, "a", encoding="utf-8") as f:
+            f.write(json.dumps(record, sort_keys=True) + "\n")
+        print(f"\nResult appended to {history_path}" + (" (uncommitted changes)" if dirty else ""))
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump(record, f, indent=2)
+        print(f"Self-benchmark JSON report generated at {args.json}")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
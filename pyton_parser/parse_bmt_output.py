@@ -6,27 +6,336 @@
 #  Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
 #  o en <https://opensource.org/licenses/MIT>.
 
-import serial
 import re
+import sys
+import json
 import time
 import argparse
+import socket
+import struct
 
-def parse_gtest_output_main_logic(port, baudrate, output_junit_file=None):
-    print(f"Attempting to connect to {port} at {baudrate} baud...")
+try:
+    import serial
+    SerialTimeoutException = serial.SerialTimeoutException
+except ImportError:  # Only needed for --port; --input works without pyserial
+    serial = None
+    class SerialTimeoutException(Exception): pass
+
+class StreamSource:
+    """Adapts a file (or stdin) to the subset of the serial.Serial API used by the parser.
+
+    Used with --input to parse the output of the Linux host port (or a saved UART log).
+    readline() returns b'' only at end of file, so `at_eof` lets the main loop stop at once.
+    """
+    def __init__(self, path):
+        self.name = path
+        self.stream = sys.stdin.buffer if path == '-' else open(path, 'rb')
+        self.is_open = True
+        self.at_eof = False
+
+    def readline(self):
+        line = self.stream.readline()
+        if not line:
+            self.at_eof = True
+        return line
+
+    def read(self, size):
+        data = self.stream.read1(size) if hasattr(self.stream, 'read1') else self.stream.read(size)
+        if not data:
+            self.at_eof = True
+        return data
+
+    def close(self):
+        if self.stream is not sys.stdin.buffer:
+            self.stream.close()
+        self.is_open = False
+
+class SocketSource:
+    """Reads the output over the network (bmt_transport.h): --listen waits for the target to connect
+    (TCP) or for its datagrams (UDP), --connect connects to a target listening on TCP.
+
+    UDP datagrams start with a big-endian sequence number; gaps are counted in `lost_datagrams`.
+    """
+    UDP_HEADER = 2
+
+    def __init__(self, mode, address, timeout=3.0, accept_timeout=60.0):
+        host, _, port = address.rpartition(':')
+        self.name = f"{mode}:{address}"
+        self.is_open = True
+        self.at_eof = False
+        self.udp = mode == 'udp'
+        self.lost_datagrams = 0
+        self.next_seq = None
+        if mode == 'connect':
+            self.sock = socket.create_connection((host or '127.0.0.1', int(port)), timeout=accept_timeout)
+        else:
+            kind = socket.SOCK_DGRAM if self.udp else socket.SOCK_STREAM
+            family = socket.AF_INET6 if ':' in host else socket.AF_INET
+            server = socket.socket(family, kind)
+            server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+            server.bind((host or ('::' if family == socket.AF_INET6 else '0.0.0.0'), int(port)))
+            if self.udp:
+                self.sock = server
+            else:
+                server.listen(1)
+                server.settimeout(accept_timeout)
+                try:
+                    self.sock, peer = server.accept()
+                    print(f"Target connected from {peer[0]}:{peer[1]}")
+                finally:
+                    server.close()
+        self.sock.settimeout(timeout)
+
+    def read(self, size):
+        try:
+            if not self.udp:
+                data = self.sock.recv(size)
+                if not data:
+                    self.at_eof = True
+                return data
+            datagram = self.sock.recv(65535)
+        except socket.timeout:
+            return b''
+        if len(datagram) < self.UDP_HEADER:
+            return b''
+        seq = (datagram[0] << 8) | datagram[1]
+        if self.next_seq is not None and seq != self.next_seq:
+            self.lost_datagrams += (seq - self.next_seq) & 0xFFFF
+        self.next_seq = (seq + 1) & 0xFFFF
+        return datagram[self.UDP_HEADER:]
+
+    def close(self):
+        self.sock.close()
+        self.is_open = False
+
+COMPRESS_SYNC = 0x1E
+COMPRESS_FLAG_RESET = 0x80
+COMPRESS_HEADER = 5
+
+def lzss_decode(payload, window_bits, length_bits, history):
+    """Expands the LZSS payload of one bmt_compress.h frame. `history` (bytearray) holds the text
+    decoded so far since the last reset: matches may refer to it, and it is extended in place.
+    Returns the new text. The zero padding at the end is shorter than any token, so it is skipped."""
+    start = len(history)
+    total_bits = len(payload) * 8
+    stream = int.from_bytes(payload, 'big')
+    bit = 0
+    def take(count):
+        nonlocal bit
+        bit += count
+        return (stream >> (total_bits - bit)) & ((1 << count) - 1)
+    match_bits = 1 + window_bits + length_bits
+    while bit < total_bits:
+        if (stream >> (total_bits - bit - 1)) & 1:
+            if total_bits - bit < 9:
+                break
+            history.append(take(9) & 0xFF)
+        else:
+            if total_bits - bit < match_bits:
+                break
+            take(1)
+            distance = take(window_bits) + 1
+            length = take(length_bits) + 2
+            if distance > len(history):
+                raise ValueError(f"match distance {distance} before the start of the stream")
+            for _ in range(length):  # Byte by byte: the match may overlap the text it produces
+                history.append(history[-distance])
+    text = bytes(history[start:])
+    window = 1 << window_bits
+    if len(history) > 2 * window:
+        del history[:-window]
+    return text
+
+class DecompressingSource:
+    """Wraps a source (serial port or StreamSource) and expands the frames of bmt_compress.h, so the
+    rest of the parser reads text lines whether the target compresses its output or not.
+
+    Bytes outside frames are passed through. `link_bytes` counts what crossed the link and
+    `text_bytes` the text it carried, for the compression summary.
+    """
+    def __init__(self, inner):
+        self.inner = inner
+        self.name = getattr(inner, 'name', '')
+        self.raw = bytearray()
+        self.text = bytearray()
+        self.history = bytearray()
+        self.frames = 0
+        self.link_bytes = 0
+        self.text_bytes = 0
+        self.first_byte_time = None
+        self.last_byte_time = None
+
+    @property
+    def is_open(self):
+        return self.inner.is_open
+
+    @property
+    def at_eof(self):
+        return getattr(self.inner, 'at_eof', False) and not self.text and not self.raw
+
+    def _fill(self):
+        if hasattr(self.inner, 'in_waiting'):  # Serial port: read what has arrived, or wait for one byte
+            data = self.inner.read(max(1, self.inner.in_waiting))
+        else:
+            data = self.inner.read(4096)
+        if data:
+            now = time.monotonic()
+            self.first_byte_time = self.first_byte_time or now
+            self.last_byte_time = now
+        self.link_bytes += len(data)
+        self.raw += data
+        return bool(data)
+
+    def _expand(self):
+        """Moves the complete text and frames of `raw` to `text`. Leaves an incomplete frame in `raw`."""
+        while self.raw:
+            sync = self.raw.find(bytes([COMPRESS_SYNC]))
+            if sync != 0:
+                plain = self.raw if sync < 0 else self.raw[:sync]
+                self.text += plain
+                self.text_bytes += len(plain)
+                del self.raw[:len(plain)]
+                continue
+            if len(self.raw) < COMPRESS_HEADER:
+                return
+            flags, length_bits, size = self.raw[1], self.raw[2], self.raw[3] | (self.raw[4] << 8)
+            if len(self.raw) < COMPRESS_HEADER + size:
+                return
+            if flags & COMPRESS_FLAG_RESET:
+                self.history.clear()
+            try:
+                text = lzss_decode(self.raw[COMPRESS_HEADER:COMPRESS_HEADER + size], flags & 0x0F, length_bits, self.history)
+            except ValueError as e:  # Joined mid-stream (no reset frame seen): skip until the next reset
+                print(f"WARNING: compressed frame dropped: {e}")
+                text = b''
+                self.history.clear()
+            del self.raw[:COMPRESS_HEADER + size]
+            self.frames += 1
+            self.text += text
+            self.text_bytes += len(text)
+
+    def readline(self):
+        while True:
+            newline = self.text.find(b'\n')
+            if newline >= 0:
+                line = bytes(self.text[:newline + 1])
+                del self.text[:newline + 1]
+                return line
+            if not self._fill():
+                # Timeout or end of input: hand over what there is (a truncated frame is dropped at EOF)
+                if getattr(self.inner, 'at_eof', False):
+                    self.raw.clear()
+                line = bytes(self.text)
+                self.text.clear()
+                return line
+            self._expand()
+
+    def close(self):
+        self.inner.close()
+
+def parse_bench_fields(text):
+    """Parses the `key=value` pairs of a [ BENCH    ] line. Numeric values become floats."""
+    fields = {}
+    for key, value in re.findall(r"(\w+)=(\S+)", text):
+        try:
+            fields[key] = float(value) if '.' in value else int(value)
+        except ValueError:
+            fields[key] = value
+    return fields
+
+def read_elf_build_id(path):
+    """GNU build ID (hex) of an ELF file, from its NT_GNU_BUILD_ID note, or None if it has none."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:4] != b'\x7fELF':
+        raise ValueError(f"{path} is not an ELF file")
+    is64 = data[4] == 2
+    endian = '<' if data[5] == 1 else '>'
+    if is64:
+        shoff, = struct.unpack_from(endian + 'Q', data, 0x28)
+        shentsize, shnum = struct.unpack_from(endian + 'HH', data, 0x3A)
+    else:
+        shoff, = struct.unpack_from(endian + 'I', data, 0x20)
+        shentsize, shnum = struct.unpack_from(endian + 'HH', data, 0x2E)
+    for i in range(shnum):
+        sh = shoff + i * shentsize
+        sh_type, = struct.unpack_from(endian + 'I', data, sh + 4)
+        if sh_type != 7:  # SHT_NOTE
+            continue
+        offset, size = struct.unpack_from(endian + ('QQ' if is64 else 'II'), data, sh + (0x18 if is64 else 0x10))
+        p = offset
+        while p + 12 <= offset + size:
+            namesz, descsz, note_type = struct.unpack_from(endian + 'III', data, p)
+            desc = p + 12 + ((namesz + 3) & ~3)
+            if note_type == 3 and data[p + 12:p + 12 + namesz] == b'GNU\0':  # NT_GNU_BUILD_ID
+                return data[desc:desc + descsz].hex()
+            p = desc + ((descsz + 3) & ~3)
+    return None
+
+def write_bench_json(filename, results):
     try:
-        ser = serial.Serial(port, baudrate, timeout=3) 
-        print(f"Connected to {port}. Waiting for test output...")
-    except serial.SerialException as e:
-        print(f"Error opening serial port {port}: {e}")
-        if output_junit_file: generate_empty_junit_xml(output_junit_file, f"Serial Port Error: {e}")
-        return -1
+        with open(filename, 'w', encoding='utf-8') as f:
+            json.dump({"run_meta": results["run_meta"], "host_env": results["host_env"], "memory_profile": results["memory_profile"],
+                       "benchmarks": results["benchmarks"], "comparisons": results["comparisons"],
+                       "irq_latency": results["irq_latency"], "histograms": results["histograms"],
+                       "stress": results["stress"], "linearizability": results["linearizability"],
+                       "properties": results["properties"], "fuzz": results["fuzz"],
+                       "virtual_time": results["virtual_time"], "stack": results["stack"],
+                       "memtest": results["memtest"], "compression": results["compression"],
+                       "transport": results["transport"]}, f, indent=2)
+        print(f"Benchmark JSON report generated at {filename} ({len(results['benchmarks'])} entries)")
+    except Exception as e:
+        print(f"Error generating benchmark JSON report: {e}")
+
+def parse_gtest_output_main_logic(port, baudrate, output_junit_file=None, input_file=None, output_bench_json=None, elf_file=None,
+                                  network=None):
+    if network:
+        mode, address = network
+        try:
+            if mode == 'connect':
+                print(f"Connecting to the target at {address}...")
+            else:
+                print(f"Listening on {'udp' if mode == 'udp' else 'tcp'} {address} for the target...")
+            ser = SocketSource(mode, address)
+            port = ser.name
+        except (OSError, ValueError) as e:
+            print(f"Error opening {mode} {address}: {e}")
+            if output_junit_file: generate_empty_junit_xml(output_junit_file, f"Network Error: {e}")
+            return -1
+    elif input_file:
+        try:
+            ser = StreamSource(input_file)
+            port = input_file
+            print(f"Reading test output from {'stdin' if input_file == '-' else input_file}...")
+        except OSError as e:
+            print(f"Error opening input {input_file}: {e}")
+            if output_junit_file: generate_empty_junit_xml(output_junit_file, f"Input Error: {e}")
+            return -1
+    else:
+        if serial is None:
+            print("Error: pyserial is not installed (pip install pyserial). Use --input to parse a file.")
+            return -1
+        print(f"Attempting to connect to {port} at {baudrate} baud...")
+        try:
+            ser = serial.Serial(port, baudrate, timeout=3) 
+            print(f"Connected to {port}. Waiting for test output...")
+        except serial.SerialException as e:
+            print(f"Error opening serial port {port}: {e}")
+            if output_junit_file: generate_empty_junit_xml(output_junit_file, f"Serial Port Error: {e}")
+            return -1
+
+    ser = DecompressingSource(ser)
 
     results = {
         "total_run": 0, "total_passed": 0, "total_failed": 0,
-        "suites": {}
+        "suites": {}, "benchmarks": [], "comparisons": [], "host_env": {},
+        "memory_profile": {}, "histograms": {}, "irq_latency": [],
+        "stress": [], "linearizability": [], "properties": [], "fuzz": [], "virtual_time": [],
+        "stack": [], "memtest": [], "run_meta": {}, "compression": {}, "transport": {}
     }
     current_suite_for_failure = None
     current_test_for_failure = None
+    pending_fuzz_inputs = []
     in_test_run_phase = False
     explicit_end_token = "[BMT_DONE_ALL_TESTS]"
     re_running_tests = re.compile(r"\[==========\] Running (\d+) tests\.")
@@ -34,8 +343,28 @@ def parse_gtest_output_main_logic(port, baudrate, output_junit_file=None):
     re_ok = re.compile(r"\[       OK \] (.*?)\.(.*?) \((\d+|\d+\.\d+) ms\)")
     re_failed_line = re.compile(r"\[  FAILED  \] (.*?)\.(.*?) \((\d+|\d+\.\d+) ms\)")
     re_failure_location = re.compile(r"(.+?):(\d+): Failure")
-    re_failure_assertion_type = re.compile(r"  (ASSERT_.+?|EXPECT_.+?|FAIL|ADD_FAILURE)\((.*?)\)")
+    re_failure_assertion_type = re.compile(r"  (ASSERT_.+?|EXPECT_.+?|FAIL|ADD_FAILURE|STACK OVERFLOW|MEMTEST)\((.*?)\)")
     re_failure_message = re.compile(r"    Message: (.*)")
+    re_bench = re.compile(r"\[ BENCH    \] (\S+)(.*)")
+    re_bench_ab = re.compile(r"\[ BENCH AB \] (\S+?):(\S+)(.*)")
+    re_host_env = re.compile(r"\[ HOST ENV \](.*)")
+    re_memprof = re.compile(r"\[ MEMPROF  \](.*)")
+    re_irqlat = re.compile(r"\[ IRQLAT   \] (\S+)(.*)")
+    re_hist = re.compile(r"\[ HIST     \] (\S+)(.*)")
+    re_hist_bin = re.compile(r"\[ HIST BIN \] (\S+)(.*)")
+    re_stress = re.compile(r"\[ STRESS   \] (\S+)(.*)")
+    re_lincheck = re.compile(r"\[ LINCHECK \] (\S+)(.*)")
+    re_property = re.compile(r"\[ PROPERTY \] (\S+)( failed| flaky)?(.*)")
+    re_fuzz = re.compile(r"\[ FUZZ     \] (\S+)(.*)")
+    re_vclock = re.compile(r"\[ VCLOCK   \] (.*?)\.(\S+)(.*)")
+    re_stack = re.compile(r"\[ STACK    \] (.*?)\.(\S+)(.*)")
+    re_memtest = re.compile(r"\[ MEMTEST  \](.*)")
+    re_run_meta = re.compile(r"\[ RUN META \] (\w+)=(.*)")
+    re_compress = re.compile(r"\[ COMPRESS \](.*)")
+    re_transport = re.compile(r"\[ TRANSPORT\](.*)")
+    tx_fill = {"bytes": 0, "first": None, "last": None}  # Filler of bmt_transport_bench(), not shown
+    re_fuzz_in = re.compile(r"\[ FUZZ IN  \] (\S+)(.*)")
+    re_prop_val = re.compile(r"\[ PROP VAL \] (\w+)=(\S+)(?: len=(\d+))?")
     max_idle_reads_after_start = 5
     idle_reads_count = 0
 
@@ -44,6 +373,9 @@ def parse_gtest_output_main_logic(port, baudrate, output_junit_file=None):
             line_content = None
             try:
                 line_bytes = ser.readline()
+                if not line_bytes and getattr(ser, 'at_eof', False):
+                    print("End of input reached.")
+                    break
                 if not line_bytes:
                     if not in_test_run_phase:
                         print("DEBUG: No data yet, waiting for tests to start...")
@@ -58,7 +390,7 @@ def parse_gtest_output_main_logic(port, baudrate, output_junit_file=None):
                         continue
                 line_content = line_bytes.decode('utf-8', errors='replace').strip()
                 idle_reads_count = 0
-            except serial.SerialTimeoutException:
+            except SerialTimeoutException:
                 print("DEBUG: SerialTimeoutException (should not happen with readline behavior).")
                 if not in_test_run_phase: continue
                 else:
@@ -72,10 +404,28 @@ def parse_gtest_output_main_logic(port, baudrate, output_junit_file=None):
             if not line_content:
                 if in_test_run_phase: print("DEBUG: Received an empty line after strip.")
                 continue
+            if line_content.startswith("[ TX FILL  ]"):
+                tx_fill["first"] = tx_fill["first"] or time.monotonic()
+                tx_fill["last"] = time.monotonic()
+                tx_fill["bytes"] += len(line_bytes)
+                continue
             print(f"DUT: {line_content}")
             if explicit_end_token in line_content:
                 print(f"Explicit end of tests token '{explicit_end_token}' received.")
                 break
+            match_run_meta = re_run_meta.match(line_content)
+            if match_run_meta:
+                key, value = match_run_meta.groups()
+                results["run_meta"][key] = int(value) if key.endswith(("_khz", "_bytes")) and value.isdigit() else value
+                continue
+            match_compress = re_compress.match(line_content)
+            if match_compress:
+                results["compression"].update(parse_bench_fields(match_compress.group(1)))
+                continue
+            match_transport = re_transport.match(line_content)
+            if match_transport:
+                results["transport"].update(parse_bench_fields(match_transport.group(1)))
+                continue
             match_running = re_running_tests.match(line_content)
             if match_running:
                 in_test_run_phase = True
@@ -83,6 +433,130 @@ def parse_gtest_output_main_logic(port, baudrate, output_junit_file=None):
                 current_test_for_failure = None
                 print("DEBUG: Detected test run start.")
                 continue
+            match_bench = re_bench.match(line_content)
+            if match_bench:
+                bench_entry = {"name": match_bench.group(1),
+                               "suite": current_suite_for_failure, "test": current_test_for_failure}
+                bench_entry.update(parse_bench_fields(match_bench.group(2)))
+                results["benchmarks"].append(bench_entry)
+                continue
+            match_bench_ab = re_bench_ab.match(line_content)
+            if match_bench_ab:
+                ab_entry = {"a": match_bench_ab.group(1), "b": match_bench_ab.group(2),
+                            "suite": current_suite_for_failure, "test": current_test_for_failure}
+                ab_entry.update(parse_bench_fields(match_bench_ab.group(3)))
+                results["comparisons"].append(ab_entry)
+                continue
+            match_memprof = re_memprof.match(line_content)
+            if match_memprof:
+                point = parse_bench_fields(match_memprof.group(1))
+                region = str(point.pop("region", "unknown"))
+                results["memory_profile"].setdefault(region, []).append(point)
+                continue
+            match_hist_bin = re_hist_bin.match(line_content)
+            if match_hist_bin:
+                hist = results["histograms"].setdefault(match_hist_bin.group(1), {"bins": []})
+                hist["bins"].append(parse_bench_fields(match_hist_bin.group(2)))
+                continue
+            match_hist = re_hist.match(line_content)
+            if match_hist:
+                hist = {"suite": current_suite_for_failure, "test": current_test_for_failure, "bins": []}
+                hist.update(parse_bench_fields(match_hist.group(2)))
+                results["histograms"][match_hist.group(1)] = hist
+                continue
+            match_stress = re_stress.match(line_content)
+            if match_stress:
+                name, _, core = match_stress.group(1).partition("/core")
+                fields = parse_bench_fields(match_stress.group(2))
+                if core:
+                    if results["stress"] and results["stress"][-1]["name"] == name:
+                        fields["core"] = int(core)
+                        results["stress"][-1]["per_core"].append(fields)
+                else:
+                    stress_entry = {"name": name, "suite": current_suite_for_failure,
+                                    "test": current_test_for_failure, "per_core": []}
+                    stress_entry.update(fields)
+                    results["stress"].append(stress_entry)
+                continue
+            match_lincheck = re_lincheck.match(line_content)
+            if match_lincheck:
+                name, _, role = match_lincheck.group(1).partition("/")
+                fields = parse_bench_fields(match_lincheck.group(2))
+                if role:
+                    if results["linearizability"] and results["linearizability"][-1]["name"] == name:
+                        fields["stuck"] = (role == "stuck")
+                        results["linearizability"][-1]["operations"].append(fields)
+                else:
+                    lin_entry = {"name": name, "suite": current_suite_for_failure,
+                                 "test": current_test_for_failure, "operations": []}
+                    lin_entry.update(fields)
+                    results["linearizability"].append(lin_entry)
+                continue
+            match_property = re_property.match(line_content)
+            if match_property:
+                name, status = match_property.group(1), (match_property.group(2) or " passed").strip()
+                if status == "flaky" and results["properties"] and results["properties"][-1]["name"] == name:
+                    results["properties"][-1]["flaky"] = True
+                else:
+                    prop_entry = {"name": name, "suite": current_suite_for_failure,
+                                  "test": current_test_for_failure, "status": status, "counterexample": {}}
+                    prop_entry.update(parse_bench_fields(match_property.group(3)))
+                    results["properties"].append(prop_entry)
+                continue
+            match_prop_val = re_prop_val.match(line_content)
+            if match_prop_val:
+                if results["properties"]:
+                    value = match_prop_val.group(2)
+                    if match_prop_val.group(3) is not None:
+                        value = {"hex": value, "len": int(match_prop_val.group(3))}
+                    else:
+                        value = int(value)
+                    results["properties"][-1]["counterexample"][match_prop_val.group(1)] = value
+                continue
+            match_vclock = re_vclock.match(line_content)
+            if match_vclock:
+                vclock_entry = {"suite": match_vclock.group(1), "test": match_vclock.group(2)}
+                vclock_entry.update(parse_bench_fields(match_vclock.group(3)))
+                results["virtual_time"].append(vclock_entry)
+                continue
+            match_stack = re_stack.match(line_content)
+            if match_stack:
+                stack_entry = {"suite": match_stack.group(1), "test": match_stack.group(2)}
+                stack_entry.update(parse_bench_fields(match_stack.group(3)))
+                results["stack"].append(stack_entry)
+                continue
+            match_memtest = re_memtest.match(line_content)
+            if match_memtest:
+                memtest_entry = {"suite": current_suite_for_failure, "test": current_test_for_failure}
+                memtest_entry.update(parse_bench_fields(match_memtest.group(1)))
+                results["memtest"].append(memtest_entry)
+                continue
+            match_fuzz_in = re_fuzz_in.match(line_content)
+            if match_fuzz_in:
+                # Failing inputs are printed before the summary line of their target
+                fuzz_input = parse_bench_fields(match_fuzz_in.group(2))
+                fuzz_input["data"] = re.search(r"data=(\S*)", match_fuzz_in.group(2)).group(1)  # hex, not a number
+                pending_fuzz_inputs.append(fuzz_input)
+                continue
+            match_fuzz = re_fuzz.match(line_content)
+            if match_fuzz:
+                fuzz_entry = {"name": match_fuzz.group(1), "suite": current_suite_for_failure,
+                              "test": current_test_for_failure, "failing_inputs": pending_fuzz_inputs}
+                fuzz_entry.update(parse_bench_fields(match_fuzz.group(2)))
+                results["fuzz"].append(fuzz_entry)
+                pending_fuzz_inputs = []
+                continue
+            match_irqlat = re_irqlat.match(line_content)
+            if match_irqlat:
+                irq_entry = {"name": match_irqlat.group(1),
+                             "suite": current_suite_for_failure, "test": current_test_for_failure}
+                irq_entry.update(parse_bench_fields(match_irqlat.group(2)))
+                results["irq_latency"].append(irq_entry)
+                continue
+            match_host_env = re_host_env.match(line_content)
+            if match_host_env:
+                results["host_env"] = parse_bench_fields(match_host_env.group(1))
+                continue
             match_run = re_run.match(line_content)
             if match_run:
                 current_suite_for_failure = match_run.group(1)
@@ -149,12 +623,77 @@ def parse_gtest_output_main_logic(port, baudrate, output_junit_file=None):
     finally:
         if 'ser' in locals() and ser.is_open:
             ser.close()
-            print(f"Serial port {port} closed.")
+            print(f"Serial port {port} closed." if not (input_file or network) else f"Input {port} closed.")
     print("\n--- Test Run Summary (Console) ---")
     if not results["suites"] and results["total_run"] == 0 :
         print("No test results captured or no tests were run.")
         if output_junit_file: generate_empty_junit_xml(output_junit_file, "No tests run or captured")
         return 0 
+    build_id_mismatch = False
+    if elf_file:
+        try:
+            elf_id = read_elf_build_id(elf_file)
+        except (OSError, ValueError) as e:
+            print(f"Error reading the build ID of {elf_file}: {e}")
+            elf_id = None
+        run_id = results["run_meta"].get("build_id")
+        results["run_meta"]["build_id_verified"] = bool(elf_id and run_id and str(run_id) == elf_id)
+        if not results["run_meta"]["build_id_verified"]:
+            build_id_mismatch = True
+            print(f"ERROR: build ID of the run ({run_id or 'not printed'}) does not match {elf_file} ({elf_id or 'none'})")
+    if results["run_meta"]:
+        print("\n--- Run metadata ---")
+        for key, value in results["run_meta"].items():
+            print(f"  {key}: {value}")
+    if ser.frames:
+        comp = results["compression"]
+        comp.update({"link_bytes": ser.link_bytes, "text_bytes": ser.text_bytes, "link_frames": ser.frames})
+        print("\n--- Output compression ---")
+        print(f"  {ser.text_bytes} text bytes in {ser.link_bytes} link bytes ({ser.frames} frames), "
+              f"ratio {ser.link_bytes / max(ser.text_bytes, 1):.3f}")
+        if 'ns_per_byte' in comp:
+            print(f"  compressor: {comp['ns_per_byte']} ns/byte on target "
+                  f"(window {comp.get('window', '?')}, matches up to {comp.get('max_match', '?')} bytes)")
+            if not (input_file or network) and comp.get('ratio') is not None:
+                # 8N1: 10 bits per byte. Compressing pays off while it saves more link time than it costs
+                link_ns = 1e10 / baudrate
+                saved_ns = (1.0 - comp['ratio']) * link_ns
+                verdict = "worth it" if comp['ns_per_byte'] < saved_ns else "NOT worth it"
+                print(f"  at {baudrate} baud: {link_ns:.0f} ns/byte on the link, saves {saved_ns:.0f} ns/byte "
+                      f"-> {verdict}")
+    transport = results["transport"]
+    if transport or network:
+        elapsed = (ser.last_byte_time - ser.first_byte_time) if ser.first_byte_time else 0.0
+        transport.update({"link": "serial" if not (input_file or network) else (network[0] if network else "file"),
+                          "link_bytes": ser.link_bytes, "receive_s": round(elapsed, 3)})
+        print("\n--- Transport ---")
+        if 'name' in transport:
+            line = f"  target: {transport['name']}, {transport.get('bytes', '?')} bytes in {transport.get('sends', '?')} sends, " \
+                   f"{transport.get('send_ms', '?')} ms sending"
+            if 'bytes_per_s' in transport:
+                line += f" ({transport['bytes_per_s'] / 1e6:.3f} MB/s)"
+            print(line)
+        if 'bench_bytes' in transport:
+            print(f"  target bench: {transport['bench_bytes']} bytes in {transport.get('bench_ms', '?')} ms "
+                  f"({transport.get('bench_bytes_per_s', 0) / 1e6:.3f} MB/s)")
+        if elapsed > 0:
+            print(f"  host: {ser.link_bytes} bytes received over {elapsed:.3f} s of run")
+        if tx_fill["bytes"]:
+            transport["host_bench_bytes"] = tx_fill["bytes"]
+            fill_s = tx_fill["last"] - tx_fill["first"]
+            line = f"  host bench: {tx_fill['bytes']} filler bytes received"
+            if fill_s > 0:
+                transport["host_bench_bytes_per_s"] = int(tx_fill["bytes"] / fill_s)
+                line += f" in {fill_s * 1000:.3f} ms ({tx_fill['bytes'] / fill_s / 1e6:.3f} MB/s)"
+            if transport.get('bench_bytes') and tx_fill["bytes"] < transport['bench_bytes']:
+                line += f", {transport['bench_bytes'] - tx_fill['bytes']} bytes missing"
+            print(line)
+        if not (input_file or network):
+            print(f"  serial link at {baudrate} baud: at most {baudrate / 10 / 1e6:.4f} MB/s (8N1)")
+        if network and network[0] == 'udp':
+            transport["lost_datagrams"] = ser.inner.lost_datagrams
+            if ser.inner.lost_datagrams:
+                print(f"  WARNING: {ser.inner.lost_datagrams} UDP datagram(s) lost: the output is incomplete")
     final_total_tests = results["total_run"]
     final_passed_tests = results["total_passed"]
     final_failed_tests = results["total_failed"]
@@ -169,6 +708,102 @@ def parse_gtest_output_main_logic(port, baudrate, output_junit_file=None):
                      print(f"       Assertion: {failure['assertion']}({failure['expression']})")
                 if failure['message']:
                      print(f"       Message: {failure['message']}")
+    for region, points in results["memory_profile"].items():
+        print(f"\n--- Memory profile: {region} ---")
+        print(f"  {'working set':>12} {'latency ns':>11} {'read MB/s':>10} {'write MB/s':>11} {'copy MB/s':>10}")
+        for pt in points:
+            print(f"  {pt.get('ws', 0):>12} {pt.get('latency_ns', 0):>11} {pt.get('read_mbps', 0):>10} "
+                  f"{pt.get('write_mbps', 0):>11} {pt.get('copy_mbps', 0):>10}")
+    if results["stress"]:
+        print("\n--- Stress tests ---")
+        for st in results["stress"]:
+            print(f"  {st['name']}: {st.get('cores', '?')} cores x {st.get('iters', '?')} iterations, "
+                  f"{st.get('iters_per_sec', '?')} iters/s, {st.get('failures', 0)} failure(s)")
+            for pc in st["per_core"]:
+                if pc.get('failures'):
+                    print(f"    core {pc['core']}: {pc['failures']} failure(s) after {pc.get('iters', '?')} iterations")
+    if results["linearizability"]:
+        print("\n--- Linearizability checks ---")
+        for lc in results["linearizability"]:
+            print(f"  {lc['name']} ({lc.get('spec', '?')}): {lc.get('result', '?')}, {lc.get('ops', '?')} ops, "
+                  f"{lc.get('objects', '?')} object(s), {lc.get('steps', '?')} steps")
+            for op in lc["operations"]:
+                if op.get('stuck'):
+                    print(f"    cannot linearize: core {op.get('core')} {op.get('op')}(arg={op.get('arg')}) "
+                          f"ok={op.get('ok')} ret={op.get('ret')} [{op.get('invoke_ns')}, {op.get('response_ns')}] ns")
+    if results["properties"]:
+        print("\n--- Properties ---")
+        for pr in results["properties"]:
+            if pr["status"] == "failed":
+                print(f"  {pr['name']}: FAILED at case {pr.get('case', '?')} (seed {pr.get('seed', '?')}), "
+                      f"{pr.get('shrinks', 0)} shrink step(s){', FLAKY' if pr.get('flaky') else ''}")
+                for var, value in pr["counterexample"].items():
+                    shown = f"{value['hex']} ({value['len']} bytes)" if isinstance(value, dict) else value
+                    print(f"    {var} = {shown}")
+            else:
+                print(f"  {pr['name']}: {pr.get('cases', '?')} cases passed, {pr.get('ns_per_case', '?')} ns/case "
+                      f"(seed {pr.get('seed', '?')})")
+    if results["fuzz"]:
+        print("\n--- Fuzz corpus replay ---")
+        for fz in results["fuzz"]:
+            print(f"  {fz['name']}: {fz.get('inputs', '?')} inputs ({fz.get('builtin', 0)} built-in, "
+                  f"{fz.get('files', 0)} files), {fz.get('failures', 0)} failure(s)")
+            for fi in fz["failing_inputs"]:
+                print(f"    failing {fi.get('source', '?')} input #{fi.get('index', '?')} "
+                      f"({fi.get('len', '?')} bytes): {fi.get('data', '')}")
+    if results["virtual_time"]:
+        print("\n--- Virtual time ---")
+        for vt in results["virtual_time"]:
+            print(f"  {vt['suite']}.{vt['test']}: {vt.get('virtual_ms', '?')} ms virtual in {vt.get('real_ms', '?')} ms real")
+    if results["stack"]:
+        print("\n--- Test stacks ---")
+        deepest = max(results["stack"], key=lambda st: st.get('peak', 0))
+        print(f"  {len(results['stack'])} tests on their own stack, deepest {deepest['suite']}.{deepest['test']}: "
+              f"{deepest.get('peak', '?')} of {deepest.get('size', '?')} bytes ({deepest.get('guard', '?')} guard)")
+        for st in results["stack"]:
+            if st.get('overflow'):
+                print(f"  {st['suite']}.{st['test']}: STACK OVERFLOW")
+            elif st.get('size') and st.get('peak', 0) * 4 > st['size'] * 3:
+                print(f"  WARNING: {st['suite']}.{st['test']} uses {st['peak']} of {st['size']} bytes (> 75 %)")
+    if results["memtest"]:
+        print("\n--- RAM tests ---")
+        for mt in results["memtest"]:
+            line = (f"  {mt.get('region', '?')} {mt.get('algo', '?')}: {mt.get('size', '?')} bytes, "
+                    f"{mt.get('mbps', '?')} MB/s, {mt.get('errors', 0)} error(s)")
+            if mt.get('errors'):
+                line += f", first at {mt.get('first_addr')} (expected {mt.get('expected')}, read {mt.get('actual')})"
+            print(line)
+    if results["histograms"]:
+        print("\n--- Histograms ---")
+        for name, h in results["histograms"].items():
+            unit = h.get('unit', '')
+            print(f"  {name}: n={h.get('count', 0)} min={h.get('min', '-')} p50={h.get('p50', '-')} "
+                  f"p99={h.get('p99', '-')} p99.9={h.get('p999', '-')} max={h.get('max', '-')} {unit}")
+        for irq in results["irq_latency"]:
+            if irq.get('missed'):
+                print(f"  WARNING: {irq['name']}: {irq['missed']} of {irq.get('iters', '?')} interrupts missed")
+    if results["benchmarks"]:
+        print("\n--- Benchmarks ---")
+        if results["host_env"] and not results["host_env"].get("trusted", 1):
+            print(f"  WARNING: measurement environment not fully controlled: {results['host_env']}")
+        for b in results["benchmarks"]:
+            line = f"  {b['name']}: {b.get('ns_median', b.get('ns_min', 0))} ns/iter (median), CV {b.get('cv_pct', '?')} %"
+            if 'mbps' in b:
+                line += f", {b['mbps']} MB/s"
+            if b.get('noisy'):
+                line += "  <-- NOISY, not trusted"
+            print(line)
+        for c in results["comparisons"]:
+            flag = "  <-- NOISY, not trusted" if c.get('noisy') else ""
+            print(f"  {c['b']} / {c['a']}: ratio {c.get('ratio', '?')} (CV {c.get('cv_pct', '?')} %){flag}")
+        noisy_count = sum(1 for b in results["benchmarks"] + results["comparisons"] if b.get('noisy'))
+        if noisy_count:
+            print(f"  {noisy_count} result(s) exceeded the noise threshold and should not be used for regression detection.")
+    if output_bench_json and (results["benchmarks"] or results["memory_profile"] or results["histograms"]
+                              or results["stress"] or results["linearizability"] or results["properties"] or results["fuzz"]
+                              or results["virtual_time"] or results["stack"] or results["memtest"]
+                              or results["compression"] or results["transport"]):
+        write_bench_json(output_bench_json, results)
     print("\n------------------------------------")
     print(f"Total Tests Run: {final_total_tests}")
     print(f"Passed: {final_passed_tests}")
@@ -198,7 +833,8 @@ def parse_gtest_output_main_logic(port, baudrate, output_junit_file=None):
                                                 output=failure_output.strip(),
                                                 failure_type=failure_type)
                     test_cases.append(tc)
-                ts = TestSuite(name=suite_name, test_cases=test_cases)
+                ts = TestSuite(name=suite_name, test_cases=test_cases,
+                               properties={k: str(v) for k, v in results["run_meta"].items()})
                 test_suites_list.append(ts)
             
             if test_suites_list:
@@ -215,6 +851,8 @@ def parse_gtest_output_main_logic(port, baudrate, output_junit_file=None):
             print(f"Error generating JUnit XML report: {e_junit}")
             if output_junit_file:
                 generate_empty_junit_xml(output_junit_file, f"JUnit Generation Error: {e_junit}")
+    if build_id_mismatch:
+        return -5
     return final_failed_tests
 
 def generate_empty_junit_xml(filename, message="No tests run or captured"):
@@ -233,11 +871,26 @@ def generate_empty_junit_xml(filename, message="No tests run or captured"):
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="Parse BMT gtest-like output from serial and optionally generate JUnit XML.")
-    parser.add_argument('--port', required=True, help="Serial port (e.g., COM3 or /dev/ttyUSB0)")
+    source_group = parser.add_mutually_exclusive_group(required=True)
+    source_group.add_argument('--port', help="Serial port (e.g., COM3 or /dev/ttyUSB0)")
+    source_group.add_argument('--input', help="Read the output from a file instead of a serial port ('-' for stdin, e.g. the Linux host port piped in)")
+    source_group.add_argument('--listen', metavar='[HOST:]PORT', help="Wait for the target to connect over TCP (BMT_TRANSPORT=tcp:HOST:PORT on the Linux host port), or for its datagrams with --udp")
+    source_group.add_argument('--connect', metavar='HOST:PORT', help="Connect over TCP to a target waiting for the parser (BMT_TRANSPORT=tcp-listen:PORT)")
+    parser.add_argument('--udp', action='store_true', help="With --listen, receive UDP datagrams instead of a TCP connection")
     parser.add_argument('--baud', type=int, default=115200, help="Baud rate (default: 115200)")
     parser.add_argument('--junit_xml', type=str, help="Filename to output JUnit XML report (e.g., test_results.xml)")
+    parser.add_argument('--bench_json', type=str, help="Filename to output the [ BENCH ] results as JSON (e.g., bench.json)")
+    parser.add_argument('--elf', type=str, help="ELF of the image under test: its GNU build ID must match the one the run prints")
     args = parser.parse_args()
-    num_failures = parse_gtest_output_main_logic(args.port, args.baud, args.junit_xml)
+    if args.udp and not args.listen:
+        parser.error("--udp requires --listen")
+    network = None
+    if args.listen:
+        network = ('udp' if args.udp else 'listen', args.listen)
+    elif args.connect:
+        network = ('connect', args.connect)
+    num_failures = parse_gtest_output_main_logic(args.port, args.baud, args.junit_xml, args.input, args.bench_json, args.elf,
+                                                 network)
     if num_failures < 0:
         print(f"Script exited with an error code: {num_failures}")
         exit(abs(num_failures)) 
@@ -0,0 +1,405 @@
+// src/bmt_bench.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_bench.h"
+#include "bmt_internal.h"
+
+/**
+ * @brief Weak default for the high-resolution timestamp.
+ *
+ * Falls back to bmt_platform_get_msec_ticks(). Platforms with a cycle counter or a
+ * 64-bit global timer should override it to get meaningful benchmark numbers.
+ *
+ * @return Current timestamp in milliseconds.
+ */
+__attribute__((weak)) uint64_t bmt_platform_get_hires_ticks(void) {
+    return bmt_platform_get_msec_ticks();
+}
+
+/**
+ * @brief Weak default for the high-resolution timestamp frequency.
+ * @return 1000, matching the millisecond fallback of bmt_platform_get_hires_ticks().
+ */
+__attribute__((weak)) uint32_t bmt_platform_get_hires_tick_hz(void) {
+    return 1000;
+}
+
+void bmt_print_u64(uint64_t val) {
+    char buf[21];
+    char* p = &buf[sizeof(buf) - 1];
+    *p = '\0';
+    do {
+        *--p = (char)('0' + (val % 10));
+        val /= 10;
+    } while (val > 0);
+    bmt_platform_puts(p);
+}
+
+void bmt_print_fixed3(uint64_t val_x1000) {
+    uint32_t frac = (uint32_t)(val_x1000 % 1000);
+    bmt_print_u64(val_x1000 / 1000);
+    bmt_platform_putchar('.');
+    bmt_platform_putchar((char)('0' + frac / 100));
+    bmt_platform_putchar((char)('0' + (frac / 10) % 10));
+    bmt_platform_putchar((char)('0' + frac % 10));
+}
+
+void bmt_print_hex(const uint8_t* data, size_t size) {
+    static const char hex[] = "0123456789abcdef";
+    for (size_t i = 0; i < size; ++i) {
+        bmt_platform_putchar(hex[data[i] >> 4]);
+        bmt_platform_putchar(hex[data[i] & 0xFu]);
+    }
+}
+
+void bmt_print_fixed2(uint64_t val_x100) {
+    uint32_t frac = (uint32_t)(val_x100 % 100);
+    bmt_print_u64(val_x100 / 100);
+    bmt_platform_putchar('.');
+    bmt_platform_putchar((char)('0' + frac / 10));
+    bmt_platform_putchar((char)('0' + frac % 10));
+}
+
+uint64_t bmt_ticks_to_ps(uint64_t ticks) {
+    uint64_t hz = bmt_platform_get_hires_tick_hz();
+    if (hz == 0) {
+        return 0;
+    }
+    // Split the multiplication so that ticks * 10^12 never overflows:
+    // whole seconds first, then the remainder in two 10^6 steps.
+    uint64_t q = ticks / hz;
+    uint64_t r = ticks % hz;
+    uint64_t r_us = (r * 1000000ULL) / hz;
+    uint64_t r_rem = (r * 1000000ULL) % hz;
+    return q * 1000000000000ULL + r_us * 1000000ULL + (r_rem * 1000000ULL) / hz;
+}
+
+/**
+ * @internal
+ * @brief Active benchmark configuration.
+ */
+static bmt_bench_config_t g_bmt_bench_config = {
+    BMT_BENCH_DEFAULT_SAMPLES, BMT_BENCH_DEFAULT_WARMUP, BMT_BENCH_DEFAULT_CV_MAX
+};
+
+void bmt_bench_set_config(const bmt_bench_config_t* config) {
+    g_bmt_bench_config = *config;
+    if (g_bmt_bench_config.samples == 0) g_bmt_bench_config.samples = 1;
+    if (g_bmt_bench_config.samples > BMT_BENCH_MAX_SAMPLES) g_bmt_bench_config.samples = BMT_BENCH_MAX_SAMPLES;
+}
+
+const bmt_bench_config_t* bmt_bench_get_config(void) {
+    return &g_bmt_bench_config;
+}
+
+/**
+ * @internal
+ * @brief Number of timed samples to take, clamped to [1, BMT_BENCH_MAX_SAMPLES].
+ */
+static uint32_t bmt_bench_sample_count(void) {
+    uint32_t samples = g_bmt_bench_config.samples;
+    if (samples == 0) samples = 1;
+    if (samples > BMT_BENCH_MAX_SAMPLES) samples = BMT_BENCH_MAX_SAMPLES;
+    return samples;
+}
+
+/**
+ * @internal
+ * @brief Integer square root (floor) of a 64-bit value.
+ */
+static uint64_t bmt_isqrt_u64(uint64_t v) {
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > v) bit >>= 2;
+    while (bit != 0) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+/**
+ * @internal
+ * @brief Times one sample of `iterations` calls to `func`.
+ * @return Time per iteration in picoseconds.
+ */
+static uint64_t bmt_bench_time_sample(bmt_bench_func_t func, void* ctx, uint32_t iterations) {
+    uint64_t start = bmt_platform_get_hires_ticks();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        func(ctx);
+    }
+    uint64_t end = bmt_platform_get_hires_ticks();
+    return bmt_ticks_to_ps(end - start) / iterations;
+}
+
+/**
+ * @internal
+ * @brief Computes min/max/mean/median and the coefficient of variation of a set of samples.
+ *
+ * The samples array is sorted in place.
+ */
+static void bmt_bench_summarize(uint64_t* samples_ps, uint32_t n, bmt_bench_result_t* res) {
+    uint64_t sum = 0;
+
+    for (uint32_t i = 1; i < n; ++i) {
+        uint64_t v = samples_ps[i];
+        uint32_t j = i;
+        while (j > 0 && samples_ps[j - 1] > v) {
+            samples_ps[j] = samples_ps[j - 1];
+            j--;
+        }
+        samples_ps[j] = v;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        sum += samples_ps[i];
+    }
+    res->samples = n;
+    res->min_ps = samples_ps[0];
+    res->max_ps = samples_ps[n - 1];
+    res->mean_ps = sum / n;
+    res->median_ps = (n & 1u) ? samples_ps[n / 2] : (samples_ps[n / 2 - 1] + samples_ps[n / 2]) / 2;
+
+    // The CV is scale-invariant: shift the samples down so that the squared deviations cannot overflow.
+    uint32_t shift = 0;
+    while ((res->max_ps >> shift) >= (1ULL << 26)) shift++;
+    uint64_t mean_s = res->mean_ps >> shift;
+    uint64_t var_sum = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t v = samples_ps[i] >> shift;
+        uint64_t d = (v > mean_s) ? v - mean_s : mean_s - v;
+        var_sum += d * d;
+    }
+    uint64_t stddev_s = bmt_isqrt_u64(var_sum / n);
+    res->cv_x100 = mean_s ? (uint32_t)((stddev_s * 10000ULL) / mean_s) : 0;
+    res->noisy = res->cv_x100 > g_bmt_bench_config.cv_max_x100;
+}
+
+void bmt_bench_run(const char* name, bmt_bench_func_t func, void* ctx, uint32_t iterations,
+                   uint32_t bytes_per_iter, bmt_bench_result_t* result) {
+    bmt_bench_result_t local;
+    bmt_bench_result_t* res = result ? result : &local;
+    uint64_t samples_ps[BMT_BENCH_MAX_SAMPLES];
+    uint32_t samples = bmt_bench_sample_count();
+
+    if (iterations == 0) iterations = 1;
+
+    for (uint32_t w = 0; w < g_bmt_bench_config.warmup; ++w) {
+        (void)bmt_bench_time_sample(func, ctx, iterations);
+    }
+    for (uint32_t s = 0; s < samples; ++s) {
+        samples_ps[s] = bmt_bench_time_sample(func, ctx, iterations);
+    }
+
+    res->name = name;
+    res->iterations = iterations;
+    res->bytes_per_iter = bytes_per_iter;
+    bmt_bench_summarize(samples_ps, samples, res);
+
+    bmt_bench_report(res);
+}
+
+uint32_t bmt_bench_compare(const char* name_a, bmt_bench_func_t func_a, void* ctx_a,
+                           const char* name_b, bmt_bench_func_t func_b, void* ctx_b,
+                           uint32_t iterations, uint32_t bytes_per_iter,
+                           bmt_bench_result_t* result_a, bmt_bench_result_t* result_b) {
+    bmt_bench_result_t local_a, local_b;
+    bmt_bench_result_t* res_a = result_a ? result_a : &local_a;
+    bmt_bench_result_t* res_b = result_b ? result_b : &local_b;
+    uint64_t samples_a[BMT_BENCH_MAX_SAMPLES];
+    uint64_t samples_b[BMT_BENCH_MAX_SAMPLES];
+    uint64_t ratios[BMT_BENCH_MAX_SAMPLES];
+    uint32_t samples = bmt_bench_sample_count();
+
+    if (iterations == 0) iterations = 1;
+
+    for (uint32_t w = 0; w < g_bmt_bench_config.warmup; ++w) {
+        (void)bmt_bench_time_sample(func_a, ctx_a, iterations);
+        (void)bmt_bench_time_sample(func_b, ctx_b, iterations);
+    }
+    // ABBA ordering: each pair alternates which side goes first, cancelling linear drifts
+    for (uint32_t s = 0; s < samples; ++s) {
+        if (s & 1u) {
+            samples_b[s] = bmt_bench_time_sample(func_b, ctx_b, iterations);
+            samples_a[s] = bmt_bench_time_sample(func_a, ctx_a, iterations);
+        } else {
+            samples_a[s] = bmt_bench_time_sample(func_a, ctx_a, iterations);
+            samples_b[s] = bmt_bench_time_sample(func_b, ctx_b, iterations);
+        }
+        ratios[s] = samples_a[s] ? (samples_b[s] * 1000ULL) / samples_a[s] : 0;
+    }
+
+    res_a->name = name_a;
+    res_a->iterations = iterations;
+    res_a->bytes_per_iter = bytes_per_iter;
+    bmt_bench_summarize(samples_a, samples, res_a);
+    res_b->name = name_b;
+    res_b->iterations = iterations;
+    res_b->bytes_per_iter = bytes_per_iter;
+    bmt_bench_summarize(samples_b, samples, res_b);
+
+    // The noise of the comparison itself is the spread of the per-pair ratios
+    bmt_bench_result_t ratio_stats;
+    bmt_bench_summarize(ratios, samples, &ratio_stats);
+    uint32_t ratio_x1000 = res_a->median_ps ? (uint32_t)((res_b->median_ps * 1000ULL) / res_a->median_ps) : 0;
+
+    bmt_bench_report(res_a);
+    bmt_bench_report(res_b);
+    bmt_platform_puts("[ BENCH AB ] ");
+    bmt_platform_puts(name_a);
+    bmt_platform_putchar(':');
+    bmt_platform_puts(name_b);
+    bmt_platform_puts(" ratio=");
+    bmt_print_fixed3(ratio_x1000);
+    bmt_platform_puts(" cv_pct=");
+    bmt_print_fixed2(ratio_stats.cv_x100);
+    if (ratio_stats.noisy) {
+        bmt_platform_puts(" noisy=1");
+    }
+    bmt_platform_puts("\r\n");
+    return ratio_x1000;
+}
+
+void bmt_bench_report(const bmt_bench_result_t* result) {
+    bmt_platform_puts("[ BENCH    ] ");
+    bmt_platform_puts(result->name);
+    bmt_platform_puts(" iters=");
+    bmt_print_u64(result->iterations);
+    bmt_platform_puts(" samples=");
+    bmt_print_u64(result->samples);
+    bmt_platform_puts(" ns_min=");
+    bmt_print_fixed3(result->min_ps);
+    bmt_platform_puts(" ns_mean=");
+    bmt_print_fixed3(result->mean_ps);
+    bmt_platform_puts(" ns_max=");
+    bmt_print_fixed3(result->max_ps);
+    bmt_platform_puts(" ns_median=");
+    bmt_print_fixed3(result->median_ps);
+    bmt_platform_puts(" cv_pct=");
+    bmt_print_fixed2(result->cv_x100);
+    if (result->bytes_per_iter > 0) {
+        bmt_platform_puts(" bytes=");
+        bmt_print_u64(result->bytes_per_iter);
+        bmt_platform_puts(" mbps=");
+        // bytes/ps = 10^6 MB/s; printed with two decimals from the best sample.
+        uint64_t mbps_x100 = result->min_ps ? ((uint64_t)result->bytes_per_iter * 100000000ULL) / result->min_ps : 0;
+        bmt_print_fixed2(mbps_x100);
+    }
+    if (result->noisy) {
+        bmt_platform_puts(" noisy=1");
+    }
+    bmt_platform_puts("\r\n");
+}
+
+/**
+ * @internal
+ * @brief Maps a value to its bucket in a bmt_hist_t.
+ */
+static uint32_t bmt_hist_index(uint32_t value) {
+    if (value < (1u << BMT_HIST_SUB_BITS)) {
+        return value;
+    }
+    uint32_t msb = 31u - (uint32_t)__builtin_clz(value);
+    uint32_t sub = (value >> (msb - BMT_HIST_SUB_BITS)) & ((1u << BMT_HIST_SUB_BITS) - 1u);
+    return ((msb - BMT_HIST_SUB_BITS + 1u) << BMT_HIST_SUB_BITS) + sub;
+}
+
+/**
+ * @internal
+ * @brief Lowest value that maps to bucket `index`.
+ */
+static uint64_t bmt_hist_bucket_lo(uint32_t index) {
+    if (index < (1u << BMT_HIST_SUB_BITS)) {
+        return index;
+    }
+    uint32_t msb = (index >> BMT_HIST_SUB_BITS) + BMT_HIST_SUB_BITS - 1u;
+    uint64_t sub = index & ((1u << BMT_HIST_SUB_BITS) - 1u);
+    return (((uint64_t)1 << BMT_HIST_SUB_BITS) + sub) << (msb - BMT_HIST_SUB_BITS);
+}
+
+void bmt_hist_init(bmt_hist_t* hist, const char* name) {
+    hist->name = name;
+    hist->count = 0;
+    hist->min = UINT32_MAX;
+    hist->max = 0;
+    hist->sum = 0;
+    for (uint32_t i = 0; i < BMT_HIST_BUCKETS; ++i) {
+        hist->buckets[i] = 0;
+    }
+}
+
+void bmt_hist_add(bmt_hist_t* hist, uint32_t value) {
+    hist->buckets[bmt_hist_index(value)]++;
+    hist->count++;
+    hist->sum += value;
+    if (value < hist->min) hist->min = value;
+    if (value > hist->max) hist->max = value;
+}
+
+uint32_t bmt_hist_percentile(const bmt_hist_t* hist, uint32_t per_mille) {
+    if (hist->count == 0) {
+        return 0;
+    }
+    // Rank of the percentile, rounded up: p50 of 10 values is the 5th one
+    uint64_t rank = ((uint64_t)hist->count * per_mille + 999u) / 1000u;
+    if (rank == 0) rank = 1;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < BMT_HIST_BUCKETS; ++i) {
+        seen += hist->buckets[i];
+        if (seen >= rank) {
+            uint64_t hi = bmt_hist_bucket_lo(i + 1u) - 1u;
+            return (hi > hist->max) ? hist->max : (uint32_t)hi;
+        }
+    }
+    return hist->max;
+}
+
+void bmt_hist_report(const bmt_hist_t* hist, const char* unit) {
+    static const uint32_t percentiles[] = { 500, 900, 990, 999 };
+    static const char* const labels[] = { " p50=", " p90=", " p99=", " p999=" };
+
+    bmt_platform_puts("[ HIST     ] ");
+    bmt_platform_puts(hist->name);
+    bmt_platform_puts(" unit=");
+    bmt_platform_puts(unit);
+    bmt_platform_puts(" count=");
+    bmt_print_u64(hist->count);
+    if (hist->count > 0) {
+        bmt_platform_puts(" min=");
+        bmt_print_u64(hist->min);
+        bmt_platform_puts(" mean=");
+        bmt_print_u64(hist->sum / hist->count);
+        for (uint32_t i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); ++i) {
+            bmt_platform_puts(labels[i]);
+            bmt_print_u64(bmt_hist_percentile(hist, percentiles[i]));
+        }
+        bmt_platform_puts(" max=");
+        bmt_print_u64(hist->max);
+    }
+    bmt_platform_puts("\r\n");
+
+    for (uint32_t i = 0; i < BMT_HIST_BUCKETS; ++i) {
+        if (hist->buckets[i] == 0) {
+            continue;
+        }
+        bmt_platform_puts("[ HIST BIN ] ");
+        bmt_platform_puts(hist->name);
+        bmt_platform_puts(" lo=");
+        bmt_print_u64(bmt_hist_bucket_lo(i));
+        bmt_platform_puts(" hi=");
+        bmt_print_u64(bmt_hist_bucket_lo(i + 1u));
+        bmt_platform_puts(" count=");
+        bmt_print_u64(hist->buckets[i]);
+        bmt_platform_puts("\r\n");
+    }
+}
@@ -0,0 +1,238 @@
+// src/bmt_compress.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_compress.h"
+#include "bmt_platform_io.h"
+#include "bmt_internal.h"
+
+#if BMT_COMPRESS_WINDOW_BITS < 4 || BMT_COMPRESS_WINDOW_BITS > 12
+#error "BMT_COMPRESS_WINDOW_BITS must be between 4 and 12"
+#endif
+#if BMT_COMPRESS_LENGTH_BITS < 3 || BMT_COMPRESS_LENGTH_BITS > 8
+#error "BMT_COMPRESS_LENGTH_BITS must be between 3 and 8"
+#endif
+#if BMT_COMPRESS_FRAME_MAX < 8 || BMT_COMPRESS_FRAME_MAX > 0xFFFF
+#error "BMT_COMPRESS_FRAME_MAX must be between 8 and 65535"
+#endif
+
+/** @internal @brief Bytes of the window. */
+#define BMT_COMPRESS_WINDOW (1u << BMT_COMPRESS_WINDOW_BITS)
+/** @internal @brief Shortest match (a shorter one costs more bits than its literals). */
+#define BMT_COMPRESS_MIN_MATCH 2u
+/** @internal @brief Longest match. */
+#define BMT_COMPRESS_MAX_MATCH ((1u << BMT_COMPRESS_LENGTH_BITS) + BMT_COMPRESS_MIN_MATCH - 1u)
+/** @internal @brief Bytes of `buf`: the history plus room to append, at least one longest match. */
+#define BMT_COMPRESS_BUF (BMT_COMPRESS_WINDOW + (BMT_COMPRESS_WINDOW > BMT_COMPRESS_MAX_MATCH ? BMT_COMPRESS_WINDOW : BMT_COMPRESS_MAX_MATCH))
+/** @internal @brief Bytes of the frame header. */
+#define BMT_COMPRESS_HEADER 5u
+/** @internal @brief Bytes a token may add to the payload (flag + window + length bits, + pending bits). */
+#define BMT_COMPRESS_TOKEN_MAX ((1u + BMT_COMPRESS_WINDOW_BITS + BMT_COMPRESS_LENGTH_BITS + 7u + 7u) / 8u)
+
+/**
+ * @internal
+ * @brief State of the compressor. Static: the output path has no heap.
+ *
+ * `buf` holds up to one window of already encoded text (the history matches refer to)
+ * followed by the text not encoded yet. When full, the history is moved to the front.
+ */
+static struct {
+    bmt_compress_sink_t sink;
+    bool reset;                 /**< Next frame must tell the host to clear its window. */
+    uint8_t buf[BMT_COMPRESS_BUF];
+    uint32_t pos;               /**< First byte of `buf` not encoded yet. */
+    uint32_t end;               /**< Bytes in `buf`. */
+    uint8_t frame[BMT_COMPRESS_HEADER + BMT_COMPRESS_FRAME_MAX];
+    uint32_t frame_len;         /**< Payload bytes in `frame`. */
+    uint32_t bits;              /**< Bits not yet stored in `frame`, right-aligned. */
+    uint32_t bit_count;
+    uint32_t last_frame_ms;
+    uint64_t start_ticks;       /**< Start of the current compression interval. */
+    bmt_compress_stats_t stats;
+} g_bmt_compress;
+
+/**
+ * @internal
+ * @brief Appends bits to the payload, MSB first.
+ * @param value The bits, right-aligned.
+ * @param count Number of bits (at most 24).
+ */
+static void bmt_compress_put_bits(uint32_t value, uint32_t count) {
+    g_bmt_compress.bits = (g_bmt_compress.bits << count) | (value & ((1u << count) - 1u));
+    g_bmt_compress.bit_count += count;
+    while (g_bmt_compress.bit_count >= 8u) {
+        g_bmt_compress.bit_count -= 8u;
+        g_bmt_compress.frame[BMT_COMPRESS_HEADER + g_bmt_compress.frame_len++] =
+            (uint8_t)(g_bmt_compress.bits >> g_bmt_compress.bit_count);
+    }
+}
+
+/**
+ * @internal
+ * @brief Pads the payload to a byte and sends the frame. The time spent in the sink is not
+ *        counted as compression time.
+ */
+static void bmt_compress_send_frame(void) {
+    if (g_bmt_compress.bit_count > 0u) {
+        bmt_compress_put_bits(0u, 8u - g_bmt_compress.bit_count);
+    }
+    if (g_bmt_compress.frame_len == 0u) {
+        return;
+    }
+    uint8_t* header = g_bmt_compress.frame;
+    header[0] = BMT_COMPRESS_SYNC;
+    header[1] = (uint8_t)(BMT_COMPRESS_WINDOW_BITS | (g_bmt_compress.reset ? BMT_COMPRESS_FLAG_RESET : 0u));
+    header[2] = BMT_COMPRESS_LENGTH_BITS;
+    header[3] = (uint8_t)(g_bmt_compress.frame_len & 0xFFu);
+    header[4] = (uint8_t)(g_bmt_compress.frame_len >> 8);
+    uint32_t size = BMT_COMPRESS_HEADER + g_bmt_compress.frame_len;
+
+    uint64_t now = bmt_platform_get_hires_ticks();
+    g_bmt_compress.stats.ticks += now - g_bmt_compress.start_ticks;
+    g_bmt_compress.sink(g_bmt_compress.frame, size);
+    g_bmt_compress.start_ticks = bmt_platform_get_hires_ticks();
+
+    g_bmt_compress.stats.out_bytes += size;
+    g_bmt_compress.stats.frames++;
+    g_bmt_compress.reset = false;
+    g_bmt_compress.frame_len = 0u;
+    g_bmt_compress.last_frame_ms = bmt_platform_get_msec_ticks();
+}
+
+/**
+ * @internal
+ * @brief Encodes the pending text as literals and matches. Without `final`, stops while less
+ *        than the longest match is pending, since more text could make a longer match.
+ * @param final Encode everything.
+ */
+static void bmt_compress_encode(bool final) {
+    const uint8_t* buf = g_bmt_compress.buf;
+    while (g_bmt_compress.pos < g_bmt_compress.end) {
+        uint32_t pos = g_bmt_compress.pos;
+        uint32_t avail = g_bmt_compress.end - pos;
+        if (avail < BMT_COMPRESS_MAX_MATCH && !final) {
+            break;
+        }
+        uint32_t max_len = avail < BMT_COMPRESS_MAX_MATCH ? avail : BMT_COMPRESS_MAX_MATCH;
+        uint32_t first = pos > BMT_COMPRESS_WINDOW ? pos - BMT_COMPRESS_WINDOW : 0u;
+        uint32_t best_len = 0u, best_dist = 0u;
+        // Nearest candidates first: on equal length the closest match wins. A match may run
+        // into the text it encodes (distance < length), as in every LZ77 decoder.
+        for (uint32_t cand = pos; cand-- > first && best_len < max_len;) {
+            if (buf[cand] != buf[pos] || buf[cand + best_len] != buf[pos + best_len]) {
+                continue;
+            }
+            uint32_t len = 1u;
+            while (len < max_len && buf[cand + len] == buf[pos + len]) {
+                ++len;
+            }
+            if (len > best_len) {
+                best_len = len;
+                best_dist = pos - cand;
+            }
+        }
+
+        if (g_bmt_compress.frame_len + BMT_COMPRESS_TOKEN_MAX > BMT_COMPRESS_FRAME_MAX) {
+            bmt_compress_send_frame();
+        }
+        if (best_len >= BMT_COMPRESS_MIN_MATCH) {
+            bmt_compress_put_bits(0u, 1u);
+            bmt_compress_put_bits(best_dist - 1u, BMT_COMPRESS_WINDOW_BITS);
+            bmt_compress_put_bits(best_len - BMT_COMPRESS_MIN_MATCH, BMT_COMPRESS_LENGTH_BITS);
+            g_bmt_compress.pos += best_len;
+        } else {
+            bmt_compress_put_bits(0x100u | buf[pos], 9u);
+            g_bmt_compress.pos++;
+        }
+    }
+}
+
+void bmt_compress_init(bmt_compress_sink_t sink) {
+    g_bmt_compress.sink = sink;
+    g_bmt_compress.reset = true;
+    g_bmt_compress.pos = 0u;
+    g_bmt_compress.end = 0u;
+    g_bmt_compress.frame_len = 0u;
+    g_bmt_compress.bits = 0u;
+    g_bmt_compress.bit_count = 0u;
+    g_bmt_compress.last_frame_ms = bmt_platform_get_msec_ticks();
+    g_bmt_compress.stats = (bmt_compress_stats_t){0};
+}
+
+bool bmt_compress_enabled(void) {
+    return g_bmt_compress.sink != NULL;
+}
+
+void bmt_compress_write(const char* data, size_t size) {
+    if (g_bmt_compress.sink == NULL) {
+        return;
+    }
+    g_bmt_compress.start_ticks = bmt_platform_get_hires_ticks();
+    bool line_end = false;
+    for (size_t i = 0; i < size; ++i) {
+        if (g_bmt_compress.end == sizeof(g_bmt_compress.buf)) {
+            // Keep one window of history, drop the rest
+            bmt_compress_encode(false);
+            uint32_t keep_from = g_bmt_compress.pos - BMT_COMPRESS_WINDOW;
+            for (uint32_t j = keep_from; j < g_bmt_compress.end; ++j) {
+                g_bmt_compress.buf[j - keep_from] = g_bmt_compress.buf[j];
+            }
+            g_bmt_compress.pos -= keep_from;
+            g_bmt_compress.end -= keep_from;
+        }
+        g_bmt_compress.buf[g_bmt_compress.end++] = (uint8_t)data[i];
+        line_end |= (data[i] == '\n');
+    }
+    g_bmt_compress.stats.in_bytes += size;
+    bmt_compress_encode(false);
+    g_bmt_compress.stats.ticks += bmt_platform_get_hires_ticks() - g_bmt_compress.start_ticks;
+
+#if BMT_COMPRESS_FLUSH_MS > 0
+    if (line_end && (uint32_t)(bmt_platform_get_msec_ticks() - g_bmt_compress.last_frame_ms) >= BMT_COMPRESS_FLUSH_MS) {
+        bmt_compress_flush();
+    }
+#else
+    (void)line_end;
+#endif
+}
+
+void bmt_compress_flush(void) {
+    if (g_bmt_compress.sink == NULL) {
+        return;
+    }
+    g_bmt_compress.start_ticks = bmt_platform_get_hires_ticks();
+    bmt_compress_encode(true);
+    bmt_compress_send_frame();
+    g_bmt_compress.stats.ticks += bmt_platform_get_hires_ticks() - g_bmt_compress.start_ticks;
+}
+
+void bmt_compress_get_stats(bmt_compress_stats_t* stats) {
+    *stats = g_bmt_compress.stats;
+}
+
+void bmt_compress_report(void) {
+    bmt_compress_stats_t s = g_bmt_compress.stats;
+    bmt_platform_puts("[ COMPRESS ] in=");
+    bmt_print_u64(s.in_bytes);
+    bmt_platform_puts(" out=");
+    bmt_print_u64(s.out_bytes);
+    bmt_platform_puts(" frames=");
+    bmt_print_u64(s.frames);
+    if (s.in_bytes > 0) {
+        bmt_platform_puts(" ratio=");
+        bmt_print_fixed3(s.out_bytes * 1000u / s.in_bytes);
+        bmt_platform_puts(" ns_per_byte=");
+        bmt_print_fixed3(bmt_ticks_to_ps(s.ticks) / s.in_bytes);
+    }
+    bmt_platform_puts(" window=");
+    bmt_print_u64(BMT_COMPRESS_WINDOW);
+    bmt_platform_puts(" max_match=");
+    bmt_print_u64(BMT_COMPRESS_MAX_MATCH);
+    bmt_platform_puts("\r\n");
+    bmt_compress_flush();
+}
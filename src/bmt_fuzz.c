@@ -0,0 +1,229 @@
+// src/bmt_fuzz.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_fuzz.h"
+#include "bmt_internal.h"
+#include <string.h>
+#ifdef BMT_FUZZ_BUILD
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+/**
+ * @brief Weak default: the target given at build time with `-DBMT_FUZZ_TARGET="Suite.Name"`, or NULL.
+ * @return The target name, or NULL.
+ */
+__attribute__((weak)) const char* bmt_platform_fuzz_target(void) {
+#ifdef BMT_FUZZ_TARGET
+    return BMT_FUZZ_TARGET;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @brief Weak default: no external corpus.
+ * @return false.
+ */
+__attribute__((weak)) bool bmt_platform_fuzz_corpus_entry(const char* name, uint32_t index, uint8_t* buffer,
+                                                          size_t capacity, size_t* size) {
+    (void)name; (void)index; (void)buffer; (void)capacity;
+    *size = 0;
+    return false;
+}
+
+/**
+ * @internal
+ * @brief A registered FUZZ_CORPUS block.
+ */
+typedef struct {
+    const char* name;
+    const bmt_fuzz_input_t* inputs;
+    uint32_t count;
+} bmt_fuzz_corpus_t;
+
+static bmt_fuzz_target_t g_bmt_fuzz_targets[BMT_FUZZ_MAX_TARGETS];
+static uint32_t g_bmt_fuzz_target_count = 0;
+static bmt_fuzz_corpus_t g_bmt_fuzz_corpora[BMT_FUZZ_MAX_CORPORA];
+static uint32_t g_bmt_fuzz_corpus_count = 0;
+
+/**
+ * @internal
+ * @brief Storage for inputs read through bmt_platform_fuzz_corpus_entry().
+ */
+static uint8_t g_bmt_fuzz_buffer[BMT_FUZZ_MAX_INPUT];
+
+void bmt_fuzz_register(const char* name, bmt_fuzz_func_t func) {
+    if (g_bmt_fuzz_target_count < BMT_FUZZ_MAX_TARGETS) {
+        g_bmt_fuzz_targets[g_bmt_fuzz_target_count].name = name;
+        g_bmt_fuzz_targets[g_bmt_fuzz_target_count].func = func;
+        g_bmt_fuzz_target_count++;
+    } else {
+        bmt_platform_puts("ERROR: Max fuzz targets reached. Increase BMT_FUZZ_MAX_TARGETS.\r\n");
+    }
+}
+
+void bmt_fuzz_register_corpus(const char* name, const bmt_fuzz_input_t* inputs, uint32_t count) {
+    if (g_bmt_fuzz_corpus_count < BMT_FUZZ_MAX_CORPORA) {
+        g_bmt_fuzz_corpora[g_bmt_fuzz_corpus_count].name = name;
+        g_bmt_fuzz_corpora[g_bmt_fuzz_corpus_count].inputs = inputs;
+        g_bmt_fuzz_corpora[g_bmt_fuzz_corpus_count].count = count;
+        g_bmt_fuzz_corpus_count++;
+    } else {
+        bmt_platform_puts("ERROR: Max fuzz corpora reached. Increase BMT_FUZZ_MAX_CORPORA.\r\n");
+    }
+}
+
+const bmt_fuzz_target_t* bmt_fuzz_find(const char* name) {
+    if (name == NULL) {
+        return (g_bmt_fuzz_target_count == 1) ? &g_bmt_fuzz_targets[0] : NULL;
+    }
+    for (uint32_t i = 0; i < g_bmt_fuzz_target_count; ++i) {
+        if (strcmp(g_bmt_fuzz_targets[i].name, name) == 0) {
+            return &g_bmt_fuzz_targets[i];
+        }
+    }
+    return NULL;
+}
+
+const bmt_fuzz_target_t* bmt_fuzz_target_at(uint32_t index) {
+    return (index < g_bmt_fuzz_target_count) ? &g_bmt_fuzz_targets[index] : NULL;
+}
+
+bool bmt_fuzz_run_input(bmt_fuzz_func_t func, const uint8_t* data, size_t size) {
+    bmt_jmp_buf runner_jmp;
+    memcpy(runner_jmp, g_bmt_assert_jmp_buf, sizeof(bmt_jmp_buf));
+    bool expect_failed = g_bmt_current_test_failed_expect;
+    bool unwinds = g_bmt_assert_unwinds;
+    bool passed = false;
+
+    g_bmt_current_test_failed_expect = false;
+    g_bmt_assert_unwinds = false;  // ASSERT_* of the body must come back here
+    if (bmt_setjmp(g_bmt_assert_jmp_buf) == 0) {
+        func(data, size);
+        passed = !g_bmt_current_test_failed_expect;
+    }
+    memcpy(g_bmt_assert_jmp_buf, runner_jmp, sizeof(bmt_jmp_buf));
+    g_bmt_current_test_failed_expect = expect_failed;
+    g_bmt_assert_unwinds = unwinds;
+    return passed;
+}
+
+/**
+ * @internal
+ * @brief Prints the `[ FUZZ IN  ]` line of a failing input (its first BMT_FUZZ_REPORT_BYTES bytes in hex).
+ */
+static void bmt_fuzz_report_input(const char* name, const char* source, uint32_t index,
+                                  const uint8_t* data, size_t size) {
+    bmt_platform_puts("[ FUZZ IN  ] ");
+    bmt_platform_puts(name);
+    bmt_platform_puts(" source=");
+    bmt_platform_puts(source);
+    bmt_platform_puts(" index=");
+    bmt_print_u64(index);
+    bmt_platform_puts(" len=");
+    bmt_print_u64(size);
+    bmt_platform_puts(" data=");
+    bmt_print_hex(data, (size < BMT_FUZZ_REPORT_BYTES) ? size : BMT_FUZZ_REPORT_BYTES);
+    if (size > BMT_FUZZ_REPORT_BYTES) {
+        bmt_platform_puts("...");
+    }
+    bmt_platform_puts("\r\n");
+}
+
+void bmt_fuzz_replay(const char* name, bmt_fuzz_func_t func) {
+    uint32_t builtin = 0, files = 0, failures = 0;
+    uint64_t start = bmt_platform_get_hires_ticks();
+
+    for (uint32_t c = 0; c < g_bmt_fuzz_corpus_count; ++c) {
+        const bmt_fuzz_corpus_t* corpus = &g_bmt_fuzz_corpora[c];
+        if (strcmp(corpus->name, name) != 0) {
+            continue;
+        }
+        for (uint32_t i = 0; i < corpus->count; ++i) {
+            const bmt_fuzz_input_t* in = &corpus->inputs[i];
+            if (!bmt_fuzz_run_input(func, in->data, in->size)) {
+                bmt_fuzz_report_input(name, "builtin", builtin, in->data, in->size);
+                failures++;
+            }
+            builtin++;
+        }
+    }
+
+    size_t size = 0;
+    while (bmt_platform_fuzz_corpus_entry(name, files, g_bmt_fuzz_buffer, sizeof(g_bmt_fuzz_buffer), &size)) {
+        if (!bmt_fuzz_run_input(func, g_bmt_fuzz_buffer, size)) {
+            bmt_fuzz_report_input(name, "file", files, g_bmt_fuzz_buffer, size);
+            failures++;
+        }
+        files++;
+    }
+    uint64_t ticks = bmt_platform_get_hires_ticks() - start;
+    uint32_t inputs = builtin + files;
+
+    bmt_platform_puts("[ FUZZ     ] ");
+    bmt_platform_puts(name);
+    bmt_platform_puts(" inputs=");
+    bmt_print_u64(inputs);
+    bmt_platform_puts(" builtin=");
+    bmt_print_u64(builtin);
+    bmt_platform_puts(" files=");
+    bmt_print_u64(files);
+    bmt_platform_puts(" failures=");
+    bmt_print_u64(failures);
+    bmt_platform_puts(" ns_per_input=");
+    bmt_print_fixed3(inputs ? bmt_ticks_to_ps(ticks) / inputs : 0);
+    bmt_platform_puts("\r\n");
+
+    if (failures > 0) {
+        g_bmt_current_test_failed_expect = true;
+    }
+}
+
+int bmt_fuzz_one_input(const uint8_t* data, size_t size) {
+    static const bmt_fuzz_target_t* target = NULL;
+    if (target == NULL) {
+        const char* name = bmt_platform_fuzz_target();
+        target = bmt_fuzz_find(name);
+        if (target == NULL) {
+            bmt_platform_puts("ERROR: ");
+            bmt_platform_puts(name ? "Unknown fuzz target " : "No fuzz target selected");
+            bmt_platform_puts(name ? name : "");
+            bmt_platform_puts(". Targets:");
+            for (uint32_t i = 0; i < g_bmt_fuzz_target_count; ++i) {
+                bmt_platform_puts(" ");
+                bmt_platform_puts(g_bmt_fuzz_targets[i].name);
+            }
+            bmt_platform_puts("\r\n");
+#ifdef BMT_FUZZ_BUILD
+            exit(1);
+#else
+            return 0;
+#endif
+        }
+    }
+    if (!bmt_fuzz_run_input(target->func, data, size)) {
+#ifdef BMT_FUZZ_BUILD
+        fflush(NULL);  // Keep the failure report, stdout may be buffered
+        abort();       // The fuzzer reports a crash and saves the input
+#else
+        bmt_platform_puts("ERROR: Fuzz target failed\r\n");
+#endif
+    }
+    return 0;
+}
+
+#ifdef BMT_FUZZ_BUILD
+/**
+ * @brief libFuzzer entry point (also used by AFL++ with `-fsanitize=fuzzer`).
+ */
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    return bmt_fuzz_one_input(data, size);
+}
+#endif
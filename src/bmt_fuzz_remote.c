@@ -0,0 +1,329 @@
+// src/bmt_fuzz_remote.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_fuzz.h"
+#include "bmt_internal.h"
+#include <string.h>
+
+/**
+ * @brief Weak default: no input link.
+ * @return -1.
+ */
+__attribute__((weak)) int bmt_platform_getchar(void) {
+    return -1;
+}
+
+/**
+ * @brief Weak default: no fault handlers (a crash ends the fuzzing session).
+ */
+__attribute__((weak)) void bmt_platform_fuzz_fault_guard(bool enable) {
+    (void)enable;
+}
+
+/** @internal @brief Words of a coverage map. */
+#define BMT_FUZZ_MAP_WORDS (BMT_FUZZ_MAP_BITS / 32u)
+
+/** @internal @brief Largest batch (the count is one byte). */
+#define BMT_FUZZ_BATCH_MAX 255u
+
+/**
+ * @internal
+ * @brief Result of one input of a batch.
+ */
+typedef struct {
+    char status;        /**< 'P', 'F' or 'C'. */
+    uint16_t new_edges;
+    uint16_t edges;
+    uint32_t hash;
+} bmt_fuzz_result_t;
+
+/**
+ * @internal
+ * @brief State of bmt_fuzz_serve(). Static: the target has no heap to spare.
+ */
+static struct {
+    volatile bool running;      /**< An input is running: a fault can be recovered. */
+    volatile bool crashed;      /**< Set by bmt_fuzz_fault(). */
+    uint32_t crash_cause;
+    uintptr_t crash_address;
+    volatile bool tracing;      /**< Coverage callbacks record edges. */
+    uint32_t prev;              /**< Previous location, to record edges rather than blocks. */
+    uint32_t map[BMT_FUZZ_MAP_WORDS];
+    uint32_t seen[BMT_FUZZ_MAP_WORDS];
+    uint8_t frame[BMT_FUZZ_FRAME_MAX + 1u];  // + '\0' for target names
+    bmt_fuzz_result_t results[BMT_FUZZ_BATCH_MAX];
+} g_bmt_fuzz_remote;
+
+#ifdef BMT_FUZZ_COVERAGE
+/**
+ * @internal
+ * @brief Records the edge from the previous location to `location` (AFL-style: the map index
+ *        is the XOR of both, with the previous one shifted so A->B and B->A differ).
+ */
+static inline void bmt_fuzz_cov_hit(uint32_t location) {
+    if (!g_bmt_fuzz_remote.tracing) {
+        return;
+    }
+    location ^= location >> 16;
+    location *= 0x45D9F3Bu;
+    location ^= location >> 16;
+    uint32_t idx = (location ^ g_bmt_fuzz_remote.prev) & (BMT_FUZZ_MAP_BITS - 1u);
+    g_bmt_fuzz_remote.map[idx >> 5] |= 1u << (idx & 31u);
+    g_bmt_fuzz_remote.prev = location >> 1;
+}
+
+/** @brief GCC `-fsanitize-coverage=trace-pc`: called at every basic block of instrumented code. */
+void __sanitizer_cov_trace_pc(void) {
+    bmt_fuzz_cov_hit((uint32_t)(uintptr_t)__builtin_return_address(0));
+}
+
+/** @brief Clang `-fsanitize-coverage=trace-pc-guard`: numbers the guards of each module. */
+void __sanitizer_cov_trace_pc_guard_init(uint32_t* start, uint32_t* stop) {
+    static uint32_t next = 0;
+    if (start == stop || *start != 0) {
+        return;
+    }
+    for (uint32_t* guard = start; guard < stop; ++guard) {
+        *guard = ++next;
+    }
+}
+
+/** @brief Clang `-fsanitize-coverage=trace-pc-guard`: called at every edge of instrumented code. */
+void __sanitizer_cov_trace_pc_guard(uint32_t* guard) {
+    bmt_fuzz_cov_hit(*guard);
+}
+#endif
+
+bool bmt_fuzz_fault_recoverable(void) {
+    return g_bmt_fuzz_remote.running;
+}
+
+void bmt_fuzz_fault(uint32_t cause, uintptr_t address) {
+    if (!g_bmt_fuzz_remote.running) {
+        return;
+    }
+    g_bmt_fuzz_remote.running = false;
+    g_bmt_fuzz_remote.tracing = false;
+    g_bmt_fuzz_remote.crashed = true;
+    g_bmt_fuzz_remote.crash_cause = cause;
+    g_bmt_fuzz_remote.crash_address = address;
+    bmt_longjmp(g_bmt_assert_jmp_buf, 1);  // Back into bmt_fuzz_run_input(), which reports a failure
+}
+
+/**
+ * @internal
+ * @brief CRC-16/CCITT (poly 0x1021), bitwise: frames are small next to the time to receive them.
+ */
+static uint16_t bmt_fuzz_crc16(uint16_t crc, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (int b = 0; b < 8; ++b) {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @internal
+ * @brief Receives one frame into `g_bmt_fuzz_remote.frame`, resynchronizing on the sync bytes.
+ * @return 1 if valid, 0 if corrupt or too long (already consumed), -1 if the link closed.
+ */
+static int bmt_fuzz_read_frame(uint8_t* type, uint32_t* size) {
+    int c = 0, prev = -1;
+    while ((c = bmt_platform_getchar()) >= 0) {
+        if (prev == (int)BMT_FUZZ_SYNC0 && c == (int)BMT_FUZZ_SYNC1) {
+            break;
+        }
+        prev = c;
+    }
+    uint8_t header[3];
+    for (int i = 0; i < 3 && c >= 0; ++i) {
+        header[i] = (uint8_t)(c = bmt_platform_getchar());
+    }
+    if (c < 0) {
+        return -1;
+    }
+    *type = header[0];
+    *size = (uint32_t)header[1] | ((uint32_t)header[2] << 8);
+    uint16_t crc = bmt_fuzz_crc16(0xFFFFu, header, 3);
+    uint8_t crc_rx[2] = { 0, 0 };
+    for (uint32_t i = 0; i < *size + 2u; ++i) {
+        if ((c = bmt_platform_getchar()) < 0) {
+            return -1;
+        }
+        if (i >= *size) {
+            crc_rx[i - *size] = (uint8_t)c;
+        } else if (i < BMT_FUZZ_FRAME_MAX) {  // Longer frames are read to the end and dropped
+            g_bmt_fuzz_remote.frame[i] = (uint8_t)c;
+            crc = bmt_fuzz_crc16(crc, &g_bmt_fuzz_remote.frame[i], 1);
+        }
+    }
+    return (*size <= BMT_FUZZ_FRAME_MAX && crc == (uint16_t)(crc_rx[0] | (crc_rx[1] << 8))) ? 1 : 0;
+}
+
+/**
+ * @internal
+ * @brief Runs one input with coverage recording and folds its edges into the global map.
+ */
+static void bmt_fuzz_remote_input(const bmt_fuzz_target_t* target, const uint8_t* data, size_t size,
+                                  bool verbose, bmt_fuzz_result_t* result) {
+    memset(g_bmt_fuzz_remote.map, 0, sizeof(g_bmt_fuzz_remote.map));
+    g_bmt_fuzz_remote.prev = 0;
+    g_bmt_fuzz_remote.crashed = false;
+    g_bmt_fuzz_remote.running = true;
+    g_bmt_fuzz_remote.tracing = true;
+    bool passed = bmt_fuzz_run_input(target->func, data, size);
+    g_bmt_fuzz_remote.tracing = false;
+    g_bmt_fuzz_remote.running = false;
+
+    result->status = g_bmt_fuzz_remote.crashed ? 'C' : (passed ? 'P' : 'F');
+    if (g_bmt_fuzz_remote.crashed && verbose) {
+        bmt_platform_puts("[ FUZZ SRV ] crash cause=");
+        bmt_print_u64(g_bmt_fuzz_remote.crash_cause);
+        bmt_platform_puts(" address=0x");
+        uint8_t addr_be[sizeof(uintptr_t)];
+        for (size_t i = 0; i < sizeof(uintptr_t); ++i) {
+            addr_be[i] = (uint8_t)(g_bmt_fuzz_remote.crash_address >> (8u * (sizeof(uintptr_t) - 1u - i)));
+        }
+        bmt_print_hex(addr_be, sizeof(addr_be));
+        bmt_platform_puts("\r\n");
+    }
+
+    uint32_t edges = 0, new_edges = 0, hash = 2166136261u;
+    for (uint32_t w = 0; w < BMT_FUZZ_MAP_WORDS; ++w) {
+        uint32_t m = g_bmt_fuzz_remote.map[w];
+        if (m == 0) {
+            continue;
+        }
+        edges += (uint32_t)__builtin_popcount(m);
+        new_edges += (uint32_t)__builtin_popcount(m & ~g_bmt_fuzz_remote.seen[w]);
+        g_bmt_fuzz_remote.seen[w] |= m;
+        hash = (hash ^ w) * 16777619u;
+        hash = (hash ^ m) * 16777619u;
+    }
+    result->edges = (uint16_t)edges;
+    result->new_edges = (uint16_t)new_edges;
+    result->hash = (edges > 0) ? hash : 0;
+}
+
+/**
+ * @internal
+ * @brief Runs a batch frame and prints its `[ FUZZ RES ]` line.
+ * @return Inputs that failed or crashed, or -1 if the frame is malformed.
+ */
+static int bmt_fuzz_remote_batch(const bmt_fuzz_target_t* target, uint32_t size, uint32_t* inputs) {
+    const uint8_t* p = g_bmt_fuzz_remote.frame;
+    if (size < 4u) {
+        return -1;
+    }
+    uint32_t seq = (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+    bool verbose = (p[2] & BMT_FUZZ_BATCH_VERBOSE) != 0;
+    uint32_t count = p[3];
+    uint32_t off = 4, bad = 0;
+
+    // All lengths are checked before anything runs: a corrupt batch runs nothing
+    for (uint32_t i = 0; i < count; ++i) {
+        if (off + 2u > size) return -1;
+        off += 2u + ((uint32_t)p[off] | ((uint32_t)p[off + 1] << 8));
+        if (off > size) return -1;
+    }
+
+    bmt_report_mute(!verbose);
+    off = 4;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t len = (uint32_t)p[off] | ((uint32_t)p[off + 1] << 8);
+        bmt_fuzz_remote_input(target, &p[off + 2], len, verbose, &g_bmt_fuzz_remote.results[i]);
+        bad += (g_bmt_fuzz_remote.results[i].status != 'P') ? 1u : 0u;
+        off += 2u + len;
+    }
+    bmt_report_mute(false);
+    *inputs += count;
+
+    bmt_platform_puts("[ FUZZ RES ] seq=");
+    bmt_print_u64(seq);
+    bmt_platform_puts(" results=");
+    for (uint32_t i = 0; i < count; ++i) {
+        const bmt_fuzz_result_t* r = &g_bmt_fuzz_remote.results[i];
+        uint8_t hash_be[4] = { (uint8_t)(r->hash >> 24), (uint8_t)(r->hash >> 16), (uint8_t)(r->hash >> 8), (uint8_t)r->hash };
+        if (i > 0) bmt_platform_putchar(',');
+        bmt_platform_putchar(r->status);
+        bmt_platform_putchar(':');
+        bmt_print_u64(r->new_edges);
+        bmt_platform_putchar(':');
+        bmt_print_u64(r->edges);
+        bmt_platform_putchar(':');
+        bmt_print_hex(hash_be, 4);
+    }
+    bmt_platform_puts("\r\n");
+    return (int)bad;
+}
+
+uint32_t bmt_fuzz_serve(void) {
+    const bmt_fuzz_target_t* target = bmt_fuzz_find(bmt_platform_fuzz_target());
+    uint32_t inputs = 0, bad = 0;
+    uint8_t type = 0;
+    uint32_t size = 0;
+
+    memset(g_bmt_fuzz_remote.seen, 0, sizeof(g_bmt_fuzz_remote.seen));
+    bmt_platform_puts("[ FUZZ SRV ] ready targets=");
+    for (uint32_t i = 0; bmt_fuzz_target_at(i) != NULL; ++i) {
+        if (i > 0) bmt_platform_putchar(',');
+        bmt_platform_puts(bmt_fuzz_target_at(i)->name);
+    }
+    bmt_platform_puts(" map_bits=");
+    bmt_print_u64(BMT_FUZZ_MAP_BITS);
+    bmt_platform_puts(" frame_max=");
+    bmt_print_u64(BMT_FUZZ_FRAME_MAX);
+    bmt_platform_puts(" max_input=");
+    bmt_print_u64(BMT_FUZZ_MAX_INPUT);
+    bmt_platform_puts("\r\n");
+
+    bmt_platform_fuzz_fault_guard(true);
+    for (;;) {
+        int r = bmt_fuzz_read_frame(&type, &size);
+        if (r < 0 || (r > 0 && type == BMT_FUZZ_FRAME_END)) {
+            break;
+        }
+        if (r == 0) {
+            bmt_platform_puts("[ FUZZ SRV ] error=frame\r\n");
+        } else if (type == BMT_FUZZ_FRAME_SELECT) {
+            g_bmt_fuzz_remote.frame[size] = '\0';
+            target = bmt_fuzz_find((const char*)g_bmt_fuzz_remote.frame);
+            bmt_platform_puts("[ FUZZ SRV ] target=");
+            bmt_platform_puts((const char*)g_bmt_fuzz_remote.frame);
+            bmt_platform_puts(target ? " ok=1\r\n" : " ok=0\r\n");
+        } else if (type == BMT_FUZZ_FRAME_BATCH && target == NULL) {
+            bmt_platform_puts("[ FUZZ SRV ] error=target\r\n");
+        } else if (type == BMT_FUZZ_FRAME_BATCH) {
+            int batch_bad = bmt_fuzz_remote_batch(target, size, &inputs);
+            if (batch_bad < 0) {
+                bmt_platform_puts("[ FUZZ SRV ] error=batch\r\n");
+            } else {
+                bad += (uint32_t)batch_bad;
+            }
+        } else {
+            bmt_platform_puts("[ FUZZ SRV ] error=type\r\n");
+        }
+    }
+    bmt_platform_fuzz_fault_guard(false);
+
+    uint32_t edges = 0;
+    for (uint32_t w = 0; w < BMT_FUZZ_MAP_WORDS; ++w) {
+        edges += (uint32_t)__builtin_popcount(g_bmt_fuzz_remote.seen[w]);
+    }
+    bmt_platform_puts("[ FUZZ SRV ] done inputs=");
+    bmt_print_u64(inputs);
+    bmt_platform_puts(" failures=");
+    bmt_print_u64(bad);
+    bmt_platform_puts(" edges=");
+    bmt_print_u64(edges);
+    bmt_platform_puts("\r\n");
+    return bad;
+}
@@ -0,0 +1,111 @@
+// src/bmt_internal.h
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#ifndef BMT_INTERNAL_H
+#define BMT_INTERNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @internal
+ * @file bmt_internal.h
+ * @brief Helpers shared between the framework translation units. Not part of the public API.
+ */
+
+/**
+ * @internal
+ * @brief Prints an unsigned 64-bit integer in decimal through bmt_platform_puts().
+ *
+ * Unlike the runner's `bmt_itoa()`, this does not go through `long`, so it is safe
+ * on 32-bit targets (e.g. Cortex-A9) where `long` cannot hold a 64-bit tick count.
+ *
+ * @param val The value to print.
+ */
+void bmt_print_u64(uint64_t val);
+
+/**
+ * @internal
+ * @brief Prints a fixed-point value with three decimals (e.g. 12345 -> "12.345").
+ * @param val_x1000 The value multiplied by 1000.
+ */
+void bmt_print_fixed3(uint64_t val_x1000);
+
+/**
+ * @internal
+ * @brief Prints bytes as lowercase hex, two digits per byte and no separators.
+ * @param data The bytes.
+ * @param size Number of bytes.
+ */
+void bmt_print_hex(const uint8_t* data, size_t size);
+
+/**
+ * @internal
+ * @brief Prints a fixed-point value with two decimals (e.g. 12345 -> "123.45").
+ * @param val_x100 The value multiplied by 100.
+ */
+void bmt_print_fixed2(uint64_t val_x100);
+
+/**
+ * @internal
+ * @brief Converts high-resolution ticks to picoseconds without overflowing for
+ *        realistic durations, using bmt_platform_get_hires_tick_hz().
+ * @param ticks Elapsed ticks as returned by bmt_platform_get_hires_ticks().
+ * @return Elapsed time in picoseconds.
+ */
+uint64_t bmt_ticks_to_ps(uint64_t ticks);
+
+/**
+ * @internal
+ * @brief Whether a stress test (bmt_stress.h) is running on several cores.
+ */
+bool bmt_stress_is_active(void);
+
+/**
+ * @internal
+ * @brief Called by bmt_report_failure() before printing. During a stress test it counts the
+ *        failure for the calling core and takes the output lock.
+ * @return false if the report must not be printed (too many failures in this stress test).
+ */
+bool bmt_stress_report_begin(void);
+
+/**
+ * @internal
+ * @brief Called by bmt_report_failure() after printing. During a stress test it prints the
+ *        core and iteration of the failure and releases the output lock.
+ */
+void bmt_stress_report_end(void);
+
+/**
+ * @internal
+ * @brief Ends the stress test body on the calling core (the per-core equivalent of
+ *        bmt_terminate_current_test()).
+ */
+void bmt_stress_terminate(void);
+
+/**
+ * @internal
+ * @brief Silences bmt_report_failure(), e.g. while a property test (bmt_property.h) searches
+ *        for and shrinks a counterexample, of which only the final one is reported.
+ * @param muted true to silence failure reports, false to print them again.
+ * @return Whether they were silenced before the call.
+ */
+bool bmt_report_mute(bool muted);
+
+/**
+ * @internal
+ * @brief Called by the runner after each test: if the test used virtual time (bmt_vclock.h),
+ *        goes back to real time and prints the test's virtual and real duration.
+ * @param suite Suite name of the test that just ended.
+ * @param name Name of the test that just ended.
+ */
+void bmt_vclock_test_end(const char* suite, const char* name);
+
+#endif // BMT_INTERNAL_H
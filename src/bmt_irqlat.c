@@ -0,0 +1,176 @@
+// src/bmt_irqlat.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_irqlat.h"
+#include "bmt_internal.h"
+#include <stddef.h>
+
+/**
+ * @brief Weak default: the platform has no timer interrupt.
+ * @return false.
+ */
+__attribute__((weak)) bool bmt_platform_timer_irq_arm(uint64_t fire_at, bmt_platform_irq_handler_t handler) {
+    (void)fire_at;
+    (void)handler;
+    return false;
+}
+
+/**
+ * @brief Weak default: nothing to cancel.
+ */
+__attribute__((weak)) void bmt_platform_timer_irq_cancel(void) {
+}
+
+/**
+ * @internal
+ * @brief State shared with the handler. Written in interrupt context.
+ */
+static volatile bool g_bmt_irqlat_fired;
+static volatile uint64_t g_bmt_irqlat_entry;
+static volatile uint64_t g_bmt_irqlat_exit;
+static bmt_bench_func_t g_bmt_irqlat_isr_body;
+static void* g_bmt_irqlat_isr_ctx;
+
+/**
+ * @internal
+ * @brief Handler passed to bmt_platform_timer_irq_arm(): timestamps entry and exit.
+ */
+static void bmt_irqlat_handler(void) {
+    uint64_t entry = bmt_platform_get_hires_ticks();
+    if (g_bmt_irqlat_isr_body) {
+        g_bmt_irqlat_isr_body(g_bmt_irqlat_isr_ctx);
+    }
+    uint64_t exit = bmt_platform_get_hires_ticks();
+    g_bmt_irqlat_entry = entry;
+    g_bmt_irqlat_exit = exit;
+    g_bmt_irqlat_fired = true;
+}
+
+/**
+ * @internal
+ * @brief Converts high-resolution ticks to nanoseconds, saturating at UINT32_MAX.
+ */
+static uint32_t bmt_irqlat_ticks_to_ns(uint64_t ticks) {
+    uint64_t ns = bmt_ticks_to_ps(ticks) / 1000u;
+    return (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)ns;
+}
+
+/**
+ * @internal
+ * @brief Converts microseconds to high-resolution ticks.
+ */
+static uint64_t bmt_irqlat_us_to_ticks(uint32_t us) {
+    return ((uint64_t)us * bmt_platform_get_hires_tick_hz()) / 1000000u;
+}
+
+/**
+ * @internal
+ * @brief Smallest number of ticks between two consecutive timestamp reads.
+ */
+static uint64_t bmt_irqlat_timestamp_ticks(void) {
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < 64; ++i) {
+        uint64_t t0 = bmt_platform_get_hires_ticks();
+        uint64_t t1 = bmt_platform_get_hires_ticks();
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    return best;
+}
+
+/**
+ * @internal
+ * @brief Copies `a` followed by `b` into `dst` (truncating to `len`).
+ */
+static void bmt_irqlat_concat(char* dst, uint32_t len, const char* a, const char* b) {
+    uint32_t i = 0;
+    while (*a && i + 1 < len) dst[i++] = *a++;
+    while (*b && i + 1 < len) dst[i++] = *b++;
+    dst[i] = '\0';
+}
+
+void bmt_irqlat_default_config(bmt_irqlat_config_t* config) {
+    config->iterations = BMT_IRQLAT_DEFAULT_ITERATIONS;
+    config->delay_us = BMT_IRQLAT_DEFAULT_DELAY_US;
+    config->timeout_us = BMT_IRQLAT_DEFAULT_TIMEOUT_US;
+    config->load_name = NULL;
+    config->load = NULL;
+    config->load_ctx = NULL;
+    config->isr_body = NULL;
+    config->isr_ctx = NULL;
+}
+
+bool bmt_irqlat_run(const char* name, const bmt_irqlat_config_t* config, bmt_irqlat_result_t* result) {
+    uint64_t delay = bmt_irqlat_us_to_ticks(config->delay_us);
+    uint64_t timeout = bmt_irqlat_us_to_ticks(config->timeout_us);
+    uint64_t ts_ticks = bmt_irqlat_timestamp_ticks();
+    uint32_t seed = 0x2545F491u;
+
+    bmt_irqlat_concat(result->latency_name, BMT_IRQLAT_NAME_MAX, name, "/latency");
+    bmt_irqlat_concat(result->isr_name, BMT_IRQLAT_NAME_MAX, name, "/isr");
+    bmt_hist_init(&result->latency, result->latency_name);
+    bmt_hist_init(&result->isr_duration, result->isr_name);
+    result->missed = 0;
+    result->timestamp_ns = bmt_irqlat_ticks_to_ns(ts_ticks);
+
+    g_bmt_irqlat_isr_body = config->isr_body;
+    g_bmt_irqlat_isr_ctx = config->isr_ctx;
+
+    for (uint32_t i = 0; i < config->iterations; ++i) {
+        // xorshift32 jitter in [0, delay / 2] so the fire time does not lock to the load's period
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        uint64_t jitter = (delay > 1u) ? seed % (delay / 2u + 1u) : 0;
+
+        g_bmt_irqlat_fired = false;
+        uint64_t fire_at = bmt_platform_get_hires_ticks() + delay + jitter;
+        if (!bmt_platform_timer_irq_arm(fire_at, bmt_irqlat_handler)) {
+            if (i == 0) {
+                return false;
+            }
+            result->missed++;
+            continue;
+        }
+        while (!g_bmt_irqlat_fired) {
+            if (config->load) {
+                config->load(config->load_ctx);
+            }
+            if (bmt_platform_get_hires_ticks() > fire_at + timeout) {
+                bmt_platform_timer_irq_cancel();
+                break;
+            }
+        }
+        if (!g_bmt_irqlat_fired) {
+            result->missed++;
+            continue;
+        }
+        uint64_t entry = g_bmt_irqlat_entry;
+        uint64_t exit = g_bmt_irqlat_exit;
+        uint64_t isr = exit - entry;
+        bmt_hist_add(&result->latency, bmt_irqlat_ticks_to_ns(entry > fire_at ? entry - fire_at : 0));
+        bmt_hist_add(&result->isr_duration, bmt_irqlat_ticks_to_ns(isr > ts_ticks ? isr - ts_ticks : 0));
+    }
+
+    bmt_platform_puts("[ IRQLAT   ] ");
+    bmt_platform_puts(name);
+    bmt_platform_puts(" iters=");
+    bmt_print_u64(config->iterations);
+    bmt_platform_puts(" missed=");
+    bmt_print_u64(result->missed);
+    bmt_platform_puts(" delay_us=");
+    bmt_print_u64(config->delay_us);
+    bmt_platform_puts(" load=");
+    bmt_platform_puts(config->load_name ? config->load_name : (config->load ? "custom" : "none"));
+    bmt_platform_puts(" timestamp_ns=");
+    bmt_print_u64(result->timestamp_ns);
+    bmt_platform_puts("\r\n");
+    bmt_hist_report(&result->latency, "ns");
+    bmt_hist_report(&result->isr_duration, "ns");
+    return true;
+}
@@ -0,0 +1,32 @@
+// src/bmt_isolate.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "baremetal_test.h"
+#include "bmt_internal.h"
+
+bool bmt_run_isolated(void (*func)(void* ctx), void* ctx) {
+    bmt_jmp_buf runner_jmp;
+    __builtin_memcpy(runner_jmp, g_bmt_assert_jmp_buf, sizeof(bmt_jmp_buf));
+    bool expect_failed = g_bmt_current_test_failed_expect;
+    bool unwinds = g_bmt_assert_unwinds;
+    bool muted = bmt_report_mute(true);
+    bool passed = false;
+
+    g_bmt_current_test_failed_expect = false;
+    g_bmt_assert_unwinds = false;  // ASSERT_* of the body must come back here
+    if (bmt_setjmp(g_bmt_assert_jmp_buf) == 0) {
+        func(ctx);
+        passed = !g_bmt_current_test_failed_expect;
+    }
+    __builtin_memcpy(g_bmt_assert_jmp_buf, runner_jmp, sizeof(bmt_jmp_buf));
+    g_bmt_current_test_failed_expect = expect_failed;
+    g_bmt_assert_unwinds = unwinds;
+    bmt_report_mute(muted);
+    return passed;
+}
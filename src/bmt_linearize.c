@@ -0,0 +1,523 @@
+// src/bmt_linearize.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_linearize.h"
+#include "bmt_internal.h"
+#include <string.h>
+
+/**
+ * @internal
+ * @brief splitmix64 finalizer, used for state hashes and the per-operation keys of the cache.
+ */
+static uint64_t bmt_lin_mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// --- Built-in specifications ---
+
+/**
+ * @internal
+ * @brief State of the queue and stack specifications. The queue is a ring (`first` is the
+ *        oldest element); the stack uses `values[0 .. count - 1]` with the top at the end.
+ */
+typedef struct {
+    uint32_t first;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t values[];
+} bmt_lin_seq_state_t;
+
+static size_t bmt_lin_seq_state_size(uint32_t ops) {
+    return sizeof(bmt_lin_seq_state_t) + (size_t)(ops ? ops : 1u) * sizeof(uint32_t);
+}
+
+static void bmt_lin_seq_init(void* state, uint32_t ops) {
+    bmt_lin_seq_state_t* s = (bmt_lin_seq_state_t*)state;
+    s->first = 0;
+    s->count = 0;
+    s->capacity = ops ? ops : 1u;
+}
+
+static bool bmt_lin_queue_apply(void* state, const bmt_lin_op_t* op, uint64_t* undo) {
+    bmt_lin_seq_state_t* s = (bmt_lin_seq_state_t*)state;
+    (void)undo;
+    if (op->op == BMT_LIN_QUEUE_ENQ) {
+        if (s->count == s->capacity) return false;
+        s->values[(s->first + s->count) % s->capacity] = op->arg;
+        s->count++;
+        return true;
+    }
+    if (!op->ok) {
+        return s->count == 0;
+    }
+    if (s->count == 0 || s->values[s->first] != op->ret) return false;
+    s->first = (s->first + 1u) % s->capacity;
+    s->count--;
+    return true;
+}
+
+static void bmt_lin_queue_undo(void* state, const bmt_lin_op_t* op, uint64_t undo) {
+    bmt_lin_seq_state_t* s = (bmt_lin_seq_state_t*)state;
+    (void)undo;
+    if (op->op == BMT_LIN_QUEUE_ENQ) {
+        s->count--;
+    } else if (op->ok) {
+        s->first = (s->first + s->capacity - 1u) % s->capacity;
+        s->values[s->first] = op->ret;
+        s->count++;
+    }
+}
+
+static uint64_t bmt_lin_queue_hash(const void* state) {
+    const bmt_lin_seq_state_t* s = (const bmt_lin_seq_state_t*)state;
+    uint64_t h = s->count;
+    for (uint32_t i = 0; i < s->count; ++i) {
+        h = bmt_lin_mix(h ^ s->values[(s->first + i) % s->capacity]);
+    }
+    return h;
+}
+
+static bool bmt_lin_stack_apply(void* state, const bmt_lin_op_t* op, uint64_t* undo) {
+    bmt_lin_seq_state_t* s = (bmt_lin_seq_state_t*)state;
+    (void)undo;
+    if (op->op == BMT_LIN_STACK_PUSH) {
+        if (s->count == s->capacity) return false;
+        s->values[s->count++] = op->arg;
+        return true;
+    }
+    if (!op->ok) {
+        return s->count == 0;
+    }
+    if (s->count == 0 || s->values[s->count - 1u] != op->ret) return false;
+    s->count--;
+    return true;
+}
+
+static void bmt_lin_stack_undo(void* state, const bmt_lin_op_t* op, uint64_t undo) {
+    bmt_lin_seq_state_t* s = (bmt_lin_seq_state_t*)state;
+    (void)undo;
+    if (op->op == BMT_LIN_STACK_PUSH) {
+        s->count--;
+    } else if (op->ok) {
+        s->values[s->count++] = op->ret;
+    }
+}
+
+static uint64_t bmt_lin_stack_hash(const void* state) {
+    const bmt_lin_seq_state_t* s = (const bmt_lin_seq_state_t*)state;
+    uint64_t h = s->count;
+    for (uint32_t i = 0; i < s->count; ++i) {
+        h = bmt_lin_mix(h ^ s->values[i]);
+    }
+    return h;
+}
+
+static size_t bmt_lin_register_state_size(uint32_t ops) {
+    (void)ops;
+    return sizeof(uint32_t);
+}
+
+static void bmt_lin_register_init(void* state, uint32_t ops) {
+    (void)ops;
+    *(uint32_t*)state = 0;
+}
+
+static bool bmt_lin_register_apply(void* state, const bmt_lin_op_t* op, uint64_t* undo) {
+    uint32_t* value = (uint32_t*)state;
+    if (op->op == BMT_LIN_REG_WRITE) {
+        *undo = *value;
+        *value = op->arg;
+        return true;
+    }
+    return *value == op->ret;
+}
+
+static void bmt_lin_register_undo(void* state, const bmt_lin_op_t* op, uint64_t undo) {
+    if (op->op == BMT_LIN_REG_WRITE) {
+        *(uint32_t*)state = (uint32_t)undo;
+    }
+}
+
+static uint64_t bmt_lin_register_hash(const void* state) {
+    return bmt_lin_mix(*(const uint32_t*)state);
+}
+
+static const char* const bmt_lin_queue_ops[] = { "enq", "deq" };
+static const char* const bmt_lin_stack_ops[] = { "push", "pop" };
+static const char* const bmt_lin_register_ops[] = { "write", "read" };
+
+const bmt_lin_spec_t bmt_lin_queue_spec = {
+    "queue", bmt_lin_queue_ops, 2,
+    bmt_lin_seq_state_size, bmt_lin_seq_init, bmt_lin_queue_apply, bmt_lin_queue_undo, bmt_lin_queue_hash
+};
+
+const bmt_lin_spec_t bmt_lin_stack_spec = {
+    "stack", bmt_lin_stack_ops, 2,
+    bmt_lin_seq_state_size, bmt_lin_seq_init, bmt_lin_stack_apply, bmt_lin_stack_undo, bmt_lin_stack_hash
+};
+
+const bmt_lin_spec_t bmt_lin_register_spec = {
+    "register", bmt_lin_register_ops, 2,
+    bmt_lin_register_state_size, bmt_lin_register_init, bmt_lin_register_apply, bmt_lin_register_undo,
+    bmt_lin_register_hash
+};
+
+// --- Recording ---
+
+void bmt_lin_history_init(bmt_lin_history_t* history, bmt_lin_op_t* buffer, uint32_t capacity, uint32_t cores) {
+    if (cores == 0) cores = 1;
+    if (cores > BMT_STRESS_MAX_CORES) cores = BMT_STRESS_MAX_CORES;
+    uint32_t per_core = capacity / cores;
+    for (uint32_t c = 0; c < BMT_STRESS_MAX_CORES; ++c) {
+        history->logs[c].ops = (c < cores) ? buffer + (size_t)c * per_core : NULL;
+        history->logs[c].capacity = (c < cores) ? per_core : 0;
+        history->logs[c].count = 0;
+        history->logs[c].dropped = 0;
+    }
+    history->cores = cores;
+}
+
+// --- Checker ---
+
+/**
+ * @internal
+ * @brief Call or return event of the history, sorted by time. On equal timestamps calls go
+ *        first, so the two operations count as concurrent (never a false violation).
+ */
+typedef struct {
+    uint64_t time;
+    uint32_t op;        /**< Index of the operation within the object's sub-history. */
+    uint32_t is_return;
+} bmt_lin_event_t;
+
+/**
+ * @internal
+ * @brief Search stack entry: a linearized operation and how to undo it.
+ */
+typedef struct {
+    uint64_t undo;
+    uint32_t event;     /**< Its call event. */
+} bmt_lin_frame_t;
+
+/**
+ * @internal
+ * @brief Scratch arrays carved from the workspace.
+ */
+typedef struct {
+    const bmt_lin_op_t** ops;   /**< All completed operations, sorted by (key, invoke). */
+    bmt_lin_event_t* events;    /**< 2n events of the current object. */
+    int32_t* next;              /**< Doubly linked list of the events not yet linearized. */
+    int32_t* prev;              /**< Index 2n is the list head. */
+    uint32_t* ret_event;        /**< Return event of each operation. */
+    bmt_lin_frame_t* stack;
+    void* state;
+    uint64_t* cache;            /**< Open-addressing set of visited (linearized set, state) hashes. */
+    uint32_t cache_slots;       /**< Slots available (power of two). */
+    uint64_t steps;
+    uint64_t evictions;         /**< Cache entries overwritten because their probe window was full. */
+} bmt_lin_work_t;
+
+static bool bmt_lin_op_less(const void* a, const void* b) {
+    const bmt_lin_op_t* x = *(const bmt_lin_op_t* const*)a;
+    const bmt_lin_op_t* y = *(const bmt_lin_op_t* const*)b;
+    return (x->key != y->key) ? x->key < y->key : x->invoke < y->invoke;
+}
+
+static bool bmt_lin_event_less(const void* a, const void* b) {
+    const bmt_lin_event_t* x = (const bmt_lin_event_t*)a;
+    const bmt_lin_event_t* y = (const bmt_lin_event_t*)b;
+    return (x->time != y->time) ? x->time < y->time : x->is_return < y->is_return;
+}
+
+/**
+ * @internal
+ * @brief In-place heapsort (no recursion, no allocation) for elements of up to 16 bytes.
+ */
+static void bmt_lin_sort(void* base, uint32_t count, size_t size, bool (*less)(const void*, const void*)) {
+    uint8_t* b = (uint8_t*)base;
+    uint8_t tmp[16];
+    #define BMT_LIN_AT(i) (b + (size_t)(i) * size)
+    #define BMT_LIN_SWAP(i, j) do { memcpy(tmp, BMT_LIN_AT(i), size); memcpy(BMT_LIN_AT(i), BMT_LIN_AT(j), size); \
+                                    memcpy(BMT_LIN_AT(j), tmp, size); } while (0)
+    for (uint32_t end = count, start = count / 2u; end > 1u;) {
+        uint32_t root;
+        if (start > 0) {
+            root = --start;
+        } else {
+            --end;
+            BMT_LIN_SWAP(0, end);
+            root = 0;
+        }
+        for (;;) {
+            uint32_t child = 2u * root + 1u;
+            if (child >= end) break;
+            if (child + 1u < end && less(BMT_LIN_AT(child), BMT_LIN_AT(child + 1u))) child++;
+            if (!less(BMT_LIN_AT(root), BMT_LIN_AT(child))) break;
+            BMT_LIN_SWAP(root, child);
+            root = child;
+        }
+    }
+    #undef BMT_LIN_SWAP
+    #undef BMT_LIN_AT
+}
+
+/**
+ * @internal
+ * @brief Inserts a hash into the visited set.
+ * @return false if it was already there. When the probe window is full, the new hash replaces
+ *         the first slot of the window: forgetting a configuration only makes the search slower, never wrong.
+ */
+static bool bmt_lin_cache_insert(bmt_lin_work_t* w, uint64_t h) {
+    h |= 1u;  // 0 marks an empty slot
+    uint32_t mask = w->cache_slots - 1u;
+    uint32_t start = (uint32_t)(h >> 32) & mask;
+    for (uint32_t i = start, probes = 0; probes < BMT_LIN_CACHE_PROBES; i = (i + 1u) & mask, ++probes) {
+        if (w->cache[i] == h) return false;
+        if (w->cache[i] == 0) {
+            w->cache[i] = h;
+            return true;
+        }
+    }
+    w->cache[start] = h;
+    w->evictions++;
+    return true;
+}
+
+static void bmt_lin_lift(bmt_lin_work_t* w, uint32_t e) {
+    for (int k = 0; k < 2; ++k) {
+        int32_t p = w->prev[e], n = w->next[e];
+        w->next[p] = n;
+        if (n >= 0) w->prev[n] = p;
+        e = w->ret_event[w->events[e].op];
+    }
+}
+
+static void bmt_lin_unlift(bmt_lin_work_t* w, uint32_t e) {
+    uint32_t r = w->ret_event[w->events[e].op];
+    uint32_t order[2] = { r, e };  // reverse order of bmt_lin_lift()
+    for (int k = 0; k < 2; ++k) {
+        uint32_t x = order[k];
+        int32_t p = w->prev[x], n = w->next[x];
+        w->next[p] = (int32_t)x;
+        if (n >= 0) w->prev[n] = (int32_t)x;
+    }
+}
+
+/**
+ * @internal
+ * @brief Wing & Gong search over the sub-history `ops[0 .. n - 1]` of one object.
+ *
+ * Walks the event list trying to linearize each pending call next; a return event reached
+ * before its operation was linearized means the current prefix is a dead end, so it
+ * backtracks. Lowe's cache of (linearized set, state) prunes prefixes already explored:
+ * the set is hashed incrementally (XOR of a per-operation key), the state with spec->hash.
+ *
+ * @param object Index of the object, mixed into the cache keys.
+ * @param stuck Output: operation that could not be placed at the deepest point reached.
+ * @return BMT_LIN_OK, BMT_LIN_VIOLATION or BMT_LIN_INCONCLUSIVE.
+ */
+static bmt_lin_result_t bmt_lin_check_object(bmt_lin_work_t* w, const bmt_lin_spec_t* spec,
+                                             const bmt_lin_op_t* const* ops, uint32_t n, uint32_t object,
+                                             uint32_t* stuck) {
+    uint32_t head = 2u * n;
+    for (uint32_t i = 0; i < n; ++i) {
+        w->events[2u * i] = (bmt_lin_event_t){ ops[i]->invoke, i, 0 };
+        w->events[2u * i + 1u] = (bmt_lin_event_t){ ops[i]->response, i, 1 };
+    }
+    bmt_lin_sort(w->events, 2u * n, sizeof(bmt_lin_event_t), bmt_lin_event_less);
+    for (uint32_t e = 0; e < 2u * n; ++e) {
+        w->prev[e] = (e == 0) ? (int32_t)head : (int32_t)e - 1;
+        w->next[e] = (e + 1u < 2u * n) ? (int32_t)e + 1 : -1;
+        if (w->events[e].is_return) w->ret_event[w->events[e].op] = e;
+    }
+    w->next[head] = (n > 0) ? 0 : -1;
+
+    // Seeding the set hash with the object index keeps the cache valid across objects without clearing it
+    spec->init(w->state, n);
+    uint64_t linearized = bmt_lin_mix(~(uint64_t)object);
+    uint32_t depth = 0, best_depth = 0;
+    bmt_lin_result_t result = BMT_LIN_OK;
+    *stuck = 0;
+
+    int32_t cur = w->next[head];
+    while (w->next[head] >= 0) {
+        if (++w->steps > BMT_LIN_MAX_STEPS) {
+            result = BMT_LIN_INCONCLUSIVE;
+            break;
+        }
+        const bmt_lin_event_t* ev = &w->events[cur];
+        const bmt_lin_op_t* op = ops[ev->op];
+        if (!ev->is_return) {
+            uint64_t undo = 0;
+            if (spec->apply(w->state, op, &undo)) {
+                uint64_t set = linearized ^ bmt_lin_mix(ev->op);
+                if (bmt_lin_cache_insert(w, bmt_lin_mix(set) ^ spec->hash(w->state))) {
+                    w->stack[depth++] = (bmt_lin_frame_t){ undo, (uint32_t)cur };
+                    linearized = set;
+                    bmt_lin_lift(w, (uint32_t)cur);
+                    cur = w->next[head];
+                    continue;
+                }
+                spec->undo(w->state, op, undo);
+            }
+            cur = w->next[cur];
+        } else {
+            if (depth >= best_depth) {
+                best_depth = depth;
+                *stuck = ev->op;
+            }
+            if (depth == 0) {
+                result = BMT_LIN_VIOLATION;
+                break;
+            }
+            bmt_lin_frame_t f = w->stack[--depth];
+            const bmt_lin_op_t* undone = ops[w->events[f.event].op];
+            spec->undo(w->state, undone, f.undo);
+            linearized ^= bmt_lin_mix(w->events[f.event].op);
+            bmt_lin_unlift(w, f.event);
+            cur = w->next[f.event];
+        }
+    }
+    return result;
+}
+
+/**
+ * @internal
+ * @brief Prints one operation of a violation report.
+ */
+static void bmt_lin_print_op(const char* name, const bmt_lin_spec_t* spec, const bmt_lin_op_t* op,
+                             uint64_t origin, bool stuck) {
+    bmt_platform_puts("[ LINCHECK ] ");
+    bmt_platform_puts(name);
+    bmt_platform_puts(stuck ? "/stuck" : "/concurrent");
+    bmt_platform_puts(" core=");
+    bmt_print_u64(op->core);
+    bmt_platform_puts(" key=");
+    bmt_print_u64(op->key);
+    bmt_platform_puts(" op=");
+    if (op->op < spec->num_op_names) {
+        bmt_platform_puts(spec->op_names[op->op]);
+    } else {
+        bmt_print_u64(op->op);
+    }
+    bmt_platform_puts(" arg=");
+    bmt_print_u64(op->arg);
+    bmt_platform_puts(" ok=");
+    bmt_print_u64(op->ok);
+    bmt_platform_puts(" ret=");
+    bmt_print_u64(op->ret);
+    bmt_platform_puts(" invoke_ns=");
+    bmt_print_u64(bmt_ticks_to_ps(op->invoke - origin) / 1000u);
+    bmt_platform_puts(" response_ns=");
+    bmt_print_u64(bmt_ticks_to_ps(op->response - origin) / 1000u);
+    bmt_platform_puts("\r\n");
+}
+
+bmt_lin_result_t bmt_lin_check(const char* name, const bmt_lin_history_t* history, const bmt_lin_spec_t* spec,
+                               void* workspace, size_t workspace_size) {
+    uint32_t total = 0, dropped = 0;
+    for (uint32_t c = 0; c < history->cores; ++c) {
+        total += history->logs[c].count;
+        dropped += history->logs[c].dropped;
+    }
+
+    // Carve the workspace, largest alignment first
+    uintptr_t p = ((uintptr_t)workspace + 7u) & ~(uintptr_t)7u;
+    uintptr_t end = (uintptr_t)workspace + workspace_size;
+    bmt_lin_work_t w;
+    size_t state_bytes = (spec->state_size(total) + 7u) & ~(size_t)7u;
+    size_t fixed = (size_t)total * (sizeof(bmt_lin_op_t*) + 2u * sizeof(bmt_lin_event_t) + sizeof(bmt_lin_frame_t)
+                                    + sizeof(uint32_t) + 4u * sizeof(int32_t))
+                   + 2u * sizeof(int32_t) + state_bytes + 64u * sizeof(uint64_t) + 8u;
+    if (p > end || end - p < fixed) {
+        bmt_platform_puts("[ LINCHECK ] ");
+        bmt_platform_puts(name);
+        bmt_platform_puts(" result=error workspace=");
+        bmt_print_u64(workspace_size);
+        bmt_platform_puts(" needed=");
+        bmt_print_u64(fixed + 8u);
+        bmt_platform_puts("\r\n");
+        return BMT_LIN_ERROR;
+    }
+    w.events = (bmt_lin_event_t*)p;          p += (size_t)2u * total * sizeof(bmt_lin_event_t);
+    w.stack = (bmt_lin_frame_t*)p;           p += (size_t)total * sizeof(bmt_lin_frame_t);
+    w.state = (void*)p;                      p += state_bytes;
+    w.ops = (const bmt_lin_op_t**)p;         p += (size_t)total * sizeof(bmt_lin_op_t*);
+    p = (p + 7u) & ~(uintptr_t)7u;
+    w.next = (int32_t*)p;                    p += (size_t)(2u * total + 1u) * sizeof(int32_t);
+    w.prev = (int32_t*)p;                    p += (size_t)(2u * total + 1u) * sizeof(int32_t);
+    w.ret_event = (uint32_t*)p;              p += (size_t)total * sizeof(uint32_t);
+    p = (p + 7u) & ~(uintptr_t)7u;
+    w.cache = (uint64_t*)p;
+    uint32_t slots = 64u;
+    while ((uint64_t)slots * 2u * sizeof(uint64_t) <= (uint64_t)(end - p) && slots < 0x40000000u) slots <<= 1;
+    w.cache_slots = slots;
+    w.steps = 0;
+    w.evictions = 0;
+    memset(w.cache, 0, (size_t)slots * sizeof(uint64_t));
+
+    // Completed operations, grouped by object
+    uint32_t n = 0;
+    for (uint32_t c = 0; c < history->cores; ++c) {
+        for (uint32_t i = 0; i < history->logs[c].count; ++i) {
+            if (history->logs[c].ops[i].response != 0) {
+                w.ops[n++] = &history->logs[c].ops[i];
+            }
+        }
+    }
+    bmt_lin_sort(w.ops, n, sizeof(bmt_lin_op_t*), bmt_lin_op_less);
+
+    bmt_lin_result_t result = (dropped > 0) ? BMT_LIN_INCONCLUSIVE : BMT_LIN_OK;
+    uint32_t objects = 0, first = 0, count = 0, stuck = 0;
+    for (uint32_t i = 0; i < n && result == BMT_LIN_OK; i = first + count) {
+        first = i;
+        count = 1;
+        while (first + count < n && w.ops[first + count]->key == w.ops[first]->key) count++;
+        objects++;
+        result = bmt_lin_check_object(&w, spec, &w.ops[first], count, objects, &stuck);
+    }
+
+    bmt_platform_puts("[ LINCHECK ] ");
+    bmt_platform_puts(name);
+    bmt_platform_puts(" spec=");
+    bmt_platform_puts(spec->name);
+    bmt_platform_puts(" ops=");
+    bmt_print_u64(n);
+    bmt_platform_puts(" objects=");
+    bmt_print_u64(objects);
+    bmt_platform_puts(" steps=");
+    bmt_print_u64(w.steps);
+    bmt_platform_puts(" evictions=");
+    bmt_print_u64(w.evictions);
+    if (dropped > 0) {
+        bmt_platform_puts(" dropped=");
+        bmt_print_u64(dropped);
+    }
+    bmt_platform_puts(" result=");
+    bmt_platform_puts(result == BMT_LIN_OK ? "ok" : (result == BMT_LIN_VIOLATION ? "violation" : "inconclusive"));
+    bmt_platform_puts("\r\n");
+
+    if (result == BMT_LIN_VIOLATION) {
+        const bmt_lin_op_t* const* obj = &w.ops[first];
+        const bmt_lin_op_t* bad = obj[stuck];
+        uint64_t origin = obj[0]->invoke;
+        bmt_lin_print_op(name, spec, bad, origin, true);
+        uint32_t printed = 0;
+        for (uint32_t i = 0; i < count && printed < BMT_LIN_REPORT_OPS; ++i) {
+            if (i != stuck && obj[i]->invoke <= bad->response && obj[i]->response >= bad->invoke) {
+                bmt_lin_print_op(name, spec, obj[i], origin, false);
+                printed++;
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,274 @@
+// src/bmt_memprof.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_memprof.h"
+#include "bmt_bench.h"
+#include "bmt_internal.h"
+#include <string.h>
+
+/**
+ * @internal
+ * @brief Number of repetitions of each measurement; the fastest one is kept.
+ */
+#define BMT_MEMPROF_REPS 3
+
+/**
+ * @internal
+ * @brief Calibration registry: profiles measured during this run.
+ */
+static bmt_memprof_profile_t g_bmt_memprof_profiles[BMT_MEMPROF_MAX_REGIONS];
+
+/**
+ * @internal
+ * @brief Number of valid entries in g_bmt_memprof_profiles.
+ */
+static uint32_t g_bmt_memprof_count = 0;
+
+/**
+ * @internal
+ * @brief Scratch profile used when the registry is full (results are printed but not kept).
+ */
+static bmt_memprof_profile_t g_bmt_memprof_scratch;
+
+/**
+ * @internal
+ * @brief xorshift32 step used to shuffle the pointer-chase permutation.
+ */
+static uint32_t bmt_memprof_rand(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * @internal
+ * @brief Builds a single random cycle through `n` cache-line sized nodes (Sattolo's algorithm).
+ *
+ * Word 0 of each node holds the pointer to the next node; word 1 is used as scratch
+ * space for the permutation, so no extra memory is needed.
+ */
+static void** bmt_memprof_build_chain(uint8_t* base, size_t n) {
+    uint32_t seed = 0x9E3779B9u;
+    for (size_t i = 0; i < n; ++i) {
+        ((size_t*)(base + i * BMT_MEMPROF_LINE_SIZE))[1] = i;
+    }
+    for (size_t i = n - 1; i > 0; --i) {
+        size_t j = bmt_memprof_rand(&seed) % i;
+        size_t* slot_i = &((size_t*)(base + i * BMT_MEMPROF_LINE_SIZE))[1];
+        size_t* slot_j = &((size_t*)(base + j * BMT_MEMPROF_LINE_SIZE))[1];
+        size_t tmp = *slot_i;
+        *slot_i = *slot_j;
+        *slot_j = tmp;
+    }
+    for (size_t k = 0; k < n; ++k) {
+        size_t from = ((size_t*)(base + k * BMT_MEMPROF_LINE_SIZE))[1];
+        size_t to = ((size_t*)(base + ((k + 1) % n) * BMT_MEMPROF_LINE_SIZE))[1];
+        *(void**)(base + from * BMT_MEMPROF_LINE_SIZE) = base + to * BMT_MEMPROF_LINE_SIZE;
+    }
+    return (void**)base;
+}
+
+/**
+ * @internal
+ * @brief Follows the chain for `loads` dependent loads (multiple of 8).
+ * @return Elapsed high-resolution ticks.
+ */
+static uint64_t bmt_memprof_chase(void** start, uint32_t loads) {
+    void** p = start;
+    uint64_t t0 = bmt_platform_get_hires_ticks();
+    for (uint32_t i = 0; i < loads; i += 8) {
+        p = (void**)*p; p = (void**)*p; p = (void**)*p; p = (void**)*p;
+        p = (void**)*p; p = (void**)*p; p = (void**)*p; p = (void**)*p;
+    }
+    uint64_t t1 = bmt_platform_get_hires_ticks();
+    BMT_BENCH_DO_NOT_OPTIMIZE(p);
+    return t1 - t0;
+}
+
+/**
+ * @internal
+ * @brief Sequential 64-bit read sweep over `bytes`, `reps` times.
+ */
+static uint64_t bmt_memprof_read(const uint64_t* buf, size_t bytes, uint32_t reps) {
+    size_t words = bytes / sizeof(uint64_t);
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    uint64_t t0 = bmt_platform_get_hires_ticks();
+    for (uint32_t r = 0; r < reps; ++r) {
+        const volatile uint64_t* p = buf;
+        for (size_t i = 0; i < words; i += 4) {
+            s0 += p[i];
+            s1 += p[i + 1];
+            s2 += p[i + 2];
+            s3 += p[i + 3];
+        }
+    }
+    uint64_t t1 = bmt_platform_get_hires_ticks();
+    uint64_t sum = s0 + s1 + s2 + s3;
+    BMT_BENCH_DO_NOT_OPTIMIZE(sum);
+    return t1 - t0;
+}
+
+/**
+ * @internal
+ * @brief Sequential 64-bit write sweep over `bytes`, `reps` times.
+ */
+static uint64_t bmt_memprof_write(uint64_t* buf, size_t bytes, uint32_t reps) {
+    size_t words = bytes / sizeof(uint64_t);
+    uint64_t t0 = bmt_platform_get_hires_ticks();
+    for (uint32_t r = 0; r < reps; ++r) {
+        volatile uint64_t* p = buf;
+        uint64_t v = r;
+        for (size_t i = 0; i < words; i += 4) {
+            p[i] = v;
+            p[i + 1] = v;
+            p[i + 2] = v;
+            p[i + 3] = v;
+        }
+    }
+    uint64_t t1 = bmt_platform_get_hires_ticks();
+    return t1 - t0;
+}
+
+/**
+ * @internal
+ * @brief Copies the first half of `bytes` onto the second half, `reps` times.
+ */
+static uint64_t bmt_memprof_copy(uint64_t* buf, size_t bytes, uint32_t reps) {
+    size_t words = bytes / 2 / sizeof(uint64_t);
+    const volatile uint64_t* src = buf;
+    volatile uint64_t* dst = buf + words;
+    uint64_t t0 = bmt_platform_get_hires_ticks();
+    for (uint32_t r = 0; r < reps; ++r) {
+        for (size_t i = 0; i < words; i += 4) {
+            dst[i] = src[i];
+            dst[i + 1] = src[i + 1];
+            dst[i + 2] = src[i + 2];
+            dst[i + 3] = src[i + 3];
+        }
+    }
+    uint64_t t1 = bmt_platform_get_hires_ticks();
+    return t1 - t0;
+}
+
+/**
+ * @internal
+ * @brief Converts `bytes` processed in `ticks` to MB/s.
+ */
+static uint32_t bmt_memprof_mbps(uint64_t bytes, uint64_t ticks) {
+    uint64_t ps = bmt_ticks_to_ps(ticks);
+    return ps ? (uint32_t)((bytes * 1000000ULL) / ps) : 0;
+}
+
+/**
+ * @internal
+ * @brief Measures one working set and fills `pt`.
+ */
+static void bmt_memprof_measure(uint8_t* base, size_t ws, bmt_memprof_point_t* pt) {
+    uint32_t reps = (uint32_t)(BMT_MEMPROF_MIN_BYTES / ws);
+    if (reps == 0) reps = 1;
+
+    // Latency: dependent loads through a random cycle defeat the prefetchers
+    size_t nodes = ws / BMT_MEMPROF_LINE_SIZE;
+    void** chain = bmt_memprof_build_chain(base, nodes);
+    uint32_t loads = (uint32_t)((nodes > BMT_MEMPROF_MIN_BYTES / BMT_MEMPROF_LINE_SIZE) ? nodes : BMT_MEMPROF_MIN_BYTES / BMT_MEMPROF_LINE_SIZE);
+    loads = (loads + 7u) & ~7u;
+    uint64_t best = UINT64_MAX;
+    (void)bmt_memprof_chase(chain, (uint32_t)((nodes + 7u) & ~7u)); // Warm-up: one lap
+    for (int r = 0; r < BMT_MEMPROF_REPS; ++r) {
+        uint64_t t = bmt_memprof_chase(chain, loads);
+        if (t < best) best = t;
+    }
+    pt->working_set = (uint32_t)ws;
+    pt->latency_ps = (uint32_t)(bmt_ticks_to_ps(best) / loads);
+
+    // Bandwidth
+    best = UINT64_MAX;
+    for (int r = 0; r < BMT_MEMPROF_REPS; ++r) {
+        uint64_t t = bmt_memprof_read((const uint64_t*)base, ws, reps);
+        if (t < best) best = t;
+    }
+    pt->read_mbps = bmt_memprof_mbps((uint64_t)ws * reps, best);
+
+    best = UINT64_MAX;
+    for (int r = 0; r < BMT_MEMPROF_REPS; ++r) {
+        uint64_t t = bmt_memprof_write((uint64_t*)base, ws, reps);
+        if (t < best) best = t;
+    }
+    pt->write_mbps = bmt_memprof_mbps((uint64_t)ws * reps, best);
+
+    best = UINT64_MAX;
+    for (int r = 0; r < BMT_MEMPROF_REPS; ++r) {
+        uint64_t t = bmt_memprof_copy((uint64_t*)base, ws, reps);
+        if (t < best) best = t;
+    }
+    pt->copy_mbps = bmt_memprof_mbps((uint64_t)(ws / 2) * reps, best);
+}
+
+/**
+ * @internal
+ * @brief Prints one "[ MEMPROF  ]" line.
+ */
+static void bmt_memprof_report(const char* region, const bmt_memprof_point_t* pt) {
+    bmt_platform_puts("[ MEMPROF  ] region=");
+    bmt_platform_puts(region);
+    bmt_platform_puts(" ws=");
+    bmt_print_u64(pt->working_set);
+    bmt_platform_puts(" latency_ns=");
+    bmt_print_fixed3(pt->latency_ps);
+    bmt_platform_puts(" read_mbps=");
+    bmt_print_u64(pt->read_mbps);
+    bmt_platform_puts(" write_mbps=");
+    bmt_print_u64(pt->write_mbps);
+    bmt_platform_puts(" copy_mbps=");
+    bmt_print_u64(pt->copy_mbps);
+    bmt_platform_puts("\r\n");
+}
+
+const bmt_memprof_profile_t* bmt_memprof_run(const char* region, void* buffer, size_t size, size_t min_working_set) {
+    bmt_memprof_profile_t* profile = (bmt_memprof_profile_t*)bmt_memprof_find(region);
+    size_t ws = 1024;
+
+    if (!profile) {
+        profile = (g_bmt_memprof_count < BMT_MEMPROF_MAX_REGIONS) ? &g_bmt_memprof_profiles[g_bmt_memprof_count++] : &g_bmt_memprof_scratch;
+    }
+    profile->region = region;
+    profile->num_points = 0;
+
+    while (ws < min_working_set) ws <<= 1;
+    for (; ws <= size && profile->num_points < BMT_MEMPROF_MAX_POINTS; ws <<= 1) {
+        bmt_memprof_point_t* pt = &profile->points[profile->num_points++];
+        bmt_memprof_measure((uint8_t*)buffer, ws, pt);
+        bmt_memprof_report(region, pt);
+    }
+    return (profile == &g_bmt_memprof_scratch) ? NULL : profile;
+}
+
+const bmt_memprof_profile_t* bmt_memprof_find(const char* region) {
+    for (uint32_t i = 0; i < g_bmt_memprof_count; ++i) {
+        if (strcmp(g_bmt_memprof_profiles[i].region, region) == 0) {
+            return &g_bmt_memprof_profiles[i];
+        }
+    }
+    return NULL;
+}
+
+const bmt_memprof_point_t* bmt_memprof_lookup(const bmt_memprof_profile_t* profile, size_t bytes) {
+    if (!profile || profile->num_points == 0) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < profile->num_points; ++i) {
+        if (profile->points[i].working_set >= bytes) {
+            return &profile->points[i];
+        }
+    }
+    return &profile->points[profile->num_points - 1];
+}
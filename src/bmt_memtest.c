@@ -0,0 +1,426 @@
+// src/bmt_memtest.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_memtest.h"
+#include "baremetal_test.h"
+#include "bmt_internal.h"
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Weak default: no regions to test.
+ * @return false.
+ */
+__attribute__((weak)) bool bmt_platform_memtest_region(uint32_t index, const char** name, void** base, size_t* size) {
+    (void)index;
+    (void)name;
+    (void)base;
+    (void)size;
+    return false;
+}
+
+/**
+ * @internal
+ * @brief Unit of every access: the widest load/store of the target. The helpers below are
+ *        the only code that depends on it.
+ */
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+typedef uint64x2_t bmt_memtest_cell_t;
+
+static inline bmt_memtest_cell_t bmt_memtest_pair(uint64_t lo, uint64_t hi) {
+    return vcombine_u64(vcreate_u64(lo), vcreate_u64(hi));
+}
+
+static inline bmt_memtest_cell_t bmt_memtest_load(const bmt_memtest_cell_t* p) {
+    return vld1q_u64((const uint64_t*)p);
+}
+
+static inline void bmt_memtest_store(bmt_memtest_cell_t* p, bmt_memtest_cell_t v) {
+    vst1q_u64((uint64_t*)p, v);
+}
+
+static inline bool bmt_memtest_differs(bmt_memtest_cell_t a, bmt_memtest_cell_t b) {
+    uint64x2_t x = veorq_u64(a, b); // No 64-bit compare on ARMv7 NEON
+    return vget_lane_u64(vorr_u64(vget_low_u64(x), vget_high_u64(x)), 0) != 0;
+}
+#elif defined(__SSE2__)
+typedef __m128i bmt_memtest_cell_t;
+
+static inline bmt_memtest_cell_t bmt_memtest_pair(uint64_t lo, uint64_t hi) {
+    return _mm_set_epi64x((long long)hi, (long long)lo);
+}
+
+static inline bmt_memtest_cell_t bmt_memtest_load(const bmt_memtest_cell_t* p) {
+    return _mm_load_si128(p);
+}
+
+static inline void bmt_memtest_store(bmt_memtest_cell_t* p, bmt_memtest_cell_t v) {
+    _mm_store_si128(p, v);
+}
+
+static inline bool bmt_memtest_differs(bmt_memtest_cell_t a, bmt_memtest_cell_t b) {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF;
+}
+#else
+typedef uint64_t bmt_memtest_cell_t;
+
+static inline bmt_memtest_cell_t bmt_memtest_pair(uint64_t lo, uint64_t hi) {
+    (void)hi;
+    return lo;
+}
+
+static inline bmt_memtest_cell_t bmt_memtest_load(const bmt_memtest_cell_t* p) {
+    return *p;
+}
+
+static inline void bmt_memtest_store(bmt_memtest_cell_t* p, bmt_memtest_cell_t v) {
+    *p = v;
+}
+
+static inline bool bmt_memtest_differs(bmt_memtest_cell_t a, bmt_memtest_cell_t b) {
+    return a != b;
+}
+#endif
+
+/**
+ * @internal
+ * @brief Bytes per cell, and 64-bit words per cell.
+ */
+#define BMT_MEMTEST_CELL_BYTES ((uint32_t)sizeof(bmt_memtest_cell_t))
+#define BMT_MEMTEST_CELL_WORDS (BMT_MEMTEST_CELL_BYTES / 8u)
+
+/**
+ * @internal
+ * @brief Keeps the compiler from carrying values or merging accesses across march elements.
+ */
+#define BMT_MEMTEST_BARRIER() __asm__ volatile("" ::: "memory")
+
+/**
+ * @internal
+ * @brief Moving inversions patterns.
+ */
+static const uint64_t g_bmt_memtest_patterns[] = {
+    0x5555555555555555ULL, 0x3333333333333333ULL, 0x0F0F0F0F0F0F0F0FULL, 0x00FF00FF00FF00FFULL
+};
+
+/**
+ * @internal
+ * @brief Region under test and the result of the test in progress.
+ */
+typedef struct {
+    bmt_memtest_cell_t* cells;
+    size_t count;
+    bmt_memtest_result_t* result;
+} bmt_memtest_ctx_t;
+
+/**
+ * @internal
+ * @brief Same value in every 64-bit lane.
+ */
+static inline bmt_memtest_cell_t bmt_memtest_splat(uint64_t v) {
+    return bmt_memtest_pair(v, v);
+}
+
+/**
+ * @internal
+ * @brief Records the wrong words of a cell. Kept out of line: the loops only pay for the compare.
+ */
+__attribute__((noinline)) static void bmt_memtest_mismatch(bmt_memtest_ctx_t* ctx, const bmt_memtest_cell_t* p,
+                                                           bmt_memtest_cell_t expected, bmt_memtest_cell_t actual) {
+    uint64_t exp_words[BMT_MEMTEST_CELL_WORDS];
+    uint64_t act_words[BMT_MEMTEST_CELL_WORDS];
+    memcpy(exp_words, &expected, sizeof(exp_words));
+    memcpy(act_words, &actual, sizeof(act_words));
+    for (uint32_t w = 0; w < BMT_MEMTEST_CELL_WORDS; ++w) {
+        if (exp_words[w] != act_words[w]) {
+            if (ctx->result->errors == 0) {
+                ctx->result->first_addr = (uintptr_t)p + w * 8u;
+                ctx->result->expected = exp_words[w];
+                ctx->result->actual = act_words[w];
+            }
+            ctx->result->errors++;
+        }
+    }
+}
+
+/**
+ * @internal
+ * @brief Checks one cell against `expected`.
+ */
+static inline void bmt_memtest_check(bmt_memtest_ctx_t* ctx, const bmt_memtest_cell_t* p, bmt_memtest_cell_t expected) {
+    bmt_memtest_cell_t v = bmt_memtest_load(p);
+    if (bmt_memtest_differs(v, expected)) {
+        bmt_memtest_mismatch(ctx, p, expected, v);
+    }
+}
+
+/**
+ * @internal
+ * @brief Ascending ⇑(w value).
+ */
+static void bmt_memtest_fill(bmt_memtest_ctx_t* ctx, uint64_t value) {
+    bmt_memtest_cell_t v = bmt_memtest_splat(value);
+    bmt_memtest_cell_t* p = ctx->cells;
+    for (size_t i = 0; i < ctx->count; ++i) {
+        bmt_memtest_store(&p[i], v);
+    }
+    ctx->result->bytes += (uint64_t)ctx->count * BMT_MEMTEST_CELL_BYTES;
+    BMT_MEMTEST_BARRIER();
+}
+
+/**
+ * @internal
+ * @brief Ascending ⇑(r expected).
+ */
+static void bmt_memtest_verify(bmt_memtest_ctx_t* ctx, uint64_t expected) {
+    bmt_memtest_cell_t e = bmt_memtest_splat(expected);
+    const bmt_memtest_cell_t* p = ctx->cells;
+    for (size_t i = 0; i < ctx->count; ++i) {
+        bmt_memtest_check(ctx, &p[i], e);
+    }
+    ctx->result->bytes += (uint64_t)ctx->count * BMT_MEMTEST_CELL_BYTES;
+    BMT_MEMTEST_BARRIER();
+}
+
+/**
+ * @internal
+ * @brief March element (r expected, w value), ascending (⇑) or descending (⇓).
+ */
+static void bmt_memtest_read_write(bmt_memtest_ctx_t* ctx, bool ascending, uint64_t expected, uint64_t value) {
+    bmt_memtest_cell_t e = bmt_memtest_splat(expected);
+    bmt_memtest_cell_t v = bmt_memtest_splat(value);
+    bmt_memtest_cell_t* p = ctx->cells;
+    if (ascending) {
+        for (size_t i = 0; i < ctx->count; ++i) {
+            bmt_memtest_check(ctx, &p[i], e);
+            bmt_memtest_store(&p[i], v);
+        }
+    } else {
+        for (size_t i = ctx->count; i-- > 0;) {
+            bmt_memtest_check(ctx, &p[i], e);
+            bmt_memtest_store(&p[i], v);
+        }
+    }
+    ctx->result->bytes += 2u * (uint64_t)ctx->count * BMT_MEMTEST_CELL_BYTES;
+    BMT_MEMTEST_BARRIER();
+}
+
+/**
+ * @internal
+ * @brief Walking ones and zeros through the first cell (data lines), then the address lines:
+ *        a pattern at every power-of-two cell offset, and the antipattern written at one
+ *        offset at a time must not show up at any other.
+ */
+static void bmt_memtest_walking_ones(bmt_memtest_ctx_t* ctx) {
+    bmt_memtest_cell_t* p = ctx->cells;
+    const uint64_t pattern = 0xAAAAAAAAAAAAAAAAULL;
+    const uint64_t antipattern = ~pattern;
+
+    for (uint32_t bit = 0; bit < 64; ++bit) {
+        uint64_t one = 1ULL << bit;
+        bmt_memtest_store(&p[0], bmt_memtest_splat(one));
+        BMT_MEMTEST_BARRIER();
+        bmt_memtest_check(ctx, &p[0], bmt_memtest_splat(one));
+        bmt_memtest_store(&p[0], bmt_memtest_splat(~one));
+        BMT_MEMTEST_BARRIER();
+        bmt_memtest_check(ctx, &p[0], bmt_memtest_splat(~one));
+    }
+    ctx->result->bytes += 4u * 64u * BMT_MEMTEST_CELL_BYTES;
+
+    bmt_memtest_store(&p[0], bmt_memtest_splat(pattern));
+    for (size_t off = 1; off < ctx->count; off <<= 1) {
+        bmt_memtest_store(&p[off], bmt_memtest_splat(pattern));
+        ctx->result->bytes += BMT_MEMTEST_CELL_BYTES;
+    }
+    BMT_MEMTEST_BARRIER();
+    // Address line stuck high: writing offset 0 lands on another offset
+    bmt_memtest_store(&p[0], bmt_memtest_splat(antipattern));
+    BMT_MEMTEST_BARRIER();
+    for (size_t off = 1; off < ctx->count; off <<= 1) {
+        bmt_memtest_check(ctx, &p[off], bmt_memtest_splat(pattern));
+        ctx->result->bytes += BMT_MEMTEST_CELL_BYTES;
+    }
+    bmt_memtest_store(&p[0], bmt_memtest_splat(pattern));
+    // Address line stuck low or shorted: writing one offset lands on offset 0 or another one
+    for (size_t test = 1; test < ctx->count; test <<= 1) {
+        bmt_memtest_store(&p[test], bmt_memtest_splat(antipattern));
+        BMT_MEMTEST_BARRIER();
+        bmt_memtest_check(ctx, &p[0], bmt_memtest_splat(pattern));
+        for (size_t off = 1; off < ctx->count; off <<= 1) {
+            if (off != test) {
+                bmt_memtest_check(ctx, &p[off], bmt_memtest_splat(pattern));
+                ctx->result->bytes += BMT_MEMTEST_CELL_BYTES;
+            }
+        }
+        bmt_memtest_store(&p[test], bmt_memtest_splat(pattern));
+        BMT_MEMTEST_BARRIER();
+        ctx->result->bytes += 3u * BMT_MEMTEST_CELL_BYTES;
+    }
+}
+
+/**
+ * @internal
+ * @brief Address-in-address: each cell holds its address (and its complement in the other
+ *        lanes), then the complement of that.
+ */
+static void bmt_memtest_address(bmt_memtest_ctx_t* ctx) {
+    bmt_memtest_cell_t* p = ctx->cells;
+    for (int pass = 0; pass < 2; ++pass) {
+        uint64_t flip = pass ? ~0ULL : 0;
+        for (size_t i = 0; i < ctx->count; ++i) {
+            uint64_t a = (uint64_t)(uintptr_t)&p[i];
+            bmt_memtest_store(&p[i], bmt_memtest_pair(a ^ flip, ~a ^ flip));
+        }
+        BMT_MEMTEST_BARRIER();
+        for (size_t i = 0; i < ctx->count; ++i) {
+            uint64_t a = (uint64_t)(uintptr_t)&p[i];
+            bmt_memtest_check(ctx, &p[i], bmt_memtest_pair(a ^ flip, ~a ^ flip));
+        }
+        BMT_MEMTEST_BARRIER();
+        ctx->result->bytes += 2u * (uint64_t)ctx->count * BMT_MEMTEST_CELL_BYTES;
+    }
+}
+
+/**
+ * @internal
+ * @brief March C-.
+ */
+static void bmt_memtest_march_c_minus(bmt_memtest_ctx_t* ctx) {
+    const uint64_t zero = 0, one = ~0ULL;
+    bmt_memtest_fill(ctx, zero);
+    bmt_memtest_read_write(ctx, true, zero, one);
+    bmt_memtest_read_write(ctx, true, one, zero);
+    bmt_memtest_read_write(ctx, false, zero, one);
+    bmt_memtest_read_write(ctx, false, one, zero);
+    bmt_memtest_verify(ctx, zero);
+}
+
+/**
+ * @internal
+ * @brief Moving inversions, once per pattern.
+ */
+static void bmt_memtest_moving_inversions(bmt_memtest_ctx_t* ctx) {
+    for (size_t k = 0; k < sizeof(g_bmt_memtest_patterns) / sizeof(g_bmt_memtest_patterns[0]); ++k) {
+        uint64_t pat = g_bmt_memtest_patterns[k];
+        bmt_memtest_fill(ctx, pat);
+        bmt_memtest_read_write(ctx, true, pat, ~pat);
+        bmt_memtest_read_write(ctx, false, ~pat, pat);
+    }
+    bmt_memtest_verify(ctx, g_bmt_memtest_patterns[sizeof(g_bmt_memtest_patterns) / sizeof(g_bmt_memtest_patterns[0]) - 1]);
+}
+
+/**
+ * @internal
+ * @brief Formats `val` as "0x" followed by `digits` hex digits.
+ */
+static void bmt_memtest_hex(uint64_t val, uint32_t digits, char* buf) {
+    static const char hex[] = "0123456789abcdef";
+    buf[0] = '0';
+    buf[1] = 'x';
+    for (uint32_t i = 0; i < digits; ++i) {
+        buf[2 + i] = hex[(val >> (4u * (digits - 1u - i))) & 0xFu];
+    }
+    buf[2 + digits] = '\0';
+}
+
+/**
+ * @internal
+ * @brief Prints the "[ MEMTEST  ]" line of a test and reports its errors as a failure.
+ */
+static void bmt_memtest_report(const char* region, size_t size, const bmt_memtest_result_t* r) {
+    char addr[2 + 2 * sizeof(uintptr_t) + 1];
+    char word[2 + 16 + 1];
+
+    bmt_platform_puts("[ MEMTEST  ] region=");
+    bmt_platform_puts(region);
+    bmt_platform_puts(" algo=");
+    bmt_platform_puts(r->test);
+    bmt_platform_puts(" size=");
+    bmt_print_u64(size);
+    bmt_platform_puts(" cell=");
+    bmt_print_u64(BMT_MEMTEST_CELL_BYTES);
+    bmt_platform_puts(" errors=");
+    bmt_print_u64(r->errors);
+    bmt_platform_puts(" mbps=");
+    bmt_print_u64(r->mbps);
+    bmt_memtest_hex(r->first_addr, 2 * sizeof(uintptr_t), addr);
+    if (r->errors) {
+        bmt_platform_puts(" first_addr=");
+        bmt_platform_puts(addr);
+        bmt_memtest_hex(r->expected, 16, word);
+        bmt_platform_puts(" expected=");
+        bmt_platform_puts(word);
+        bmt_memtest_hex(r->actual, 16, word);
+        bmt_platform_puts(" actual=");
+        bmt_platform_puts(word);
+    }
+    bmt_platform_puts("\r\n");
+
+    if (r->errors) {
+        bmt_report_failure(__FILE__, __LINE__, "MEMTEST", r->test, "region %s: %ld wrong words, first at %s",
+                           region, (long)(r->errors > 0x7FFFFFFFu ? 0x7FFFFFFFu : r->errors), addr);
+        g_bmt_current_test_failed_expect = true;
+    }
+}
+
+uint64_t bmt_memtest_run(const char* region, void* base, size_t size, uint32_t tests,
+                         bmt_memtest_result_t* results) {
+    static const struct {
+        const char* name;
+        void (*run)(bmt_memtest_ctx_t* ctx);
+    } k_tests[BMT_MEMTEST_NUM_TESTS] = {
+        { "walking_ones", bmt_memtest_walking_ones },
+        { "address", bmt_memtest_address },
+        { "march_c-", bmt_memtest_march_c_minus },
+        { "moving_inv", bmt_memtest_moving_inversions },
+    };
+    uintptr_t start = ((uintptr_t)base + BMT_MEMTEST_CELL_BYTES - 1u) & ~(uintptr_t)(BMT_MEMTEST_CELL_BYTES - 1u);
+    size_t skipped = (size_t)(start - (uintptr_t)base);
+    bmt_memtest_result_t scratch;
+    bmt_memtest_ctx_t ctx;
+    uint64_t total = 0;
+
+    ctx.cells = (bmt_memtest_cell_t*)start;
+    ctx.count = (size > skipped) ? (size - skipped) / BMT_MEMTEST_CELL_BYTES : 0;
+    if (ctx.count == 0) {
+        return 0;
+    }
+    for (uint32_t t = 0; t < BMT_MEMTEST_NUM_TESTS; ++t) {
+        bmt_memtest_result_t* r = results ? &results[t] : &scratch;
+        memset(r, 0, sizeof(*r));
+        if (!(tests & (1u << t))) {
+            continue;
+        }
+        r->test = k_tests[t].name;
+        ctx.result = r;
+        uint64_t t0 = bmt_platform_get_hires_ticks();
+        k_tests[t].run(&ctx);
+        uint64_t ps = bmt_ticks_to_ps(bmt_platform_get_hires_ticks() - t0);
+        r->mbps = ps ? (uint32_t)((r->bytes * 1000000ULL) / ps) : 0;
+        bmt_memtest_report(region, ctx.count * BMT_MEMTEST_CELL_BYTES, r);
+        total += r->errors;
+    }
+    return total;
+}
+
+uint64_t bmt_memtest_run_regions(uint32_t tests) {
+    const char* name;
+    void* base;
+    size_t size;
+    uint64_t total = 0;
+    for (uint32_t i = 0; bmt_platform_memtest_region(i, &name, &base, &size); ++i) {
+        total += bmt_memtest_run(name, base, size, tests, NULL);
+    }
+    return total;
+}
@@ -0,0 +1,66 @@
+// src/bmt_mock.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_mock.h"
+#include <string.h>
+
+/**
+ * @internal
+ * @brief State of a registered mock, zeroed by bmt_mock_reset_all().
+ */
+typedef struct {
+    const char* name;
+    void* state;
+    size_t size;
+} bmt_mock_entry_t;
+
+static bmt_mock_entry_t g_bmt_mocks[BMT_MOCK_MAX_MOCKS];
+static uint32_t g_bmt_mock_count = 0;
+
+/**
+ * @internal
+ * @brief Names of the mocks called in this test, in call order (the first BMT_MOCK_LOG_SIZE).
+ */
+static const char* g_bmt_mock_log[BMT_MOCK_LOG_SIZE];
+static uint32_t g_bmt_mock_log_len = 0;
+
+void bmt_mock_register(const char* name, void* state, size_t size) {
+    if (g_bmt_mock_count < BMT_MOCK_MAX_MOCKS) {
+        g_bmt_mocks[g_bmt_mock_count].name = name;
+        g_bmt_mocks[g_bmt_mock_count].state = state;
+        g_bmt_mocks[g_bmt_mock_count].size = size;
+        g_bmt_mock_count++;
+    } else {
+        bmt_platform_puts("ERROR: Max mocks reached. Increase BMT_MOCK_MAX_MOCKS.\r\n");
+    }
+}
+
+uint32_t bmt_mock_record(const char* name, uint32_t* call_count) {
+    if (g_bmt_mock_log_len < BMT_MOCK_LOG_SIZE) {
+        g_bmt_mock_log[g_bmt_mock_log_len++] = name;
+    }
+    return (*call_count)++;
+}
+
+void bmt_mock_reset_all(void) {
+    for (uint32_t i = 0; i < g_bmt_mock_count; ++i) {
+        memset(g_bmt_mocks[i].state, 0, g_bmt_mocks[i].size);
+    }
+    g_bmt_mock_log_len = 0;
+}
+
+bool bmt_mock_called_in_order(const char* const* names, uint32_t count) {
+    uint32_t next = 0;
+    for (uint32_t i = 0; i < g_bmt_mock_log_len && next < count; ++i) {
+        if (strcmp(g_bmt_mock_log[i], names[next]) == 0) {
+            next++;
+        }
+    }
+    return next == count;
+}
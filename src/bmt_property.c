@@ -0,0 +1,419 @@
+// src/bmt_property.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_property.h"
+#include "bmt_internal.h"
+#include <string.h>
+
+/**
+ * @brief Weak default: the seed given at build time with `-DBMT_PROP_SEED=...`, or the
+ *        high-resolution timer so every run explores different cases.
+ * @return The base seed.
+ */
+__attribute__((weak)) uint64_t bmt_platform_prop_seed(void) {
+#ifdef BMT_PROP_SEED
+    return (uint64_t)BMT_PROP_SEED;
+#else
+    return bmt_platform_get_hires_ticks();
+#endif
+}
+
+/**
+ * @brief Weak default: the case seed given at build time with `-DBMT_PROP_REPLAY=...`, or 0 (no replay).
+ * @return The case seed to replay, or 0.
+ */
+__attribute__((weak)) uint64_t bmt_platform_prop_replay(void) {
+#ifdef BMT_PROP_REPLAY
+    return (uint64_t)BMT_PROP_REPLAY;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @internal
+ * @brief How the generators get their values.
+ */
+typedef enum {
+    BMT_PROP_GENERATE,  /**< From the PRNG (recorded in `trace`). */
+    BMT_PROP_REPLAY     /**< From `replay` (recorded in `trace` after clamping). */
+} bmt_prop_mode_t;
+
+/**
+ * @internal
+ * @brief Generator state. Static: nothing is allocated per case.
+ */
+static struct {
+    bmt_prop_mode_t mode;
+    bool verbose;               /**< Generators print their values (final replay). */
+    uint32_t s[4];              /**< xoshiro128** state. */
+    uint32_t pos;               /**< Draws made in the current case. */
+    uint32_t replay_len;
+    uint32_t replay[BMT_PROP_MAX_CHOICES];
+    uint32_t trace[BMT_PROP_MAX_CHOICES];
+    uint32_t best[BMT_PROP_MAX_CHOICES];
+} g_bmt_prop;
+
+/**
+ * @internal
+ * @brief splitmix64 step, used to derive case seeds and to seed xoshiro128**.
+ */
+static uint64_t bmt_prop_splitmix(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void bmt_prop_seed(uint64_t seed) {
+    uint64_t a = bmt_prop_splitmix(&seed);
+    uint64_t b = bmt_prop_splitmix(&seed);
+    g_bmt_prop.s[0] = (uint32_t)a;
+    g_bmt_prop.s[1] = (uint32_t)(a >> 32);
+    g_bmt_prop.s[2] = (uint32_t)b;
+    g_bmt_prop.s[3] = (uint32_t)(b >> 32) | 1u;  // never all zero
+}
+
+/**
+ * @internal
+ * @brief xoshiro128** (Blackman & Vigna): 32-bit output, only shifts, rotates and one
+ *        multiply, so it is cheap on 32-bit cores without a 64-bit multiplier.
+ */
+static uint32_t bmt_prop_next(void) {
+    uint32_t* s = g_bmt_prop.s;
+    uint32_t x = s[1] * 5u;
+    uint32_t result = ((x << 7) | (x >> 25)) * 9u;
+    uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+    return result;
+}
+
+/**
+ * @internal
+ * @brief One recorded draw: an index in [0, n), where a smaller index means a simpler value.
+ *
+ * When generating, about one draw in eight picks one of the `special` indices (boundaries)
+ * instead of a uniform one. When replaying, the recorded index is clamped to the range.
+ */
+static uint32_t bmt_prop_choice(uint64_t n, const uint32_t* special, uint32_t num_special) {
+    uint32_t k = 0;
+    if (g_bmt_prop.pos >= BMT_PROP_MAX_CHOICES) {
+        return 0;
+    }
+    if (g_bmt_prop.mode == BMT_PROP_REPLAY) {
+        k = (g_bmt_prop.pos < g_bmt_prop.replay_len) ? g_bmt_prop.replay[g_bmt_prop.pos] : 0;
+        if (k >= n) k = (uint32_t)(n - 1u);
+    } else {
+        uint32_t r = bmt_prop_next();
+        if ((r & 7u) == 0 && num_special > 0) {
+            k = special[(r >> 3) % num_special];
+        } else {
+            k = (uint32_t)(((uint64_t)bmt_prop_next() * n) >> 32);
+        }
+    }
+    g_bmt_prop.trace[g_bmt_prop.pos++] = k;
+    return k;
+}
+
+/**
+ * @internal
+ * @brief Maps index `k` to a value of [lo, hi], alternating around `origin`
+ *        (origin, origin + 1, origin - 1, origin + 2...) until one side runs out.
+ */
+static int64_t bmt_prop_decode(uint32_t k, int64_t lo, int64_t hi, int64_t origin) {
+    uint64_t up = (uint64_t)(hi - origin), down = (uint64_t)(origin - lo);
+    uint64_t m = (up < down) ? up : down;
+    if (k <= 2u * m) {
+        return (k & 1u) ? origin + (int64_t)((k + 1u) / 2u) : origin - (int64_t)(k / 2u);
+    }
+    uint64_t rest = (uint64_t)k - 2u * m;
+    return (up > down) ? origin + (int64_t)(m + rest) : origin - (int64_t)(m + rest);
+}
+
+/**
+ * @internal
+ * @brief Inverse of bmt_prop_decode().
+ */
+static uint32_t bmt_prop_encode(int64_t v, int64_t lo, int64_t hi, int64_t origin) {
+    uint64_t up = (uint64_t)(hi - origin), down = (uint64_t)(origin - lo);
+    uint64_t m = (up < down) ? up : down;
+    uint64_t d = (v >= origin) ? (uint64_t)(v - origin) : (uint64_t)(origin - v);
+    if (d == 0) return 0;
+    if (d <= m) return (uint32_t)((v > origin) ? 2u * d - 1u : 2u * d);
+    return (uint32_t)(2u * m + (d - m));
+}
+
+/**
+ * @internal
+ * @brief Prints a signed 64-bit value.
+ */
+static void bmt_prop_print_i64(int64_t v) {
+    if (v < 0) {
+        bmt_platform_putchar('-');
+        bmt_print_u64((uint64_t)0 - (uint64_t)v);
+    } else {
+        bmt_print_u64((uint64_t)v);
+    }
+}
+
+int64_t bmt_prop_int(const char* name, int64_t lo, int64_t hi) {
+    if (hi < lo) hi = lo;
+    if ((uint64_t)(hi - lo) > 0xFFFFFFFFULL) hi = lo + 0xFFFFFFFFLL;  // indices are 32-bit
+    int64_t origin = (lo > 0) ? lo : ((hi < 0) ? hi : 0);
+    uint32_t special[5];
+    uint32_t num_special = 0;
+    special[num_special++] = 0;
+    special[num_special++] = bmt_prop_encode(lo, lo, hi, origin);
+    special[num_special++] = bmt_prop_encode(hi, lo, hi, origin);
+    if (origin < hi) special[num_special++] = bmt_prop_encode(origin + 1, lo, hi, origin);
+    if (origin > lo) special[num_special++] = bmt_prop_encode(origin - 1, lo, hi, origin);
+
+    int64_t v = bmt_prop_decode(bmt_prop_choice((uint64_t)(hi - lo) + 1u, special, num_special), lo, hi, origin);
+    if (g_bmt_prop.verbose) {
+        bmt_platform_puts("[ PROP VAL ] ");
+        bmt_platform_puts(name);
+        bmt_platform_putchar('=');
+        bmt_prop_print_i64(v);
+        bmt_platform_puts("\r\n");
+    }
+    return v;
+}
+
+size_t bmt_prop_buf(const char* name, uint8_t* buf, size_t max_len) {
+    static const uint32_t len_special[] = { 0, 1 };
+    static const uint32_t byte_special[] = { 0, 255, 1, 128, 127 };  // a byte's index is its value
+    size_t len = bmt_prop_choice((uint64_t)max_len + 1u, len_special, max_len ? 2u : 1u);
+    for (size_t i = 0; i < len; ++i) {
+        buf[i] = (uint8_t)bmt_prop_choice(256u, byte_special, 5u);
+    }
+    if (g_bmt_prop.verbose) {
+        bmt_platform_puts("[ PROP VAL ] ");
+        bmt_platform_puts(name);
+        bmt_platform_putchar('=');
+        bmt_print_hex(buf, len);
+        bmt_platform_puts(" len=");
+        bmt_print_u64(len);
+        bmt_platform_puts("\r\n");
+    }
+    return len;
+}
+
+/**
+ * @internal
+ * @brief Runs one case with the runner's assertion jump redirected here.
+ * @return true if the property held (no ASSERT_* or EXPECT_* failed).
+ */
+static bool bmt_prop_exec(bmt_prop_case_func_t case_func) {
+    g_bmt_prop.pos = 0;
+    g_bmt_current_test_failed_expect = false;
+    if (bmt_setjmp(g_bmt_assert_jmp_buf) == 0) {
+        case_func();
+        return !g_bmt_current_test_failed_expect;
+    }
+    return false;
+}
+
+/**
+ * @internal
+ * @brief Whether the draws in `trace` are simpler than those in `best`: fewer of them, or as
+ *        many and lexicographically smaller. Only simpler failures are accepted, so shrinking
+ *        always terminates (a replay pads missing draws with zeros and may end up longer).
+ */
+static bool bmt_prop_simpler(const uint32_t* trace, uint32_t len, const uint32_t* best, uint32_t best_len) {
+    if (len != best_len) {
+        return len < best_len;
+    }
+    for (uint32_t i = 0; i < len; ++i) {
+        if (trace[i] != best[i]) {
+            return trace[i] < best[i];
+        }
+    }
+    return false;
+}
+
+/**
+ * @internal
+ * @brief Replays `candidate[0 .. len - 1]`. If the property still fails and the draws it
+ *        actually made are simpler, they become the new best counterexample.
+ */
+static bool bmt_prop_try(bmt_prop_case_func_t case_func, const uint32_t* candidate, uint32_t len,
+                         uint32_t* best_len, uint32_t* runs) {
+    (*runs)++;
+    g_bmt_prop.mode = BMT_PROP_REPLAY;
+    if (candidate != g_bmt_prop.replay) {
+        memcpy(g_bmt_prop.replay, candidate, len * sizeof(uint32_t));
+    }
+    g_bmt_prop.replay_len = len;
+    if (bmt_prop_exec(case_func) ||
+        !bmt_prop_simpler(g_bmt_prop.trace, g_bmt_prop.pos, g_bmt_prop.best, *best_len)) {
+        return false;
+    }
+    *best_len = g_bmt_prop.pos;
+    memcpy(g_bmt_prop.best, g_bmt_prop.trace, *best_len * sizeof(uint32_t));
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Shrinks the failing draws in `best`: drops draws from the end, deletes blocks of
+ *        draws, then lowers each draw (to 0, else by binary search), until nothing improves
+ *        or the run budget is spent.
+ * @return Number of successful shrink steps.
+ */
+static uint32_t bmt_prop_shrink(bmt_prop_case_func_t case_func, uint32_t* best_len) {
+    uint32_t runs = 0, shrinks = 0;
+    bool improved = true;
+    while (improved && runs < BMT_PROP_MAX_SHRINK_RUNS) {
+        improved = false;
+
+        for (uint32_t cut = *best_len / 2u; cut > 0 && runs < BMT_PROP_MAX_SHRINK_RUNS; cut /= 2u) {
+            if (bmt_prop_try(case_func, g_bmt_prop.best, *best_len - cut, best_len, &runs)) {
+                shrinks++;
+                improved = true;
+            }
+        }
+
+        for (uint32_t block = 4; block > 0; block /= 2u) {
+            for (uint32_t i = 0; i + block <= *best_len && runs < BMT_PROP_MAX_SHRINK_RUNS; ) {
+                uint32_t len = *best_len;
+                memcpy(g_bmt_prop.replay, g_bmt_prop.best, i * sizeof(uint32_t));
+                memcpy(&g_bmt_prop.replay[i], &g_bmt_prop.best[i + block], (len - i - block) * sizeof(uint32_t));
+                if (bmt_prop_try(case_func, g_bmt_prop.replay, len - block, best_len, &runs)) {
+                    shrinks++;
+                    improved = true;
+                } else {
+                    i++;
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < *best_len && runs < BMT_PROP_MAX_SHRINK_RUNS; ++i) {
+            if (g_bmt_prop.best[i] == 0) continue;
+            memcpy(g_bmt_prop.replay, g_bmt_prop.best, *best_len * sizeof(uint32_t));
+            g_bmt_prop.replay[i] = 0;
+            if (bmt_prop_try(case_func, g_bmt_prop.replay, *best_len, best_len, &runs)) {
+                shrinks++;
+                improved = true;
+                continue;
+            }
+            // Smallest failing index, assuming failure is monotonic in the magnitude of the
+            // value: first among indices of the same parity (same sign for integers), then all
+            for (uint32_t stride = 2; stride > 0; --stride) {
+                uint32_t hi = g_bmt_prop.best[i] / stride;
+                uint32_t lo = 0;
+                while (hi - lo > 1u && runs < BMT_PROP_MAX_SHRINK_RUNS && i < *best_len) {
+                    uint32_t mid = lo + (hi - lo) / 2u;
+                    memcpy(g_bmt_prop.replay, g_bmt_prop.best, *best_len * sizeof(uint32_t));
+                    g_bmt_prop.replay[i] = mid * stride + g_bmt_prop.best[i] % stride;
+                    if (bmt_prop_try(case_func, g_bmt_prop.replay, *best_len, best_len, &runs)) {
+                        shrinks++;
+                        improved = true;
+                        hi = (i < *best_len) ? g_bmt_prop.best[i] / stride : 0;
+                    } else {
+                        lo = mid;
+                    }
+                }
+            }
+        }
+    }
+    return shrinks;
+}
+
+void bmt_prop_run(const char* name, bmt_prop_case_func_t case_func, uint32_t cases) {
+    bmt_jmp_buf runner_jmp;
+    memcpy(runner_jmp, g_bmt_assert_jmp_buf, sizeof(bmt_jmp_buf));
+    bool expect_failed = g_bmt_current_test_failed_expect;
+    bool unwinds = g_bmt_assert_unwinds;
+    g_bmt_assert_unwinds = false;  // ASSERT_* of the cases must come back to bmt_prop_exec()
+
+    // Case seeds form a chain from the base seed and the property name
+    uint64_t replay = bmt_platform_prop_replay();
+    uint64_t seed = replay;
+    if (seed == 0) {
+        uint64_t base = bmt_platform_prop_seed();
+        for (const char* p = name; *p; ++p) {
+            base = (base ^ (uint8_t)*p) * 0x100000001B3ULL;
+        }
+        seed = bmt_prop_splitmix(&base);
+    }
+    if (replay != 0) {
+        cases = 1;
+    }
+    uint64_t first_seed = seed;
+
+    bmt_report_mute(true);  // Failures are not printed while searching and shrinking
+    g_bmt_prop.verbose = false;
+    uint32_t failed_case = 0;
+    bool failed = false;
+    uint64_t start = bmt_platform_get_hires_ticks();
+    for (uint32_t i = 0; i < cases; ++i) {
+        g_bmt_prop.mode = BMT_PROP_GENERATE;
+        bmt_prop_seed(seed);
+        if (!bmt_prop_exec(case_func)) {
+            failed = true;
+            failed_case = i;
+            break;
+        }
+        uint64_t chain = seed;
+        seed = bmt_prop_splitmix(&chain);
+    }
+    uint64_t ticks = bmt_platform_get_hires_ticks() - start;
+
+    if (!failed) {
+        bmt_report_mute(false);
+        memcpy(g_bmt_assert_jmp_buf, runner_jmp, sizeof(bmt_jmp_buf));
+        g_bmt_current_test_failed_expect = expect_failed;
+        g_bmt_assert_unwinds = unwinds;
+        bmt_platform_puts("[ PROPERTY ] ");
+        bmt_platform_puts(name);
+        bmt_platform_puts(" cases=");
+        bmt_print_u64(cases);
+        bmt_platform_puts(" seed=");
+        bmt_print_u64(first_seed);
+        bmt_platform_puts(" ns_per_case=");
+        bmt_print_fixed3(cases ? bmt_ticks_to_ps(ticks) / cases : 0);
+        bmt_platform_puts("\r\n");
+        return;
+    }
+
+    uint32_t best_len = g_bmt_prop.pos;
+    memcpy(g_bmt_prop.best, g_bmt_prop.trace, best_len * sizeof(uint32_t));
+    uint32_t shrinks = bmt_prop_shrink(case_func, &best_len);
+
+    bmt_platform_puts("[ PROPERTY ] ");
+    bmt_platform_puts(name);
+    bmt_platform_puts(" failed case=");
+    bmt_print_u64(failed_case);
+    bmt_platform_puts(" seed=");
+    bmt_print_u64(seed);
+    bmt_platform_puts(" shrinks=");
+    bmt_print_u64(shrinks);
+    bmt_platform_puts("\r\n");
+
+    // Minimal counterexample, once more with its values and the normal failure report
+    bmt_report_mute(false);
+    g_bmt_prop.verbose = true;
+    g_bmt_prop.mode = BMT_PROP_REPLAY;
+    memcpy(g_bmt_prop.replay, g_bmt_prop.best, best_len * sizeof(uint32_t));
+    g_bmt_prop.replay_len = best_len;
+    if (bmt_prop_exec(case_func)) {
+        bmt_platform_puts("[ PROPERTY ] ");
+        bmt_platform_puts(name);
+        bmt_platform_puts(" flaky: the shrunk case passed when replayed\r\n");
+    }
+    g_bmt_prop.verbose = false;
+    memcpy(g_bmt_assert_jmp_buf, runner_jmp, sizeof(bmt_jmp_buf));
+    g_bmt_current_test_failed_expect = true;
+    g_bmt_assert_unwinds = unwinds;
+}
@@ -8,8 +8,8 @@
 // o en <https://opensource.org/licenses/MIT>.
 
 #include "baremetal_test.h"
-#include <stdio.h>
-#include <string.h>
+#include "bmt_internal.h"
+#include "bmt_mock.h"
 #include <stdarg.h>
 
 /**
@@ -29,7 +29,7 @@ static int g_bmt_test_count = 0;
  * @brief Jump buffer used by the BMT_ASSERT macros to immediately terminate a test
  *        upon assertion failure and return control to the test runner.
  */
-jmp_buf g_bmt_assert_jmp_buf;
+bmt_jmp_buf g_bmt_assert_jmp_buf;
 
 /**
  * @internal
@@ -38,6 +38,80 @@ jmp_buf g_bmt_assert_jmp_buf;
  */
 bool g_bmt_current_test_failed_expect = false;
 
+/**
+ * @internal
+ * @brief True while a C++ TEST body runs directly under the runner, so a failed ASSERT_* may
+ *        unwind it (BMT_CPP_ASSERT_MODE of baremetal_test.hpp) instead of longjmp-ing here.
+ *        Cleared before each test, in case a body was left by a longjmp.
+ */
+bool g_bmt_assert_unwinds = false;
+
+/**
+ * @internal
+ * @brief Set by bmt_report_mute(): bmt_report_failure() prints nothing.
+ */
+static bool g_bmt_report_muted = false;
+
+/**
+ * @internal
+ * @brief Defaults for the hooks of the optional modules, so that the runner links on its own
+ *        (e.g. a BMT_FREESTANDING image with just bmt_runner.c and bmt_string.c). Linking
+ *        bmt_stress.c, bmt_mock.c or bmt_vclock.c replaces them.
+ */
+__attribute__((weak)) bool bmt_stress_is_active(void) {
+    return false;
+}
+
+__attribute__((weak)) bool bmt_stress_report_begin(void) {
+    return true;
+}
+
+__attribute__((weak)) void bmt_stress_report_end(void) {
+}
+
+__attribute__((weak)) void bmt_stress_terminate(void) {
+}
+
+__attribute__((weak)) void bmt_mock_reset_all(void) {
+}
+
+__attribute__((weak)) void bmt_vclock_test_end(const char* suite, const char* name) {
+    (void)suite;
+    (void)name;
+}
+
+__attribute__((weak)) const char* bmt_platform_test_filter(void) {
+#ifdef BMT_TEST_FILTER
+    return BMT_TEST_FILTER;
+#else
+    return NULL;
+#endif
+}
+
+__attribute__((weak)) bool bmt_platform_cpu_info(bmt_platform_cpu_info_t* info) {
+    (void)info;
+    return false;
+}
+
+/**
+ * @internal
+ * @brief Start of `.note.gnu.build-id`, if the linker script defines it (see bmt_platform_build_id()).
+ */
+extern const uint8_t __bmt_build_id_note[] __attribute__((weak));
+
+__attribute__((weak)) const uint8_t* bmt_platform_build_id(size_t* size) {
+    const uint8_t* note = __bmt_build_id_note;
+    if (note == NULL) {
+        return NULL;
+    }
+    // ELF note: namesz, descsz, type (3 = NT_GNU_BUILD_ID), "GNU\0", then the ID
+    const uint32_t* header = (const uint32_t*)note;
+    if (header[2] != 3u) {
+        return NULL;
+    }
+    *size = header[1];
+    return note + 12u + ((header[0] + 3u) & ~3u);
+}
 
 /**
  * @internal
@@ -51,11 +125,11 @@ bool g_bmt_current_test_failed_expect = false;
  *            The buffer must be large enough to hold the converted string, including the null terminator
  *            and a potential negative sign.
  * @param radix The numerical base to use for the conversion. Currently, only 10 is supported.
- *              If any other radix is provided, the buffer will contain "radix_err".
+ *              If any other radix is provided, the buffer will contain "?".
  */
 static void bmt_itoa(long val, char* buf, int radix) {
-    if (radix != 10) { strcpy(buf, "radix_err"); return; }
-    if (val == 0) { strcpy(buf, "0"); return; }
+    if (radix != 10) { buf[0] = '?'; buf[1] = '\0'; return; }
+    if (val == 0) { buf[0] = '0'; buf[1] = '\0'; return; }
 
     char* p = buf;
     long t = val;
@@ -77,6 +151,18 @@ static void bmt_itoa(long val, char* buf, int radix) {
     }
 }
 
+/**
+ * @internal
+ * @brief Copies a name into a fixed-size field, truncating it and always terminating it.
+ */
+static void bmt_copy_name(char* dst, const char* src, size_t size) {
+    size_t i = 0;
+    for (; i + 1 < size && src[i] != '\0'; ++i) {
+        dst[i] = src[i];
+    }
+    dst[i] = '\0';
+}
+
 /**
  * @brief Registers a test case to be run by bmt_run_all_tests().
  *
@@ -93,10 +179,8 @@ static void bmt_itoa(long val, char* buf, int radix) {
  */
 void bmt_register_test(const char* suite_name, const char* test_name, bmt_test_func_ptr_t func) {
     if (g_bmt_test_count < BMT_MAX_TEST_CASES) {
-        strncpy(g_bmt_test_cases[g_bmt_test_count].suite_name, suite_name, BMT_MAX_SUITE_NAME_LEN - 1);
-        g_bmt_test_cases[g_bmt_test_count].suite_name[BMT_MAX_SUITE_NAME_LEN - 1] = '\0';
-        strncpy(g_bmt_test_cases[g_bmt_test_count].test_name, test_name, BMT_MAX_TEST_NAME_LEN - 1);
-        g_bmt_test_cases[g_bmt_test_count].test_name[BMT_MAX_TEST_NAME_LEN - 1] = '\0';
+        bmt_copy_name(g_bmt_test_cases[g_bmt_test_count].suite_name, suite_name, BMT_MAX_SUITE_NAME_LEN);
+        bmt_copy_name(g_bmt_test_cases[g_bmt_test_count].test_name, test_name, BMT_MAX_TEST_NAME_LEN);
         g_bmt_test_cases[g_bmt_test_count].func = func;
         g_bmt_test_cases[g_bmt_test_count].last_run_passed = false; // Default
         g_bmt_test_cases[g_bmt_test_count].duration_ms = 0;
@@ -106,6 +190,12 @@ void bmt_register_test(const char* suite_name, const char* test_name, bmt_test_f
     }
 }
 
+bool bmt_report_mute(bool muted) {
+    bool was_muted = g_bmt_report_muted;
+    g_bmt_report_muted = muted;
+    return was_muted;
+}
+
 /**
  * @brief Reports a test failure, typically called by assertion macros.
  *
@@ -123,8 +213,13 @@ void bmt_register_test(const char* suite_name, const char* test_name, bmt_test_f
  * @note Supports '%s' for strings and '%ld' for long integers in `msg_fmt`.
  */
 void bmt_report_failure(const char* file, int line, const char* assertion_type, const char* expression, const char* msg_fmt, ...) {
-    char buffer[256];
-
+    if (g_bmt_report_muted) {
+        return;
+    }
+    // During a stress test several cores can fail at once: serialize and rate-limit the reports
+    if (!bmt_stress_report_begin()) {
+        return;
+    }
     bmt_platform_puts(file);
     bmt_platform_putchar(':');
     char line_buf[12];
@@ -132,12 +227,11 @@ void bmt_report_failure(const char* file, int line, const char* assertion_type,
     bmt_platform_puts(line_buf);
     bmt_platform_puts(": Failure\r\n");
 
-    strcpy(buffer, "  "); // Indent
-    strcat(buffer, assertion_type);
-    strcat(buffer, "(");
-    strncat(buffer, expression, sizeof(buffer) - strlen(buffer) - 2);
-    strcat(buffer, ")\r\n");
-    bmt_platform_puts(buffer);
+    bmt_platform_puts("  "); // Indent
+    bmt_platform_puts(assertion_type);
+    bmt_platform_putchar('(');
+    bmt_platform_puts(expression);
+    bmt_platform_puts(")\r\n");
 
     if (msg_fmt) {
         bmt_platform_puts("    Message: ");
@@ -170,6 +264,7 @@ void bmt_report_failure(const char* file, int line, const char* assertion_type,
         va_end(args);
         bmt_platform_puts("\r\n");
     }
+    bmt_stress_report_end();
 }
 
 /**
@@ -180,21 +275,424 @@ void bmt_report_failure(const char* file, int line, const char* assertion_type,
  * skipping the remainder of the current test function.
  */
 void bmt_terminate_current_test(void) {
-    longjmp(g_bmt_assert_jmp_buf, 1);
+    if (bmt_stress_is_active()) {
+        bmt_stress_terminate(); // Ends only the body of the calling core
+    }
+    bmt_longjmp(g_bmt_assert_jmp_buf, 1);
+}
+
+/**
+ * @internal
+ * @brief Bounds of BMT_TEST_SECTION, defined by the linker only if some object places a test
+ *        descriptor there (both are NULL otherwise).
+ */
+extern const bmt_test_desc_t __start_bmt_tests[] __attribute__((weak));
+extern const bmt_test_desc_t __stop_bmt_tests[] __attribute__((weak));
+
+/**
+ * @internal
+ * @brief Registers the descriptors of one source file, [first, end), in `sequence` order (g++
+ *        emits them in reverse). Selection by the next larger key: no scratch memory.
+ */
+static void bmt_register_file_tests(const bmt_test_desc_t* first, const bmt_test_desc_t* end) {
+    const bmt_test_desc_t* prev = NULL;
+    for (const bmt_test_desc_t* n = first; n < end; ++n) {
+        const bmt_test_desc_t* next = NULL;
+        for (const bmt_test_desc_t* t = first; t < end; ++t) {
+            if ((prev == NULL || t->sequence > prev->sequence) && (next == NULL || t->sequence < next->sequence)) {
+                next = t;
+            }
+        }
+        bmt_register_test(next->suite_name, next->test_name, next->func);
+        prev = next;
+    }
+}
+
+/**
+ * @internal
+ * @brief Adds the tests of BMT_TEST_SECTION to the registered ones, once. The linker keeps the
+ *        descriptors of each object file together; each run is registered in declaration order.
+ */
+static void bmt_register_section_tests(void) {
+    static bool registered = false;
+    if (registered || __start_bmt_tests == NULL) {
+        return;
+    }
+    registered = true;
+    const bmt_test_desc_t* first = __start_bmt_tests;
+    for (const bmt_test_desc_t* t = first; t < __stop_bmt_tests; ++t) {
+        if (t + 1 == __stop_bmt_tests || t[1].unit != first->unit) {
+            bmt_register_file_tests(first, t + 1);
+            first = t + 1;
+        }
+    }
+}
+
+/**
+ * @internal
+ * @brief Matches `name` against the glob [pattern, end), where '*' is any run of characters
+ *        and '?' any single character. Recursion only nests at each '*' of the pattern.
+ */
+static bool bmt_glob_match(const char* pattern, const char* end, const char* name) {
+    if (pattern == end) {
+        return *name == '\0';
+    }
+    if (*pattern == '*') {
+        return bmt_glob_match(pattern + 1, end, name) || (*name != '\0' && bmt_glob_match(pattern, end, name + 1));
+    }
+    return *name != '\0' && (*pattern == '?' || *pattern == *name) && bmt_glob_match(pattern + 1, end, name + 1);
+}
+
+/**
+ * @internal
+ * @brief Keeps only the registered tests that match bmt_platform_test_filter(), in order.
+ */
+static void bmt_apply_test_filter(void) {
+    const char* filter = bmt_platform_test_filter();
+    if (filter == NULL || *filter == '\0') {
+        return;
+    }
+    char full_name[BMT_MAX_SUITE_NAME_LEN + BMT_MAX_TEST_NAME_LEN];
+    int kept = 0;
+    for (int i = 0; i < g_bmt_test_count; ++i) {
+        bmt_copy_name(full_name, g_bmt_test_cases[i].suite_name, BMT_MAX_SUITE_NAME_LEN);
+        size_t len = bmt_strlen(full_name);
+        full_name[len] = '.';
+        bmt_copy_name(full_name + len + 1, g_bmt_test_cases[i].test_name, BMT_MAX_TEST_NAME_LEN);
+        const char* p = filter;
+        for (;;) {
+            const char* end = p;
+            while (*end != '\0' && *end != ':') {
+                ++end;
+            }
+            if (bmt_glob_match(p, end, full_name)) {
+                g_bmt_test_cases[kept++] = g_bmt_test_cases[i];
+                break;
+            }
+            if (*end == '\0') {
+                break;
+            }
+            p = end + 1;
+        }
+    }
+    g_bmt_test_count = kept;
+}
+
+/**
+ * @internal
+ * @brief Compiler and version, for the run metadata.
+ */
+#if defined(__clang__)
+#define BMT_COMPILER_ID "clang " __clang_version__
+#elif defined(__GNUC__)
+#define BMT_COMPILER_ID "gcc " __VERSION__
+#else
+#define BMT_COMPILER_ID "unknown"
+#endif
+
+/**
+ * @internal
+ * @brief Prints one "[ RUN META ] key=value" line. The value runs to the end of the line.
+ */
+static void bmt_print_meta(const char* key, const char* value) {
+    bmt_platform_puts("[ RUN META ] ");
+    bmt_platform_puts(key);
+    bmt_platform_putchar('=');
+    bmt_platform_puts(value);
+    bmt_platform_puts("\r\n");
+}
+
+/**
+ * @internal
+ * @brief Prints a numeric "[ RUN META ]" line, unless the value is 0 (unknown).
+ */
+static void bmt_print_meta_u32(const char* key, uint32_t value) {
+    char buf[12];
+    if (value != 0) {
+        bmt_itoa((long)value, buf, 10);
+        bmt_print_meta(key, buf);
+    }
+}
+
+/**
+ * @internal
+ * @brief Prints the run metadata: what was built (version, build ID, commit, compiler and
+ *        flags) and what it runs on (clock and caches), so results can be compared across runs.
+ */
+static void bmt_print_run_metadata(void) {
+    static const char hex[] = "0123456789abcdef";
+    char id_hex[2 * 32 + 1];
+    size_t id_size = 0;
+    const uint8_t* id = bmt_platform_build_id(&id_size);
+
+    bmt_print_meta("version", BMT_VERSION);
+    if (id != NULL && id_size > 0) {
+        if (id_size > 32) {
+            id_size = 32;
+        }
+        for (size_t i = 0; i < id_size; ++i) {
+            id_hex[2 * i] = hex[id[i] >> 4];
+            id_hex[2 * i + 1] = hex[id[i] & 0xFu];
+        }
+        id_hex[2 * id_size] = '\0';
+        bmt_print_meta("build_id", id_hex);
+    }
+#ifdef BMT_BUILD_GIT_SHA
+    bmt_print_meta("git", BMT_BUILD_GIT_SHA);
+#endif
+    bmt_print_meta("compiler", BMT_COMPILER_ID);
+#ifdef BMT_BUILD_FLAGS
+    bmt_print_meta("flags", BMT_BUILD_FLAGS);
+#endif
+    bmt_platform_cpu_info_t cpu = {0};
+    if (bmt_platform_cpu_info(&cpu)) {
+        bmt_print_meta_u32("cpu_khz", cpu.cpu_khz);
+        bmt_print_meta_u32("l1d_bytes", cpu.l1d_bytes);
+        bmt_print_meta_u32("l1i_bytes", cpu.l1i_bytes);
+        bmt_print_meta_u32("l2_bytes", cpu.l2_bytes);
+        bmt_print_meta_u32("l3_bytes", cpu.l3_bytes);
+        bmt_print_meta_u32("line_bytes", cpu.line_bytes);
+    }
+}
+
+#if BMT_TEST_STACK_SIZE > 0
+#if !defined(__x86_64__) && !defined(__aarch64__) && !defined(__arm__)
+#error "BMT_TEST_STACK_SIZE: no test stack switch for this architecture (x86-64, AArch64 or AArch32)"
+#endif
+#if (BMT_TEST_STACK_SIZE % 16) != 0 || (BMT_TEST_STACK_GUARD_SIZE % 16) != 0
+#error "BMT_TEST_STACK_SIZE and BMT_TEST_STACK_GUARD_SIZE must be multiples of 16"
+#endif
+
+/**
+ * @internal
+ * @brief Value the test stack and the canary guards are painted with. The peak usage is the
+ *        distance from the top of the stack to the lowest word that no longer holds it.
+ */
+#define BMT_TEST_STACK_PAINT 0xA5A5A5A5u
+
+/**
+ * @internal
+ * @brief Words of the pool: lower guard, stack (growing down, towards the lower guard) and
+ *        upper guard. Placed in BMT_TEST_STACK_SECTION if defined (e.g. a RAM the MPU can map).
+ */
+#define BMT_TEST_STACK_GUARD_WORDS (BMT_TEST_STACK_GUARD_SIZE / 4)
+#define BMT_TEST_STACK_WORDS       (BMT_TEST_STACK_SIZE / 4)
+
+#ifdef BMT_TEST_STACK_SECTION
+__attribute__((section(BMT_TEST_STACK_SECTION)))
+#endif
+static uint32_t g_bmt_test_stack_pool[2 * BMT_TEST_STACK_GUARD_WORDS + BMT_TEST_STACK_WORDS]
+    __attribute__((aligned(BMT_TEST_STACK_GUARD_SIZE)));
+
+/** @internal @brief Both guards are protected by bmt_platform_stack_guard() (else: canaries). */
+static bool g_bmt_test_stack_guarded = false;
+
+/** @internal @brief A test is running on the test stack: a guard fault can be recovered. */
+static volatile bool g_bmt_test_stack_in_use = false;
+
+/** @internal @brief Set by bmt_stack_fault() for the running test. */
+static volatile bool g_bmt_test_stack_overflowed = false;
+
+/** @internal @brief Tests reported as STACK OVERFLOW (bmt_test_stack_overflows()). */
+static uint32_t g_bmt_test_stack_overflow_count = 0;
+
+__attribute__((weak)) bool bmt_platform_stack_guard(void* base, size_t size, bool enable) {
+    (void)base;
+    (void)size;
+    (void)enable;
+    return false;
+}
+
+/**
+ * @internal
+ * @brief Protects (or releases) both guards. If the platform cannot protect both, none stays
+ *        protected and the guards are painted as canaries.
+ */
+static void bmt_test_stack_guard(bool enable) {
+    uint32_t* lower = g_bmt_test_stack_pool;
+    uint32_t* upper = g_bmt_test_stack_pool + BMT_TEST_STACK_GUARD_WORDS + BMT_TEST_STACK_WORDS;
+    if (!enable) {
+        if (g_bmt_test_stack_guarded) {
+            bmt_platform_stack_guard(lower, BMT_TEST_STACK_GUARD_SIZE, false);
+            bmt_platform_stack_guard(upper, BMT_TEST_STACK_GUARD_SIZE, false);
+            g_bmt_test_stack_guarded = false;
+        }
+        return;
+    }
+    // Paint everything first: protected guards can no longer be written
+    for (uint32_t* p = g_bmt_test_stack_pool; p < upper + BMT_TEST_STACK_GUARD_WORDS; ++p) {
+        *p = BMT_TEST_STACK_PAINT;
+    }
+    bool lower_ok = bmt_platform_stack_guard(lower, BMT_TEST_STACK_GUARD_SIZE, true);
+    bool upper_ok = bmt_platform_stack_guard(upper, BMT_TEST_STACK_GUARD_SIZE, true);
+    if (lower_ok != upper_ok) {
+        bmt_platform_stack_guard(lower_ok ? lower : upper, BMT_TEST_STACK_GUARD_SIZE, false);
+    }
+    g_bmt_test_stack_guarded = lower_ok && upper_ok;
+}
+
+/**
+ * @internal
+ * @brief Calls `func` with the stack pointer at `top`, and restores it afterwards. A longjmp()
+ *        out of `func` restores the runner's stack pointer on its own.
+ *
+ * Everything the ABI lets `func` change is declared clobbered, and the runner's stack pointer
+ * is kept in a callee-saved register, so the switch is four instructions.
+ */
+__attribute__((noinline)) static void bmt_call_on_stack(bmt_test_func_ptr_t func, void* top) {
+#if defined(__x86_64__)
+    __asm__ volatile(
+        "mov  %%rsp, %%rbx\n\t"
+        "mov  %1, %%rsp\n\t"
+        "call *%0\n\t"
+        "mov  %%rbx, %%rsp"
+        :
+        : "r"(func), "r"(top)
+        : "rax", "rbx", "rcx", "rdx", "rsi", "rdi", "r8", "r9", "r10", "r11",
+          "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7",
+          "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14", "xmm15",
+#if defined(__AVX512F__)
+          "xmm16", "xmm17", "xmm18", "xmm19", "xmm20", "xmm21", "xmm22", "xmm23",
+          "xmm24", "xmm25", "xmm26", "xmm27", "xmm28", "xmm29", "xmm30", "xmm31",
+#endif
+          "memory", "cc");
+#elif defined(__aarch64__)
+    __asm__ volatile(
+        "mov  x19, sp\n\t"
+        "mov  sp, %1\n\t"
+        "blr  %0\n\t"
+        "mov  sp, x19"
+        :
+        : "r"(func), "r"(top)
+        : "x0", "x1", "x2", "x3", "x4", "x5", "x6", "x7", "x8", "x9", "x10", "x11", "x12",
+          "x13", "x14", "x15", "x16", "x17", "x18", "x19", "x30",
+          "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v16", "v17", "v18", "v19",
+          "v20", "v21", "v22", "v23", "v24", "v25", "v26", "v27", "v28", "v29", "v30", "v31",
+          "memory", "cc");
+#else
+    __asm__ volatile(
+        "mov  r4, sp\n\t"
+        "mov  sp, %1\n\t"
+        "blx  %0\n\t"
+        "mov  sp, r4"
+        :
+        : "r"(func), "r"(top)
+        : "r0", "r1", "r2", "r3", "r4", "r12", "lr",
+#if defined(__ARM_FP)
+          "s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7",
+          "s8", "s9", "s10", "s11", "s12", "s13", "s14", "s15",
+#endif
+#if defined(__ARM_NEON)
+          "d16", "d17", "d18", "d19", "d20", "d21", "d22", "d23",
+          "d24", "d25", "d26", "d27", "d28", "d29", "d30", "d31",
+#endif
+          "memory", "cc");
+#endif
+}
+
+/**
+ * @internal
+ * @brief Runs a test on the test stack. Called under the runner's bmt_setjmp().
+ */
+static void bmt_test_stack_run(bmt_test_func_ptr_t func) {
+    g_bmt_test_stack_overflowed = false;
+    g_bmt_test_stack_in_use = true;
+    bmt_call_on_stack(func, g_bmt_test_stack_pool + BMT_TEST_STACK_GUARD_WORDS + BMT_TEST_STACK_WORDS);
+    g_bmt_test_stack_in_use = false;
+}
+
+/**
+ * @internal
+ * @brief After a test: measures its peak stack usage, prints it, repaints what it used and
+ *        reports an overflow (a guard fault, or a canary that changed).
+ * @return true if the test overflowed its stack.
+ */
+static bool bmt_test_stack_end(const char* suite, const char* name) {
+    g_bmt_test_stack_in_use = false;
+    uint32_t* stack = g_bmt_test_stack_pool + BMT_TEST_STACK_GUARD_WORDS;
+    uint32_t* top = stack + BMT_TEST_STACK_WORDS;
+    uint32_t* p = g_bmt_test_stack_guarded ? stack : g_bmt_test_stack_pool;
+    while (p < top && *p == BMT_TEST_STACK_PAINT) {
+        ++p;
+    }
+    bool overflowed = g_bmt_test_stack_overflowed || p < stack;
+    uint32_t peak = (uint32_t)(top - p) * 4u;  // Into the lower guard, if it is a canary
+    if (overflowed && peak < BMT_TEST_STACK_SIZE) {
+        peak = BMT_TEST_STACK_SIZE;  // Faulted in the protected guard: at least the whole stack
+    }
+    // Everything below `p` still holds the paint: repaint only what the test used
+    for (uint32_t* q = p; q < top; ++q) {
+        *q = BMT_TEST_STACK_PAINT;
+    }
+
+    char buffer[12];
+    bmt_platform_puts("[ STACK    ] ");
+    bmt_platform_puts(suite);
+    bmt_platform_putchar('.');
+    bmt_platform_puts(name);
+    bmt_platform_puts(" peak=");
+    bmt_itoa((long)peak, buffer, 10);
+    bmt_platform_puts(buffer);
+    bmt_platform_puts(" size=");
+    bmt_itoa((long)BMT_TEST_STACK_SIZE, buffer, 10);
+    bmt_platform_puts(buffer);
+    bmt_platform_puts(g_bmt_test_stack_guarded ? " guard=protected" : " guard=canary");
+    bmt_platform_puts(overflowed ? " overflow=1\r\n" : "\r\n");
+    if (overflowed) {
+        g_bmt_test_stack_overflow_count++;
+        bmt_report_failure(__FILE__, __LINE__, "STACK OVERFLOW", "BMT_TEST_STACK_SIZE",
+                           "peak usage >= %ld of %ld bytes", (long)peak, (long)BMT_TEST_STACK_SIZE);
+    }
+    return overflowed;
+}
+#endif
+
+uintptr_t bmt_stack_guard_hit(uintptr_t address) {
+#if BMT_TEST_STACK_SIZE > 0
+    uintptr_t lower = (uintptr_t)g_bmt_test_stack_pool;
+    uintptr_t top = lower + BMT_TEST_STACK_GUARD_SIZE + BMT_TEST_STACK_SIZE;
+    bool in_guard = (address >= lower && address < lower + BMT_TEST_STACK_GUARD_SIZE) ||
+                    (address >= top && address < top + BMT_TEST_STACK_GUARD_SIZE);
+    if (g_bmt_test_stack_in_use && g_bmt_test_stack_guarded && in_guard) {
+        return top;  // The test is abandoned: its whole stack is free
+    }
+#endif
+    (void)address;
+    return 0;
+}
+
+void bmt_stack_fault(void) {
+#if BMT_TEST_STACK_SIZE > 0
+    g_bmt_test_stack_overflowed = true;
+#endif
+    bmt_longjmp(g_bmt_assert_jmp_buf, 1);
+}
+
+uint32_t bmt_test_stack_overflows(void) {
+#if BMT_TEST_STACK_SIZE > 0
+    return g_bmt_test_stack_overflow_count;
+#else
+    return 0;
+#endif
 }
 
 /**
  * @brief Runs all registered test cases and reports the results.
  *
  * This is the main entry point for executing the test suite. It performs the following steps:
- * 1. Initializes the platform I/O using `bmt_platform_io_init()`.
- * 2. Prints a header indicating the start of test execution and the total number of tests.
+ * 1. Initializes the platform I/O using `bmt_platform_io_init()`, registers the tests of
+ *    BMT_TEST_SECTION (constant descriptors, e.g. from the C++ TEST) and keeps only those
+ *    selected by `bmt_platform_test_filter()`, if any.
+ * 2. Prints the run metadata ("[ RUN META ]" lines: framework version, build ID, commit,
+ *    compiler and flags, CPU clock and caches) and a header with the total number of tests.
  * 3. Iterates through each registered test case:
  *    a. Prints a "[ RUN      ]" message with the test suite and name.
- *    b. Resets failure flags for the current test.
+ *    b. Resets failure flags for the current test and the state of all mocks.
  *    c. Records the start time using `bmt_platform_get_msec_ticks()`.
  *    d. Executes the test function. A `setjmp()` is used to catch `longjmp()` calls
- *       from `bmt_terminate_current_test()` (triggered by BMT_ASSERT macros).
+ *       from `bmt_terminate_current_test()` (triggered by BMT_ASSERT macros). With
+ *       BMT_TEST_STACK_SIZE, the test runs on its own guarded stack and its peak usage is
+ *       printed afterwards; an overflow fails it.
  *    e. Records the end time and calculates the test duration, handling timer overflows.
  *    f. Determines if the test passed or failed based on assertion and expectation results.
  *    g. Prints an "[       OK ]" or "[  FAILED  ]" message along with the test name and duration.
@@ -209,6 +707,9 @@ void bmt_terminate_current_test(void) {
  */
 int bmt_run_all_tests(void) {
     bmt_platform_io_init(); // Initialize platform I/O
+    bmt_register_section_tests();
+    bmt_apply_test_filter();
+    bmt_print_run_metadata();
 
     char buffer[128];
     bmt_platform_puts("[==========] Running ");
@@ -219,6 +720,9 @@ int bmt_run_all_tests(void) {
     int tests_passed = 0;
     int tests_failed = 0;
     uint32_t total_duration_ms = 0;
+#if BMT_TEST_STACK_SIZE > 0
+    bmt_test_stack_guard(true);
+#endif
 
     for (int i = 0; i < g_bmt_test_count; ++i) {
         bmt_platform_puts("[ RUN      ] ");
@@ -228,18 +732,30 @@ int bmt_run_all_tests(void) {
         bmt_platform_puts("\r\n");
 
         g_bmt_current_test_failed_expect = false; // Reset for EXPECT macros
+        g_bmt_assert_unwinds = false;  // Set by the C++ TEST wrapper, if any
+        bmt_mock_reset_all(); // Each test starts with fresh mocks
         bool current_test_passed_assert = true;  // Assume no ASSERT failures initially
 
         uint32_t start_ticks = bmt_platform_get_msec_ticks();
 
-        if (setjmp(g_bmt_assert_jmp_buf) == 0) {
+        if (bmt_setjmp(g_bmt_assert_jmp_buf) == 0) {
             // Execute the test
+#if BMT_TEST_STACK_SIZE > 0
+            bmt_test_stack_run(g_bmt_test_cases[i].func);
+#else
             g_bmt_test_cases[i].func();
+#endif
         } else {
             // An ASSERT macro failed and caused a longjmp here
             current_test_passed_assert = false;
         }
-        
+#if BMT_TEST_STACK_SIZE > 0
+        if (bmt_test_stack_end(g_bmt_test_cases[i].suite_name, g_bmt_test_cases[i].test_name)) {
+            current_test_passed_assert = false;
+        }
+#endif
+        bmt_vclock_test_end(g_bmt_test_cases[i].suite_name, g_bmt_test_cases[i].test_name); // Back to real time
+
         uint32_t end_ticks = bmt_platform_get_msec_ticks();
         // Handle timer overflow when calculating duration
         g_bmt_test_cases[i].duration_ms = (end_ticks >= start_ticks) ? (end_ticks - start_ticks) : (0xFFFFFFFF - start_ticks + end_ticks + 1); 
@@ -263,6 +779,10 @@ int bmt_run_all_tests(void) {
         bmt_platform_puts(" ms)\r\n");
     }
 
+#if BMT_TEST_STACK_SIZE > 0
+    bmt_test_stack_guard(false);
+#endif
+
     bmt_platform_puts("[==========] ");
     bmt_itoa(g_bmt_test_count, buffer, 10);
     bmt_platform_puts(buffer);
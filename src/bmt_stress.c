@@ -0,0 +1,359 @@
+// src/bmt_stress.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_stress.h"
+#include "bmt_bench.h"
+#include "bmt_internal.h"
+
+/**
+ * @brief Weak default: single-core platform.
+ * @return 1.
+ */
+__attribute__((weak)) uint32_t bmt_platform_num_cores(void) {
+    return 1;
+}
+
+/**
+ * @brief Weak default: everything runs on core 0.
+ * @return 0.
+ */
+__attribute__((weak)) uint32_t bmt_platform_core_id(void) {
+    return 0;
+}
+
+/**
+ * @brief Weak default: secondary cores, if any, are parked in bmt_stress_secondary_main().
+ * @return false.
+ */
+__attribute__((weak)) bool bmt_platform_start_secondary_cores(uint32_t num_cores, void (*entry)(uint32_t core)) {
+    (void)num_cores;
+    (void)entry;
+    return false;
+}
+
+/**
+ * @brief Weak default: CPU spin-wait hint.
+ */
+__attribute__((weak)) void bmt_platform_cpu_relax(void) {
+#if defined(__arm__) || defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#elif defined(__i386__) || defined(__x86_64__)
+    __asm__ __volatile__("pause" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+/**
+ * @internal
+ * @brief Sense-reversing spin barrier.
+ */
+typedef struct {
+    uint32_t count;  /**< Cores that have arrived in the current phase. */
+    uint32_t sense;  /**< Flipped by the last core to arrive, releasing the others. */
+} bmt_stress_barrier_t;
+
+/**
+ * @internal
+ * @brief Per-core state, one cache line each so the counters do not cause false sharing.
+ */
+typedef struct {
+    uint32_t completed;      /**< Iterations whose body returned normally. */
+    uint32_t failures;       /**< Failures reported by this core. */
+    uint32_t iteration;      /**< Iteration being run (for failure reports). */
+    uint32_t start_sense;    /**< Local sense for the start barrier. */
+    uint32_t body_sense;     /**< Local sense for bmt_stress_barrier(). */
+    bool asserted;           /**< An ASSERT_* failed: the core no longer runs the body. */
+    uint64_t ticks;          /**< Time from the first release to the end of the last iteration. */
+} __attribute__((aligned(64))) bmt_stress_core_t;
+
+static bmt_stress_core_t g_bmt_stress_core[BMT_STRESS_MAX_CORES];
+static bmt_jmp_buf g_bmt_stress_jmp[BMT_STRESS_MAX_CORES];
+static bmt_stress_barrier_t g_bmt_stress_start_barrier;
+static bmt_stress_barrier_t g_bmt_stress_body_barrier;
+
+static bmt_stress_func_t g_bmt_stress_body;
+static uint32_t g_bmt_stress_iterations;
+static uint32_t g_bmt_stress_cores = 1;
+static volatile bool g_bmt_stress_active = false;
+static volatile bool g_bmt_stress_abort = false;
+static volatile bool g_bmt_stress_stop = false;
+static volatile bool g_bmt_stress_start_timeout = false;
+
+/** @internal @brief Bumped by core 0 to publish a stress test to parked secondary cores. */
+static uint32_t g_bmt_stress_generation = 0;
+/** @internal @brief Secondary cores that finished the current stress test. */
+static uint32_t g_bmt_stress_done = 0;
+/** @internal @brief Serializes failure reports from several cores. */
+static uint8_t g_bmt_stress_print_lock = 0;
+/** @internal @brief Failure reports printed in the current stress test. */
+static uint32_t g_bmt_stress_reports = 0;
+
+/**
+ * @internal
+ * @brief Waits until all cores of the stress test reach the barrier.
+ * @param timeout_ms Give up after this time (0 waits forever).
+ * @param abortable Give up if a core has failed an assertion.
+ * @param latch_abort The last core to arrive copies the abort flag to g_bmt_stress_stop before
+ *        releasing the others, so every core takes the same decision after the barrier.
+ * @return false if it gave up.
+ */
+static bool bmt_stress_barrier_wait(bmt_stress_barrier_t* barrier, uint32_t* local_sense,
+                                    uint32_t timeout_ms, bool abortable, bool latch_abort) {
+    uint32_t sense = *local_sense ^ 1u;
+    uint32_t start_ms = timeout_ms ? bmt_platform_get_msec_ticks() : 0;
+    *local_sense = sense;
+    if (__atomic_add_fetch(&barrier->count, 1u, __ATOMIC_ACQ_REL) == g_bmt_stress_cores) {
+        __atomic_store_n(&barrier->count, 0u, __ATOMIC_RELAXED);
+        if (latch_abort) {
+            g_bmt_stress_stop = g_bmt_stress_abort;
+        }
+        __atomic_store_n(&barrier->sense, sense, __ATOMIC_RELEASE);
+        return true;
+    }
+    while (__atomic_load_n(&barrier->sense, __ATOMIC_ACQUIRE) != sense) {
+        if (abortable && g_bmt_stress_abort) {
+            return false;
+        }
+        if (timeout_ms && (uint32_t)(bmt_platform_get_msec_ticks() - start_ms) > timeout_ms) {
+            return false;
+        }
+        bmt_platform_cpu_relax();
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief Runs one iteration of the body, catching ASSERT_* failures.
+ * @return false if an assertion failed.
+ */
+static bool bmt_stress_call_body(uint32_t core, uint32_t iteration) {
+    if (bmt_setjmp(g_bmt_stress_jmp[core]) == 0) {
+        g_bmt_stress_body(core, iteration);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @internal
+ * @brief Share of a stress test run by each core, core 0 included.
+ */
+static void bmt_stress_worker(uint32_t core) {
+    bmt_stress_core_t* st = &g_bmt_stress_core[core];
+    uint64_t t0 = 0;
+
+    for (uint32_t it = 0; it < g_bmt_stress_iterations; ++it) {
+        uint32_t timeout = (core == 0 && it == 0) ? BMT_STRESS_START_TIMEOUT_MS : 0;
+        if (!bmt_stress_barrier_wait(&g_bmt_stress_start_barrier, &st->start_sense, timeout, false, true)) {
+            g_bmt_stress_start_timeout = true;
+            g_bmt_stress_abort = true;
+            bmt_report_failure(__FILE__, __LINE__, "STRESS_TEST", "all cores reach the start barrier",
+                               "Cores: %ld. Are the secondary cores parked in bmt_stress_secondary_main()?",
+                               (long)g_bmt_stress_cores);
+            break;
+        }
+        if (it == 0) {
+            t0 = bmt_platform_get_hires_ticks();
+        }
+        // Latched by the barrier: all cores stop at the same iteration, or none does
+        if (g_bmt_stress_stop) {
+            break;
+        }
+        if (st->asserted) {
+            continue;
+        }
+        st->iteration = it;
+        if (bmt_stress_call_body(core, it)) {
+            st->completed++;
+        } else {
+            st->asserted = true;
+            g_bmt_stress_abort = true;
+        }
+    }
+    st->ticks = bmt_platform_get_hires_ticks() - t0;
+}
+
+/**
+ * @internal
+ * @brief Entry point of a secondary core for one stress test.
+ */
+static void bmt_stress_secondary_entry(uint32_t core) {
+    bmt_stress_worker(core);
+    __atomic_add_fetch(&g_bmt_stress_done, 1u, __ATOMIC_RELEASE);
+}
+
+void bmt_stress_secondary_main(uint32_t core) {
+    uint32_t seen = 0;
+    for (;;) {
+        uint32_t gen;
+        while ((gen = __atomic_load_n(&g_bmt_stress_generation, __ATOMIC_ACQUIRE)) == seen) {
+            bmt_platform_cpu_relax();
+        }
+        seen = gen;
+        if (core < g_bmt_stress_cores) {
+            bmt_stress_secondary_entry(core);
+        }
+    }
+}
+
+/**
+ * @internal
+ * @brief Cores the next stress test will use: bmt_platform_num_cores() clamped to BMT_STRESS_MAX_CORES.
+ */
+static uint32_t bmt_stress_platform_cores(void) {
+    uint32_t cores = bmt_platform_num_cores();
+    if (cores == 0) cores = 1;
+    if (cores > BMT_STRESS_MAX_CORES) cores = BMT_STRESS_MAX_CORES;
+    return cores;
+}
+
+uint32_t bmt_stress_num_cores(void) {
+    return g_bmt_stress_active ? g_bmt_stress_cores : bmt_stress_platform_cores();
+}
+
+void bmt_stress_barrier(void) {
+    uint32_t core = bmt_platform_core_id();
+    if (!bmt_stress_barrier_wait(&g_bmt_stress_body_barrier, &g_bmt_stress_core[core].body_sense, 0, true, false)) {
+        bmt_stress_terminate();
+    }
+}
+
+bool bmt_stress_is_active(void) {
+    return g_bmt_stress_active;
+}
+
+bool bmt_stress_report_begin(void) {
+    if (!g_bmt_stress_active) {
+        return true;
+    }
+    uint32_t core = bmt_platform_core_id();
+    if (core < BMT_STRESS_MAX_CORES) {
+        __atomic_add_fetch(&g_bmt_stress_core[core].failures, 1u, __ATOMIC_RELAXED);
+    }
+    if (__atomic_fetch_add(&g_bmt_stress_reports, 1u, __ATOMIC_RELAXED) >= BMT_STRESS_MAX_REPORTS) {
+        return false;
+    }
+    while (__atomic_test_and_set(&g_bmt_stress_print_lock, __ATOMIC_ACQUIRE)) {
+        bmt_platform_cpu_relax();
+    }
+    return true;
+}
+
+void bmt_stress_report_end(void) {
+    if (!g_bmt_stress_active) {
+        return;
+    }
+    uint32_t core = bmt_platform_core_id();
+    bmt_platform_puts("    Core: ");
+    bmt_print_u64(core);
+    bmt_platform_puts(", iteration: ");
+    bmt_print_u64(core < BMT_STRESS_MAX_CORES ? g_bmt_stress_core[core].iteration : 0);
+    bmt_platform_puts("\r\n");
+    __atomic_clear(&g_bmt_stress_print_lock, __ATOMIC_RELEASE);
+}
+
+void bmt_stress_terminate(void) {
+    uint32_t core = bmt_platform_core_id();
+    bmt_longjmp(g_bmt_stress_jmp[core < BMT_STRESS_MAX_CORES ? core : 0], 1);
+}
+
+/**
+ * @internal
+ * @brief Prints one "[ STRESS   ]" line.
+ */
+static void bmt_stress_report_line(const char* name, int core, uint32_t cores, uint32_t iters,
+                                   uint32_t failures, uint64_t ticks, uint32_t total_iters) {
+    bmt_platform_puts("[ STRESS   ] ");
+    bmt_platform_puts(name);
+    if (core >= 0) {
+        bmt_platform_puts("/core");
+        bmt_print_u64((uint64_t)core);
+    } else {
+        bmt_platform_puts(" cores=");
+        bmt_print_u64(cores);
+    }
+    bmt_platform_puts(" iters=");
+    bmt_print_u64(iters);
+    bmt_platform_puts(" failures=");
+    bmt_print_u64(failures);
+    bmt_platform_puts(" ns_per_iter=");
+    bmt_print_fixed3(iters ? bmt_ticks_to_ps(ticks) / iters : 0);
+    if (core < 0) {
+        // Aggregate throughput: body executions per second across all cores
+        uint64_t us = bmt_ticks_to_ps(ticks) / 1000000ULL;
+        bmt_platform_puts(" iters_per_sec=");
+        bmt_print_u64(us ? ((uint64_t)total_iters * 1000000ULL) / us : 0);
+    }
+    bmt_platform_puts("\r\n");
+}
+
+void bmt_stress_run(const char* name, bmt_stress_func_t body, uint32_t iterations) {
+    uint32_t cores = bmt_stress_platform_cores();
+
+    for (uint32_t c = 0; c < BMT_STRESS_MAX_CORES; ++c) {
+        g_bmt_stress_core[c].completed = 0;
+        g_bmt_stress_core[c].failures = 0;
+        g_bmt_stress_core[c].iteration = 0;
+        g_bmt_stress_core[c].start_sense = 0;
+        g_bmt_stress_core[c].body_sense = 0;
+        g_bmt_stress_core[c].asserted = false;
+        g_bmt_stress_core[c].ticks = 0;
+    }
+    g_bmt_stress_start_barrier.count = 0;
+    g_bmt_stress_start_barrier.sense = 0;
+    g_bmt_stress_body_barrier.count = 0;
+    g_bmt_stress_body_barrier.sense = 0;
+    g_bmt_stress_body = body;
+    g_bmt_stress_iterations = iterations;
+    g_bmt_stress_cores = cores;
+    g_bmt_stress_abort = false;
+    g_bmt_stress_stop = false;
+    g_bmt_stress_start_timeout = false;
+    g_bmt_stress_reports = 0;
+    __atomic_store_n(&g_bmt_stress_done, 0u, __ATOMIC_RELAXED);
+    bool unwinds = g_bmt_assert_unwinds;
+    g_bmt_assert_unwinds = false;  // ASSERT_* of the body must end only the calling core
+    g_bmt_stress_active = true;
+
+    // Publish the job: start workers, or wake the cores parked in bmt_stress_secondary_main()
+    if (cores > 1 && !bmt_platform_start_secondary_cores(cores, bmt_stress_secondary_entry)) {
+        __atomic_add_fetch(&g_bmt_stress_generation, 1u, __ATOMIC_RELEASE);
+    }
+    bmt_stress_worker(0);
+    if (!g_bmt_stress_start_timeout) {
+        while (__atomic_load_n(&g_bmt_stress_done, __ATOMIC_ACQUIRE) < cores - 1) {
+            bmt_platform_cpu_relax();
+        }
+    }
+    g_bmt_stress_active = false;
+    g_bmt_assert_unwinds = unwinds;
+
+    uint32_t total_iters = 0;
+    uint32_t total_failures = 0;
+    uint64_t wall_ticks = 0;
+    for (uint32_t c = 0; c < cores; ++c) {
+        total_iters += g_bmt_stress_core[c].completed;
+        total_failures += g_bmt_stress_core[c].failures;
+        if (g_bmt_stress_core[c].ticks > wall_ticks) wall_ticks = g_bmt_stress_core[c].ticks;
+    }
+    uint32_t iters = g_bmt_stress_core[0].completed;
+    for (uint32_t c = 1; c < cores; ++c) {
+        if (g_bmt_stress_core[c].completed > iters) iters = g_bmt_stress_core[c].completed;
+    }
+    bmt_stress_report_line(name, -1, cores, iters, total_failures, wall_ticks, total_iters);
+    for (uint32_t c = 0; c < cores; ++c) {
+        bmt_stress_report_line(name, (int)c, cores, g_bmt_stress_core[c].completed,
+                               g_bmt_stress_core[c].failures, g_bmt_stress_core[c].ticks, 0);
+    }
+    if (total_failures > 0) {
+        g_bmt_current_test_failed_expect = true;
+    }
+}
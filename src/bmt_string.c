@@ -0,0 +1,130 @@
+// src/bmt_string.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "baremetal_test.h"
+
+/**
+ * @internal
+ * @brief Machine word read over char data. `may_alias` keeps the reads legal under strict
+ *        aliasing; they are aligned, so they never cross into an unmapped page.
+ */
+typedef uintptr_t __attribute__((__may_alias__)) bmt_word_t;
+
+#define BMT_WORD_SIZE  sizeof(bmt_word_t)
+#define BMT_WORD_ONES  ((bmt_word_t)-1 / 0xFFu)          // 0x0101...01
+#define BMT_WORD_HIGHS (BMT_WORD_ONES * 0x80u)           // 0x8080...80
+
+/**
+ * @internal
+ * @brief Non-zero if any byte of `w` is zero.
+ */
+#define BMT_WORD_HAS_ZERO(w) (((w) - BMT_WORD_ONES) & ~(w) & BMT_WORD_HIGHS)
+
+static inline bool bmt_is_word_aligned(const void* p) {
+    return ((uintptr_t)p & (BMT_WORD_SIZE - 1u)) == 0;
+}
+
+static inline unsigned char bmt_ascii_lower(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+size_t bmt_strlen(const char* s) {
+    const char* p = s;
+    while (!bmt_is_word_aligned(p)) {
+        if (*p == '\0') {
+            return (size_t)(p - s);
+        }
+        p++;
+    }
+    const bmt_word_t* w = (const bmt_word_t*)p;
+    while (!BMT_WORD_HAS_ZERO(*w)) {
+        w++;
+    }
+    p = (const char*)w;
+    while (*p != '\0') {
+        p++;
+    }
+    return (size_t)(p - s);
+}
+
+/**
+ * @internal
+ * @brief Skips the common prefix of `*s1` and `*s2` a word at a time, as long as both are
+ *        equally aligned and no terminator has been reached. Leaves the pointers on the
+ *        first word that differs or holds a terminator (the caller finishes byte by byte).
+ * @param limit Maximum characters to skip, or NULL for no limit; decremented by the skipped amount.
+ */
+static void bmt_skip_equal_words(const unsigned char** s1, const unsigned char** s2, size_t* limit) {
+    const unsigned char* a = *s1;
+    const unsigned char* b = *s2;
+    if (((uintptr_t)a ^ (uintptr_t)b) & (BMT_WORD_SIZE - 1u)) {
+        return;  // Different alignment: word reads would be misaligned on one side
+    }
+    while (!bmt_is_word_aligned(a)) {
+        if ((limit != NULL && *limit == 0) || *a != *b || *a == '\0') {
+            *s1 = a;
+            *s2 = b;
+            return;
+        }
+        a++;
+        b++;
+        if (limit != NULL) {
+            (*limit)--;
+        }
+    }
+    const bmt_word_t* wa = (const bmt_word_t*)a;
+    const bmt_word_t* wb = (const bmt_word_t*)b;
+    while ((limit == NULL || *limit >= BMT_WORD_SIZE) && *wa == *wb && !BMT_WORD_HAS_ZERO(*wa)) {
+        wa++;
+        wb++;
+        if (limit != NULL) {
+            *limit -= BMT_WORD_SIZE;
+        }
+    }
+    *s1 = (const unsigned char*)wa;
+    *s2 = (const unsigned char*)wb;
+}
+
+int bmt_strcmp(const char* s1, const char* s2) {
+    const unsigned char* a = (const unsigned char*)s1;
+    const unsigned char* b = (const unsigned char*)s2;
+    bmt_skip_equal_words(&a, &b, NULL);
+    while (*a != '\0' && *a == *b) {
+        a++;
+        b++;
+    }
+    return (int)*a - (int)*b;
+}
+
+int bmt_strncmp(const char* s1, const char* s2, size_t n) {
+    const unsigned char* a = (const unsigned char*)s1;
+    const unsigned char* b = (const unsigned char*)s2;
+    bmt_skip_equal_words(&a, &b, &n);
+    for (; n > 0; --n, ++a, ++b) {
+        if (*a != *b || *a == '\0') {
+            return (int)*a - (int)*b;
+        }
+    }
+    return 0;
+}
+
+int bmt_strcasecmp(const char* s1, const char* s2) {
+    const unsigned char* a = (const unsigned char*)s1;
+    const unsigned char* b = (const unsigned char*)s2;
+    for (;;) {
+        bmt_skip_equal_words(&a, &b, NULL);  // Identical bytes are equal in any case
+        unsigned char ca = bmt_ascii_lower(*a);
+        unsigned char cb = bmt_ascii_lower(*b);
+        if (ca != cb || ca == '\0') {
+            return (int)ca - (int)cb;
+        }
+        a++;
+        b++;
+    }
+}
@@ -0,0 +1,139 @@
+// src/bmt_transport.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_transport.h"
+#include "bmt_compress.h"
+#include "bmt_platform_io.h"
+#include "bmt_internal.h"
+
+/**
+ * @internal
+ * @brief State of the transport layer. Static: the output path has no heap.
+ */
+static struct {
+    const bmt_transport_t* transport;
+    uint8_t buf[BMT_TRANSPORT_BUFFER];
+    uint32_t len;               /**< Bytes in `buf`. */
+    uint32_t oldest_ms;         /**< When the first byte of `buf` was written. */
+    bmt_transport_stats_t stats;
+} g_bmt_transport;
+
+void bmt_transport_set(const bmt_transport_t* transport) {
+    g_bmt_transport.transport = transport;
+    g_bmt_transport.len = 0u;
+    g_bmt_transport.stats = (bmt_transport_stats_t){0};
+}
+
+const bmt_transport_t* bmt_transport_get(void) {
+    return g_bmt_transport.transport;
+}
+
+void bmt_transport_flush(void) {
+    if (g_bmt_transport.len == 0u || g_bmt_transport.transport == NULL) {
+        return;
+    }
+    uint64_t start = bmt_platform_get_hires_ticks();
+    g_bmt_transport.transport->write(g_bmt_transport.buf, g_bmt_transport.len);
+    g_bmt_transport.stats.ticks += bmt_platform_get_hires_ticks() - start;
+    g_bmt_transport.stats.bytes += g_bmt_transport.len;
+    g_bmt_transport.stats.sends++;
+    g_bmt_transport.len = 0u;
+}
+
+void bmt_transport_write(const uint8_t* data, size_t size) {
+    if (g_bmt_transport.transport == NULL) {
+        return;
+    }
+    bool line_end = false;
+    for (size_t i = 0; i < size; ++i) {
+        if (g_bmt_transport.len == sizeof(g_bmt_transport.buf)) {
+            bmt_transport_flush();
+        }
+        if (g_bmt_transport.len == 0u) {
+            g_bmt_transport.oldest_ms = bmt_platform_get_msec_ticks();
+        }
+        g_bmt_transport.buf[g_bmt_transport.len++] = data[i];
+        line_end |= (data[i] == '\n');
+    }
+#if BMT_TRANSPORT_FLUSH_MS > 0
+    if (line_end && g_bmt_transport.len > 0u &&
+        (uint32_t)(bmt_platform_get_msec_ticks() - g_bmt_transport.oldest_ms) >= BMT_TRANSPORT_FLUSH_MS) {
+        bmt_transport_flush();
+    }
+#else
+    if (line_end) {
+        bmt_transport_flush();
+    }
+#endif
+}
+
+int bmt_transport_getchar(void) {
+    bmt_transport_flush();
+    if (g_bmt_transport.transport == NULL || g_bmt_transport.transport->read == NULL) {
+        return -1;
+    }
+    return g_bmt_transport.transport->read();
+}
+
+void bmt_transport_get_stats(bmt_transport_stats_t* stats) {
+    *stats = g_bmt_transport.stats;
+}
+
+void bmt_transport_report(void) {
+    if (g_bmt_transport.transport == NULL) {
+        return;
+    }
+    bmt_transport_flush();  // Count what is buffered
+    bmt_transport_stats_t s = g_bmt_transport.stats;
+    uint64_t ps = bmt_ticks_to_ps(s.ticks);
+    bmt_platform_puts("[ TRANSPORT] name=");
+    bmt_platform_puts(g_bmt_transport.transport->name);
+    bmt_platform_puts(" bytes=");
+    bmt_print_u64(s.bytes);
+    bmt_platform_puts(" sends=");
+    bmt_print_u64(s.sends);
+    bmt_platform_puts(" send_ms=");
+    bmt_print_fixed3(ps / 1000000u);
+    if (ps >= 1000000u) {
+        bmt_platform_puts(" bytes_per_s=");
+        bmt_print_u64(s.bytes * 1000000u / (ps / 1000000u));
+    }
+    bmt_platform_puts("\r\n");
+    bmt_transport_flush();
+}
+
+uint64_t bmt_transport_bench(uint32_t bytes) {
+    static const char line[] = "[ TX FILL  ] 0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLM\r\n";
+    _Static_assert(sizeof(line) - 1u == 64u, "filler lines are 64 bytes");
+    if (g_bmt_transport.transport == NULL) {
+        return 0;
+    }
+    bmt_compress_flush();
+    bmt_transport_flush();
+    uint32_t lines = bytes / (sizeof(line) - 1u);
+    uint64_t start = bmt_platform_get_hires_ticks();
+    for (uint32_t i = 0; i < lines; ++i) {
+        bmt_transport_write((const uint8_t*)line, sizeof(line) - 1u);
+    }
+    bmt_transport_flush();
+    uint64_t ps = bmt_ticks_to_ps(bmt_platform_get_hires_ticks() - start);
+    uint64_t sent = (uint64_t)lines * (sizeof(line) - 1u);
+    uint64_t bytes_per_s = ps >= 1000000u ? sent * 1000000u / (ps / 1000000u) : 0u;
+
+    bmt_platform_puts("[ TRANSPORT] name=");
+    bmt_platform_puts(g_bmt_transport.transport->name);
+    bmt_platform_puts(" bench_bytes=");
+    bmt_print_u64(sent);
+    bmt_platform_puts(" bench_ms=");
+    bmt_print_fixed3(ps / 1000000u);
+    bmt_platform_puts(" bench_bytes_per_s=");
+    bmt_print_u64(bytes_per_s);
+    bmt_platform_puts("\r\n");
+    return bytes_per_s;
+}
@@ -0,0 +1,112 @@
+// src/bmt_vclock.c
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 Alejandro Avila Marcos
+//
+// Este archivo es parte de la librería Bare-Metal Test Framework (BMT).
+// BMT se distribuye bajo los términos de la Licencia MIT.
+// Puedes encontrar una copia de la licencia en el archivo LICENSE.txt
+// o en <https://opensource.org/licenses/MIT>.
+
+#include "bmt_vclock.h"
+#include "bmt_internal.h"
+
+/**
+ * @internal
+ * @brief State of the virtual clock. Times are in ticks of bmt_platform_get_hires_ticks().
+ */
+static struct {
+    bmt_vclock_mode_t mode;
+    bool used;
+    uint64_t now;
+    uint64_t start_virtual;
+    uint64_t elapsed_virtual;
+    uint64_t start_real;
+    uint64_t step;
+} g_bmt_vclock;
+
+/**
+ * @internal
+ * @brief Converts microseconds to hires ticks without overflowing for long waits.
+ */
+static uint64_t bmt_vclock_us_to_ticks(uint64_t us) {
+    uint64_t hz = bmt_platform_get_hires_tick_hz();
+    return (us / 1000000u) * hz + (us % 1000000u) * hz / 1000000u;
+}
+
+void bmt_vclock_enable(bmt_vclock_mode_t mode) {
+    if (mode == BMT_VCLOCK_OFF) {
+        if (g_bmt_vclock.mode != BMT_VCLOCK_OFF) {
+            g_bmt_vclock.elapsed_virtual += g_bmt_vclock.now - g_bmt_vclock.start_virtual;
+            g_bmt_vclock.mode = BMT_VCLOCK_OFF;
+        }
+        return;
+    }
+    if (g_bmt_vclock.mode == BMT_VCLOCK_OFF) {
+        // Start (or restart, after BMT_VCLOCK_OFF) from the real time, so the clock does not jump
+        uint64_t real = bmt_platform_get_hires_ticks();
+        if (!g_bmt_vclock.used) {
+            g_bmt_vclock.used = true;
+            g_bmt_vclock.start_real = real;
+            g_bmt_vclock.elapsed_virtual = 0;
+            g_bmt_vclock.step = bmt_vclock_us_to_ticks(BMT_VCLOCK_STEP_US);
+        }
+        g_bmt_vclock.now = real;
+        g_bmt_vclock.start_virtual = real;
+    }
+    g_bmt_vclock.mode = mode;
+}
+
+bmt_vclock_mode_t bmt_vclock_mode(void) {
+    return g_bmt_vclock.mode;
+}
+
+bool bmt_vclock_read(uint64_t* ticks) {
+    if (g_bmt_vclock.mode == BMT_VCLOCK_OFF) {
+        return false;
+    }
+    if (g_bmt_vclock.mode == BMT_VCLOCK_FAST_FORWARD) {
+        g_bmt_vclock.now += g_bmt_vclock.step;
+    }
+    *ticks = g_bmt_vclock.now;
+    return true;
+}
+
+void bmt_vclock_sleep_us(uint64_t us) {
+    uint64_t ticks = bmt_vclock_us_to_ticks(us);
+    if (g_bmt_vclock.mode != BMT_VCLOCK_OFF) {
+        g_bmt_vclock.now += ticks;
+        return;
+    }
+    uint64_t start = bmt_platform_get_hires_ticks();
+    while (bmt_platform_get_hires_ticks() - start < ticks) {
+        bmt_platform_cpu_relax();
+    }
+}
+
+void bmt_vclock_idle(void) {
+    if (g_bmt_vclock.mode != BMT_VCLOCK_OFF) {
+        g_bmt_vclock.now += g_bmt_vclock.step;
+    } else {
+        bmt_platform_cpu_relax();
+    }
+}
+
+void bmt_vclock_test_end(const char* suite, const char* name) {
+    if (!g_bmt_vclock.used) {
+        return;  // The test did not use virtual time
+    }
+    bmt_vclock_enable(BMT_VCLOCK_OFF);
+    uint64_t virtual_ticks = g_bmt_vclock.elapsed_virtual;
+    uint64_t real_ticks = bmt_platform_get_hires_ticks() - g_bmt_vclock.start_real;
+    g_bmt_vclock.used = false;
+
+    bmt_platform_puts("[ VCLOCK   ] ");
+    bmt_platform_puts(suite);
+    bmt_platform_putchar('.');
+    bmt_platform_puts(name);
+    bmt_platform_puts(" virtual_ms=");
+    bmt_print_fixed3(bmt_ticks_to_ps(virtual_ticks) / 1000000u);
+    bmt_platform_puts(" real_ms=");
+    bmt_print_fixed3(bmt_ticks_to_ps(real_ticks) / 1000000u);
+    bmt_platform_puts("\r\n");
+}